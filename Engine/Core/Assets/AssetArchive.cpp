@@ -0,0 +1,219 @@
+//
+// Created by sturd on 10/18/2026.
+//
+
+#include "AssetArchive.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace SFT::Assets {
+#pragma region additional functions
+namespace {
+auto same_asset_path(const std::string_view stored,
+                     const std::string_view requested) -> bool {
+  if (stored.size() != requested.size()) {
+    return false;
+  }
+  for (size_t i = 0; i < stored.size(); i++) {
+    if (stored[i] != (requested[i] == '\\' ? '/' : requested[i])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// the views and handles below are the only platform specific part, once a
+// file is mapped the handles can be closed, the view keeps the mapping alive
+auto map_file(const std::filesystem::path &path)
+    -> expected<std::span<const std::byte>, string> {
+#ifdef _WIN32
+  HANDLE file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ,
+                            nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL,
+                            nullptr);
+  if (file == INVALID_HANDLE_VALUE) {
+    return unexpected("failed to open " + path.string());
+  }
+  LARGE_INTEGER size{};
+  if (!GetFileSizeEx(file, &size) || size.QuadPart == 0) {
+    CloseHandle(file);
+    return unexpected(path.string() + " is empty");
+  }
+  HANDLE mapping =
+      CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  CloseHandle(file);
+  if (mapping == nullptr) {
+    return unexpected("failed to map " + path.string());
+  }
+  void *view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+  CloseHandle(mapping);
+  if (view == nullptr) {
+    return unexpected("failed to map " + path.string());
+  }
+  return std::span(static_cast<const std::byte *>(view),
+                   static_cast<size_t>(size.QuadPart));
+#else
+  const int file = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (file < 0) {
+    return unexpected("failed to open " + path.string());
+  }
+  struct stat status{};
+  if (fstat(file, &status) != 0 || status.st_size == 0) {
+    ::close(file);
+    return unexpected(path.string() + " is empty");
+  }
+  void *view = mmap(nullptr, static_cast<size_t>(status.st_size), PROT_READ,
+                    MAP_PRIVATE, file, 0);
+  ::close(file);
+  if (view == MAP_FAILED) {
+    return unexpected("failed to map " + path.string());
+  }
+  return std::span(static_cast<const std::byte *>(view),
+                   static_cast<size_t>(status.st_size));
+#endif
+}
+
+auto unmap_file(const std::byte *data, [[maybe_unused]] const size_t size)
+    -> void {
+#ifdef _WIN32
+  UnmapViewOfFile(data);
+#else
+  munmap(const_cast<std::byte *>(data), size);
+#endif
+}
+} // namespace
+#pragma endregion
+
+#pragma region AssetArchive Functions
+AssetArchive::~AssetArchive() { this->close(); }
+
+auto AssetArchive::open(const std::filesystem::path &path)
+    -> expected<void, string> {
+  this->close();
+  auto mapped = map_file(path);
+  if (!mapped.has_value()) {
+    return unexpected(mapped.error());
+  }
+  this->m_data = mapped->data();
+  this->m_size = mapped->size();
+  if (auto result = this->validate(path); !result.has_value()) {
+    this->close();
+    return unexpected(result.error());
+  }
+  return {};
+}
+
+auto AssetArchive::validate(const std::filesystem::path &path)
+    -> expected<void, string> {
+  if (this->m_size < sizeof(AssetArchiveHeader)) {
+    return unexpected(path.string() + " is too small to be an asset archive");
+  }
+  this->m_header = reinterpret_cast<const AssetArchiveHeader *>(this->m_data);
+  const auto &header = *this->m_header;
+  if (header.magic != AssetArchiveMagic) {
+    return unexpected(path.string() + " is not an asset archive");
+  }
+  if (header.version != AssetArchiveVersion) {
+    return unexpected(path.string() + " was packed as version " +
+                      std::to_string(header.version) + ", expected " +
+                      std::to_string(AssetArchiveVersion) + ", pack it again");
+  }
+  if (header.tableSlots == 0 || (header.tableSlots & (header.tableSlots - 1)) ||
+      header.entryCount >= header.tableSlots) {
+    return unexpected(path.string() + " has a malformed table of contents");
+  }
+  const uint64_t tableEnd = sizeof(AssetArchiveHeader) +
+                            uint64_t{header.tableSlots} *
+                                sizeof(AssetArchiveEntry);
+  // offsets come from the file, so every check is phrased so it can't wrap
+  if (tableEnd > this->m_size || header.namesOffset < tableEnd ||
+      header.namesOffset > this->m_size ||
+      header.namesSize > this->m_size - header.namesOffset) {
+    return unexpected(path.string() + " is truncated");
+  }
+  this->m_table = reinterpret_cast<const AssetArchiveEntry *>(
+      this->m_data + sizeof(AssetArchiveHeader));
+  this->m_names =
+      reinterpret_cast<const char *>(this->m_data + header.namesOffset);
+
+  // checked once here so lookups can trust every entry
+  uint32_t occupied = 0;
+  for (uint32_t slot = 0; slot < header.tableSlots; slot++) {
+    const auto &entry = this->m_table[slot];
+    if (entry.nameLength == 0) {
+      continue;
+    }
+    occupied++;
+    if (uint64_t{entry.nameOffset} + entry.nameLength > header.namesSize ||
+        entry.offset % AssetArchivePayloadAlignment != 0 ||
+        entry.offset > this->m_size ||
+        entry.size > this->m_size - entry.offset) {
+      return unexpected(path.string() + " has an entry out of bounds");
+    }
+  }
+  if (occupied != header.entryCount) {
+    return unexpected(path.string() + " has a malformed table of contents");
+  }
+  return {};
+}
+
+auto AssetArchive::close() -> void {
+  if (this->m_data != nullptr) {
+    unmap_file(this->m_data, this->m_size);
+  }
+  this->m_data = nullptr;
+  this->m_size = 0;
+  this->m_header = nullptr;
+  this->m_table = nullptr;
+  this->m_names = nullptr;
+}
+
+auto AssetArchive::find(const std::string_view path) const
+    -> std::optional<std::span<const std::byte>> {
+  if (this->m_data == nullptr || path.empty()) {
+    return std::nullopt;
+  }
+  const uint64_t hash = hash_asset_path(path);
+  const uint32_t mask = this->m_header->tableSlots - 1;
+  // validate() guarantees a free slot, the bound only guards the loop itself
+  uint32_t slot = static_cast<uint32_t>(hash) & mask;
+  for (uint32_t probe = 0; probe < this->m_header->tableSlots;
+       probe++, slot = (slot + 1) & mask) {
+    const auto &entry = this->m_table[slot];
+    if (entry.nameLength == 0) {
+      return std::nullopt;
+    }
+    if (entry.hash == hash &&
+        same_asset_path({this->m_names + entry.nameOffset, entry.nameLength},
+                        path)) {
+      return std::span(this->m_data + entry.offset,
+                       static_cast<size_t>(entry.size));
+    }
+  }
+  return std::nullopt;
+}
+
+auto AssetArchive::get(const std::string_view path) const
+    -> expected<std::span<const std::byte>, string> {
+  if (this->m_data == nullptr) {
+    return unexpected("no asset archive is open");
+  }
+  if (auto asset = this->find(path); asset.has_value()) {
+    return asset.value();
+  }
+  return unexpected("the asset archive has no " + string(path));
+}
+
+auto AssetArchive::entry_count() const -> uint32_t {
+  return this->m_header != nullptr ? this->m_header->entryCount : 0;
+}
+#pragma endregion
+} // namespace SFT::Assets
@@ -0,0 +1,129 @@
+//
+// Created by sturd on 10/18/2026.
+//
+
+#ifndef ASSETARCHIVE_H
+#define ASSETARCHIVE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+using std::expected;
+using std::string;
+using std::unexpected;
+
+namespace SFT::Assets {
+constexpr uint32_t AssetArchiveMagic = 0x41544653; // "SFTA"
+constexpr uint32_t AssetArchiveVersion = 1;
+// every payload starts on this boundary, mappings are page aligned so the
+// spans handed out are cache line aligned in memory too and can be memcpy'd
+// into a staging buffer at any offset Vulkan asks for
+constexpr uint32_t AssetArchivePayloadAlignment = 64;
+
+/*!
+ * @brief The header at the start of an archive, the table of contents that
+ * follows is an open addressed hash table of tableSlots entries (a power of
+ * two) probed linearly from hash & (tableSlots - 1), then the entry names,
+ * then the payloads, all values are little endian
+ */
+struct AssetArchiveHeader {
+  uint32_t magic;
+  uint32_t version;
+  uint32_t entryCount;
+  uint32_t tableSlots;
+  uint64_t namesOffset;
+  uint64_t namesSize;
+};
+
+struct AssetArchiveEntry {
+  uint64_t hash;
+  uint64_t offset;
+  uint64_t size;
+  uint32_t nameOffset;
+  // 0 marks an empty slot
+  uint32_t nameLength;
+};
+
+static_assert(std::is_trivially_copyable_v<AssetArchiveHeader>);
+static_assert(sizeof(AssetArchiveHeader) == 32);
+static_assert(sizeof(AssetArchiveEntry) == 32);
+
+/*!
+ * @brief Hashes an asset path the way the table of contents does, paths are
+ * relative to the packed directory and backslashes count as forward slashes
+ * @param path the path of the asset inside the archive
+ * @return the 64 bit FNV-1a hash of the path
+ */
+constexpr auto hash_asset_path(const std::string_view path) -> uint64_t {
+  uint64_t hash = 0xcbf29ce484222325ULL;
+  for (const char c : path) {
+    hash ^= static_cast<uint8_t>(c == '\\' ? '/' : c);
+    hash *= 0x100000001b3ULL;
+  }
+  return hash;
+}
+
+/*!
+ * @brief A read only, memory mapped archive of assets packed by the editor,
+ * lookups hash the path into the table of contents and hand out spans that
+ * point straight into the mapping, so nothing is opened, allocated or copied
+ * per asset and the OS pages payloads in on first touch
+ */
+class AssetArchive {
+private:
+  const std::byte *m_data = nullptr;
+  size_t m_size = 0;
+  const AssetArchiveHeader *m_header = nullptr;
+  const AssetArchiveEntry *m_table = nullptr;
+  const char *m_names = nullptr;
+
+  auto validate(const std::filesystem::path &path) -> expected<void, string>;
+
+public:
+  AssetArchive() = default;
+  ~AssetArchive();
+  AssetArchive(const AssetArchive &) = delete;
+  auto operator=(const AssetArchive &) -> AssetArchive & = delete;
+
+  /*!
+   * @brief Maps an archive and validates its table of contents, any archive
+   * that was open before is closed
+   * @param path the archive file
+   * @return On success, returns void, on failure, returns unexpected with error
+   * message
+   */
+  auto open(const std::filesystem::path &path) -> expected<void, string>;
+  /*!
+   * @brief Unmaps the archive, every span handed out becomes invalid
+   */
+  auto close() -> void;
+  /*!
+   * @brief Looks an asset up
+   * @param path the path of the asset inside the archive
+   * @return the asset's bytes inside the mapping, or nullopt if the archive
+   * doesn't have it
+   */
+  [[nodiscard]] auto find(std::string_view path) const
+      -> std::optional<std::span<const std::byte>>;
+  /*!
+   * @brief Looks an asset up, for callers that treat a missing asset as an
+   * error
+   * @param path the path of the asset inside the archive
+   * @return On success, returns the asset's bytes inside the mapping, on
+   * failure, returns unexpected with error message
+   */
+  [[nodiscard]] auto get(std::string_view path) const
+      -> expected<std::span<const std::byte>, string>;
+  [[nodiscard]] auto is_open() const -> bool { return this->m_data != nullptr; }
+  [[nodiscard]] auto entry_count() const -> uint32_t;
+};
+} // namespace SFT::Assets
+
+#endif // ASSETARCHIVE_H
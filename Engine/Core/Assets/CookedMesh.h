@@ -0,0 +1,66 @@
+//
+// Created by sturd on 10/18/2026.
+//
+
+#ifndef COOKEDMESH_H
+#define COOKEDMESH_H
+
+#include <cstdint>
+#include <type_traits>
+
+namespace SFT::Assets {
+constexpr uint32_t CookedMeshMagic = 0x4d544653; // "SFTM"
+constexpr uint32_t CookedMeshVersion = 1;
+constexpr uint32_t CookedMeshMaxLods = 8;
+// the vertex and index data start on this boundary
+constexpr uint32_t CookedMeshAlignment = 16;
+
+struct CookedMeshVertex {
+  float position[3];
+  float normal[3];
+  float uv[2];
+};
+
+/*!
+ * @brief One level of detail, a range of the shared index data
+ */
+struct CookedMeshLod {
+  uint32_t firstIndex;
+  uint32_t indexCount;
+  // how far, in mesh units, this level's surface can be from the full
+  // detail surface, the screen space error is this projected to pixels
+  float error;
+  uint32_t reserved;
+};
+
+/*!
+ * @brief The header of a cooked mesh file, followed by the vertices and then
+ * the indices of every LOD from the finest to the coarsest. Every LOD indexes
+ * the same vertices, simplification only ever removes vertices, so one
+ * vertex buffer serves them all, all values are little endian
+ */
+struct CookedMeshHeader {
+  uint32_t magic;
+  uint32_t version;
+  uint32_t vertexCount;
+  // of all LODs together
+  uint32_t indexCount;
+  uint32_t lodCount;
+  uint32_t reserved;
+  // hash of the source file and the cook settings, a cook is skipped when the
+  // existing output was made from the same hash
+  uint64_t sourceHash;
+  // bounding sphere in mesh units
+  float boundsCenter[3];
+  float boundsRadius;
+  uint64_t vertexOffset;
+  uint64_t indexOffset;
+  CookedMeshLod lods[CookedMeshMaxLods];
+};
+
+static_assert(std::is_trivially_copyable_v<CookedMeshHeader>);
+static_assert(sizeof(CookedMeshVertex) == 32);
+static_assert(sizeof(CookedMeshHeader) % CookedMeshAlignment == 0);
+} // namespace SFT::Assets
+
+#endif // COOKEDMESH_H
@@ -0,0 +1,46 @@
+//
+// Created by sturd on 10/18/2026.
+//
+
+#ifndef COOKEDTEXTURE_H
+#define COOKEDTEXTURE_H
+
+#include <cstdint>
+#include <type_traits>
+
+namespace SFT::Assets {
+constexpr uint32_t CookedTextureMagic = 0x58544653; // "SFTX"
+constexpr uint32_t CookedTextureVersion = 1;
+constexpr uint32_t CookedTextureMaxMips = 16;
+// payloads start on this boundary so they can be copied straight into a
+// staging buffer at an offset vkCmdCopyBufferToImage accepts
+constexpr uint32_t CookedTextureAlignment = 16;
+
+struct CookedTextureMip {
+  uint64_t offset;
+  uint64_t size;
+};
+
+/*!
+ * @brief The header of a cooked texture file, followed by the mips from the
+ * finest to the coarsest, each already in the block layout of vkFormat so
+ * they upload without any conversion, all values are little endian
+ */
+struct CookedTextureHeader {
+  uint32_t magic;
+  uint32_t version;
+  uint32_t vkFormat;
+  uint32_t width;
+  uint32_t height;
+  uint32_t mipLevels;
+  // hash of the source file and the cook settings, a cook is skipped when the
+  // existing output was made from the same hash
+  uint64_t sourceHash;
+  CookedTextureMip mips[CookedTextureMaxMips];
+};
+
+static_assert(std::is_trivially_copyable_v<CookedTextureHeader>);
+static_assert(sizeof(CookedTextureHeader) % CookedTextureAlignment == 0);
+} // namespace SFT::Assets
+
+#endif // COOKEDTEXTURE_H
@@ -0,0 +1,81 @@
+//
+// Created by sturd on 10/18/2026.
+//
+
+#ifndef RELATIVEARRAY_H
+#define RELATIVEARRAY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+
+namespace SFT::Assets {
+/*!
+ * @brief An array stored elsewhere in the same buffer, addressed by a byte
+ * offset from this field rather than by pointer, so a file holding these is
+ * valid wherever it is mapped and can be used in place without fix ups
+ */
+template <typename T> struct RelativeArray {
+  // from the address of this field, 0 with a count of 0 is an empty array
+  int64_t offset;
+  uint64_t count;
+
+  [[nodiscard]] auto data() const -> const T * {
+    return reinterpret_cast<const T *>(
+        reinterpret_cast<const std::byte *>(this) + this->offset);
+  }
+  [[nodiscard]] auto size() const -> size_t {
+    return static_cast<size_t>(this->count);
+  }
+  [[nodiscard]] auto span() const -> std::span<const T> {
+    return this->count == 0 ? std::span<const T>{}
+                            : std::span(this->data(), this->size());
+  }
+  [[nodiscard]] auto operator[](const size_t index) const -> const T & {
+    return this->data()[index];
+  }
+  /*!
+   * @brief Checks the array lies inside a buffer and is aligned for T, which
+   * is what makes it safe to read from an untrusted file
+   * @param base the start of the buffer
+   * @param size the size of the buffer
+   * @return true if every element is inside the buffer
+   */
+  [[nodiscard]] auto in_bounds(const std::byte *base, const size_t size) const
+      -> bool {
+    if (this->count == 0) {
+      return true;
+    }
+    const auto *self = reinterpret_cast<const std::byte *>(this);
+    // the offset comes from the file, it's range checked before the add so
+    // the sum can't overflow
+    const int64_t position = self - base;
+    if (this->offset < -position ||
+        this->offset > static_cast<int64_t>(size) - position) {
+      return false;
+    }
+    const int64_t start = position + this->offset;
+    if (this->count > (size - static_cast<size_t>(start)) / sizeof(T)) {
+      return false;
+    }
+    return reinterpret_cast<uintptr_t>(base + start) % alignof(T) == 0;
+  }
+};
+
+/*!
+ * @brief A UTF-8 string stored as a relative array of chars, not null
+ * terminated
+ */
+struct RelativeString : RelativeArray<char> {
+  [[nodiscard]] auto view() const -> std::string_view {
+    return this->count == 0 ? std::string_view{}
+                            : std::string_view(this->data(), this->size());
+  }
+};
+
+static_assert(sizeof(RelativeArray<uint32_t>) == 16);
+static_assert(sizeof(RelativeString) == 16);
+} // namespace SFT::Assets
+
+#endif // RELATIVEARRAY_H
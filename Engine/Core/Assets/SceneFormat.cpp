@@ -0,0 +1,89 @@
+//
+// Created by sturd on 10/18/2026.
+//
+
+#include "SceneFormat.h"
+
+namespace SFT::Assets {
+#pragma region additional functions
+namespace {
+auto index_valid(const uint32_t index, const size_t count) -> bool {
+  return index == SceneNone || index < count;
+}
+
+template <typename T>
+auto strings_in_bounds(std::span<const T> items, const std::byte *base,
+                       const size_t size, RelativeString T::*first,
+                       RelativeString T::*second = nullptr) -> bool {
+  for (const auto &item : items) {
+    if (!(item.*first).in_bounds(base, size) ||
+        (second != nullptr && !(item.*second).in_bounds(base, size))) {
+      return false;
+    }
+  }
+  return true;
+}
+} // namespace
+#pragma endregion
+
+auto view_scene(const std::span<const std::byte> bytes)
+    -> expected<SceneView, string> {
+  if (bytes.size() < sizeof(SceneHeader)) {
+    return unexpected("too small to be a scene");
+  }
+  if (reinterpret_cast<uintptr_t>(bytes.data()) % alignof(SceneHeader) != 0) {
+    return unexpected("scene data isn't 8 byte aligned");
+  }
+  const auto *header = reinterpret_cast<const SceneHeader *>(bytes.data());
+  if (header->magic != SceneMagic) {
+    return unexpected("not a scene");
+  }
+  if (header->versionMajor != SceneVersionMajor) {
+    return unexpected("scene is version " +
+                      std::to_string(header->versionMajor) + "." +
+                      std::to_string(header->versionMinor) +
+                      ", this build reads " +
+                      std::to_string(SceneVersionMajor) + ".x, bake it again");
+  }
+  if (header->headerSize < sizeof(SceneHeader) ||
+      header->fileSize > bytes.size()) {
+    return unexpected("scene is truncated");
+  }
+
+  const std::byte *base = bytes.data();
+  const auto size = static_cast<size_t>(header->fileSize);
+  if (!header->name.in_bounds(base, size) ||
+      !header->nodes.in_bounds(base, size) ||
+      !header->meshes.in_bounds(base, size) ||
+      !header->materials.in_bounds(base, size) ||
+      !header->lights.in_bounds(base, size)) {
+    return unexpected("scene has an array out of bounds");
+  }
+  const SceneView view(header);
+  if (!strings_in_bounds(view.nodes(), base, size, &SceneNode::name) ||
+      !strings_in_bounds(view.meshes(), base, size, &SceneMesh::asset) ||
+      !strings_in_bounds(view.materials(), base, size,
+                         &SceneMaterial::albedoTexture,
+                         &SceneMaterial::normalTexture)) {
+    return unexpected("scene has a string out of bounds");
+  }
+
+  const auto nodes = view.nodes();
+  for (size_t i = 0; i < nodes.size(); i++) {
+    const auto &node = nodes[i];
+    if ((node.parent != SceneNone && node.parent >= i) ||
+        !index_valid(node.mesh, view.meshes().size()) ||
+        !index_valid(node.material, view.materials().size()) ||
+        !index_valid(node.light, view.lights().size())) {
+      return unexpected("scene node " + std::to_string(i) +
+                        " has an invalid index");
+    }
+  }
+  for (const auto &light : view.lights()) {
+    if (light.type > SceneLightType::Spot) {
+      return unexpected("scene has a light of unknown type");
+    }
+  }
+  return view;
+}
+} // namespace SFT::Assets
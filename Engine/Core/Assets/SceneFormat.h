@@ -0,0 +1,152 @@
+//
+// Created by sturd on 10/18/2026.
+//
+
+#ifndef SCENEFORMAT_H
+#define SCENEFORMAT_H
+
+#include "RelativeArray.h"
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <span>
+#include <string>
+#include <type_traits>
+
+using std::expected;
+using std::string;
+using std::unexpected;
+
+namespace SFT::Assets {
+constexpr uint32_t SceneMagic = 0x53544653; // "SFTS"
+// a new major version changes the layout, a new minor version only appends
+// fields to the end of the header or to new arrays, which older readers skip
+constexpr uint16_t SceneVersionMajor = 1;
+constexpr uint16_t SceneVersionMinor = 0;
+// index fields that don't point at anything
+constexpr uint32_t SceneNone = UINT32_MAX;
+
+struct SceneTransform {
+  float translation[3];
+  // quaternion, x y z w
+  float rotation[4];
+  float scale[3];
+};
+
+struct SceneNode {
+  RelativeString name;
+  // relative to the parent
+  SceneTransform local;
+  // always lower than the node's own index, so walking the array in order
+  // visits parents before their children
+  uint32_t parent;
+  uint32_t mesh;
+  uint32_t material;
+  uint32_t light;
+};
+
+struct SceneMesh {
+  // path of the mesh in the asset archive
+  RelativeString asset;
+  float boundsMin[3];
+  float boundsMax[3];
+};
+
+struct SceneMaterial {
+  // paths of cooked textures in the asset archive, empty for none
+  RelativeString albedoTexture;
+  RelativeString normalTexture;
+  float baseColor[4];
+  float roughness;
+  float metallic;
+};
+
+enum class SceneLightType : uint32_t {
+  Directional,
+  Point,
+  Spot,
+};
+
+struct SceneLight {
+  SceneLightType type;
+  float color[3];
+  float intensity;
+  float range;
+  // spot lights only, in radians
+  float innerConeAngle;
+  float outerConeAngle;
+};
+
+/*!
+ * @brief The start of a baked scene, everything else in the file is reached
+ * through the relative arrays in here, all values are little endian
+ */
+struct SceneHeader {
+  uint32_t magic;
+  uint16_t versionMajor;
+  uint16_t versionMinor;
+  // lets a reader find the end of a header newer than it knows
+  uint32_t headerSize;
+  uint32_t reserved;
+  uint64_t fileSize;
+  RelativeString name;
+  RelativeArray<SceneNode> nodes;
+  RelativeArray<SceneMesh> meshes;
+  RelativeArray<SceneMaterial> materials;
+  RelativeArray<SceneLight> lights;
+};
+
+static_assert(std::is_trivially_copyable_v<SceneHeader>);
+static_assert(std::is_trivially_copyable_v<SceneNode>);
+static_assert(sizeof(SceneTransform) == 40);
+static_assert(sizeof(SceneNode) == 72);
+static_assert(sizeof(SceneMesh) == 40);
+static_assert(sizeof(SceneMaterial) == 56);
+static_assert(sizeof(SceneLight) == 32);
+static_assert(sizeof(SceneHeader) == 104);
+
+/*!
+ * @brief A validated baked scene, a view into the buffer it was made from,
+ * which has to outlive it
+ */
+class SceneView {
+private:
+  const SceneHeader *m_header = nullptr;
+
+public:
+  SceneView() = default;
+  explicit SceneView(const SceneHeader *header) : m_header(header) {}
+
+  [[nodiscard]] auto name() const -> std::string_view {
+    return this->m_header->name.view();
+  }
+  [[nodiscard]] auto nodes() const -> std::span<const SceneNode> {
+    return this->m_header->nodes.span();
+  }
+  [[nodiscard]] auto meshes() const -> std::span<const SceneMesh> {
+    return this->m_header->meshes.span();
+  }
+  [[nodiscard]] auto materials() const -> std::span<const SceneMaterial> {
+    return this->m_header->materials.span();
+  }
+  [[nodiscard]] auto lights() const -> std::span<const SceneLight> {
+    return this->m_header->lights.span();
+  }
+  [[nodiscard]] auto header() const -> const SceneHeader & {
+    return *this->m_header;
+  }
+};
+
+/*!
+ * @brief Validates a baked scene in place, checking every array and string is
+ * inside the buffer and every index points at something, nothing is copied or
+ * allocated so loading a level costs the mapping and this pass
+ * @param bytes the scene file, such as a span from the asset archive, aligned
+ * to at least 8 bytes
+ * @return On success, returns a view of the scene, on failure, returns
+ * unexpected with error message
+ */
+auto view_scene(std::span<const std::byte> bytes) -> expected<SceneView, string>;
+} // namespace SFT::Assets
+
+#endif // SCENEFORMAT_H
@@ -0,0 +1,262 @@
+//
+// Created by sturd on 10/18/2026.
+//
+
+#include "AudioDecoder.h"
+
+#include "Core/Utility/Utility.h"
+#include <algorithm>
+#include <cstring>
+
+namespace SFT::Audio {
+#pragma region additional functions
+namespace {
+enum class WavEncoding : uint8_t {
+  Pcm16,
+  Float32,
+  ImaAdpcm,
+};
+
+constexpr int16_t ImaIndexTable[16] = {-1, -1, -1, -1, 2, 4, 6, 8,
+                                       -1, -1, -1, -1, 2, 4, 6, 8};
+constexpr int32_t ImaStepTable[89] = {
+    7,     8,     9,     10,    11,    12,    13,    14,    16,    17,
+    19,    21,    23,    25,    28,    31,    34,    37,    41,    45,
+    50,    55,    60,    66,    73,    80,    88,    97,    107,   118,
+    130,   143,   157,   173,   190,   209,   230,   253,   279,   307,
+    337,   371,   408,   449,   494,   544,   598,   658,   724,   796,
+    876,   963,   1060,  1166,  1282,  1411,  1552,  1707,  1878,  2066,
+    2272,  2499,  2749,  3024,  3327,  3660,  4026,  4428,  4871,  5358,
+    5894,  6484,  7132,  7845,  8630,  9493,  10442, 11487, 12635, 13899,
+    15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794, 32767};
+
+template <typename T> auto read_le(const std::byte *data) -> T {
+  T value;
+  std::memcpy(&value, data, sizeof(T));
+  return value;
+}
+
+struct ImaChannel {
+  int32_t predictor = 0;
+  int32_t stepIndex = 0;
+
+  auto decode(const uint8_t nibble) -> int16_t {
+    const int32_t step = ImaStepTable[this->stepIndex];
+    int32_t difference = step >> 3;
+    if (nibble & 1) {
+      difference += step >> 2;
+    }
+    if (nibble & 2) {
+      difference += step >> 1;
+    }
+    if (nibble & 4) {
+      difference += step;
+    }
+    if (nibble & 8) {
+      difference = -difference;
+    }
+    this->predictor = std::clamp(this->predictor + difference, -32768, 32767);
+    this->stepIndex = std::clamp(this->stepIndex + ImaIndexTable[nibble], 0, 88);
+    return static_cast<int16_t>(this->predictor);
+  }
+};
+
+class WavDecoder final : public AudioDecoder {
+private:
+  vector<uint8_t> m_owned;
+  std::span<const std::byte> m_data;
+  AudioFormat m_format{};
+  WavEncoding m_encoding = WavEncoding::Pcm16;
+  uint32_t m_blockAlign = 0;
+  uint32_t m_framesPerBlock = 1;
+  uint64_t m_position = 0;
+  // ADPCM decodes a whole block at a time
+  vector<float> m_block;
+  uint64_t m_blockIndex = UINT64_MAX;
+
+  auto decode_adpcm_block(const uint64_t block) -> void {
+    const uint32_t channels = this->m_format.channels;
+    this->m_block.assign(size_t{this->m_framesPerBlock} * 2, 0.0f);
+    const size_t start = block * this->m_blockAlign;
+    const size_t size =
+        std::min<size_t>(this->m_blockAlign, this->m_data.size() - start);
+    const std::byte *data = this->m_data.data() + start;
+    if (size < 4 * channels) {
+      return;
+    }
+    ImaChannel state[2];
+    for (uint32_t c = 0; c < channels; c++) {
+      state[c].predictor = read_le<int16_t>(data + 4 * c);
+      state[c].stepIndex =
+          std::clamp<int32_t>(static_cast<uint8_t>(data[4 * c + 2]), 0, 88);
+      this->m_block[c] = state[c].predictor / 32768.0f;
+    }
+    // after the headers each channel has 4 bytes (8 samples) in turn
+    size_t offset = 4 * channels;
+    uint32_t frame = 1;
+    while (offset + 4 * channels <= size && frame < this->m_framesPerBlock) {
+      for (uint32_t c = 0; c < channels; c++) {
+        for (uint32_t i = 0; i < 8; i++) {
+          const auto byte = static_cast<uint8_t>(data[offset + c * 4 + i / 2]);
+          const uint8_t nibble = (i & 1) ? byte >> 4 : byte & 0x0f;
+          const uint32_t target = frame + i;
+          const int16_t sample = state[c].decode(nibble);
+          if (target < this->m_framesPerBlock) {
+            this->m_block[size_t{target} * 2 + c] = sample / 32768.0f;
+          }
+        }
+      }
+      offset += 4 * channels;
+      frame += 8;
+    }
+    if (channels == 1) {
+      for (uint32_t i = 0; i < this->m_framesPerBlock; i++) {
+        this->m_block[size_t{i} * 2 + 1] = this->m_block[size_t{i} * 2];
+      }
+    }
+  }
+
+public:
+  WavDecoder(std::span<const std::byte> data, const AudioFormat &format,
+             const WavEncoding encoding, const uint32_t blockAlign,
+             const uint32_t framesPerBlock)
+      : m_data(data), m_format(format), m_encoding(encoding),
+        m_blockAlign(blockAlign), m_framesPerBlock(framesPerBlock) {}
+
+  auto own(vector<uint8_t> bytes) -> void { this->m_owned = std::move(bytes); }
+
+  [[nodiscard]] auto format() const -> AudioFormat override {
+    return this->m_format;
+  }
+
+  auto decode(const std::span<float> stereo) -> size_t override {
+    const uint64_t frames = std::min<uint64_t>(
+        stereo.size() / 2, this->m_format.frames - this->m_position);
+    const uint32_t channels = this->m_format.channels;
+    for (uint64_t i = 0; i < frames; i++, this->m_position++) {
+      float left;
+      float right;
+      if (this->m_encoding == WavEncoding::ImaAdpcm) {
+        const uint64_t block = this->m_position / this->m_framesPerBlock;
+        if (block != this->m_blockIndex) {
+          this->decode_adpcm_block(block);
+          this->m_blockIndex = block;
+        }
+        const size_t frame = this->m_position % this->m_framesPerBlock;
+        left = this->m_block[frame * 2];
+        right = this->m_block[frame * 2 + 1];
+      } else {
+        const std::byte *frame =
+            this->m_data.data() + this->m_position * this->m_blockAlign;
+        if (this->m_encoding == WavEncoding::Pcm16) {
+          left = read_le<int16_t>(frame) / 32768.0f;
+          right = channels == 2 ? read_le<int16_t>(frame + 2) / 32768.0f : left;
+        } else {
+          left = read_le<float>(frame);
+          right = channels == 2 ? read_le<float>(frame + 4) : left;
+        }
+      }
+      stereo[i * 2] = left;
+      stereo[i * 2 + 1] = right;
+    }
+    return static_cast<size_t>(frames);
+  }
+
+  auto rewind() -> void override { this->m_position = 0; }
+};
+} // namespace
+#pragma endregion
+
+auto open_wav(const std::span<const std::byte> bytes)
+    -> expected<std::unique_ptr<AudioDecoder>, string> {
+  if (bytes.size() < 12 || std::memcmp(bytes.data(), "RIFF", 4) != 0 ||
+      std::memcmp(bytes.data() + 8, "WAVE", 4) != 0) {
+    return unexpected("not a RIFF WAVE file");
+  }
+  std::span<const std::byte> format;
+  std::span<const std::byte> data;
+  uint64_t factFrames = 0;
+  for (size_t offset = 12; offset + 8 <= bytes.size();) {
+    const auto size = read_le<uint32_t>(bytes.data() + offset + 4);
+    const size_t available = std::min<size_t>(size, bytes.size() - offset - 8);
+    const auto chunk = bytes.subspan(offset + 8, available);
+    if (std::memcmp(bytes.data() + offset, "fmt ", 4) == 0) {
+      format = chunk;
+    } else if (std::memcmp(bytes.data() + offset, "data", 4) == 0) {
+      data = chunk;
+    } else if (std::memcmp(bytes.data() + offset, "fact", 4) == 0 &&
+               chunk.size() >= 4) {
+      factFrames = read_le<uint32_t>(chunk.data());
+    }
+    // chunks are padded to an even size
+    offset += 8 + size + (size & 1);
+  }
+  if (format.size() < 16 || data.empty()) {
+    return unexpected("WAVE file has no fmt or data chunk");
+  }
+
+  auto tag = read_le<uint16_t>(format.data());
+  const auto channels = read_le<uint16_t>(format.data() + 2);
+  const auto sampleRate = read_le<uint32_t>(format.data() + 4);
+  const auto blockAlign = read_le<uint16_t>(format.data() + 12);
+  const auto bits = read_le<uint16_t>(format.data() + 14);
+  // WAVE_FORMAT_EXTENSIBLE keeps the real tag at the start of the sub format
+  if (tag == 0xfffe && format.size() >= 26) {
+    tag = read_le<uint16_t>(format.data() + 24);
+  }
+  if (channels < 1 || channels > 2 || sampleRate == 0 || blockAlign == 0) {
+    return unexpected("only mono and stereo WAVE files are supported");
+  }
+
+  WavEncoding encoding;
+  uint32_t framesPerBlock = 1;
+  uint64_t frames;
+  if (tag == 1 && bits == 16) {
+    encoding = WavEncoding::Pcm16;
+    frames = data.size() / blockAlign;
+  } else if (tag == 3 && bits == 32) {
+    encoding = WavEncoding::Float32;
+    frames = data.size() / blockAlign;
+  } else if (tag == 0x11 && bits == 4) {
+    encoding = WavEncoding::ImaAdpcm;
+    if (blockAlign <= 4u * channels) {
+      return unexpected("IMA ADPCM blocks are too small");
+    }
+    framesPerBlock = (blockAlign - 4u * channels) * 2 / channels + 1;
+    const uint64_t blocks = (data.size() + blockAlign - 1) / blockAlign;
+    frames = blocks * framesPerBlock;
+    if (factFrames != 0) {
+      frames = std::min(frames, factFrames);
+    }
+  } else {
+    return unexpected("unsupported WAVE encoding " + std::to_string(tag) +
+                      " with " + std::to_string(bits) + " bits");
+  }
+  // decode() steps through PCM and float data one blockAlign at a time and
+  // reads every channel of the frame, so the two have to agree
+  if (encoding != WavEncoding::ImaAdpcm && blockAlign != channels * bits / 8) {
+    return unexpected("WAVE block align " + std::to_string(blockAlign) +
+                      " does not match " + std::to_string(channels) +
+                      " channels of " + std::to_string(bits) + " bits");
+  }
+  return std::make_unique<WavDecoder>(
+      data, AudioFormat{sampleRate, channels, frames}, encoding, blockAlign,
+      framesPerBlock);
+}
+
+auto open_wav_file(const std::filesystem::path &path)
+    -> expected<std::unique_ptr<AudioDecoder>, string> {
+  auto bytes = Utility::read_file(path);
+  if (!bytes.has_value()) {
+    return unexpected(bytes.error());
+  }
+  auto decoder = open_wav(std::as_bytes(std::span(*bytes)));
+  if (!decoder.has_value()) {
+    return unexpected(path.string() + ": " + decoder.error());
+  }
+  // the span the decoder reads points into the vector's heap block, which
+  // moving the vector keeps where it is
+  static_cast<WavDecoder &>(*decoder.value()).own(std::move(*bytes));
+  return decoder;
+}
+} // namespace SFT::Audio
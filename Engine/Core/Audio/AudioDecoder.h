@@ -0,0 +1,72 @@
+//
+// Created by sturd on 10/18/2026.
+//
+
+#ifndef AUDIODECODER_H
+#define AUDIODECODER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <filesystem>
+#include <memory>
+#include <span>
+#include <string>
+#include <vector>
+
+using std::expected;
+using std::string;
+using std::unexpected;
+using std::vector;
+
+namespace SFT::Audio {
+struct AudioFormat {
+  uint32_t sampleRate = 0;
+  // 1 or 2
+  uint32_t channels = 0;
+  uint64_t frames = 0;
+};
+
+/*!
+ * @brief Turns an encoded stream into float frames, it is only ever used from
+ * one thread at a time (the mixer's decode thread once playing)
+ */
+class AudioDecoder {
+public:
+  virtual ~AudioDecoder() = default;
+  [[nodiscard]] virtual auto format() const -> AudioFormat = 0;
+  /*!
+   * @brief Decodes the next frames as interleaved stereo, mono streams are
+   * written to both channels
+   * @param stereo receives the frames, two floats per frame
+   * @return how many frames were written, less than asked for only at the
+   * end of the stream
+   */
+  virtual auto decode(std::span<float> stereo) -> size_t = 0;
+  /*!
+   * @brief Moves back to the start, for looping voices
+   */
+  virtual auto rewind() -> void = 0;
+};
+
+/*!
+ * @brief Opens a RIFF WAVE stream, 16 bit PCM, 32 bit float and 4 bit IMA
+ * ADPCM are supported, the bytes aren't copied so they must outlive the
+ * decoder, which fits data mapped from the asset archive
+ * @param bytes the whole .wav file
+ * @return On success, returns the decoder, on failure, returns unexpected with
+ * error message
+ */
+auto open_wav(std::span<const std::byte> bytes)
+    -> expected<std::unique_ptr<AudioDecoder>, string>;
+/*!
+ * @brief Reads a .wav file into memory and opens it, see open_wav
+ * @param path the file
+ * @return On success, returns the decoder, on failure, returns unexpected with
+ * error message
+ */
+auto open_wav_file(const std::filesystem::path &path)
+    -> expected<std::unique_ptr<AudioDecoder>, string>;
+} // namespace SFT::Audio
+
+#endif // AUDIODECODER_H
@@ -0,0 +1,440 @@
+//
+// Created by sturd on 10/18/2026.
+//
+
+#include "AudioMixer.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <numbers>
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+#include <emmintrin.h>
+#define SFT_AUDIO_SSE2 1
+#endif
+
+namespace SFT::Audio {
+#pragma region additional functions
+namespace {
+constexpr size_t CommandQueueSize = 1024;
+// how often the decode thread checks the streams, well inside the decode ahead
+constexpr auto DecodeInterval = std::chrono::milliseconds(2);
+constexpr size_t DecodeChunkFrames = 2048;
+
+/*!
+ * @brief Adds one voice into the mix, linearly resampled from the window and
+ * scaled by a per frame gain ramp, four output frames per iteration
+ * @param window the voice's stereo frames
+ * @param position where in the window the first output frame reads
+ * @param step window frames per output frame
+ */
+auto mix_voice(const float *window, const double position, const double step,
+               float gainLeft, float gainRight, const float rampLeft,
+               const float rampRight, float *out, const size_t frames)
+    -> void {
+  size_t i = 0;
+#ifdef SFT_AUDIO_SSE2
+  const __m128 lanes = _mm_setr_ps(0.0f, 1.0f, 2.0f, 3.0f);
+  const __m128 stepVector = _mm_set1_ps(static_cast<float>(step));
+  const __m128 rampLeftVector = _mm_mul_ps(_mm_set1_ps(rampLeft), lanes);
+  const __m128 rampRightVector = _mm_mul_ps(_mm_set1_ps(rampRight), lanes);
+  alignas(16) int32_t index[4];
+  for (; i + 4 <= frames; i += 4) {
+    // positions are computed from the block start rather than accumulated,
+    // so float rounding can't drift over the block
+    const __m128 base = _mm_set1_ps(static_cast<float>(position + step * i));
+    const __m128 read = _mm_add_ps(base, _mm_mul_ps(stepVector, lanes));
+    const __m128i whole = _mm_cvttps_epi32(read);
+    const __m128 fraction = _mm_sub_ps(read, _mm_cvtepi32_ps(whole));
+    _mm_store_si128(reinterpret_cast<__m128i *>(index), whole);
+
+    const float *f0 = window + index[0] * 2;
+    const float *f1 = window + index[1] * 2;
+    const float *f2 = window + index[2] * 2;
+    const float *f3 = window + index[3] * 2;
+    const __m128 left0 = _mm_setr_ps(f0[0], f1[0], f2[0], f3[0]);
+    const __m128 right0 = _mm_setr_ps(f0[1], f1[1], f2[1], f3[1]);
+    const __m128 left1 = _mm_setr_ps(f0[2], f1[2], f2[2], f3[2]);
+    const __m128 right1 = _mm_setr_ps(f0[3], f1[3], f2[3], f3[3]);
+    __m128 left =
+        _mm_add_ps(left0, _mm_mul_ps(_mm_sub_ps(left1, left0), fraction));
+    __m128 right =
+        _mm_add_ps(right0, _mm_mul_ps(_mm_sub_ps(right1, right0), fraction));
+
+    left = _mm_mul_ps(left, _mm_add_ps(_mm_set1_ps(gainLeft), rampLeftVector));
+    right =
+        _mm_mul_ps(right, _mm_add_ps(_mm_set1_ps(gainRight), rampRightVector));
+    gainLeft += rampLeft * 4.0f;
+    gainRight += rampRight * 4.0f;
+
+    float *target = out + i * 2;
+    _mm_storeu_ps(target, _mm_add_ps(_mm_loadu_ps(target),
+                                     _mm_unpacklo_ps(left, right)));
+    _mm_storeu_ps(target + 4, _mm_add_ps(_mm_loadu_ps(target + 4),
+                                         _mm_unpackhi_ps(left, right)));
+  }
+#endif
+  for (; i < frames; i++) {
+    const double read = position + step * i;
+    const auto whole = static_cast<size_t>(read);
+    const auto fraction = static_cast<float>(read - whole);
+    const float *frame = window + whole * 2;
+    out[i * 2] += (frame[0] + (frame[2] - frame[0]) * fraction) * gainLeft;
+    out[i * 2 + 1] += (frame[1] + (frame[3] - frame[1]) * fraction) * gainRight;
+    gainLeft += rampLeft;
+    gainRight += rampRight;
+  }
+}
+
+auto scale(std::span<float> samples, const float gain) -> void {
+  size_t i = 0;
+#ifdef SFT_AUDIO_SSE2
+  const __m128 gainVector = _mm_set1_ps(gain);
+  for (; i + 4 <= samples.size(); i += 4) {
+    _mm_storeu_ps(samples.data() + i,
+                  _mm_mul_ps(_mm_loadu_ps(samples.data() + i), gainVector));
+  }
+#endif
+  for (; i < samples.size(); i++) {
+    samples[i] *= gain;
+  }
+}
+} // namespace
+#pragma endregion
+
+#pragma region AudioMixer Functions
+AudioMixer::~AudioMixer() { this->shutdown(); }
+
+auto AudioMixer::init(const uint32_t sampleRate, const uint32_t maxVoices)
+    -> expected<void, string> {
+  if (this->m_running) {
+    return unexpected("the mixer is already running");
+  }
+  if (sampleRate == 0 || maxVoices == 0) {
+    return unexpected("the mixer needs a sample rate and at least one voice");
+  }
+  this->m_sampleRate = sampleRate;
+  this->m_maxVoices = maxVoices;
+  this->m_commands =
+      std::make_unique<Threading::SpscQueue<Command>>(CommandQueueSize);
+  this->m_newStreams =
+      std::make_unique<Threading::SpscQueue<Stream *>>(CommandQueueSize);
+  this->m_voicePool.assign(maxVoices, Voice{});
+  this->m_activeVoices.clear();
+  this->m_activeVoices.reserve(maxVoices);
+  this->m_freeVoices.clear();
+  for (uint32_t i = maxVoices; i > 0; i--) {
+    this->m_freeVoices.push_back(i - 1);
+  }
+  this->m_decodeThread = std::jthread(
+      [this](const std::stop_token &stop) { this->decode_loop(stop); });
+  this->m_running = true;
+  return {};
+}
+
+auto AudioMixer::shutdown() -> void {
+  if (!this->m_running) {
+    return;
+  }
+  this->m_decodeThread.request_stop();
+  this->m_decodeThread = {};
+  // every stream went through the decode thread's queue, so it owns them all
+  Stream *stream;
+  while (this->m_newStreams->try_pop(stream)) {
+    this->m_streams.push_back(stream);
+  }
+  for (Stream *owned : this->m_streams) {
+    delete owned;
+  }
+  this->m_streams.clear();
+  this->m_activeVoices.clear();
+  this->m_voicePool.clear();
+  this->m_commands.reset();
+  this->m_newStreams.reset();
+  this->m_activeCount = 0;
+  this->m_running = false;
+}
+
+auto AudioMixer::play(std::unique_ptr<AudioDecoder> decoder,
+                      const VoiceParams &params) -> VoiceHandle {
+  if (!this->m_running || decoder == nullptr) {
+    return {};
+  }
+  const AudioFormat format = decoder->format();
+  const double ratio =
+      static_cast<double>(format.sampleRate) / this->m_sampleRate;
+  if (format.sampleRate == 0 || ratio * MaxPitch > MaxStep) {
+    return {};
+  }
+  // this is the only thread pushing to either queue, so room now means the
+  // pushes below can't fail and leave the stream known to only one side
+  if (this->m_commands->size() >= this->m_commands->capacity() ||
+      this->m_newStreams->size() >= this->m_newStreams->capacity()) {
+    this->m_droppedCommands++;
+    return {};
+  }
+  auto *stream = new Stream(static_cast<size_t>(
+      DecodeAheadSeconds * static_cast<float>(format.sampleRate) * 2.0f));
+  stream->decoder = std::move(decoder);
+  stream->sourceRate = format.sampleRate;
+  stream->stereo = format.channels == 2;
+  stream->loop = params.loop;
+  const auto windowFrames =
+      static_cast<size_t>(std::ceil(ratio * MaxPitch * MixBlockFrames)) + 4;
+  stream->window.resize(windowFrames * 2);
+
+  const uint32_t id = this->m_nextId++;
+  this->m_newStreams->try_push(stream);
+  this->m_commands->try_push(
+      Command{CommandType::Play, id, stream, params, 0.0f});
+  return {id};
+}
+
+auto AudioMixer::send(const Command &command) -> bool {
+  if (!this->m_running || !this->m_commands->try_push(command)) {
+    this->m_droppedCommands++;
+    return false;
+  }
+  return true;
+}
+
+auto AudioMixer::stop(const VoiceHandle voice) -> void {
+  this->send({CommandType::Stop, voice.id, nullptr, {}, 0.0f});
+}
+
+auto AudioMixer::set_gain(const VoiceHandle voice, const float gain) -> void {
+  this->send({CommandType::SetGain, voice.id, nullptr, {}, gain});
+}
+
+auto AudioMixer::set_pan(const VoiceHandle voice, const float pan) -> void {
+  this->send({CommandType::SetPan, voice.id, nullptr, {}, pan});
+}
+
+auto AudioMixer::set_pitch(const VoiceHandle voice, const float pitch)
+    -> void {
+  this->send({CommandType::SetPitch, voice.id, nullptr, {}, pitch});
+}
+
+auto AudioMixer::set_master_gain(const float gain) -> void {
+  this->m_masterGain.store(gain, std::memory_order_relaxed);
+}
+
+auto AudioMixer::stats() const -> AudioMixerStats {
+  return {
+      .activeVoices = this->m_activeCount.load(std::memory_order_relaxed),
+      .starvedBlocks = this->m_starvedBlocks.load(std::memory_order_relaxed),
+      .droppedCommands =
+          this->m_droppedCommands.load(std::memory_order_relaxed),
+  };
+}
+
+auto AudioMixer::decode_loop(const std::stop_token &stop) -> void {
+  vector<float> scratch(DecodeChunkFrames * 2);
+  while (!stop.stop_requested()) {
+    Stream *stream;
+    while (this->m_newStreams->try_pop(stream)) {
+      this->m_streams.push_back(stream);
+    }
+    for (size_t i = 0; i < this->m_streams.size();) {
+      Stream *current = this->m_streams[i];
+      if (current->released.load(std::memory_order_acquire)) {
+        delete current;
+        this->m_streams[i] = this->m_streams.back();
+        this->m_streams.pop_back();
+        continue;
+      }
+      this->top_up(*current, scratch);
+      i++;
+    }
+    std::this_thread::sleep_for(DecodeInterval);
+  }
+}
+
+auto AudioMixer::top_up(Stream &stream, vector<float> &scratch) -> void {
+  if (stream.finished.load(std::memory_order_relaxed)) {
+    return;
+  }
+  while (true) {
+    // a lower bound from this side, so everything decoded fits
+    const size_t freeFrames =
+        (stream.samples.capacity() - stream.samples.size()) / 2;
+    const size_t frames = std::min(freeFrames, DecodeChunkFrames);
+    if (frames == 0) {
+      return;
+    }
+    const size_t decoded =
+        stream.decoder->decode(std::span(scratch.data(), frames * 2));
+    stream.samples.push(std::span<const float>(scratch.data(), decoded * 2));
+    if (decoded < frames) {
+      if (stream.loop && stream.decoder->format().frames > 0) {
+        stream.decoder->rewind();
+        continue;
+      }
+      stream.finished.store(true, std::memory_order_release);
+      return;
+    }
+  }
+}
+
+auto AudioMixer::apply(Command &command) -> void {
+  if (command.type == CommandType::Play) {
+    if (this->m_freeVoices.empty()) {
+      // the decode thread frees it
+      command.stream->released.store(true, std::memory_order_release);
+      this->m_droppedCommands++;
+      return;
+    }
+    const uint32_t index = this->m_freeVoices.back();
+    this->m_freeVoices.pop_back();
+    Voice &voice = this->m_voicePool[index];
+    voice = Voice{};
+    voice.id = command.id;
+    voice.stream = command.stream;
+    voice.params = command.params;
+    this->m_activeVoices.push_back(index);
+    return;
+  }
+  // hundreds of voices at most and parameter changes are rare, a scan beats
+  // keeping a map in step
+  const auto it =
+      std::ranges::find_if(this->m_activeVoices, [&](const uint32_t index) {
+        return this->m_voicePool[index].id == command.id;
+      });
+  if (it == this->m_activeVoices.end()) {
+    return;
+  }
+  Voice &voice = this->m_voicePool[*it];
+  switch (command.type) {
+  case CommandType::Stop:
+    this->release(voice);
+    break;
+  case CommandType::SetGain:
+    voice.params.gain = command.value;
+    break;
+  case CommandType::SetPan:
+    voice.params.pan = command.value;
+    break;
+  case CommandType::SetPitch:
+    voice.params.pitch = command.value;
+    break;
+  default:
+    break;
+  }
+}
+
+auto AudioMixer::release(Voice &voice) -> void {
+  voice.stream->released.store(true, std::memory_order_release);
+  voice.stream = nullptr;
+  const auto index = static_cast<uint32_t>(&voice - this->m_voicePool.data());
+  std::erase(this->m_activeVoices, index);
+  this->m_freeVoices.push_back(index);
+}
+
+auto AudioMixer::mix(const std::span<float> stereo) -> void {
+  if (!this->m_running) {
+    std::ranges::fill(stereo, 0.0f);
+    return;
+  }
+  Command command;
+  while (this->m_commands->try_pop(command)) {
+    this->apply(command);
+  }
+  for (size_t offset = 0; offset < stereo.size();
+       offset += MixBlockFrames * 2) {
+    this->mix_block(stereo.subspan(
+        offset, std::min<size_t>(MixBlockFrames * 2, stereo.size() - offset)));
+  }
+  scale(stereo, this->m_masterGain.load(std::memory_order_relaxed));
+  this->m_activeCount.store(static_cast<uint32_t>(this->m_activeVoices.size()),
+                            std::memory_order_relaxed);
+}
+
+auto AudioMixer::mix_block(const std::span<float> stereo) -> void {
+  std::ranges::fill(stereo, 0.0f);
+  const size_t frames = stereo.size() / 2;
+  // iterated backwards so finished voices can be released on the way
+  for (size_t slot = this->m_activeVoices.size(); slot > 0; slot--) {
+    Voice &voice = this->m_voicePool[this->m_activeVoices[slot - 1]];
+    Stream &stream = *voice.stream;
+    // a zero step would never finish the block, NaN would never compare
+    const float pitch = std::isfinite(voice.params.pitch)
+                            ? std::clamp(voice.params.pitch, MinPitch, MaxPitch)
+                            : 1.0f;
+    const double step =
+        std::min(static_cast<double>(stream.sourceRate) / this->m_sampleRate *
+                     pitch,
+                 MaxStep);
+
+    // pull what this block reads, frame i reads window frames floor(p) and
+    // floor(p) + 1 where p = position + step * i
+    const size_t needed = std::min(
+        static_cast<size_t>(voice.position + step * (frames - 1)) + 2,
+        stream.window.size() / 2);
+    if (needed > stream.windowFrames) {
+      stream.windowFrames +=
+          stream.samples.pop(std::span(stream.window)
+                                 .subspan(stream.windowFrames * 2,
+                                          (needed - stream.windowFrames) * 2)) /
+          2;
+    }
+    bool ending = false;
+    if (stream.windowFrames < needed) {
+      if (stream.finished.load(std::memory_order_acquire) &&
+          stream.samples.size() == 0) {
+        // one silent frame so the last real one fades into it
+        ending = true;
+        std::fill_n(stream.window.begin() +
+                        static_cast<ptrdiff_t>(stream.windowFrames * 2),
+                    2, 0.0f);
+        stream.windowFrames++;
+      } else {
+        this->m_starvedBlocks.fetch_add(1, std::memory_order_relaxed);
+      }
+    }
+    // frames whose reads are all inside the window
+    const double readable =
+        static_cast<double>(stream.windowFrames) - 1.0 - voice.position;
+    const size_t mixable =
+        readable <= 0.0 ? 0
+                        : std::min(frames, static_cast<size_t>(
+                                               std::ceil(readable / step)));
+
+    // equal power panning for mono, a balance control for stereo
+    const float pan = std::clamp(voice.params.pan, -1.0f, 1.0f);
+    float targetLeft;
+    float targetRight;
+    if (stream.stereo) {
+      targetLeft = voice.params.gain * std::min(1.0f, 1.0f - pan);
+      targetRight = voice.params.gain * std::min(1.0f, 1.0f + pan);
+    } else {
+      const float angle = (pan + 1.0f) * std::numbers::pi_v<float> / 4.0f;
+      targetLeft = voice.params.gain * std::cos(angle);
+      targetRight = voice.params.gain * std::sin(angle);
+    }
+    // ramped over the block so gain and pan changes don't click
+    const float rampLeft =
+        (targetLeft - voice.gainLeft) / static_cast<float>(frames);
+    const float rampRight =
+        (targetRight - voice.gainRight) / static_cast<float>(frames);
+    mix_voice(stream.window.data(), voice.position, step, voice.gainLeft,
+              voice.gainRight, rampLeft, rampRight, stereo.data(), mixable);
+    voice.gainLeft += rampLeft * static_cast<float>(mixable);
+    voice.gainRight += rampRight * static_cast<float>(mixable);
+
+    voice.position += step * static_cast<double>(mixable);
+    const auto consumed =
+        std::min(static_cast<size_t>(voice.position), stream.windowFrames);
+    std::memmove(stream.window.data(), stream.window.data() + consumed * 2,
+                 (stream.windowFrames - consumed) * 2 * sizeof(float));
+    stream.windowFrames -= consumed;
+    voice.position -= static_cast<double>(consumed);
+
+    if (ending && mixable < frames) {
+      this->release(voice);
+    }
+  }
+}
+#pragma endregion
+} // namespace SFT::Audio
@@ -0,0 +1,180 @@
+//
+// Created by sturd on 10/18/2026.
+//
+
+#ifndef AUDIOMIXER_H
+#define AUDIOMIXER_H
+
+#include "AudioDecoder.h"
+#include "Core/Threading/SpscQueue.h"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <thread>
+#include <vector>
+
+namespace SFT::Audio {
+struct VoiceHandle {
+  uint32_t id = 0;
+
+  [[nodiscard]] auto valid() const -> bool { return id != 0; }
+};
+
+struct VoiceParams {
+  float gain = 1.0f;
+  // -1 is fully left, 1 fully right
+  float pan = 0.0f;
+  // playback speed, resampled, 1 plays at the stream's own rate, clamped to
+  // [AudioMixer::MinPitch, AudioMixer::MaxPitch]
+  float pitch = 1.0f;
+  bool loop = false;
+};
+
+struct AudioMixerStats {
+  uint32_t activeVoices = 0;
+  // blocks a voice had to pad with silence because decoding fell behind
+  uint64_t starvedBlocks = 0;
+  // plays and parameter changes lost to full queues or the voice limit
+  uint64_t droppedCommands = 0;
+};
+
+/*!
+ * @brief Mixes any number of streamed voices into one stereo float stream,
+ * which an output (see OpenALOutput) pulls from its own thread. Three threads
+ * are involved and none of them lock: the game thread issues commands, a
+ * decode thread keeps every voice's sample queue topped up, and the output
+ * thread mixes, with SSE doing the resampling, panning and gain four frames
+ * at a time. Commands must all come from one thread
+ */
+class AudioMixer {
+private:
+  struct Stream {
+    std::unique_ptr<AudioDecoder> decoder;
+    // interleaved stereo at the stream's own rate, decode thread to mixer
+    Threading::SpscQueue<float> samples;
+    uint32_t sourceRate = 0;
+    bool stereo = true;
+    bool loop = false;
+    // frames taken from samples but not consumed yet, only the mixer touches
+    // it, sized on the game thread so mixing never allocates
+    vector<float> window;
+    size_t windowFrames = 0;
+    // set by the decode thread once the decoder ran dry
+    std::atomic<bool> finished = false;
+    // set by the mixer when it's done with the stream, the decode thread
+    // deletes it after that
+    std::atomic<bool> released = false;
+
+    explicit Stream(const size_t capacity) : samples(capacity) {}
+  };
+
+  enum class CommandType : uint8_t {
+    Play,
+    Stop,
+    SetGain,
+    SetPan,
+    SetPitch,
+  };
+  struct Command {
+    CommandType type = CommandType::Play;
+    uint32_t id = 0;
+    Stream *stream = nullptr;
+    VoiceParams params{};
+    float value = 0.0f;
+  };
+
+  struct Voice {
+    uint32_t id = 0;
+    Stream *stream = nullptr;
+    VoiceParams params{};
+    // fractional read position, relative to the first frame of the window
+    double position = 0.0;
+    float gainLeft = 0.0f;
+    float gainRight = 0.0f;
+  };
+
+  uint32_t m_sampleRate = 0;
+  uint32_t m_maxVoices = 0;
+  std::atomic<float> m_masterGain = 1.0f;
+  uint32_t m_nextId = 1;
+  bool m_running = false;
+
+  std::unique_ptr<Threading::SpscQueue<Command>> m_commands;
+  std::unique_ptr<Threading::SpscQueue<Stream *>> m_newStreams;
+
+  // owned by the mixing thread
+  vector<Voice> m_voicePool;
+  vector<uint32_t> m_activeVoices;
+  vector<uint32_t> m_freeVoices;
+
+  // owned by the decode thread
+  std::jthread m_decodeThread;
+  vector<Stream *> m_streams;
+
+  std::atomic<uint32_t> m_activeCount = 0;
+  std::atomic<uint64_t> m_starvedBlocks = 0;
+  std::atomic<uint64_t> m_droppedCommands = 0;
+
+  auto decode_loop(const std::stop_token &stop) -> void;
+  auto top_up(Stream &stream, vector<float> &scratch) -> void;
+  auto send(const Command &command) -> bool;
+  auto apply(Command &command) -> void;
+  auto mix_block(std::span<float> stereo) -> void;
+  auto release(Voice &voice) -> void;
+
+public:
+  // mixing happens in blocks of at most this many frames
+  static constexpr uint32_t MixBlockFrames = 256;
+  // how far ahead of the mixer each stream is decoded, in seconds
+  static constexpr float DecodeAheadSeconds = 0.25f;
+  // a voice always moves forward, pausing is stop and play again
+  static constexpr float MinPitch = 1.0f / 64.0f;
+  static constexpr float MaxPitch = 4.0f;
+  // streams may be at most this many times the mix rate, after pitch
+  static constexpr double MaxStep = 16.0;
+
+  AudioMixer() = default;
+  ~AudioMixer();
+  AudioMixer(const AudioMixer &) = delete;
+  auto operator=(const AudioMixer &) -> AudioMixer & = delete;
+
+  /*!
+   * @brief Allocates every voice up front and starts the decode thread
+   * @param sampleRate the rate mix produces
+   * @param maxVoices how many voices can play at once
+   * @return On success, returns void, on failure, returns unexpected with error
+   * message
+   */
+  auto init(uint32_t sampleRate, uint32_t maxVoices) -> expected<void, string>;
+  /*!
+   * @brief Stops the decode thread and frees every stream, the output must be
+   * stopped first
+   */
+  auto shutdown() -> void;
+  /*!
+   * @brief Starts a voice
+   * @param decoder the stream to play, decoded on the decode thread from now
+   * @param params how to play it
+   * @return the voice, or an invalid handle if the command queue is full
+   */
+  auto play(std::unique_ptr<AudioDecoder> decoder, const VoiceParams &params)
+      -> VoiceHandle;
+  auto stop(VoiceHandle voice) -> void;
+  auto set_gain(VoiceHandle voice, float gain) -> void;
+  auto set_pan(VoiceHandle voice, float pan) -> void;
+  auto set_pitch(VoiceHandle voice, float pitch) -> void;
+  auto set_master_gain(float gain) -> void;
+  /*!
+   * @brief Produces the next frames, called by the output from one thread
+   * @param stereo receives interleaved stereo frames, overwritten
+   */
+  auto mix(std::span<float> stereo) -> void;
+  [[nodiscard]] auto sample_rate() const -> uint32_t {
+    return this->m_sampleRate;
+  }
+  [[nodiscard]] auto stats() const -> AudioMixerStats;
+};
+} // namespace SFT::Audio
+
+#endif // AUDIOMIXER_H
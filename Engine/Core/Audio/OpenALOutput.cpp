@@ -0,0 +1,146 @@
+//
+// Created by sturd on 10/18/2026.
+//
+
+#include "OpenALOutput.h"
+
+#include <algorithm>
+#include <chrono>
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+#include <emmintrin.h>
+#define SFT_AUDIO_SSE2 1
+#endif
+
+namespace SFT::Audio {
+#pragma region additional functions
+namespace {
+// clamps the float mix into 16 bit samples, saturating rather than wrapping
+auto to_pcm16(const std::span<const float> samples, int16_t *out) -> void {
+  size_t i = 0;
+#ifdef SFT_AUDIO_SSE2
+  const __m128 scale = _mm_set1_ps(32767.0f);
+  for (; i + 8 <= samples.size(); i += 8) {
+    const __m128i low =
+        _mm_cvtps_epi32(_mm_mul_ps(_mm_loadu_ps(samples.data() + i), scale));
+    const __m128i high = _mm_cvtps_epi32(
+        _mm_mul_ps(_mm_loadu_ps(samples.data() + i + 4), scale));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(out + i),
+                     _mm_packs_epi32(low, high));
+  }
+#endif
+  for (; i < samples.size(); i++) {
+    out[i] = static_cast<int16_t>(
+        std::clamp(samples[i] * 32767.0f, -32768.0f, 32767.0f));
+  }
+}
+} // namespace
+#pragma endregion
+
+#pragma region OpenALOutput Functions
+OpenALOutput::~OpenALOutput() { this->shutdown(); }
+
+auto OpenALOutput::init(AudioMixer &mixer, const char *deviceName,
+                        const uint32_t blockFrames, const uint32_t bufferCount)
+    -> expected<void, string> {
+  if (this->m_device != nullptr) {
+    return unexpected("the audio output is already running");
+  }
+  this->m_device = alcOpenDevice(deviceName);
+  if (this->m_device == nullptr) {
+    return unexpected("failed to open the OpenAL device");
+  }
+  const ALCint attributes[] = {ALC_FREQUENCY,
+                               static_cast<ALCint>(mixer.sample_rate()), 0};
+  this->m_context = alcCreateContext(this->m_device, attributes);
+  if (this->m_context == nullptr ||
+      !alcMakeContextCurrent(this->m_context)) {
+    this->shutdown();
+    return unexpected("failed to create the OpenAL context");
+  }
+  alGenSources(1, &this->m_source);
+  // the mix is already panned, the source must not be positioned again
+  alSourcei(this->m_source, AL_SOURCE_RELATIVE, AL_TRUE);
+  this->m_buffers.resize(std::max(2u, bufferCount));
+  alGenBuffers(static_cast<ALsizei>(this->m_buffers.size()),
+               this->m_buffers.data());
+  if (alGetError() != AL_NO_ERROR) {
+    this->shutdown();
+    return unexpected("failed to create the OpenAL source and buffers");
+  }
+
+  this->m_mixer = &mixer;
+  this->m_blockFrames = std::max(1u, blockFrames);
+  this->m_mixBlock.resize(size_t{this->m_blockFrames} * 2);
+  this->m_outputBlock.resize(size_t{this->m_blockFrames} * 2);
+  for (const ALuint buffer : this->m_buffers) {
+    this->fill(buffer);
+  }
+  alSourceQueueBuffers(this->m_source,
+                       static_cast<ALsizei>(this->m_buffers.size()),
+                       this->m_buffers.data());
+  alSourcePlay(this->m_source);
+  this->m_thread = std::jthread(
+      [this](const std::stop_token &stop) { this->output_loop(stop); });
+  return {};
+}
+
+auto OpenALOutput::shutdown() -> void {
+  this->m_thread = {};
+  if (this->m_source != 0) {
+    alSourceStop(this->m_source);
+    alDeleteSources(1, &this->m_source);
+    this->m_source = 0;
+  }
+  if (!this->m_buffers.empty()) {
+    alDeleteBuffers(static_cast<ALsizei>(this->m_buffers.size()),
+                    this->m_buffers.data());
+    this->m_buffers.clear();
+  }
+  if (this->m_context != nullptr) {
+    alcMakeContextCurrent(nullptr);
+    alcDestroyContext(this->m_context);
+    this->m_context = nullptr;
+  }
+  if (this->m_device != nullptr) {
+    alcCloseDevice(this->m_device);
+    this->m_device = nullptr;
+  }
+  this->m_mixer = nullptr;
+}
+
+auto OpenALOutput::fill(const ALuint buffer) -> void {
+  this->m_mixer->mix(this->m_mixBlock);
+  to_pcm16(this->m_mixBlock, this->m_outputBlock.data());
+  alBufferData(buffer, AL_FORMAT_STEREO16, this->m_outputBlock.data(),
+               static_cast<ALsizei>(this->m_outputBlock.size() *
+                                    sizeof(int16_t)),
+               static_cast<ALsizei>(this->m_mixer->sample_rate()));
+}
+
+auto OpenALOutput::output_loop(const std::stop_token &stop) -> void {
+  // polled a few times per block, so a finished buffer waits at most a
+  // quarter of a block before it's refilled
+  const auto interval = std::chrono::microseconds(
+      1'000'000ull * this->m_blockFrames / this->m_mixer->sample_rate() / 4);
+  while (!stop.stop_requested()) {
+    ALint processed = 0;
+    alGetSourcei(this->m_source, AL_BUFFERS_PROCESSED, &processed);
+    for (; processed > 0; processed--) {
+      ALuint buffer;
+      alSourceUnqueueBuffers(this->m_source, 1, &buffer);
+      this->fill(buffer);
+      alSourceQueueBuffers(this->m_source, 1, &buffer);
+    }
+    ALint state = AL_PLAYING;
+    alGetSourcei(this->m_source, AL_SOURCE_STATE, &state);
+    if (state != AL_PLAYING) {
+      // every queued buffer played out before we refilled one
+      this->m_underruns.fetch_add(1, std::memory_order_relaxed);
+      alSourcePlay(this->m_source);
+    }
+    std::this_thread::sleep_for(interval);
+  }
+}
+#pragma endregion
+} // namespace SFT::Audio
@@ -0,0 +1,71 @@
+//
+// Created by sturd on 10/18/2026.
+//
+
+#ifndef OPENALOUTPUT_H
+#define OPENALOUTPUT_H
+
+#include "AudioMixer.h"
+#include <AL/al.h>
+#include <AL/alc.h>
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+namespace SFT::Audio {
+/*!
+ * @brief Plays a mixer through a single OpenAL streaming source, the mix is
+ * made in blocks on a dedicated thread and queued on a few OpenAL buffers, so
+ * OpenAL only ever sees one voice however many the mixer plays. OpenAL Soft
+ * picks its backend from ALSOFT_DRIVERS, "null" or "wave" (with
+ * ALSOFT_CONF pointing at a wave file) run it without an audio device
+ */
+class OpenALOutput {
+private:
+  ALCdevice *m_device = nullptr;
+  ALCcontext *m_context = nullptr;
+  ALuint m_source = 0;
+  vector<ALuint> m_buffers;
+  AudioMixer *m_mixer = nullptr;
+  uint32_t m_blockFrames = 0;
+  vector<float> m_mixBlock;
+  vector<int16_t> m_outputBlock;
+  std::jthread m_thread;
+  std::atomic<uint64_t> m_underruns = 0;
+
+  auto fill(ALuint buffer) -> void;
+  auto output_loop(const std::stop_token &stop) -> void;
+
+public:
+  OpenALOutput() = default;
+  ~OpenALOutput();
+  OpenALOutput(const OpenALOutput &) = delete;
+  auto operator=(const OpenALOutput &) -> OpenALOutput & = delete;
+
+  /*!
+   * @brief Opens the device at the mixer's rate and starts streaming
+   * @param mixer the mixer to play, it must outlive the output
+   * @param deviceName the OpenAL device, nullptr for the default one
+   * @param blockFrames frames per OpenAL buffer, latency is about
+   * blockFrames * bufferCount
+   * @param bufferCount how many buffers are queued
+   * @return On success, returns void, on failure, returns unexpected with error
+   * message
+   */
+  auto init(AudioMixer &mixer, const char *deviceName, uint32_t blockFrames,
+            uint32_t bufferCount) -> expected<void, string>;
+  /*!
+   * @brief Stops the output thread and closes the device
+   */
+  auto shutdown() -> void;
+  /*!
+   * @brief How often OpenAL ran out of queued audio and had to be restarted
+   */
+  [[nodiscard]] auto underruns() const -> uint64_t {
+    return this->m_underruns.load(std::memory_order_relaxed);
+  }
+};
+} // namespace SFT::Audio
+
+#endif // OPENALOUTPUT_H
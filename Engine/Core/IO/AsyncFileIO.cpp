@@ -0,0 +1,533 @@
+//
+// Created by sturd on 10/18/2026.
+//
+
+#include "AsyncFileIO.h"
+
+#include "Core/Utility/Utility.h"
+#include "spdlog/spdlog.h"
+#include <algorithm>
+#include <cstring>
+
+#ifdef _WIN32
+#include <system_error>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+#ifdef __linux__
+#include <poll.h>
+#include <sys/eventfd.h>
+#endif
+
+namespace SFT::IO {
+#pragma region additional functions
+namespace {
+#ifdef __linux__
+constexpr uint64_t WakeTag = UINT64_MAX;
+constexpr uint64_t CancelTag = UINT64_MAX - 1;
+// an io_uring read takes a 32 bit length, bigger reads are issued in chunks
+constexpr uint64_t MaxReadChunk = 1ull << 30;
+#endif
+
+auto resolve_size(const std::filesystem::path &path, const uint64_t fileSize,
+                  const uint64_t offset, const uint64_t size)
+    -> expected<uint64_t, string> {
+  if (offset > fileSize || size > fileSize - offset) {
+    return unexpected("read past the end of " + path.string());
+  }
+  return size != 0 ? size : fileSize - offset;
+}
+
+// the thread pool backend's read, positioned so any number of readers can
+// share a file without seeking
+auto read_range(const std::filesystem::path &path, const uint64_t offset,
+                const uint64_t size) -> expected<vector<std::byte>, string> {
+#ifdef _WIN32
+  std::error_code error;
+  const auto fileSize = std::filesystem::file_size(path, error);
+  if (error) {
+    return unexpected("failed to open " + path.string() + ": " +
+                      error.message());
+  }
+  auto length = resolve_size(path, fileSize, offset, size);
+  if (!length.has_value()) {
+    return unexpected(length.error());
+  }
+  vector<std::byte> data(length.value());
+  if (auto result = Utility::read_file_range(path, offset, data);
+      !result.has_value()) {
+    return unexpected(result.error());
+  }
+  return data;
+#else
+  const int file = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (file < 0) {
+    return unexpected("failed to open " + path.string() + ": " +
+                      strerror(errno));
+  }
+  struct stat status{};
+  if (fstat(file, &status) != 0) {
+    close(file);
+    return unexpected("failed to stat " + path.string());
+  }
+  auto length =
+      resolve_size(path, static_cast<uint64_t>(status.st_size), offset, size);
+  if (!length.has_value()) {
+    close(file);
+    return unexpected(length.error());
+  }
+  vector<std::byte> data(length.value());
+  for (uint64_t done = 0; done < data.size();) {
+    const ssize_t result = pread(file, data.data() + done, data.size() - done,
+                                 static_cast<off_t>(offset + done));
+    if (result < 0 && errno == EINTR) {
+      continue;
+    }
+    if (result <= 0) {
+      close(file);
+      return unexpected("failed to read " + path.string() + ": " +
+                        (result == 0 ? "unexpected end of file"
+                                     : strerror(errno)));
+    }
+    done += static_cast<uint64_t>(result);
+  }
+  close(file);
+  return data;
+#endif
+}
+} // namespace
+#pragma endregion
+
+#pragma region AsyncFileIO Functions
+AsyncFileIO::~AsyncFileIO() { this->shutdown(); }
+
+auto AsyncFileIO::init(const uint32_t queueDepth,
+                       const uint32_t fallbackThreads,
+                       Threading::ThreadPool *completionPool)
+    -> expected<void, string> {
+  if (this->m_running) {
+    return unexpected("the file I/O service is already running");
+  }
+  this->m_completionPool = completionPool;
+  this->m_stopping = false;
+#ifdef __linux__
+  auto ring = this->init_ring(queueDepth);
+  if (ring.has_value()) {
+    this->m_backend = IOBackend::IoUring;
+    this->m_running = true;
+    spdlog::debug("File I/O uses io_uring with a queue depth of {}",
+                  this->m_queueDepth);
+    return {};
+  }
+  spdlog::warn("io_uring is unavailable, reading files on a thread pool: {}",
+               ring.error());
+#endif
+  this->m_backend = IOBackend::ThreadPool;
+  this->m_readers =
+      std::make_unique<Threading::ThreadPool>(std::max(1u, fallbackThreads));
+  this->m_running = true;
+  return {};
+}
+
+auto AsyncFileIO::shutdown() -> void {
+  vector<Pending> dropped;
+  {
+    std::lock_guard lock(this->m_mutex);
+    if (!this->m_running || this->m_stopping) {
+      return;
+    }
+    this->m_stopping = true;
+    for (auto &queue : this->m_pending) {
+      std::ranges::move(queue, std::back_inserter(dropped));
+      queue.clear();
+    }
+    this->m_stats.cancelled += dropped.size();
+    for (const uint64_t id : this->m_inFlight) {
+      this->m_cancelled.insert(id);
+#ifdef __linux__
+      if (this->m_backend == IOBackend::IoUring) {
+        this->m_ringCancels.push_back(id);
+      }
+#endif
+    }
+  }
+  for (auto &pending : dropped) {
+    this->deliver(pending.request.onComplete,
+                  {{pending.id}, unexpected("cancelled"), true});
+  }
+#ifdef __linux__
+  if (this->m_backend == IOBackend::IoUring) {
+    this->wake_ring();
+    this->m_ringThread = {};
+    this->m_ring.destroy();
+    close(this->m_wakeFd);
+    this->m_wakeFd = -1;
+  }
+#endif
+  // finishes the reads in flight, which complete as cancelled
+  this->m_readers.reset();
+  if (this->m_completionPool != nullptr) {
+    this->m_completionPool->wait_idle();
+  }
+  std::lock_guard lock(this->m_mutex);
+  this->m_cancelled.clear();
+  this->m_running = false;
+  this->m_stopping = false;
+}
+
+auto AsyncFileIO::submit(IORequest request) -> IORequestHandle {
+  return this->enqueue(std::span(&request, 1)).front();
+}
+
+auto AsyncFileIO::submit_batch(const std::span<IORequest> requests)
+    -> vector<IORequestHandle> {
+  return this->enqueue(requests);
+}
+
+auto AsyncFileIO::enqueue(const std::span<IORequest> requests)
+    -> vector<IORequestHandle> {
+  vector<IORequestHandle> handles;
+  handles.reserve(requests.size());
+  vector<Pending> rejected;
+  {
+    std::lock_guard lock(this->m_mutex);
+    for (auto &request : requests) {
+      Pending pending{this->m_nextId++, std::move(request)};
+      handles.push_back({pending.id});
+      if (!this->m_running || this->m_stopping) {
+        rejected.push_back(std::move(pending));
+        continue;
+      }
+      this->m_stats.submitted++;
+      const auto priority = static_cast<size_t>(pending.request.priority);
+      this->m_pending[std::min(priority, IOPriorityCount - 1)].push_back(
+          std::move(pending));
+    }
+  }
+  for (auto &pending : rejected) {
+    this->deliver(pending.request.onComplete,
+                  {{pending.id},
+                   unexpected("the file I/O service isn't running"),
+                   false});
+  }
+  const size_t accepted = requests.size() - rejected.size();
+  if (accepted == 0) {
+    return handles;
+  }
+#ifdef __linux__
+  if (this->m_backend == IOBackend::IoUring) {
+    this->wake_ring();
+    return handles;
+  }
+#endif
+  // one job per request, each job takes whatever is most urgent when it runs
+  // rather than the request it was queued for
+  for (size_t i = 0; i < accepted; i++) {
+    this->m_readers->submit([this] { this->read_blocking(); });
+  }
+  return handles;
+}
+
+auto AsyncFileIO::cancel(const IORequestHandle handle) -> bool {
+  std::optional<Pending> dropped;
+  {
+    std::lock_guard lock(this->m_mutex);
+    for (auto &queue : this->m_pending) {
+      const auto it = std::ranges::find(queue, handle.id, &Pending::id);
+      if (it != queue.end()) {
+        dropped = std::move(*it);
+        queue.erase(it);
+        this->m_stats.cancelled++;
+        break;
+      }
+    }
+    if (!dropped.has_value()) {
+      if (!this->m_inFlight.contains(handle.id)) {
+        return false;
+      }
+      if (!this->m_cancelled.insert(handle.id).second) {
+        return true;
+      }
+#ifdef __linux__
+      if (this->m_backend == IOBackend::IoUring) {
+        this->m_ringCancels.push_back(handle.id);
+      }
+#endif
+    }
+  }
+  if (dropped.has_value()) {
+    this->deliver(dropped->request.onComplete,
+                  {handle, unexpected("cancelled"), true});
+    return true;
+  }
+#ifdef __linux__
+  if (this->m_backend == IOBackend::IoUring) {
+    this->wake_ring();
+  }
+#endif
+  return true;
+}
+
+auto AsyncFileIO::stats() -> AsyncFileIOStats {
+  std::lock_guard lock(this->m_mutex);
+  AsyncFileIOStats stats = this->m_stats;
+  for (const auto &queue : this->m_pending) {
+    stats.pending += static_cast<uint32_t>(queue.size());
+  }
+  stats.inFlight = static_cast<uint32_t>(this->m_inFlight.size());
+  return stats;
+}
+
+// m_mutex must be held
+auto AsyncFileIO::pop_pending(Pending &out) -> bool {
+  for (auto &queue : this->m_pending) {
+    if (!queue.empty()) {
+      out = std::move(queue.front());
+      queue.pop_front();
+      this->m_inFlight.insert(out.id);
+      return true;
+    }
+  }
+  return false;
+}
+
+auto AsyncFileIO::read_blocking() -> void {
+  Pending pending;
+  {
+    std::lock_guard lock(this->m_mutex);
+    if (!this->pop_pending(pending)) {
+      // its request was cancelled before a reader got to it
+      return;
+    }
+  }
+  auto data = read_range(pending.request.path, pending.request.offset,
+                         pending.request.size);
+  this->finish(pending.id, pending.request.onComplete, std::move(data));
+}
+
+auto AsyncFileIO::finish(const uint64_t id, IOCallback &callback,
+                         expected<vector<std::byte>, string> data) -> void {
+  bool cancelled;
+  {
+    std::lock_guard lock(this->m_mutex);
+    this->m_inFlight.erase(id);
+    cancelled = this->m_cancelled.erase(id) > 0;
+    if (cancelled) {
+      this->m_stats.cancelled++;
+    } else if (data.has_value()) {
+      this->m_stats.completed++;
+      this->m_stats.bytesRead += data->size();
+    } else {
+      this->m_stats.failed++;
+    }
+  }
+  if (cancelled) {
+    this->deliver(callback, {{id}, unexpected("cancelled"), true});
+  } else {
+    this->deliver(callback, {{id}, std::move(data), false});
+  }
+}
+
+auto AsyncFileIO::deliver(IOCallback &callback, IOCompletion completion)
+    -> void {
+  if (!callback) {
+    return;
+  }
+  if (this->m_completionPool == nullptr) {
+    callback(std::move(completion));
+    return;
+  }
+  this->m_completionPool->submit(
+      [callback = std::move(callback),
+       completion = std::move(completion)]() mutable {
+        callback(std::move(completion));
+      });
+}
+
+#ifdef __linux__
+auto AsyncFileIO::init_ring(const uint32_t queueDepth)
+    -> expected<void, string> {
+  this->m_queueDepth = std::max(1u, queueDepth);
+  // room for a read and a cancel per request in flight, plus the wake up poll
+  if (auto result = this->m_ring.init(this->m_queueDepth * 2 + 1);
+      !result.has_value()) {
+    return unexpected(result.error());
+  }
+  this->m_wakeFd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+  if (this->m_wakeFd < 0) {
+    this->m_ring.destroy();
+    return unexpected(string("failed to create an eventfd: ") +
+                      strerror(errno));
+  }
+  this->m_ringThread = std::jthread([this] { this->ring_loop(); });
+  return {};
+}
+
+auto AsyncFileIO::wake_ring() -> void {
+  const uint64_t one = 1;
+  [[maybe_unused]] const auto written = write(this->m_wakeFd, &one, sizeof(one));
+}
+
+auto AsyncFileIO::queue_ring_read(const uint64_t id, RingRead &read) -> bool {
+  io_uring_sqe *sqe = this->m_ring.get_sqe();
+  if (sqe == nullptr) {
+    return false;
+  }
+  sqe->opcode = IORING_OP_READ;
+  sqe->fd = read.fd;
+  sqe->addr = reinterpret_cast<uint64_t>(read.buffer.data() + read.done);
+  sqe->len = static_cast<uint32_t>(
+      std::min<uint64_t>(read.buffer.size() - read.done, MaxReadChunk));
+  sqe->off = read.request.offset + read.done;
+  sqe->user_data = id;
+  return true;
+}
+
+auto AsyncFileIO::ring_loop() -> void {
+  bool wakeArmed = false;
+  while (true) {
+    vector<Pending> batch;
+    vector<uint64_t> cancels;
+    bool stopping;
+    {
+      std::lock_guard lock(this->m_mutex);
+      stopping = this->m_stopping;
+      cancels.swap(this->m_ringCancels);
+      Pending pending;
+      while (this->m_ringReads.size() + batch.size() < this->m_queueDepth &&
+             this->pop_pending(pending)) {
+        batch.push_back(std::move(pending));
+      }
+    }
+    if (stopping && batch.empty() && this->m_ringReads.empty()) {
+      return;
+    }
+
+    for (const uint64_t id : cancels) {
+      if (!this->m_ringReads.contains(id)) {
+        continue;
+      }
+      // best effort, a read the kernel can't stop still completes and is
+      // reported as cancelled
+      if (io_uring_sqe *sqe = this->m_ring.get_sqe(); sqe != nullptr) {
+        sqe->opcode = IORING_OP_ASYNC_CANCEL;
+        sqe->fd = -1;
+        sqe->addr = id;
+        sqe->user_data = CancelTag;
+      }
+    }
+    // opening is left synchronous, it's cheap next to the reads and keeps the
+    // minimum kernel at 5.6 for IORING_OP_READ
+    for (auto &pending : batch) {
+      const auto &path = pending.request.path;
+      const int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+      if (fd < 0) {
+        this->finish(pending.id, pending.request.onComplete,
+                     unexpected("failed to open " + path.string() + ": " +
+                                strerror(errno)));
+        continue;
+      }
+      struct stat status{};
+      if (fstat(fd, &status) != 0) {
+        const string reason = strerror(errno);
+        close(fd);
+        this->finish(pending.id, pending.request.onComplete,
+                     unexpected("failed to stat " + path.string() + ": " +
+                                reason));
+        continue;
+      }
+      auto length = resolve_size(path, static_cast<uint64_t>(status.st_size),
+                                 pending.request.offset, pending.request.size);
+      if (!length.has_value() || length.value() == 0) {
+        close(fd);
+        this->finish(pending.id, pending.request.onComplete,
+                     length.has_value()
+                         ? expected<vector<std::byte>, string>(vector<std::byte>{})
+                         : unexpected(length.error()));
+        continue;
+      }
+      auto &read =
+          this->m_ringReads
+              .emplace(pending.id,
+                       RingRead{std::move(pending.request), fd,
+                                vector<std::byte>(length.value()), 0})
+              .first->second;
+      this->queue_ring_read(pending.id, read);
+    }
+    if (!wakeArmed) {
+      if (io_uring_sqe *sqe = this->m_ring.get_sqe(); sqe != nullptr) {
+        sqe->opcode = IORING_OP_POLL_ADD;
+        sqe->fd = this->m_wakeFd;
+        sqe->poll_events = POLLIN;
+        sqe->user_data = WakeTag;
+        wakeArmed = true;
+      }
+    }
+
+    if (auto result = this->m_ring.submit(1); !result.has_value()) {
+      spdlog::error("File I/O failed: {}", result.error());
+      // reads the kernel already took still own their buffers, only the ones
+      // it never saw are failed, they are taken back so it can't start them
+      this->m_ring.discard_unsubmitted([&](const io_uring_sqe &sqe) {
+        if (sqe.user_data == WakeTag) {
+          wakeArmed = false;
+          return;
+        }
+        const auto it = this->m_ringReads.find(sqe.user_data);
+        if (sqe.opcode != IORING_OP_READ || it == this->m_ringReads.end()) {
+          return;
+        }
+        close(it->second.fd);
+        const uint64_t id = it->first;
+        IOCallback callback = std::move(it->second.request.onComplete);
+        this->m_ringReads.erase(it);
+        this->finish(id, callback, unexpected(result.error()));
+      });
+      continue;
+    }
+    this->m_ring.for_each_completion([&](const io_uring_cqe &cqe) {
+      if (cqe.user_data == WakeTag) {
+        uint64_t value;
+        [[maybe_unused]] const auto consumed =
+            ::read(this->m_wakeFd, &value, sizeof(value));
+        wakeArmed = false;
+        return;
+      }
+      if (cqe.user_data == CancelTag) {
+        return;
+      }
+      const auto it = this->m_ringReads.find(cqe.user_data);
+      if (it == this->m_ringReads.end()) {
+        return;
+      }
+      auto &read = it->second;
+      if (cqe.res > 0) {
+        read.done += static_cast<uint64_t>(cqe.res);
+        // short reads carry on from where they stopped
+        if (read.done < read.buffer.size() &&
+            this->queue_ring_read(it->first, read)) {
+          return;
+        }
+      }
+      expected<vector<std::byte>, string> data = std::move(read.buffer);
+      if (cqe.res < 0) {
+        data = unexpected("failed to read " + read.request.path.string() +
+                          ": " + strerror(-cqe.res));
+      } else if (read.done < data->size()) {
+        data = unexpected("failed to read " + read.request.path.string() +
+                          ": unexpected end of file");
+      }
+      close(read.fd);
+      const uint64_t id = it->first;
+      IOCallback callback = std::move(read.request.onComplete);
+      this->m_ringReads.erase(it);
+      this->finish(id, callback, std::move(data));
+    });
+  }
+}
+#endif
+#pragma endregion
+} // namespace SFT::IO
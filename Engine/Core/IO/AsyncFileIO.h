@@ -0,0 +1,196 @@
+//
+// Created by sturd on 10/18/2026.
+//
+
+#ifndef ASYNCFILEIO_H
+#define ASYNCFILEIO_H
+
+#include "Core/Threading/ThreadPool.h"
+#include "IoUring.h"
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <expected>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+using std::expected;
+using std::string;
+using std::unexpected;
+using std::vector;
+
+namespace SFT::IO {
+enum class IOPriority : uint8_t {
+  // needed to finish the current frame, such as a missing mip tail
+  Critical,
+  High,
+  Normal,
+  // prefetching that nothing waits on yet
+  Low,
+};
+constexpr size_t IOPriorityCount = 4;
+
+enum class IOBackend : uint8_t {
+  IoUring,
+  ThreadPool,
+};
+
+struct IORequestHandle {
+  uint64_t id = 0;
+
+  [[nodiscard]] auto valid() const -> bool { return id != 0; }
+};
+
+struct IOCompletion {
+  IORequestHandle handle;
+  // the bytes read, or why they couldn't be
+  expected<vector<std::byte>, string> data;
+  bool cancelled = false;
+};
+
+using IOCallback = std::function<void(IOCompletion)>;
+
+struct IORequest {
+  std::filesystem::path path;
+  uint64_t offset = 0;
+  // 0 reads from offset to the end of the file
+  uint64_t size = 0;
+  IOPriority priority = IOPriority::Normal;
+  // called exactly once, also for failed and cancelled requests
+  IOCallback onComplete;
+};
+
+struct AsyncFileIOStats {
+  uint64_t submitted = 0;
+  uint64_t completed = 0;
+  uint64_t failed = 0;
+  uint64_t cancelled = 0;
+  uint64_t bytesRead = 0;
+  uint32_t pending = 0;
+  uint32_t inFlight = 0;
+};
+
+/*!
+ * @brief Reads files without blocking the caller, requests wait in one queue
+ * per priority and the most urgent ones are issued first. On Linux reads go
+ * through io_uring from a single I/O thread, many at once and submitted in
+ * batches with one syscall, elsewhere (or when io_uring is unavailable) a few
+ * threads issue blocking positioned reads. Completions are handed to a
+ * completion pool when one is given, so decoding or staging for upload starts
+ * without a hop through the game thread
+ */
+class AsyncFileIO {
+private:
+  struct Pending {
+    uint64_t id = 0;
+    IORequest request;
+  };
+#ifdef __linux__
+  struct RingRead {
+    IORequest request;
+    int fd = -1;
+    vector<std::byte> buffer;
+    uint64_t done = 0;
+  };
+#endif
+
+  IOBackend m_backend = IOBackend::ThreadPool;
+  Threading::ThreadPool *m_completionPool = nullptr;
+  std::atomic<uint64_t> m_nextId = 1;
+  bool m_running = false;
+
+  std::mutex m_mutex;
+  std::array<std::deque<Pending>, IOPriorityCount> m_pending;
+  // issued but not completed, cancelling one of these can only mark it
+  std::unordered_set<uint64_t> m_inFlight;
+  std::unordered_set<uint64_t> m_cancelled;
+  bool m_stopping = false;
+  AsyncFileIOStats m_stats;
+
+  std::unique_ptr<Threading::ThreadPool> m_readers;
+
+#ifdef __linux__
+  IoUring m_ring;
+  uint32_t m_queueDepth = 0;
+  int m_wakeFd = -1;
+  std::jthread m_ringThread;
+  // cancellations the ring thread still has to pass to the kernel
+  vector<uint64_t> m_ringCancels;
+  // only touched by the ring thread
+  std::unordered_map<uint64_t, RingRead> m_ringReads;
+
+  auto init_ring(uint32_t queueDepth) -> expected<void, string>;
+  auto ring_loop() -> void;
+  auto queue_ring_read(uint64_t id, RingRead &read) -> bool;
+  auto wake_ring() -> void;
+#endif
+
+  auto enqueue(std::span<IORequest> requests) -> vector<IORequestHandle>;
+  auto pop_pending(Pending &out) -> bool;
+  auto read_blocking() -> void;
+  auto finish(uint64_t id, IOCallback &callback,
+              expected<vector<std::byte>, string> data) -> void;
+  auto deliver(IOCallback &callback, IOCompletion completion) -> void;
+
+public:
+  AsyncFileIO() = default;
+  ~AsyncFileIO();
+  AsyncFileIO(const AsyncFileIO &) = delete;
+  auto operator=(const AsyncFileIO &) -> AsyncFileIO & = delete;
+
+  /*!
+   * @brief Starts the I/O thread, io_uring is tried first on Linux and the
+   * thread pool backend is used when it can't be set up
+   * @param queueDepth how many reads may be in flight at once
+   * @param fallbackThreads how many threads the thread pool backend reads with
+   * @param completionPool where completion callbacks run, nullptr runs them on
+   * the I/O threads, which must then only do light work in them
+   * @return On success, returns void, on failure, returns unexpected with error
+   * message
+   */
+  auto init(uint32_t queueDepth, uint32_t fallbackThreads,
+            Threading::ThreadPool *completionPool) -> expected<void, string>;
+  /*!
+   * @brief Cancels everything not yet completed and joins the I/O threads,
+   * every callback has run when this returns
+   */
+  auto shutdown() -> void;
+  /*!
+   * @brief Queues a read
+   * @param request what to read and who to tell
+   * @return the handle to cancel the read with
+   */
+  auto submit(IORequest request) -> IORequestHandle;
+  /*!
+   * @brief Queues many reads under one lock and one wake up of the I/O thread,
+   * which issues as many of them as the queue depth allows in one syscall
+   * @param requests the reads, moved from
+   * @return the handles in the same order as the requests
+   */
+  auto submit_batch(std::span<IORequest> requests) -> vector<IORequestHandle>;
+  /*!
+   * @brief Cancels a read, reads that weren't issued yet are dropped and reads
+   * in flight are cancelled in the kernel where possible, the callback gets a
+   * cancelled completion either way
+   * @param handle the read to cancel
+   * @return true if the read was still pending or in flight, false if it
+   * already completed
+   */
+  auto cancel(IORequestHandle handle) -> bool;
+  [[nodiscard]] auto backend() const -> IOBackend { return this->m_backend; }
+  [[nodiscard]] auto stats() -> AsyncFileIOStats;
+};
+} // namespace SFT::IO
+
+#endif // ASYNCFILEIO_H
@@ -0,0 +1,177 @@
+//
+// Created by sturd on 10/18/2026.
+//
+
+#include "IoUring.h"
+
+#ifdef __linux__
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace SFT::IO {
+#pragma region additional functions
+namespace {
+template <typename T> auto offset_ptr(void *base, const uint32_t offset) -> T * {
+  return reinterpret_cast<T *>(static_cast<std::byte *>(base) + offset);
+}
+
+// the ring indices are shared with the kernel, which reads and writes them
+// concurrently, so every access that crosses that boundary is ordered
+auto load_acquire(uint32_t *value) -> uint32_t {
+  return std::atomic_ref(*value).load(std::memory_order_acquire);
+}
+
+auto store_release(uint32_t *value, const uint32_t newValue) -> void {
+  std::atomic_ref(*value).store(newValue, std::memory_order_release);
+}
+} // namespace
+#pragma endregion
+
+#pragma region IoUring Functions
+IoUring::~IoUring() { this->destroy(); }
+
+auto IoUring::init(const uint32_t entries) -> expected<void, string> {
+  io_uring_params params{};
+  const long fd = syscall(__NR_io_uring_setup, entries, &params);
+  if (fd < 0) {
+    return unexpected(string("io_uring_setup failed: ") + strerror(errno));
+  }
+  this->m_fd = static_cast<int>(fd);
+
+  this->m_sqRingSize = params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+  this->m_cqRingSize =
+      params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+  const bool singleMmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+  if (singleMmap) {
+    this->m_sqRingSize = this->m_cqRingSize =
+        std::max(this->m_sqRingSize, this->m_cqRingSize);
+  }
+  this->m_sqRing =
+      mmap(nullptr, this->m_sqRingSize, PROT_READ | PROT_WRITE,
+           MAP_SHARED | MAP_POPULATE, this->m_fd, IORING_OFF_SQ_RING);
+  if (this->m_sqRing == MAP_FAILED) {
+    this->m_sqRing = nullptr;
+    this->destroy();
+    return unexpected("failed to map the io_uring submission queue");
+  }
+  if (singleMmap) {
+    this->m_cqRing = this->m_sqRing;
+  } else {
+    this->m_cqRing =
+        mmap(nullptr, this->m_cqRingSize, PROT_READ | PROT_WRITE,
+             MAP_SHARED | MAP_POPULATE, this->m_fd, IORING_OFF_CQ_RING);
+    if (this->m_cqRing == MAP_FAILED) {
+      this->m_cqRing = nullptr;
+      this->destroy();
+      return unexpected("failed to map the io_uring completion queue");
+    }
+  }
+  this->m_sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+  void *sqes = mmap(nullptr, this->m_sqesSize, PROT_READ | PROT_WRITE,
+                    MAP_SHARED | MAP_POPULATE, this->m_fd, IORING_OFF_SQES);
+  if (sqes == MAP_FAILED) {
+    this->destroy();
+    return unexpected("failed to map the io_uring SQE array");
+  }
+  this->m_sqes = static_cast<io_uring_sqe *>(sqes);
+
+  this->m_sqHead = offset_ptr<uint32_t>(this->m_sqRing, params.sq_off.head);
+  this->m_sqTail = offset_ptr<uint32_t>(this->m_sqRing, params.sq_off.tail);
+  this->m_sqArray = offset_ptr<uint32_t>(this->m_sqRing, params.sq_off.array);
+  this->m_sqMask = *offset_ptr<uint32_t>(this->m_sqRing, params.sq_off.ring_mask);
+  this->m_sqEntries = params.sq_entries;
+  this->m_cqHead = offset_ptr<uint32_t>(this->m_cqRing, params.cq_off.head);
+  this->m_cqTail = offset_ptr<uint32_t>(this->m_cqRing, params.cq_off.tail);
+  this->m_cqes = offset_ptr<io_uring_cqe>(this->m_cqRing, params.cq_off.cqes);
+  this->m_cqMask = *offset_ptr<uint32_t>(this->m_cqRing, params.cq_off.ring_mask);
+  this->m_localTail = *this->m_sqTail;
+  this->m_unsubmitted = 0;
+  return {};
+}
+
+auto IoUring::destroy() -> void {
+  if (this->m_sqes != nullptr) {
+    munmap(this->m_sqes, this->m_sqesSize);
+  }
+  if (this->m_cqRing != nullptr && this->m_cqRing != this->m_sqRing) {
+    munmap(this->m_cqRing, this->m_cqRingSize);
+  }
+  if (this->m_sqRing != nullptr) {
+    munmap(this->m_sqRing, this->m_sqRingSize);
+  }
+  if (this->m_fd >= 0) {
+    close(this->m_fd);
+  }
+  this->m_fd = -1;
+  this->m_sqes = nullptr;
+  this->m_sqRing = nullptr;
+  this->m_cqRing = nullptr;
+}
+
+auto IoUring::get_sqe() -> io_uring_sqe * {
+  if (this->m_localTail - load_acquire(this->m_sqHead) >= this->m_sqEntries) {
+    return nullptr;
+  }
+  const uint32_t index = this->m_localTail & this->m_sqMask;
+  io_uring_sqe *sqe = &this->m_sqes[index];
+  std::memset(sqe, 0, sizeof(*sqe));
+  this->m_sqArray[index] = index;
+  this->m_localTail++;
+  this->m_unsubmitted++;
+  return sqe;
+}
+
+auto IoUring::submit(const uint32_t waitFor) -> expected<void, string> {
+  store_release(this->m_sqTail, this->m_localTail);
+  const unsigned flags = waitFor > 0 ? IORING_ENTER_GETEVENTS : 0;
+  while (true) {
+    const long submitted =
+        syscall(__NR_io_uring_enter, this->m_fd, this->m_unsubmitted, waitFor,
+                flags, nullptr, 0);
+    if (submitted >= 0) {
+      this->m_unsubmitted -= static_cast<uint32_t>(submitted);
+      return {};
+    }
+    if (errno == EINTR) {
+      continue;
+    }
+    // the completion queue is backed up, reaping will make room
+    if (errno == EAGAIN || errno == EBUSY) {
+      return {};
+    }
+    return unexpected(string("io_uring_enter failed: ") + strerror(errno));
+  }
+}
+
+auto IoUring::discard_unsubmitted(
+    const std::function<void(const io_uring_sqe &)> &handler) -> uint32_t {
+  const uint32_t head = load_acquire(this->m_sqHead);
+  for (uint32_t i = head; i != this->m_localTail; i++) {
+    handler(this->m_sqes[this->m_sqArray[i & this->m_sqMask]]);
+  }
+  const uint32_t discarded = this->m_localTail - head;
+  this->m_localTail = head;
+  store_release(this->m_sqTail, head);
+  this->m_unsubmitted = 0;
+  return discarded;
+}
+
+auto IoUring::for_each_completion(
+    const std::function<void(const io_uring_cqe &)> &handler) -> uint32_t {
+  uint32_t head = *this->m_cqHead;
+  const uint32_t tail = load_acquire(this->m_cqTail);
+  uint32_t reaped = 0;
+  for (; head != tail; head++, reaped++) {
+    handler(this->m_cqes[head & this->m_cqMask]);
+  }
+  store_release(this->m_cqHead, head);
+  return reaped;
+}
+#pragma endregion
+} // namespace SFT::IO
+#endif // __linux__
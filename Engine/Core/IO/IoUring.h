@@ -0,0 +1,98 @@
+//
+// Created by sturd on 10/18/2026.
+//
+
+#ifndef IOURING_H
+#define IOURING_H
+
+#ifdef __linux__
+#include <linux/io_uring.h>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <functional>
+#include <string>
+
+using std::expected;
+using std::string;
+using std::unexpected;
+
+namespace SFT::IO {
+/*!
+ * @brief A minimal io_uring built on the raw syscalls so no liburing is needed,
+ * only the thread that owns it may touch it, SQEs are queued with get_sqe and
+ * handed to the kernel by submit
+ */
+class IoUring {
+private:
+  int m_fd = -1;
+  void *m_sqRing = nullptr;
+  size_t m_sqRingSize = 0;
+  void *m_cqRing = nullptr;
+  size_t m_cqRingSize = 0;
+  io_uring_sqe *m_sqes = nullptr;
+  size_t m_sqesSize = 0;
+
+  uint32_t *m_sqHead = nullptr;
+  uint32_t *m_sqTail = nullptr;
+  uint32_t *m_sqArray = nullptr;
+  uint32_t m_sqMask = 0;
+  uint32_t m_sqEntries = 0;
+  uint32_t *m_cqHead = nullptr;
+  uint32_t *m_cqTail = nullptr;
+  io_uring_cqe *m_cqes = nullptr;
+  uint32_t m_cqMask = 0;
+
+  // SQEs queued since the last submit, the kernel's tail is only moved then
+  uint32_t m_localTail = 0;
+  uint32_t m_unsubmitted = 0;
+
+public:
+  IoUring() = default;
+  ~IoUring();
+  IoUring(const IoUring &) = delete;
+  auto operator=(const IoUring &) -> IoUring & = delete;
+
+  /*!
+   * @brief Creates the ring and maps its queues
+   * @param entries the submission queue size, rounded up to a power of two by
+   * the kernel
+   * @return On success, returns void, on failure, returns unexpected with error
+   * message, which happens on kernels without io_uring or where it is
+   * disabled (seccomp, io_uring_disabled)
+   */
+  auto init(uint32_t entries) -> expected<void, string>;
+  auto destroy() -> void;
+  /*!
+   * @brief Gets a zeroed SQE to fill, it goes to the kernel on the next submit
+   * @return the SQE, or nullptr when the submission queue is full
+   */
+  auto get_sqe() -> io_uring_sqe *;
+  /*!
+   * @brief Submits every queued SQE in one syscall and optionally waits
+   * @param waitFor how many completions to wait for, 0 to return right away
+   * @return On success, returns void, on failure, returns unexpected with error
+   * message
+   */
+  auto submit(uint32_t waitFor) -> expected<void, string>;
+  /*!
+   * @brief Takes back every queued SQE the kernel hasn't consumed yet, meant
+   * for after a failed submit, the kernel only reads the submission queue
+   * inside io_uring_enter so nothing taken back can still be started
+   * @param handler called once per SQE taken back, before it is reused
+   * @return the number of SQEs taken back
+   */
+  auto discard_unsubmitted(
+      const std::function<void(const io_uring_sqe &)> &handler) -> uint32_t;
+  /*!
+   * @brief Reaps every completion that is ready
+   * @param handler called once per completion
+   * @return the number of completions reaped
+   */
+  auto for_each_completion(const std::function<void(const io_uring_cqe &)> &handler)
+      -> uint32_t;
+};
+} // namespace SFT::IO
+#endif // __linux__
+
+#endif // IOURING_H
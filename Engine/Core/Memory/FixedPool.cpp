@@ -0,0 +1,137 @@
+//
+// Created by sturd on 10/18/2026.
+//
+
+#include "FixedPool.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <mutex>
+#include <new>
+#include <utility>
+
+namespace SFT::Memory {
+#pragma region additional functions
+namespace {
+constexpr size_t chunkAlignment = 64;
+constexpr std::array<size_t, 6> sizeClasses = {16, 32, 64, 128, 256, 512};
+static_assert(sizeClasses.back() == MaxPooledSize);
+// each size class grabs about 64KiB at a time
+constexpr size_t pooledChunkBytes = 64 * 1024;
+
+auto size_class(const size_t bytes) -> size_t {
+  return static_cast<size_t>(std::countr_zero(
+             std::bit_ceil(std::max(bytes, sizeClasses.front())))) -
+         std::countr_zero(sizeClasses.front());
+}
+
+/*!
+ * @brief Chunks of pools whose threads exited, blocks from them can still be
+ * live on other threads, so they're only freed when the process exits
+ */
+struct OrphanedChunks {
+  std::mutex mutex;
+  vector<std::pair<std::byte *, size_t>> chunks;
+
+  ~OrphanedChunks() {
+    for (const auto &[chunk, size] : this->chunks) {
+      ::operator delete(chunk, size, std::align_val_t{chunkAlignment});
+    }
+  }
+};
+
+auto orphaned_chunks() -> OrphanedChunks & {
+  static OrphanedChunks orphans;
+  return orphans;
+}
+
+struct ThreadPools {
+  vector<FixedPool> pools;
+
+  ThreadPools() {
+    // the orphan list must outlive every thread's pools
+    orphaned_chunks();
+    pools.reserve(sizeClasses.size());
+    // the blocks are charged by whoever takes them, to their own tag,
+    // charging the chunks as well would count every pooled byte twice
+    for (const size_t size : sizeClasses) {
+      pools.emplace_back(size, pooledChunkBytes / size, std::nullopt);
+    }
+  }
+  ~ThreadPools() {
+    auto &orphans = orphaned_chunks();
+    std::scoped_lock lock(orphans.mutex);
+    for (auto &pool : this->pools) {
+      for (std::byte *chunk : pool.release_chunks()) {
+        orphans.chunks.emplace_back(chunk, pool.chunk_bytes());
+      }
+    }
+  }
+};
+
+auto thread_pools() -> ThreadPools & {
+  thread_local ThreadPools pools;
+  return pools;
+}
+} // namespace
+#pragma endregion
+
+#pragma region FixedPool Functions
+FixedPool::FixedPool(const size_t blockSize, const size_t blocksPerChunk,
+                     const std::optional<MemoryTag> tag)
+    : m_blockSize(std::max(blockSize, sizeof(FreeBlock))),
+      m_blocksPerChunk(std::max<size_t>(blocksPerChunk, 1)), m_tag(tag) {}
+
+FixedPool::FixedPool(FixedPool &&other) noexcept
+    : m_free(std::exchange(other.m_free, nullptr)),
+      m_chunks(std::move(other.m_chunks)), m_blockSize(other.m_blockSize),
+      m_blocksPerChunk(other.m_blocksPerChunk), m_tag(other.m_tag) {
+  other.m_chunks.clear();
+}
+
+FixedPool::~FixedPool() {
+  for (std::byte *chunk : this->m_chunks) {
+    ::operator delete(chunk, this->chunk_bytes(),
+                      std::align_val_t{chunkAlignment});
+    if (this->m_tag.has_value()) {
+      record_free(this->m_tag.value(), this->chunk_bytes());
+    }
+  }
+}
+
+auto FixedPool::grow() -> void {
+  auto *chunk = static_cast<std::byte *>(
+      ::operator new(this->chunk_bytes(), std::align_val_t{chunkAlignment}));
+  if (this->m_tag.has_value()) {
+    record_allocation(this->m_tag.value(), this->chunk_bytes());
+  }
+  this->m_chunks.push_back(chunk);
+  // threaded back to front so blocks come out in address order
+  for (size_t i = this->m_blocksPerChunk; i-- > 0;) {
+    this->deallocate(chunk + i * this->m_blockSize);
+  }
+}
+
+auto FixedPool::release_chunks() -> vector<std::byte *> {
+  // the chunks stay charged to the tag, they're still allocated
+  this->m_free = nullptr;
+  return std::exchange(this->m_chunks, {});
+}
+
+auto pool_allocate(const size_t bytes) -> void * {
+  if (bytes > MaxPooledSize) {
+    return ::operator new(bytes);
+  }
+  return thread_pools().pools[size_class(bytes)].allocate();
+}
+
+auto pool_deallocate(void *block, const size_t bytes) -> void {
+  if (bytes > MaxPooledSize) {
+    ::operator delete(block, bytes);
+    return;
+  }
+  thread_pools().pools[size_class(bytes)].deallocate(block);
+}
+#pragma endregion
+} // namespace SFT::Memory
@@ -0,0 +1,99 @@
+//
+// Created by sturd on 10/18/2026.
+//
+
+#ifndef FIXEDPOOL_H
+#define FIXEDPOOL_H
+
+#include "MemoryStats.h"
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+using std::vector;
+
+namespace SFT::Memory {
+/*!
+ * @brief Hands out blocks of one size from an intrusive free list, chunks of
+ * blocks are allocated as it grows and only returned on destruction. Not
+ * thread safe, see pool_allocate for the per thread pools
+ */
+class FixedPool {
+private:
+  struct FreeBlock {
+    FreeBlock *next;
+  };
+  FreeBlock *m_free = nullptr;
+  vector<std::byte *> m_chunks;
+  size_t m_blockSize = 0;
+  size_t m_blocksPerChunk = 0;
+  std::optional<MemoryTag> m_tag = MemoryTag::General;
+
+  auto grow() -> void;
+
+public:
+  /*!
+   * @brief Creates the pool, the first chunk is allocated on first use
+   * @param blockSize the size of every block, at least a pointer, blocks are
+   * aligned to the largest power of two dividing it, up to 64 bytes
+   * @param blocksPerChunk how many blocks each chunk holds
+   * @param tag the subsystem the chunks are charged to, nullopt when whoever
+   * takes blocks from the pool charges them instead
+   */
+  FixedPool(size_t blockSize, size_t blocksPerChunk,
+            std::optional<MemoryTag> tag = MemoryTag::General);
+  ~FixedPool();
+  FixedPool(FixedPool &&other) noexcept;
+  FixedPool(const FixedPool &) = delete;
+  auto operator=(const FixedPool &) -> FixedPool & = delete;
+
+  auto allocate() -> void * {
+    if (this->m_free == nullptr) {
+      this->grow();
+    }
+    FreeBlock *block = this->m_free;
+    this->m_free = block->next;
+    return block;
+  }
+  /*!
+   * @brief Returns a block, it must have come from a pool with the same block
+   * size whose chunks are still alive
+   */
+  auto deallocate(void *block) -> void {
+    auto *freeBlock = static_cast<FreeBlock *>(block);
+    freeBlock->next = this->m_free;
+    this->m_free = freeBlock;
+  }
+  /*!
+   * @brief Hands the chunks to the caller, the pool is left empty, used when
+   * blocks may outlive the pool
+   */
+  auto release_chunks() -> vector<std::byte *>;
+  [[nodiscard]] auto block_size() const -> size_t { return this->m_blockSize; }
+  [[nodiscard]] auto chunk_bytes() const -> size_t {
+    return this->m_blockSize * this->m_blocksPerChunk;
+  }
+};
+
+// requests larger than this skip the per thread pools
+constexpr size_t MaxPooledSize = 512;
+
+/*!
+ * @brief Allocates from the calling thread's pool for the size class, sizes
+ * over MaxPooledSize fall back to operator new. The block may be freed on any
+ * thread, it then joins that thread's pool. Nothing is charged to a tag, the
+ * caller charges what it takes (PoolResource does) so no byte counts twice
+ * @param bytes the size
+ * @return the memory, aligned to its size class, at most 64 bytes
+ */
+auto pool_allocate(size_t bytes) -> void *;
+/*!
+ * @brief Frees memory from pool_allocate
+ * @param block the memory
+ * @param bytes the size it was allocated with
+ */
+auto pool_deallocate(void *block, size_t bytes) -> void;
+} // namespace SFT::Memory
+
+#endif // FIXEDPOOL_H
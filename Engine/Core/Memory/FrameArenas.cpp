@@ -0,0 +1,29 @@
+//
+// Created by sturd on 10/18/2026.
+//
+
+#include "FrameArenas.h"
+
+namespace SFT::Memory {
+#pragma region FrameArenas Functions
+auto FrameArenas::init(const uint32_t framesInFlight, const size_t blockSize,
+                       const MemoryTag tag) -> void {
+  this->m_arenas.clear();
+  this->m_arenas.reserve(framesInFlight);
+  for (uint32_t i = 0; i < framesInFlight; i++) {
+    this->m_arenas.emplace_back(blockSize, tag);
+  }
+  this->m_frameSlot = 0;
+}
+
+auto FrameArenas::destroy() -> void {
+  this->m_arenas.clear();
+  this->m_frameSlot = 0;
+}
+
+auto FrameArenas::begin_frame(const uint32_t frameSlot) -> void {
+  this->m_frameSlot = frameSlot;
+  this->m_arenas[frameSlot].reset();
+}
+#pragma endregion
+} // namespace SFT::Memory
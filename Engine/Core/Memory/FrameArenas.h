@@ -0,0 +1,53 @@
+//
+// Created by sturd on 10/18/2026.
+//
+
+#ifndef FRAMEARENAS_H
+#define FRAMEARENAS_H
+
+#include "LinearArena.h"
+#include <cstdint>
+#include <vector>
+
+using std::vector;
+
+namespace SFT::Memory {
+/*!
+ * @brief One linear arena per frame in flight, for CPU data that only has to
+ * live until the GPU is done with the frame that produced it, like draw lists
+ * and upload staging, so a frame's allocations cost a pointer bump each and
+ * are all freed together
+ */
+class FrameArenas {
+private:
+  vector<LinearArena> m_arenas;
+  uint32_t m_frameSlot = 0;
+
+public:
+  /*!
+   * @brief Creates the arenas
+   * @param framesInFlight how many frames can be recorded before the oldest is
+   * known to be finished
+   * @param blockSize the block size of each arena
+   * @param tag the subsystem the arenas are charged to
+   */
+  auto init(uint32_t framesInFlight, size_t blockSize, MemoryTag tag) -> void;
+  /*!
+   * @brief Frees the arenas' memory
+   */
+  auto destroy() -> void;
+  /*!
+   * @brief Resets the slot's arena and makes it current, call it once the
+   * fence of the previous frame that used the slot has signaled
+   * @param frameSlot the frame in flight being recorded
+   */
+  auto begin_frame(uint32_t frameSlot) -> void;
+  /*!
+   * @brief Gets the arena of the frame being recorded, it is also a
+   * std::pmr::memory_resource for frame local containers
+   */
+  auto current() -> LinearArena & { return this->m_arenas[this->m_frameSlot]; }
+};
+} // namespace SFT::Memory
+
+#endif // FRAMEARENAS_H
@@ -0,0 +1,148 @@
+//
+// Created by sturd on 10/18/2026.
+//
+
+#include "LinearArena.h"
+
+#include "Core/Threading/SpscQueue.h"
+#include <algorithm>
+
+namespace SFT::Memory {
+#pragma region additional functions
+namespace {
+constexpr size_t scratchBlockSize = 256 * 1024;
+} // namespace
+#pragma endregion
+
+#pragma region LinearArena Functions
+LinearArena::LinearArena(const size_t blockSize, const MemoryTag tag)
+    : m_blockSize(std::max<size_t>(blockSize, Threading::CacheLineSize)),
+      m_tag(tag) {}
+
+LinearArena::~LinearArena() { this->release(); }
+
+LinearArena::LinearArena(LinearArena &&other) noexcept
+    : m_blocks(std::move(other.m_blocks)), m_current(other.m_current),
+      m_offset(other.m_offset), m_usedBefore(other.m_usedBefore),
+      m_highWater(other.m_highWater), m_blockSize(other.m_blockSize),
+      m_tag(other.m_tag) {
+  other.m_blocks.clear();
+  other.m_current = 0;
+  other.m_offset = 0;
+  other.m_usedBefore = 0;
+}
+
+auto LinearArena::operator=(LinearArena &&other) noexcept -> LinearArena & {
+  if (this != &other) {
+    this->release();
+    this->m_blocks = std::move(other.m_blocks);
+    this->m_current = other.m_current;
+    this->m_offset = other.m_offset;
+    this->m_usedBefore = other.m_usedBefore;
+    this->m_highWater = other.m_highWater;
+    this->m_blockSize = other.m_blockSize;
+    this->m_tag = other.m_tag;
+    other.m_blocks.clear();
+    other.m_current = 0;
+    other.m_offset = 0;
+    other.m_usedBefore = 0;
+  }
+  return *this;
+}
+
+auto LinearArena::allocate_block(const size_t size) -> Block {
+  Block block{static_cast<std::byte *>(::operator new(
+                  size, std::align_val_t{Threading::CacheLineSize})),
+              size};
+  record_allocation(this->m_tag, size);
+  return block;
+}
+
+auto LinearArena::free_block(const Block &block) -> void {
+  ::operator delete(block.data, block.size,
+                    std::align_val_t{Threading::CacheLineSize});
+  record_free(this->m_tag, block.size);
+}
+
+auto LinearArena::release() -> void {
+  for (const auto &block : this->m_blocks) {
+    this->free_block(block);
+  }
+  this->m_blocks.clear();
+  this->m_current = 0;
+  this->m_offset = 0;
+  this->m_usedBefore = 0;
+}
+
+auto LinearArena::allocate_slow(const size_t bytes, const size_t alignment)
+    -> void * {
+  // blocks are aligned to a cache line, larger alignments need slack
+  const size_t needed =
+      bytes + (alignment > Threading::CacheLineSize ? alignment : 0);
+  const size_t next = this->m_blocks.empty() ? 0 : this->m_current + 1;
+  if (!this->m_blocks.empty()) {
+    this->m_usedBefore += this->m_offset;
+    this->m_highWater = std::max(this->m_highWater, this->m_usedBefore);
+  }
+  // a spare block left over from a rewind is reused when it's large enough
+  auto spare = std::find_if(
+      this->m_blocks.begin() + static_cast<std::ptrdiff_t>(next),
+      this->m_blocks.end(),
+      [needed](const Block &block) { return block.size >= needed; });
+  if (spare == this->m_blocks.end()) {
+    this->m_blocks.push_back(
+        this->allocate_block(std::max(this->m_blockSize, needed)));
+    spare = this->m_blocks.end() - 1;
+  }
+  std::iter_swap(this->m_blocks.begin() + static_cast<std::ptrdiff_t>(next),
+                 spare);
+  this->m_current = next;
+  const auto address = reinterpret_cast<uintptr_t>(this->m_blocks[next].data);
+  const size_t aligned = ((address + alignment - 1) & ~(alignment - 1)) - address;
+  this->m_offset = aligned + bytes;
+  return this->m_blocks[next].data + aligned;
+}
+
+auto LinearArena::rewind(const Marker &marker) -> void {
+  this->m_highWater = std::max(this->m_highWater, this->used_bytes());
+  if (this->m_blocks.empty()) {
+    return;
+  }
+  this->m_current = marker.block;
+  this->m_offset = marker.offset;
+  this->m_usedBefore = marker.usedBefore;
+}
+
+auto LinearArena::reset() -> void {
+  this->m_highWater = std::max(this->m_highWater, this->used_bytes());
+  if (this->m_blocks.size() > 1) {
+    size_t total = 0;
+    for (const auto &block : this->m_blocks) {
+      total += block.size;
+    }
+    this->release();
+    this->m_blocks.push_back(this->allocate_block(total));
+  }
+  this->m_current = 0;
+  this->m_offset = 0;
+  this->m_usedBefore = 0;
+}
+
+auto LinearArena::high_water_bytes() const -> size_t {
+  return std::max(this->m_highWater, this->used_bytes());
+}
+
+auto LinearArena::capacity_bytes() const -> size_t {
+  size_t total = 0;
+  for (const auto &block : this->m_blocks) {
+    total += block.size;
+  }
+  return total;
+}
+
+auto thread_scratch_arena() -> LinearArena & {
+  thread_local LinearArena arena(scratchBlockSize);
+  return arena;
+}
+#pragma endregion
+} // namespace SFT::Memory
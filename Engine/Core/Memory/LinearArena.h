@@ -0,0 +1,170 @@
+//
+// Created by sturd on 10/18/2026.
+//
+
+#ifndef LINEARARENA_H
+#define LINEARARENA_H
+
+#include "MemoryStats.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+using std::vector;
+
+namespace SFT::Memory {
+/*!
+ * @brief A bump allocator, allocating is a pointer increment and everything is
+ * released at once with reset or rewind. It grows by adding blocks so earlier
+ * pointers stay valid, and reset merges the blocks into one so a steady
+ * workload stops touching the heap after its first pass. Not thread safe, it
+ * also works as a std::pmr::memory_resource where deallocate does nothing
+ */
+class LinearArena : public std::pmr::memory_resource {
+private:
+  struct Block {
+    std::byte *data = nullptr;
+    size_t size = 0;
+  };
+  vector<Block> m_blocks;
+  // blocks after the current one are spares left over from a rewind
+  size_t m_current = 0;
+  size_t m_offset = 0;
+  // bytes used in the blocks before the current one
+  size_t m_usedBefore = 0;
+  size_t m_highWater = 0;
+  size_t m_blockSize = 0;
+  MemoryTag m_tag = MemoryTag::General;
+
+  auto allocate_block(size_t size) -> Block;
+  auto free_block(const Block &block) -> void;
+  auto release() -> void;
+  auto allocate_slow(size_t bytes, size_t alignment) -> void *;
+
+protected:
+  auto do_allocate(size_t bytes, size_t alignment) -> void * override {
+    return this->allocate(bytes, alignment);
+  }
+  auto do_deallocate(void *, size_t, size_t) -> void override {}
+  [[nodiscard]] auto do_is_equal(const memory_resource &other) const noexcept
+      -> bool override {
+    return this == &other;
+  }
+
+public:
+  /*!
+   * @brief Position in the arena, rewinding to it frees everything allocated
+   * after it was taken
+   */
+  struct Marker {
+    size_t block = 0;
+    size_t offset = 0;
+    size_t usedBefore = 0;
+  };
+
+  /*!
+   * @brief Creates the arena, the first block is allocated on first use
+   * @param blockSize the size of each block, larger allocations get a block of
+   * their own
+   * @param tag the subsystem the blocks are charged to
+   */
+  explicit LinearArena(size_t blockSize = 64 * 1024,
+                       MemoryTag tag = MemoryTag::General);
+  ~LinearArena() override;
+  LinearArena(LinearArena &&other) noexcept;
+  auto operator=(LinearArena &&other) noexcept -> LinearArena &;
+  LinearArena(const LinearArena &) = delete;
+  auto operator=(const LinearArena &) -> LinearArena & = delete;
+
+  /*!
+   * @brief Allocates uninitialized memory
+   * @param bytes the size
+   * @param alignment a power of two
+   * @return the memory, never null, throws std::bad_alloc like new
+   */
+  auto allocate(size_t bytes,
+                size_t alignment = alignof(std::max_align_t)) -> void * {
+    const auto address = reinterpret_cast<uintptr_t>(
+        this->m_blocks.empty() ? nullptr
+                               : this->m_blocks[this->m_current].data);
+    const size_t aligned =
+        ((address + this->m_offset + alignment - 1) & ~(alignment - 1)) -
+        address;
+    if (!this->m_blocks.empty() &&
+        aligned + bytes <= this->m_blocks[this->m_current].size) {
+      this->m_offset = aligned + bytes;
+      return this->m_blocks[this->m_current].data + aligned;
+    }
+    return this->allocate_slow(bytes, alignment);
+  }
+  /*!
+   * @brief Allocates and value initializes an array, the elements are never
+   * destroyed so they must not need it
+   * @param count the number of elements
+   */
+  template <typename T> auto allocate_array(const size_t count) -> std::span<T> {
+    static_assert(std::is_trivially_destructible_v<T>);
+    T *items = static_cast<T *>(this->allocate(sizeof(T) * count, alignof(T)));
+    std::uninitialized_value_construct_n(items, count);
+    return {items, count};
+  }
+  /*!
+   * @brief Constructs one object in the arena, it is never destroyed so it
+   * must not need it
+   */
+  template <typename T, typename... Args> auto create(Args &&...args) -> T * {
+    static_assert(std::is_trivially_destructible_v<T>);
+    return new (this->allocate(sizeof(T), alignof(T)))
+        T(std::forward<Args>(args)...);
+  }
+  [[nodiscard]] auto marker() const -> Marker {
+    return {this->m_current, this->m_offset, this->m_usedBefore};
+  }
+  /*!
+   * @brief Frees everything allocated since the marker was taken, the blocks
+   * are kept for reuse
+   */
+  auto rewind(const Marker &marker) -> void;
+  /*!
+   * @brief Frees everything, if the arena had to grow its blocks are merged
+   * into one large enough for the whole high water mark
+   */
+  auto reset() -> void;
+  [[nodiscard]] auto used_bytes() const -> size_t {
+    return this->m_usedBefore + this->m_offset;
+  }
+  [[nodiscard]] auto high_water_bytes() const -> size_t;
+  [[nodiscard]] auto capacity_bytes() const -> size_t;
+};
+
+/*!
+ * @brief Rewinds an arena when it goes out of scope, for temporaries that
+ * only live for the duration of a function
+ */
+class ArenaScope {
+private:
+  LinearArena &m_arena;
+  LinearArena::Marker m_marker;
+
+public:
+  explicit ArenaScope(LinearArena &arena)
+      : m_arena(arena), m_marker(arena.marker()) {}
+  ~ArenaScope() { this->m_arena.rewind(this->m_marker); }
+  ArenaScope(const ArenaScope &) = delete;
+  auto operator=(const ArenaScope &) -> ArenaScope & = delete;
+};
+
+/*!
+ * @brief Gets the calling thread's scratch arena, wrap its use in an
+ * ArenaScope so the next user finds it empty
+ */
+auto thread_scratch_arena() -> LinearArena &;
+} // namespace SFT::Memory
+
+#endif // LINEARARENA_H
@@ -0,0 +1,84 @@
+//
+// Created by sturd on 10/18/2026.
+//
+
+#include "MemoryResources.h"
+
+#include "FixedPool.h"
+#include <algorithm>
+#include <bit>
+#include <new>
+
+namespace SFT::Memory {
+#pragma region additional functions
+namespace {
+constexpr size_t maxPoolAlignment = 64;
+
+// pooled blocks are aligned to their size class, up to a cache line
+auto fits_pool(const size_t bytes, const size_t alignment) -> bool {
+  return bytes <= MaxPooledSize &&
+         alignment <= std::min(std::bit_ceil(std::max<size_t>(bytes, 16)),
+                               maxPoolAlignment);
+}
+} // namespace
+#pragma endregion
+
+#pragma region PoolResource Functions
+auto PoolResource::do_allocate(const size_t bytes, const size_t alignment)
+    -> void * {
+  void *block = fits_pool(bytes, alignment)
+                    ? pool_allocate(bytes)
+                    : ::operator new(bytes, std::align_val_t{alignment});
+  record_allocation(this->m_tag, bytes);
+  return block;
+}
+
+auto PoolResource::do_deallocate(void *block, const size_t bytes,
+                                 const size_t alignment) -> void {
+  if (fits_pool(bytes, alignment)) {
+    pool_deallocate(block, bytes);
+  } else {
+    ::operator delete(block, bytes, std::align_val_t{alignment});
+  }
+  record_free(this->m_tag, bytes);
+}
+
+auto PoolResource::do_is_equal(const memory_resource &other) const noexcept
+    -> bool {
+  // the pools are shared, any pool resource can free another's memory
+  return dynamic_cast<const PoolResource *>(&other) != nullptr;
+}
+
+auto pool_resource(const MemoryTag tag) -> PoolResource * {
+  static PoolResource resources[] = {
+      PoolResource(MemoryTag::General), PoolResource(MemoryTag::Renderer),
+      PoolResource(MemoryTag::Assets),  PoolResource(MemoryTag::Audio),
+      PoolResource(MemoryTag::IO),      PoolResource(MemoryTag::Scene),
+  };
+  static_assert(std::size(resources) == static_cast<size_t>(MemoryTag::Count));
+  return &resources[static_cast<size_t>(tag)];
+}
+#pragma endregion
+
+#pragma region TrackingResource Functions
+auto TrackingResource::do_allocate(const size_t bytes, const size_t alignment)
+    -> void * {
+  void *block = this->m_upstream->allocate(bytes, alignment);
+  record_allocation(this->m_tag, bytes);
+  return block;
+}
+
+auto TrackingResource::do_deallocate(void *block, const size_t bytes,
+                                     const size_t alignment) -> void {
+  this->m_upstream->deallocate(block, bytes, alignment);
+  record_free(this->m_tag, bytes);
+}
+
+auto TrackingResource::do_is_equal(const memory_resource &other) const noexcept
+    -> bool {
+  const auto *tracking = dynamic_cast<const TrackingResource *>(&other);
+  return this == &other ||
+         (tracking != nullptr && this->m_upstream->is_equal(*tracking->m_upstream));
+}
+#pragma endregion
+} // namespace SFT::Memory
@@ -0,0 +1,63 @@
+//
+// Created by sturd on 10/18/2026.
+//
+
+#ifndef MEMORYRESOURCES_H
+#define MEMORYRESOURCES_H
+
+#include "MemoryStats.h"
+#include <memory_resource>
+
+namespace SFT::Memory {
+/*!
+ * @brief A std::pmr::memory_resource over the per thread pools, small node
+ * allocations like map and set entries skip malloc and its locks, everything
+ * else goes to operator new. Allocations are charged to the tag
+ */
+class PoolResource : public std::pmr::memory_resource {
+private:
+  MemoryTag m_tag;
+
+protected:
+  auto do_allocate(size_t bytes, size_t alignment) -> void * override;
+  auto do_deallocate(void *block, size_t bytes, size_t alignment)
+      -> void override;
+  [[nodiscard]] auto do_is_equal(const memory_resource &other) const noexcept
+      -> bool override;
+
+public:
+  explicit PoolResource(const MemoryTag tag) : m_tag(tag) {}
+};
+
+/*!
+ * @brief A std::pmr::memory_resource that forwards to another one and charges
+ * every allocation to a tag, for long lived containers that should show up in
+ * the subsystem's stats
+ */
+class TrackingResource : public std::pmr::memory_resource {
+private:
+  MemoryTag m_tag;
+  std::pmr::memory_resource *m_upstream;
+
+protected:
+  auto do_allocate(size_t bytes, size_t alignment) -> void * override;
+  auto do_deallocate(void *block, size_t bytes, size_t alignment)
+      -> void override;
+  [[nodiscard]] auto do_is_equal(const memory_resource &other) const noexcept
+      -> bool override;
+
+public:
+  explicit TrackingResource(
+      const MemoryTag tag,
+      std::pmr::memory_resource *upstream = std::pmr::new_delete_resource())
+      : m_tag(tag), m_upstream(upstream) {}
+};
+
+/*!
+ * @brief Gets a pool resource per tag, the resources live for the whole
+ * process
+ */
+auto pool_resource(MemoryTag tag) -> PoolResource *;
+} // namespace SFT::Memory
+
+#endif // MEMORYRESOURCES_H
@@ -0,0 +1,97 @@
+//
+// Created by sturd on 10/18/2026.
+//
+
+#include "MemoryStats.h"
+
+#include "Core/Threading/SpscQueue.h"
+#include "spdlog/spdlog.h"
+#include <atomic>
+
+namespace SFT::Memory {
+#pragma region additional functions
+namespace {
+// one cache line per tag, subsystems allocating on different threads don't
+// slow each other down
+struct alignas(Threading::CacheLineSize) TagCounters {
+  std::atomic<uint64_t> currentBytes = 0;
+  std::atomic<uint64_t> peakBytes = 0;
+  std::atomic<uint64_t> liveAllocations = 0;
+  std::atomic<uint64_t> totalAllocations = 0;
+};
+
+TagCounters counters[static_cast<size_t>(MemoryTag::Count)];
+
+auto counters_for(const MemoryTag tag) -> TagCounters & {
+  return counters[static_cast<size_t>(tag)];
+}
+} // namespace
+#pragma endregion
+
+#pragma region MemoryStats Functions
+auto record_allocation(const MemoryTag tag, const size_t bytes) -> void {
+  auto &tagCounters = counters_for(tag);
+  const uint64_t current =
+      tagCounters.currentBytes.fetch_add(bytes, std::memory_order_relaxed) +
+      bytes;
+  uint64_t peak = tagCounters.peakBytes.load(std::memory_order_relaxed);
+  while (current > peak && !tagCounters.peakBytes.compare_exchange_weak(
+                               peak, current, std::memory_order_relaxed)) {
+  }
+  tagCounters.liveAllocations.fetch_add(1, std::memory_order_relaxed);
+  tagCounters.totalAllocations.fetch_add(1, std::memory_order_relaxed);
+}
+
+auto record_free(const MemoryTag tag, const size_t bytes) -> void {
+  auto &tagCounters = counters_for(tag);
+  tagCounters.currentBytes.fetch_sub(bytes, std::memory_order_relaxed);
+  tagCounters.liveAllocations.fetch_sub(1, std::memory_order_relaxed);
+}
+
+auto memory_stats(const MemoryTag tag) -> MemoryTagStats {
+  const auto &tagCounters = counters_for(tag);
+  return {
+      .currentBytes = tagCounters.currentBytes.load(std::memory_order_relaxed),
+      .peakBytes = tagCounters.peakBytes.load(std::memory_order_relaxed),
+      .liveAllocations =
+          tagCounters.liveAllocations.load(std::memory_order_relaxed),
+      .totalAllocations =
+          tagCounters.totalAllocations.load(std::memory_order_relaxed),
+  };
+}
+
+auto memory_tag_name(const MemoryTag tag) -> const char * {
+  switch (tag) {
+  case MemoryTag::General:
+    return "General";
+  case MemoryTag::Renderer:
+    return "Renderer";
+  case MemoryTag::Assets:
+    return "Assets";
+  case MemoryTag::Audio:
+    return "Audio";
+  case MemoryTag::IO:
+    return "IO";
+  case MemoryTag::Scene:
+    return "Scene";
+  default:
+    return "Unknown";
+  }
+}
+
+auto log_memory_stats() -> void {
+  for (size_t i = 0; i < static_cast<size_t>(MemoryTag::Count); i++) {
+    const auto tag = static_cast<MemoryTag>(i);
+    const MemoryTagStats stats = memory_stats(tag);
+    if (stats.totalAllocations == 0) {
+      continue;
+    }
+    spdlog::debug("memory {}: {} bytes in {} allocations, peak {} bytes, {} "
+                  "allocations total",
+                  memory_tag_name(tag), stats.currentBytes,
+                  stats.liveAllocations, stats.peakBytes,
+                  stats.totalAllocations);
+  }
+}
+#pragma endregion
+} // namespace SFT::Memory
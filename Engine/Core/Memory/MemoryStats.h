@@ -0,0 +1,56 @@
+//
+// Created by sturd on 10/18/2026.
+//
+
+#ifndef MEMORYSTATS_H
+#define MEMORYSTATS_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace SFT::Memory {
+/*!
+ * @brief The subsystem an allocation is charged to
+ */
+enum class MemoryTag : uint8_t {
+  General,
+  Renderer,
+  Assets,
+  Audio,
+  IO,
+  Scene,
+  Count,
+};
+
+struct MemoryTagStats {
+  uint64_t currentBytes = 0;
+  uint64_t peakBytes = 0;
+  uint64_t liveAllocations = 0;
+  uint64_t totalAllocations = 0;
+};
+
+/*!
+ * @brief Charges an allocation to a subsystem, safe from any thread
+ * @param tag the subsystem
+ * @param bytes the size of the allocation
+ */
+auto record_allocation(MemoryTag tag, size_t bytes) -> void;
+/*!
+ * @brief Releases an allocation charged with record_allocation
+ * @param tag the subsystem it was charged to
+ * @param bytes the size it was charged with
+ */
+auto record_free(MemoryTag tag, size_t bytes) -> void;
+/*!
+ * @brief Gets a snapshot of a subsystem's counters, each counter is read on
+ * its own so they may be a few allocations apart
+ */
+auto memory_stats(MemoryTag tag) -> MemoryTagStats;
+auto memory_tag_name(MemoryTag tag) -> const char *;
+/*!
+ * @brief Logs every subsystem that allocated anything at debug level
+ */
+auto log_memory_stats() -> void;
+} // namespace SFT::Memory
+
+#endif // MEMORYSTATS_H
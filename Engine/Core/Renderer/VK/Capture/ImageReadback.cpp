@@ -0,0 +1,234 @@
+//
+// Created by sturd on 10/18/2026.
+//
+
+#include "ImageReadback.h"
+
+#include <algorithm>
+
+namespace SFT::Renderer::VK {
+#pragma region additional functions
+namespace {
+auto layout_barrier(VkCommandBuffer commandBuffer, const ReadbackSource &source,
+                    const VkImageLayout oldLayout, const VkImageLayout newLayout,
+                    const VkPipelineStageFlags2 srcStage,
+                    const VkAccessFlags2 srcAccess,
+                    const VkPipelineStageFlags2 dstStage,
+                    const VkAccessFlags2 dstAccess) -> void {
+  VkImageMemoryBarrier2 barrier{};
+  barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2;
+  barrier.srcStageMask = srcStage;
+  barrier.srcAccessMask = srcAccess;
+  barrier.dstStageMask = dstStage;
+  barrier.dstAccessMask = dstAccess;
+  barrier.oldLayout = oldLayout;
+  barrier.newLayout = newLayout;
+  barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+  barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+  barrier.image = source.image;
+  barrier.subresourceRange.aspectMask = source.aspect;
+  barrier.subresourceRange.baseMipLevel = source.mipLevel;
+  barrier.subresourceRange.levelCount = 1;
+  barrier.subresourceRange.baseArrayLayer = source.arrayLayer;
+  barrier.subresourceRange.layerCount = 1;
+  VkDependencyInfo dependency{};
+  dependency.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO;
+  dependency.imageMemoryBarrierCount = 1;
+  dependency.pImageMemoryBarriers = &barrier;
+  vkCmdPipelineBarrier2(commandBuffer, &dependency);
+}
+} // namespace
+#pragma endregion
+
+#pragma region ImageReadback Functions
+auto ImageReadback::texel_size(const VkFormat format) -> uint32_t {
+  switch (format) {
+  case VK_FORMAT_R8_UNORM:
+  case VK_FORMAT_R8_SRGB:
+    return 1;
+  case VK_FORMAT_R8G8_UNORM:
+  case VK_FORMAT_R16_SFLOAT:
+  case VK_FORMAT_R16_UNORM:
+  case VK_FORMAT_D16_UNORM:
+    return 2;
+  case VK_FORMAT_R8G8B8A8_UNORM:
+  case VK_FORMAT_R8G8B8A8_SRGB:
+  case VK_FORMAT_B8G8R8A8_UNORM:
+  case VK_FORMAT_B8G8R8A8_SRGB:
+  case VK_FORMAT_A2B10G10R10_UNORM_PACK32:
+  case VK_FORMAT_A2R10G10B10_UNORM_PACK32:
+  case VK_FORMAT_B10G11R11_UFLOAT_PACK32:
+  case VK_FORMAT_R16G16_SFLOAT:
+  case VK_FORMAT_R32_SFLOAT:
+  case VK_FORMAT_R32_UINT:
+  case VK_FORMAT_D32_SFLOAT:
+    return 4;
+  case VK_FORMAT_R16G16B16A16_SFLOAT:
+  case VK_FORMAT_R16G16B16A16_UNORM:
+  case VK_FORMAT_R32G32_SFLOAT:
+    return 8;
+  case VK_FORMAT_R32G32B32A32_SFLOAT:
+    return 16;
+  default:
+    return 0;
+  }
+}
+
+auto ImageReadback::init(VkDevice device, VkPhysicalDevice physicalDevice,
+                         const uint32_t slotCount) -> void {
+  this->m_device = device;
+  vkGetPhysicalDeviceMemoryProperties(physicalDevice,
+                                      &this->m_memoryProperties);
+  this->m_slots.resize(std::max(1u, slotCount));
+}
+
+auto ImageReadback::destroy() -> void {
+  for (auto &slot : this->m_slots) {
+    destroy_gpu_buffer(this->m_device, slot.buffer);
+  }
+  this->m_slots.clear();
+}
+
+auto ImageReadback::ensure_capacity(Slot &slot, const VkDeviceSize bytes)
+    -> expected<void, string> {
+  if (slot.buffer.buffer != VK_NULL_HANDLE && slot.buffer.size >= bytes) {
+    return {};
+  }
+  destroy_gpu_buffer(this->m_device, slot.buffer);
+  // cached memory makes the CPU's reads of the pixels fast, it may not be
+  // coherent, so deliver always invalidates
+  auto buffer = create_gpu_buffer(
+      this->m_device, this->m_memoryProperties, bytes,
+      VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+      VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_CACHED_BIT,
+      DeviceMemoryCategory::Staging);
+  if (!buffer.has_value()) {
+    buffer = create_gpu_buffer(this->m_device, this->m_memoryProperties, bytes,
+                               VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                               VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
+                                   VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                               DeviceMemoryCategory::Staging);
+  }
+  if (!buffer.has_value()) {
+    return unexpected("readback: " + buffer.error());
+  }
+  slot.buffer = buffer.value();
+  return {};
+}
+
+auto ImageReadback::record_copy(VkCommandBuffer commandBuffer,
+                                const ReadbackSource &source,
+                                ReadbackCallback callback)
+    -> expected<uint64_t, string> {
+  if (source.layout == VK_IMAGE_LAYOUT_UNDEFINED) {
+    return unexpected("readback needs the layout the image is in");
+  }
+  const uint32_t texelSize = texel_size(source.format);
+  if (texelSize == 0) {
+    return unexpected("readback can't copy this image format");
+  }
+  const auto slot = std::ranges::find_if(
+      this->m_slots, [](const Slot &candidate) { return !candidate.busy; });
+  if (slot == this->m_slots.end()) {
+    return unexpected("every readback slot is in flight");
+  }
+  const uint32_t rowPitch = source.extent.width * texelSize;
+  const VkDeviceSize bytes =
+      static_cast<VkDeviceSize>(rowPitch) * source.extent.height;
+  if (auto result = this->ensure_capacity(*slot, bytes); !result.has_value()) {
+    return unexpected(result.error());
+  }
+
+  // whatever wrote the image last has to finish, then it goes back to the
+  // layout it came in
+  layout_barrier(commandBuffer, source, source.layout,
+                 VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                 VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT,
+                 VK_ACCESS_2_MEMORY_WRITE_BIT, VK_PIPELINE_STAGE_2_COPY_BIT,
+                 VK_ACCESS_2_TRANSFER_READ_BIT);
+  VkBufferImageCopy region{};
+  region.imageSubresource.aspectMask = source.aspect;
+  region.imageSubresource.mipLevel = source.mipLevel;
+  region.imageSubresource.baseArrayLayer = source.arrayLayer;
+  region.imageSubresource.layerCount = 1;
+  region.imageExtent = {source.extent.width, source.extent.height, 1};
+  vkCmdCopyImageToBuffer(commandBuffer, source.image,
+                         VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                         slot->buffer.buffer, 1, &region);
+  layout_barrier(commandBuffer, source, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                 source.layout, VK_PIPELINE_STAGE_2_COPY_BIT, VK_ACCESS_2_NONE,
+                 VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT,
+                 VK_ACCESS_2_MEMORY_READ_BIT | VK_ACCESS_2_MEMORY_WRITE_BIT);
+
+  VkBufferMemoryBarrier2 hostBarrier{};
+  hostBarrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER_2;
+  hostBarrier.srcStageMask = VK_PIPELINE_STAGE_2_COPY_BIT;
+  hostBarrier.srcAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT;
+  hostBarrier.dstStageMask = VK_PIPELINE_STAGE_2_HOST_BIT;
+  hostBarrier.dstAccessMask = VK_ACCESS_2_HOST_READ_BIT;
+  hostBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+  hostBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+  hostBarrier.buffer = slot->buffer.buffer;
+  hostBarrier.size = bytes;
+  VkDependencyInfo dependency{};
+  dependency.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO;
+  dependency.bufferMemoryBarrierCount = 1;
+  dependency.pBufferMemoryBarriers = &hostBarrier;
+  vkCmdPipelineBarrier2(commandBuffer, &dependency);
+
+  slot->busy = true;
+  slot->point = {};
+  slot->id = this->m_nextId++;
+  slot->format = source.format;
+  slot->extent = source.extent;
+  slot->rowPitch = rowPitch;
+  slot->bytes = bytes;
+  slot->callback = std::move(callback);
+  return slot->id;
+}
+
+auto ImageReadback::submitted(const TimelinePoint point) -> void {
+  for (auto &slot : this->m_slots) {
+    if (slot.busy && slot.point.value == 0) {
+      slot.point = point;
+    }
+  }
+}
+
+auto ImageReadback::deliver(const QueueTimelines &timelines) -> uint32_t {
+  uint32_t delivered = 0;
+  // oldest first, so callbacks see captures in the order they were taken
+  vector<Slot *> ready;
+  for (auto &slot : this->m_slots) {
+    if (slot.busy && slot.point.value != 0 &&
+        timelines.is_complete(slot.point)) {
+      ready.push_back(&slot);
+    }
+  }
+  std::ranges::sort(ready, {}, &Slot::id);
+  for (Slot *slot : ready) {
+    // a no-op on coherent memory
+    VkMappedMemoryRange range{};
+    range.sType = VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE;
+    range.memory = slot->buffer.memory;
+    range.offset = 0;
+    range.size = VK_WHOLE_SIZE;
+    vkInvalidateMappedMemoryRanges(this->m_device, 1, &range);
+    if (slot->callback) {
+      ReadbackResult result;
+      result.id = slot->id;
+      result.pixels = {slot->buffer.mapped, slot->bytes};
+      result.format = slot->format;
+      result.extent = slot->extent;
+      result.rowPitch = slot->rowPitch;
+      slot->callback(result);
+    }
+    slot->callback = nullptr;
+    slot->busy = false;
+    slot->point = {};
+    delivered++;
+  }
+  return delivered;
+}
+#pragma endregion
+} // namespace SFT::Renderer::VK
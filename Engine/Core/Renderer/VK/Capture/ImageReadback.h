@@ -0,0 +1,132 @@
+//
+// Created by sturd on 10/18/2026.
+//
+
+#ifndef IMAGEREADBACK_H
+#define IMAGEREADBACK_H
+
+#include "Core/Renderer/VK/Memory/GpuBuffer.h"
+#include "Core/Renderer/VK/Sync/QueueTimelines.h"
+#include "Core/Renderer/VK/VulkanDispatch.h"
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <functional>
+#include <span>
+#include <string>
+#include <vector>
+
+using std::expected;
+using std::string;
+using std::unexpected;
+using std::vector;
+
+namespace SFT::Renderer::VK {
+/*!
+ * @brief An image to copy back, its layout is restored after the copy
+ */
+struct ReadbackSource {
+  VkImage image = VK_NULL_HANDLE;
+  VkFormat format = VK_FORMAT_UNDEFINED;
+  VkExtent2D extent{};
+  // the layout the image is in when the copy is recorded, swap chain images
+  // are usually in PRESENT_SRC_KHR by then, it must be set, transitioning
+  // out of UNDEFINED would let the driver discard the pixels being copied
+  VkImageLayout layout = VK_IMAGE_LAYOUT_UNDEFINED;
+  VkImageAspectFlags aspect = VK_IMAGE_ASPECT_COLOR_BIT;
+  uint32_t mipLevel = 0;
+  uint32_t arrayLayer = 0;
+};
+
+/*!
+ * @brief Pixels copied back from the GPU, tightly packed rows. The span points
+ * into the ring's mapped memory and is only valid during the callback
+ */
+struct ReadbackResult {
+  uint64_t id = 0;
+  std::span<const std::byte> pixels;
+  VkFormat format = VK_FORMAT_UNDEFINED;
+  VkExtent2D extent{};
+  uint32_t rowPitch = 0;
+};
+
+using ReadbackCallback = std::function<void(const ReadbackResult &)>;
+
+/*!
+ * @brief Copies images into a ring of host visible buffers and hands the
+ * pixels to a callback once the GPU is done, a few frames later, without
+ * ever waiting on the GPU. record_copy goes into the frame's command buffer,
+ * submitted stamps what was recorded with the submit's timeline point and
+ * deliver runs the callbacks of every copy that point has passed
+ */
+class ImageReadback {
+private:
+  struct Slot {
+    GpuBuffer buffer;
+    bool busy = false;
+    // 0 while recorded but not yet submitted
+    TimelinePoint point{};
+    uint64_t id = 0;
+    VkFormat format = VK_FORMAT_UNDEFINED;
+    VkExtent2D extent{};
+    uint32_t rowPitch = 0;
+    VkDeviceSize bytes = 0;
+    ReadbackCallback callback;
+  };
+
+  VkDevice m_device = VK_NULL_HANDLE;
+  VkPhysicalDeviceMemoryProperties m_memoryProperties{};
+  vector<Slot> m_slots;
+  uint64_t m_nextId = 1;
+
+  auto ensure_capacity(Slot &slot, VkDeviceSize bytes) -> expected<void, string>;
+
+public:
+  /*!
+   * @brief Sets up the ring, buffers are created on first use and grow to
+   * fit the largest image copied through them
+   * @param device the logical device
+   * @param physicalDevice the device the buffers come from
+   * @param slotCount how many copies can be in flight at once
+   */
+  auto init(VkDevice device, VkPhysicalDevice physicalDevice,
+            uint32_t slotCount) -> void;
+  /*!
+   * @brief Frees the buffers, pending callbacks are dropped, the GPU must be
+   * done with every copy
+   */
+  auto destroy() -> void;
+  /*!
+   * @brief Records a copy of an image into a free slot of the ring
+   * @param commandBuffer the command buffer being recorded
+   * @param source the image and the layout it's in
+   * @param callback gets the pixels once the copy is done, on the thread
+   * calling deliver
+   * @return On success, returns the id the result will carry, on failure
+   * (including every slot being in flight or the source layout being left
+   * UNDEFINED), returns unexpected with error message, nothing is recorded
+   * then
+   */
+  auto record_copy(VkCommandBuffer commandBuffer, const ReadbackSource &source,
+                   ReadbackCallback callback) -> expected<uint64_t, string>;
+  /*!
+   * @brief Marks every copy recorded since the last call as part of a submit
+   * @param point the point the submit returned
+   */
+  auto submitted(TimelinePoint point) -> void;
+  /*!
+   * @brief Runs the callbacks of every copy the GPU has finished and frees
+   * their slots, never blocks
+   * @param timelines the timelines the submits went to
+   * @return how many callbacks ran
+   */
+  auto deliver(const QueueTimelines &timelines) -> uint32_t;
+  /*!
+   * @brief Bytes per texel of the formats a readback can copy, 0 for formats
+   * it can't (block compressed and multi planar ones)
+   */
+  [[nodiscard]] static auto texel_size(VkFormat format) -> uint32_t;
+};
+} // namespace SFT::Renderer::VK
+
+#endif // IMAGEREADBACK_H
@@ -0,0 +1,311 @@
+//
+// Created by sturd on 10/18/2026.
+//
+
+#include "HiZPyramid.h"
+
+#include "Core/Renderer/VK/Memory/DeviceMemory.h"
+#include "Core/Renderer/VK/RenderGraph/Barriers.h"
+#include <algorithm>
+#include <bit>
+
+namespace SFT::Renderer::VK {
+#pragma region additional functions
+namespace {
+constexpr VkFormat pyramidFormat = VK_FORMAT_R32_SFLOAT;
+constexpr uint32_t groupSize = 8;
+
+auto previous_power_of_two(const uint32_t value) -> uint32_t {
+  return value == 0 ? 1 : std::bit_floor(value);
+}
+
+auto compute_barrier(VkCommandBuffer commandBuffer) -> void {
+  memory_barrier(commandBuffer, VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+                 VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT,
+                 VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+                 VK_ACCESS_2_SHADER_SAMPLED_READ_BIT);
+}
+} // namespace
+#pragma endregion
+
+#pragma region HiZPyramid Functions
+auto HiZPyramid::init(VkDevice device, VkPhysicalDevice physicalDevice,
+                      PipelineLayoutCache &layoutCache,
+                      const std::span<const std::byte> downsampleCode,
+                      const uint32_t framesInFlight) -> expected<void, string> {
+  this->m_device = device;
+  this->m_framesInFlight = std::max(1u, framesInFlight);
+  vkGetPhysicalDeviceMemoryProperties(physicalDevice,
+                                      &this->m_memoryProperties);
+  auto pipeline = create_compute_pipeline(device, layoutCache, downsampleCode);
+  if (!pipeline.has_value()) {
+    return unexpected("Hi-Z downsample: " + pipeline.error());
+  }
+  this->m_downsample = std::move(pipeline.value());
+  auto setLayout =
+      layoutCache.get_set_layout_for(this->m_downsample.reflection, 0);
+  if (!setLayout.has_value()) {
+    return unexpected(setLayout.error());
+  }
+  this->m_setLayout = setLayout.value();
+
+  // only ever read with texelFetch, the filter doesn't matter
+  VkSamplerCreateInfo samplerInfo{};
+  samplerInfo.sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
+  samplerInfo.magFilter = VK_FILTER_NEAREST;
+  samplerInfo.minFilter = VK_FILTER_NEAREST;
+  samplerInfo.mipmapMode = VK_SAMPLER_MIPMAP_MODE_NEAREST;
+  samplerInfo.addressModeU = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+  samplerInfo.addressModeV = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+  samplerInfo.addressModeW = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+  samplerInfo.maxLod = VK_LOD_CLAMP_NONE;
+  if (vkCreateSampler(device, &samplerInfo, nullptr, &this->m_sampler) !=
+      VK_SUCCESS) {
+    return unexpected("failed to create the Hi-Z sampler");
+  }
+  return {};
+}
+
+auto HiZPyramid::release_image() -> void {
+  if (this->m_pool != VK_NULL_HANDLE) {
+    vkDestroyDescriptorPool(this->m_device, this->m_pool, nullptr);
+  }
+  for (const auto view : this->m_mipViews) {
+    vkDestroyImageView(this->m_device, view, nullptr);
+  }
+  if (this->m_view != VK_NULL_HANDLE) {
+    vkDestroyImageView(this->m_device, this->m_view, nullptr);
+  }
+  if (this->m_image != VK_NULL_HANDLE) {
+    vkDestroyImage(this->m_device, this->m_image, nullptr);
+  }
+  free_device_memory(this->m_device, this->m_memory);
+  this->m_pool = VK_NULL_HANDLE;
+  this->m_mipViews.clear();
+  this->m_depthSets.clear();
+  this->m_mipSets.clear();
+  this->m_view = VK_NULL_HANDLE;
+  this->m_image = VK_NULL_HANDLE;
+  this->m_memory = VK_NULL_HANDLE;
+  this->m_extent = {};
+  this->m_levels = 0;
+  this->m_initialized = false;
+}
+
+auto HiZPyramid::destroy() -> void {
+  this->release_image();
+  if (this->m_sampler != VK_NULL_HANDLE) {
+    vkDestroySampler(this->m_device, this->m_sampler, nullptr);
+  }
+  this->m_sampler = VK_NULL_HANDLE;
+  destroy_compute_pipeline(this->m_device, this->m_downsample);
+}
+
+auto HiZPyramid::resize(const VkExtent2D depthExtent)
+    -> expected<void, string> {
+  const VkExtent2D extent{previous_power_of_two(depthExtent.width),
+                          previous_power_of_two(depthExtent.height)};
+  if (this->m_image != VK_NULL_HANDLE && extent.width == this->m_extent.width &&
+      extent.height == this->m_extent.height) {
+    return {};
+  }
+  this->release_image();
+  this->m_extent = extent;
+  this->m_levels = std::bit_width(std::max(extent.width, extent.height));
+  // a half built pyramid would pass the same extent check next time, so any
+  // failure releases all of it and the next resize starts over
+  if (auto result = this->create_image(); !result.has_value()) {
+    this->release_image();
+    return unexpected(result.error());
+  }
+  return {};
+}
+
+auto HiZPyramid::create_image() -> expected<void, string> {
+  const VkExtent2D extent = this->m_extent;
+  VkImageCreateInfo imageInfo{};
+  imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+  imageInfo.imageType = VK_IMAGE_TYPE_2D;
+  imageInfo.format = pyramidFormat;
+  imageInfo.extent = {extent.width, extent.height, 1};
+  imageInfo.mipLevels = this->m_levels;
+  imageInfo.arrayLayers = 1;
+  imageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+  imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+  imageInfo.usage = VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_STORAGE_BIT;
+  imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+  imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+  if (vkCreateImage(this->m_device, &imageInfo, nullptr, &this->m_image) !=
+      VK_SUCCESS) {
+    return unexpected("failed to create the Hi-Z pyramid");
+  }
+  VkMemoryRequirements requirements;
+  vkGetImageMemoryRequirements(this->m_device, this->m_image, &requirements);
+  uint32_t memoryType = UINT32_MAX;
+  for (uint32_t i = 0; i < this->m_memoryProperties.memoryTypeCount; i++) {
+    if ((requirements.memoryTypeBits & (1u << i)) &&
+        (this->m_memoryProperties.memoryTypes[i].propertyFlags &
+         VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT)) {
+      memoryType = i;
+      break;
+    }
+  }
+  if (memoryType == UINT32_MAX) {
+    return unexpected("no device local memory fits the Hi-Z pyramid");
+  }
+  VkMemoryAllocateInfo allocInfo{};
+  allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+  allocInfo.allocationSize = requirements.size;
+  allocInfo.memoryTypeIndex = memoryType;
+  if (allocate_device_memory(this->m_device, allocInfo,
+                             DeviceMemoryCategory::RenderTargets,
+                             &this->m_memory) != VK_SUCCESS) {
+    return unexpected("failed to allocate the Hi-Z pyramid");
+  }
+  if (vkBindImageMemory(this->m_device, this->m_image, this->m_memory, 0) !=
+      VK_SUCCESS) {
+    return unexpected("failed to bind the Hi-Z pyramid memory");
+  }
+
+  VkImageViewCreateInfo viewInfo{};
+  viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+  viewInfo.image = this->m_image;
+  viewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
+  viewInfo.format = pyramidFormat;
+  viewInfo.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+  viewInfo.subresourceRange.levelCount = this->m_levels;
+  viewInfo.subresourceRange.layerCount = 1;
+  if (vkCreateImageView(this->m_device, &viewInfo, nullptr, &this->m_view) !=
+      VK_SUCCESS) {
+    return unexpected("failed to create the Hi-Z pyramid view");
+  }
+  this->m_mipViews.resize(this->m_levels, VK_NULL_HANDLE);
+  viewInfo.subresourceRange.levelCount = 1;
+  for (uint32_t level = 0; level < this->m_levels; level++) {
+    viewInfo.subresourceRange.baseMipLevel = level;
+    if (vkCreateImageView(this->m_device, &viewInfo, nullptr,
+                          &this->m_mipViews[level]) != VK_SUCCESS) {
+      return unexpected("failed to create a Hi-Z level view");
+    }
+  }
+
+  const uint32_t setCount = this->m_framesInFlight + this->m_levels - 1;
+  const VkDescriptorPoolSize poolSizes[] = {
+      {VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, setCount},
+      {VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, setCount},
+  };
+  VkDescriptorPoolCreateInfo poolInfo{};
+  poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+  poolInfo.maxSets = setCount;
+  poolInfo.poolSizeCount = 2;
+  poolInfo.pPoolSizes = poolSizes;
+  if (vkCreateDescriptorPool(this->m_device, &poolInfo, nullptr,
+                             &this->m_pool) != VK_SUCCESS) {
+    return unexpected("failed to create the Hi-Z descriptor pool");
+  }
+  vector<VkDescriptorSetLayout> layouts(setCount, this->m_setLayout);
+  vector<VkDescriptorSet> sets(setCount);
+  VkDescriptorSetAllocateInfo setInfo{};
+  setInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+  setInfo.descriptorPool = this->m_pool;
+  setInfo.descriptorSetCount = setCount;
+  setInfo.pSetLayouts = layouts.data();
+  if (vkAllocateDescriptorSets(this->m_device, &setInfo, sets.data()) !=
+      VK_SUCCESS) {
+    return unexpected("failed to allocate the Hi-Z descriptor sets");
+  }
+  this->m_depthSets.assign(sets.begin(),
+                           sets.begin() + this->m_framesInFlight);
+  this->m_mipSets.assign(sets.begin() + this->m_framesInFlight, sets.end());
+
+  // levels past 0 always read the level above, written once here
+  vector<VkDescriptorImageInfo> images;
+  images.reserve(this->m_mipSets.size() * 2);
+  vector<VkWriteDescriptorSet> writes;
+  for (uint32_t level = 1; level < this->m_levels; level++) {
+    images.push_back({this->m_sampler, this->m_mipViews[level - 1],
+                      VK_IMAGE_LAYOUT_GENERAL});
+    images.push_back(
+        {VK_NULL_HANDLE, this->m_mipViews[level], VK_IMAGE_LAYOUT_GENERAL});
+    VkWriteDescriptorSet write{};
+    write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+    write.dstSet = this->m_mipSets[level - 1];
+    write.descriptorCount = 1;
+    write.dstBinding = 0;
+    write.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+    write.pImageInfo = &images[images.size() - 2];
+    writes.push_back(write);
+    write.dstBinding = 1;
+    write.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+    write.pImageInfo = &images.back();
+    writes.push_back(write);
+  }
+  vkUpdateDescriptorSets(this->m_device, static_cast<uint32_t>(writes.size()),
+                         writes.data(), 0, nullptr);
+  return {};
+}
+
+auto HiZPyramid::record_build(VkCommandBuffer commandBuffer,
+                              const uint32_t frameSlot, VkImageView depthView)
+    -> void {
+  // the slot's previous frame is done, so its set can be rewritten
+  VkDescriptorSet depthSet =
+      this->m_depthSets[frameSlot % this->m_framesInFlight];
+  const VkDescriptorImageInfo depthImage{
+      this->m_sampler, depthView, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL};
+  const VkDescriptorImageInfo targetImage{VK_NULL_HANDLE, this->m_mipViews[0],
+                                          VK_IMAGE_LAYOUT_GENERAL};
+  VkWriteDescriptorSet writes[2]{};
+  writes[0].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+  writes[0].dstSet = depthSet;
+  writes[0].dstBinding = 0;
+  writes[0].descriptorCount = 1;
+  writes[0].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+  writes[0].pImageInfo = &depthImage;
+  writes[1] = writes[0];
+  writes[1].dstBinding = 1;
+  writes[1].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+  writes[1].pImageInfo = &targetImage;
+  vkUpdateDescriptorSets(this->m_device, 2, writes, 0, nullptr);
+
+  // the pyramid lives in GENERAL, it only leaves UNDEFINED once; afterwards
+  // the previous frame's cull reads have to finish before it's overwritten
+  VkImageMemoryBarrier2 toGeneral{};
+  toGeneral.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2;
+  toGeneral.srcStageMask = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT;
+  toGeneral.srcAccessMask = VK_ACCESS_2_SHADER_SAMPLED_READ_BIT;
+  toGeneral.dstStageMask = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT;
+  toGeneral.dstAccessMask = VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT;
+  toGeneral.oldLayout = this->m_initialized ? VK_IMAGE_LAYOUT_GENERAL
+                                            : VK_IMAGE_LAYOUT_UNDEFINED;
+  toGeneral.newLayout = VK_IMAGE_LAYOUT_GENERAL;
+  toGeneral.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+  toGeneral.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+  toGeneral.image = this->m_image;
+  toGeneral.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+  toGeneral.subresourceRange.levelCount = this->m_levels;
+  toGeneral.subresourceRange.layerCount = 1;
+  VkDependencyInfo dependency{};
+  dependency.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO;
+  dependency.imageMemoryBarrierCount = 1;
+  dependency.pImageMemoryBarriers = &toGeneral;
+  vkCmdPipelineBarrier2(commandBuffer, &dependency);
+  this->m_initialized = true;
+
+  vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE,
+                    this->m_downsample.pipeline);
+  for (uint32_t level = 0; level < this->m_levels; level++) {
+    VkDescriptorSet set =
+        level == 0 ? depthSet : this->m_mipSets[level - 1];
+    vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE,
+                            this->m_downsample.layout, 0, 1, &set, 0,
+                            nullptr);
+    const uint32_t width = std::max(1u, this->m_extent.width >> level);
+    const uint32_t height = std::max(1u, this->m_extent.height >> level);
+    vkCmdDispatch(commandBuffer, (width + groupSize - 1) / groupSize,
+                  (height + groupSize - 1) / groupSize, 1);
+    compute_barrier(commandBuffer);
+  }
+}
+#pragma endregion
+} // namespace SFT::Renderer::VK
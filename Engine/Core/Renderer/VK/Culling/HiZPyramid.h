@@ -0,0 +1,99 @@
+//
+// Created by sturd on 10/18/2026.
+//
+
+#ifndef HIZPYRAMID_H
+#define HIZPYRAMID_H
+
+#include "../Pipeline/ComputePipeline.h"
+#include "../Pipeline/PipelineLayoutCache.h"
+#include "Core/Renderer/VK/VulkanDispatch.h"
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <span>
+#include <string>
+#include <vector>
+
+using std::expected;
+using std::string;
+using std::unexpected;
+using std::vector;
+
+namespace SFT::Renderer::VK {
+/*!
+ * @brief A mip chain of the farthest depth under every texel, built from the
+ * depth buffer by a compute pass per level. The reduction is done by hand
+ * rather than with a min/max sampler, so only core features are needed. Level
+ * 0 is the depth buffer's size rounded down to powers of two
+ */
+class HiZPyramid {
+private:
+  VkDevice m_device = VK_NULL_HANDLE;
+  VkPhysicalDeviceMemoryProperties m_memoryProperties{};
+  ComputePipeline m_downsample;
+  VkDescriptorSetLayout m_setLayout = VK_NULL_HANDLE;
+  VkSampler m_sampler = VK_NULL_HANDLE;
+  VkDescriptorPool m_pool = VK_NULL_HANDLE;
+  uint32_t m_framesInFlight = 1;
+
+  VkImage m_image = VK_NULL_HANDLE;
+  VkDeviceMemory m_memory = VK_NULL_HANDLE;
+  VkImageView m_view = VK_NULL_HANDLE;
+  vector<VkImageView> m_mipViews;
+  // level 0 reads the depth buffer, whose view can change every frame, so it
+  // gets a set per frame in flight, the other levels read the level above
+  vector<VkDescriptorSet> m_depthSets;
+  vector<VkDescriptorSet> m_mipSets;
+  VkExtent2D m_extent{};
+  uint32_t m_levels = 0;
+  bool m_initialized = false;
+
+  auto create_image() -> expected<void, string>;
+  auto release_image() -> void;
+
+public:
+  /*!
+   * @brief Creates the downsample pipeline and the sampler
+   * @param device the logical device
+   * @param physicalDevice the device the pyramid's memory comes from
+   * @param layoutCache the cache the pipeline layout comes from
+   * @param downsampleCode SPIR-V of hiz_downsample.comp
+   * @param framesInFlight how many frames can be recorded ahead of the GPU
+   * @return On success, returns void, on failure, returns unexpected with
+   * error message
+   */
+  auto init(VkDevice device, VkPhysicalDevice physicalDevice,
+            PipelineLayoutCache &layoutCache,
+            std::span<const std::byte> downsampleCode,
+            uint32_t framesInFlight) -> expected<void, string>;
+  auto destroy() -> void;
+  /*!
+   * @brief Recreates the pyramid for a depth buffer size, does nothing if the
+   * size didn't change, otherwise the GPU must be done with the old pyramid
+   * @param depthExtent the size of the depth buffer
+   * @return On success, returns void, on failure, returns unexpected with
+   * error message
+   */
+  auto resize(VkExtent2D depthExtent) -> expected<void, string>;
+  /*!
+   * @brief Records the build of every level, the depth must be readable by
+   * compute shaders in SHADER_READ_ONLY_OPTIMAL, the pyramid ends up readable
+   * by compute shaders in GENERAL
+   * @param commandBuffer the command buffer being recorded
+   * @param frameSlot the frame in flight being recorded
+   * @param depthView a depth aspect view of the depth buffer
+   */
+  auto record_build(VkCommandBuffer commandBuffer, uint32_t frameSlot,
+                    VkImageView depthView) -> void;
+  /*!
+   * @brief A view of every level, for sampling in the cull pass
+   */
+  [[nodiscard]] auto view() const -> VkImageView { return this->m_view; }
+  [[nodiscard]] auto sampler() const -> VkSampler { return this->m_sampler; }
+  [[nodiscard]] auto extent() const -> VkExtent2D { return this->m_extent; }
+  [[nodiscard]] auto levels() const -> uint32_t { return this->m_levels; }
+};
+} // namespace SFT::Renderer::VK
+
+#endif // HIZPYRAMID_H
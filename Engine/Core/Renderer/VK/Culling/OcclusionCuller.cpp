@@ -0,0 +1,262 @@
+//
+// Created by sturd on 10/18/2026.
+//
+
+#include "OcclusionCuller.h"
+
+#include "Core/Renderer/VK/RenderGraph/Barriers.h"
+#include <cmath>
+#include <cstring>
+
+namespace SFT::Renderer::VK {
+#pragma region additional functions
+namespace {
+constexpr uint32_t groupSize = 64;
+
+// mirrors the push constant block of occlusion_cull.comp
+struct CullConstants {
+  float view[16];
+  float frustum[4];
+  float p00;
+  float p11;
+  float znear;
+  uint32_t objectCount;
+  uint32_t phase;
+  uint32_t padding;
+  VkDeviceAddress objects;
+  VkDeviceAddress visibility;
+  VkDeviceAddress commands;
+};
+static_assert(sizeof(CullConstants) == 128,
+              "128 bytes is all the push constant space Vulkan guarantees");
+} // namespace
+#pragma endregion
+
+#pragma region OcclusionCuller Functions
+auto make_cull_view(const float (&view)[16], const float p00, const float p11,
+                    const float znear) -> CullView {
+  CullView cull{};
+  std::memcpy(cull.view, view, sizeof(cull.view));
+  // a point is inside the right plane while p00 * |x| <= z, normalizing
+  // (p00, 1) makes the plane distance comparable with a sphere's radius
+  const float x = std::abs(p00);
+  const float y = std::abs(p11);
+  const float lengthX = std::sqrt(x * x + 1.0f);
+  const float lengthY = std::sqrt(y * y + 1.0f);
+  cull.frustum[0] = x / lengthX;
+  cull.frustum[1] = 1.0f / lengthX;
+  cull.frustum[2] = y / lengthY;
+  cull.frustum[3] = 1.0f / lengthY;
+  cull.p00 = x;
+  cull.p11 = y;
+  cull.znear = znear;
+  return cull;
+}
+
+auto OcclusionCuller::init(VkDevice device, VkPhysicalDevice physicalDevice,
+                           PipelineLayoutCache &layoutCache,
+                           const std::span<const std::byte> cullCode,
+                           const std::span<const std::byte> downsampleCode,
+                           const uint32_t maxObjects,
+                           const uint32_t framesInFlight)
+    -> expected<void, string> {
+  this->m_device = device;
+  this->m_maxObjects = maxObjects;
+  if (auto result = this->m_pyramid.init(device, physicalDevice, layoutCache,
+                                         downsampleCode, framesInFlight);
+      !result.has_value()) {
+    return unexpected(result.error());
+  }
+  auto pipeline = create_compute_pipeline(device, layoutCache, cullCode);
+  if (!pipeline.has_value()) {
+    return unexpected("occlusion cull: " + pipeline.error());
+  }
+  this->m_cull = std::move(pipeline.value());
+
+  auto setLayout = layoutCache.get_set_layout_for(this->m_cull.reflection, 0);
+  if (!setLayout.has_value()) {
+    return unexpected(setLayout.error());
+  }
+  const VkDescriptorPoolSize poolSize{VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
+                                      1};
+  VkDescriptorPoolCreateInfo poolInfo{};
+  poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+  poolInfo.maxSets = 1;
+  poolInfo.poolSizeCount = 1;
+  poolInfo.pPoolSizes = &poolSize;
+  if (vkCreateDescriptorPool(device, &poolInfo, nullptr, &this->m_pool) !=
+      VK_SUCCESS) {
+    return unexpected("failed to create the occlusion cull descriptor pool");
+  }
+  VkDescriptorSetAllocateInfo setInfo{};
+  setInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+  setInfo.descriptorPool = this->m_pool;
+  setInfo.descriptorSetCount = 1;
+  setInfo.pSetLayouts = &setLayout.value();
+  if (vkAllocateDescriptorSets(device, &setInfo, &this->m_pyramidSet) !=
+      VK_SUCCESS) {
+    return unexpected("failed to allocate the occlusion cull descriptor set");
+  }
+
+  VkPhysicalDeviceMemoryProperties memoryProperties;
+  vkGetPhysicalDeviceMemoryProperties(physicalDevice, &memoryProperties);
+  const VkDeviceSize commandBytes =
+      static_cast<VkDeviceSize>(maxObjects) * command_stride();
+  auto visibility = create_gpu_buffer(
+      device, memoryProperties, static_cast<VkDeviceSize>(maxObjects) * 4,
+      VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT |
+          VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT,
+      VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+  if (!visibility.has_value()) {
+    return unexpected(visibility.error());
+  }
+  this->m_visibility = visibility.value();
+  for (auto *commands : {&this->m_earlyCommands, &this->m_lateCommands}) {
+    auto buffer = create_gpu_buffer(
+        device, memoryProperties, commandBytes,
+        VK_BUFFER_USAGE_STORAGE_BUFFER_BIT |
+            VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT |
+            VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT,
+        VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+    if (!buffer.has_value()) {
+      return unexpected(buffer.error());
+    }
+    *commands = buffer.value();
+  }
+  this->m_visibilityCleared = false;
+  return {};
+}
+
+auto OcclusionCuller::destroy() -> void {
+  destroy_gpu_buffer(this->m_device, this->m_visibility);
+  destroy_gpu_buffer(this->m_device, this->m_earlyCommands);
+  destroy_gpu_buffer(this->m_device, this->m_lateCommands);
+  if (this->m_pool != VK_NULL_HANDLE) {
+    vkDestroyDescriptorPool(this->m_device, this->m_pool, nullptr);
+  }
+  this->m_pool = VK_NULL_HANDLE;
+  this->m_pyramidSet = VK_NULL_HANDLE;
+  destroy_compute_pipeline(this->m_device, this->m_cull);
+  this->m_pyramid.destroy();
+}
+
+auto OcclusionCuller::resize(const VkExtent2D depthExtent)
+    -> expected<void, string> {
+  if (auto result = this->m_pyramid.resize(depthExtent); !result.has_value()) {
+    return unexpected(result.error());
+  }
+  const VkDescriptorImageInfo image{this->m_pyramid.sampler(),
+                                    this->m_pyramid.view(),
+                                    VK_IMAGE_LAYOUT_GENERAL};
+  VkWriteDescriptorSet write{};
+  write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+  write.dstSet = this->m_pyramidSet;
+  write.dstBinding = 0;
+  write.descriptorCount = 1;
+  write.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+  write.pImageInfo = &image;
+  vkUpdateDescriptorSets(this->m_device, 1, &write, 0, nullptr);
+  return {};
+}
+
+auto OcclusionCuller::dispatch(VkCommandBuffer commandBuffer,
+                               const VkDeviceAddress objects,
+                               const uint32_t objectCount, const CullView &view,
+                               const uint32_t phase, const GpuBuffer &commands)
+    -> void {
+  CullConstants constants{};
+  std::memcpy(constants.view, view.view, sizeof(constants.view));
+  std::memcpy(constants.frustum, view.frustum, sizeof(constants.frustum));
+  constants.p00 = view.p00;
+  constants.p11 = view.p11;
+  constants.znear = view.znear;
+  constants.objectCount = objectCount;
+  constants.phase = phase;
+  constants.objects = objects;
+  constants.visibility = this->m_visibility.address;
+  constants.commands = commands.address;
+  vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE,
+                    this->m_cull.pipeline);
+  // the early pass never samples the pyramid, but the set is still bound so
+  // the layout is fully satisfied
+  vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE,
+                          this->m_cull.layout, 0, 1, &this->m_pyramidSet, 0,
+                          nullptr);
+  vkCmdPushConstants(commandBuffer, this->m_cull.layout,
+                     VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(constants),
+                     &constants);
+  vkCmdDispatch(commandBuffer, (objectCount + groupSize - 1) / groupSize, 1,
+                1);
+}
+
+auto OcclusionCuller::record_early(VkCommandBuffer commandBuffer,
+                                   const VkDeviceAddress objects,
+                                   const uint32_t objectCount,
+                                   const CullView &view)
+    -> expected<void, string> {
+  if (objectCount > this->m_maxObjects) {
+    return unexpected("occlusion culler got " + std::to_string(objectCount) +
+                      " objects, it was created for " +
+                      std::to_string(this->m_maxObjects));
+  }
+  if (this->m_pyramid.levels() == 0) {
+    return unexpected("occlusion culler has no pyramid, call resize first");
+  }
+  if (!this->m_visibilityCleared) {
+    // nothing was visible before the first frame, so the early pass draws
+    // nothing and the late pass draws everything that passes
+    vkCmdFillBuffer(commandBuffer, this->m_visibility.buffer, 0, VK_WHOLE_SIZE,
+                    0);
+    memory_barrier(commandBuffer, VK_PIPELINE_STAGE_2_CLEAR_BIT,
+                   VK_ACCESS_2_TRANSFER_WRITE_BIT,
+                   VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+                   VK_ACCESS_2_SHADER_STORAGE_READ_BIT |
+                       VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT);
+    this->m_visibilityCleared = true;
+  }
+  // the previous frame's draws still read the commands, and its late pass
+  // wrote the visibility this pass reads
+  memory_barrier(commandBuffer,
+                 VK_PIPELINE_STAGE_2_DRAW_INDIRECT_BIT |
+                     VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+                 VK_ACCESS_2_INDIRECT_COMMAND_READ_BIT |
+                     VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT,
+                 VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+                 VK_ACCESS_2_SHADER_STORAGE_READ_BIT |
+                     VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT);
+  this->dispatch(commandBuffer, objects, objectCount, view, 0,
+                 this->m_earlyCommands);
+  memory_barrier(commandBuffer, VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+                 VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT,
+                 VK_PIPELINE_STAGE_2_DRAW_INDIRECT_BIT,
+                 VK_ACCESS_2_INDIRECT_COMMAND_READ_BIT);
+  return {};
+}
+
+auto OcclusionCuller::record_late(VkCommandBuffer commandBuffer,
+                                  const uint32_t frameSlot,
+                                  VkImageView depthView,
+                                  const VkDeviceAddress objects,
+                                  const uint32_t objectCount,
+                                  const CullView &view)
+    -> expected<void, string> {
+  if (objectCount > this->m_maxObjects) {
+    return unexpected("occlusion culler got " + std::to_string(objectCount) +
+                      " objects, it was created for " +
+                      std::to_string(this->m_maxObjects));
+  }
+  if (this->m_pyramid.levels() == 0) {
+    return unexpected("occlusion culler has no pyramid, call resize first");
+  }
+  // leaves every level readable by compute shaders
+  this->m_pyramid.record_build(commandBuffer, frameSlot, depthView);
+  this->dispatch(commandBuffer, objects, objectCount, view, 1,
+                 this->m_lateCommands);
+  memory_barrier(commandBuffer, VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+                 VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT,
+                 VK_PIPELINE_STAGE_2_DRAW_INDIRECT_BIT,
+                 VK_ACCESS_2_INDIRECT_COMMAND_READ_BIT);
+  return {};
+}
+#pragma endregion
+} // namespace SFT::Renderer::VK
@@ -0,0 +1,164 @@
+//
+// Created by sturd on 10/18/2026.
+//
+
+#ifndef OCCLUSIONCULLER_H
+#define OCCLUSIONCULLER_H
+
+#include "../Memory/GpuBuffer.h"
+#include "../Pipeline/ComputePipeline.h"
+#include "../Pipeline/PipelineLayoutCache.h"
+#include "HiZPyramid.h"
+#include "Core/Renderer/VK/VulkanDispatch.h"
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <span>
+#include <string>
+
+using std::expected;
+using std::string;
+using std::unexpected;
+
+namespace SFT::Renderer::VK {
+/*!
+ * @brief One object to cull, mirrors CullObject in occlusion_cull.comp. The
+ * draw fields are copied into the object's VkDrawIndexedIndirectCommand
+ */
+struct CullObject {
+  // world space bounding sphere
+  float center[3];
+  float radius;
+  uint32_t indexCount;
+  uint32_t firstIndex;
+  int32_t vertexOffset;
+  uint32_t firstInstance;
+};
+static_assert(sizeof(CullObject) == 32);
+
+/*!
+ * @brief The camera as the cull shader wants it, see make_cull_view
+ */
+struct CullView {
+  // column major world to view matrix, the view looks down -Z
+  float view[16];
+  // normals of the right and top frustum planes, (x, z) and (y, z)
+  float frustum[4];
+  float p00;
+  float p11;
+  float znear;
+};
+
+/*!
+ * @brief Builds the cull camera for a symmetric perspective projection with
+ * reversed, infinite depth
+ * @param view column major world to view matrix
+ * @param p00 the projection's x scale, element [0][0]
+ * @param p11 the projection's y scale, element [1][1], its sign is ignored
+ * @param znear the near plane distance
+ * @return the cull camera
+ */
+auto make_cull_view(const float (&view)[16], float p00, float p11, float znear)
+    -> CullView;
+
+/*!
+ * @brief Two phase occlusion culling against a Hi-Z pyramid. The early pass
+ * emits the objects that were visible last frame, which are drawn to build
+ * the depth buffer, the late pass tests everything against a pyramid of that
+ * depth and emits the objects the early pass missed. Both passes write one
+ * indexed indirect command per object, culled ones get zero instances, so
+ * they're drawn with a plain vkCmdDrawIndexedIndirect. Objects are read by
+ * device address, an object has to keep its index across frames for its
+ * visibility to carry over
+ */
+class OcclusionCuller {
+private:
+  VkDevice m_device = VK_NULL_HANDLE;
+  ComputePipeline m_cull;
+  HiZPyramid m_pyramid;
+  VkDescriptorPool m_pool = VK_NULL_HANDLE;
+  VkDescriptorSet m_pyramidSet = VK_NULL_HANDLE;
+  GpuBuffer m_visibility;
+  GpuBuffer m_earlyCommands;
+  GpuBuffer m_lateCommands;
+  uint32_t m_maxObjects = 0;
+  bool m_visibilityCleared = false;
+
+  auto dispatch(VkCommandBuffer commandBuffer, VkDeviceAddress objects,
+                uint32_t objectCount, const CullView &view, uint32_t phase,
+                const GpuBuffer &commands) -> void;
+
+public:
+  /*!
+   * @brief Creates the cull and downsample pipelines and the per object
+   * buffers
+   * @param device the logical device
+   * @param physicalDevice the device the buffers come from
+   * @param layoutCache the cache the pipeline layouts come from
+   * @param cullCode SPIR-V of occlusion_cull.comp
+   * @param downsampleCode SPIR-V of hiz_downsample.comp
+   * @param maxObjects the most objects a single cull can take
+   * @param framesInFlight how many frames can be recorded ahead of the GPU
+   * @return On success, returns void, on failure, returns unexpected with
+   * error message
+   */
+  auto init(VkDevice device, VkPhysicalDevice physicalDevice,
+            PipelineLayoutCache &layoutCache,
+            std::span<const std::byte> cullCode,
+            std::span<const std::byte> downsampleCode, uint32_t maxObjects,
+            uint32_t framesInFlight) -> expected<void, string>;
+  auto destroy() -> void;
+  /*!
+   * @brief Sizes the pyramid for the depth buffer, call it whenever the depth
+   * buffer is recreated, the GPU must be done with the previous frames
+   * @param depthExtent the size of the depth buffer
+   * @return On success, returns void, on failure, returns unexpected with
+   * error message
+   */
+  auto resize(VkExtent2D depthExtent) -> expected<void, string>;
+  /*!
+   * @brief Records the early pass, early_commands() can be drawn once it's
+   * done, the pass waits for the previous frame's indirect draws
+   * @param commandBuffer the command buffer being recorded
+   * @param objects device address of objectCount CullObjects
+   * @param objectCount how many objects there are
+   * @param view the camera
+   * @return On success, returns void, on failure, returns unexpected with
+   * error message
+   */
+  auto record_early(VkCommandBuffer commandBuffer, VkDeviceAddress objects,
+                    uint32_t objectCount, const CullView &view)
+      -> expected<void, string>;
+  /*!
+   * @brief Records the pyramid build and the late pass, late_commands() can
+   * be drawn once it's done. The depth of the early draws must be in
+   * SHADER_READ_ONLY_OPTIMAL with its writes made visible to compute shaders
+   * @param commandBuffer the command buffer being recorded
+   * @param frameSlot the frame in flight being recorded
+   * @param depthView a depth aspect view of the depth buffer
+   * @param objects the same objects the early pass got
+   * @param objectCount how many objects there are
+   * @param view the same camera the early pass got
+   * @return On success, returns void, on failure, returns unexpected with
+   * error message
+   */
+  auto record_late(VkCommandBuffer commandBuffer, uint32_t frameSlot,
+                   VkImageView depthView, VkDeviceAddress objects,
+                   uint32_t objectCount, const CullView &view)
+      -> expected<void, string>;
+  [[nodiscard]] auto early_commands() const -> VkBuffer {
+    return this->m_earlyCommands.buffer;
+  }
+  [[nodiscard]] auto late_commands() const -> VkBuffer {
+    return this->m_lateCommands.buffer;
+  }
+  [[nodiscard]] static constexpr auto command_stride() -> uint32_t {
+    return sizeof(VkDrawIndexedIndirectCommand);
+  }
+  [[nodiscard]] auto max_objects() const -> uint32_t {
+    return this->m_maxObjects;
+  }
+};
+} // namespace SFT::Renderer::VK
+
+#endif // OCCLUSIONCULLER_H
@@ -0,0 +1,162 @@
+//
+// Created by sturd on 10/18/2026.
+//
+
+#include "DrawList.h"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+
+namespace SFT::Renderer::VK {
+#pragma region additional functions
+namespace {
+constexpr uint32_t radixBits = 8;
+constexpr uint32_t radixBuckets = 1u << radixBits;
+constexpr uint32_t radixPasses = 64 / radixBits;
+// below this splitting the sort costs more than it saves
+constexpr size_t parallelSortThreshold = 16 * 1024;
+
+auto quantize_depth(const float depth, const uint32_t bits) -> uint64_t {
+  const float clamped = std::isnan(depth) ? 0.0f : std::clamp(depth, 0.0f, 1.0f);
+  const uint64_t max = (uint64_t{1} << bits) - 1;
+  return static_cast<uint64_t>(clamped * static_cast<float>(max) + 0.5f);
+}
+
+auto digit(const uint64_t key, const uint32_t pass) -> uint32_t {
+  return static_cast<uint32_t>(key >> (pass * radixBits)) & (radixBuckets - 1);
+}
+} // namespace
+#pragma endregion
+
+#pragma region DrawList Functions
+auto make_sort_key(const DrawItem &item) -> uint64_t {
+  assert(item.pipeline < (1u << DrawPipelineBits));
+  assert(item.material < (1u << DrawMaterialBits));
+  assert(item.mesh < (1u << DrawMeshBits));
+  const uint64_t bucket = static_cast<uint64_t>(item.bucket) << 60;
+  const uint64_t pipeline = item.pipeline & ((1u << DrawPipelineBits) - 1);
+  const uint64_t material = item.material & ((1u << DrawMaterialBits) - 1);
+  const uint64_t mesh = item.mesh & ((1u << DrawMeshBits) - 1);
+  if (item.bucket == DrawBucket::Transparent) {
+    // far to near, the state only breaks ties so 12 bits of each id will do
+    const uint64_t depth = quantize_depth(1.0f - item.depth, 24);
+    return bucket | depth << 36 | pipeline << 24 | (material & 0xfff) << 12 |
+           (mesh & 0xfff);
+  }
+  return bucket | pipeline << 48 | material << 32 | mesh << 16 |
+         quantize_depth(item.depth, DrawDepthBits);
+}
+
+auto DrawList::clear() -> void {
+  this->m_items.clear();
+  this->m_entries.clear();
+  this->m_batches.clear();
+  this->m_instances.clear();
+}
+
+auto DrawList::add(const DrawItem &item) -> void {
+  this->m_entries.push_back(
+      {make_sort_key(item), static_cast<uint32_t>(this->m_items.size())});
+  this->m_items.push_back(item);
+}
+
+auto DrawList::radix_sort(Threading::ThreadPool *pool) -> void {
+  const size_t count = this->m_entries.size();
+  this->m_scratch.resize(count);
+  // bits that are equal across every key can't change the order, scenes only
+  // use a few pipelines and buckets so the top passes are usually skipped
+  uint64_t varying = 0;
+  for (const auto &entry : this->m_entries) {
+    varying |= entry.key ^ this->m_entries.front().key;
+  }
+  const size_t chunks =
+      pool != nullptr && count >= parallelSortThreshold
+          ? static_cast<size_t>(pool->thread_count()) + 1
+          : 1;
+  const size_t chunkSize = (count + chunks - 1) / chunks;
+  this->m_histograms.resize(chunks * radixBuckets);
+
+  auto run = [pool, chunks](const auto &job) {
+    if (chunks == 1) {
+      job(0, 1);
+    } else {
+      pool->parallel_for(chunks, job);
+    }
+  };
+  for (uint32_t pass = 0; pass < radixPasses; pass++) {
+    if (digit(varying, pass) == 0) {
+      continue;
+    }
+    const Entry *source = this->m_entries.data();
+    Entry *target = this->m_scratch.data();
+    uint32_t *histograms = this->m_histograms.data();
+    run([&](const size_t begin, const size_t end) {
+      for (size_t chunk = begin; chunk < end; chunk++) {
+        uint32_t *histogram = histograms + chunk * radixBuckets;
+        std::fill_n(histogram, radixBuckets, 0u);
+        const size_t last = std::min(count, (chunk + 1) * chunkSize);
+        for (size_t i = chunk * chunkSize; i < last; i++) {
+          histogram[digit(source[i].key, pass)]++;
+        }
+      }
+    });
+    // turn the counts into where each chunk starts writing each digit, digit
+    // major and chunk minor so the sort stays stable
+    uint32_t offset = 0;
+    for (uint32_t bucket = 0; bucket < radixBuckets; bucket++) {
+      for (size_t chunk = 0; chunk < chunks; chunk++) {
+        const uint32_t bucketCount = histograms[chunk * radixBuckets + bucket];
+        histograms[chunk * radixBuckets + bucket] = offset;
+        offset += bucketCount;
+      }
+    }
+    run([&](const size_t begin, const size_t end) {
+      for (size_t chunk = begin; chunk < end; chunk++) {
+        uint32_t *histogram = histograms + chunk * radixBuckets;
+        const size_t last = std::min(count, (chunk + 1) * chunkSize);
+        for (size_t i = chunk * chunkSize; i < last; i++) {
+          target[histogram[digit(source[i].key, pass)]++] = source[i];
+        }
+      }
+    });
+    this->m_entries.swap(this->m_scratch);
+  }
+}
+
+auto DrawList::build(Threading::ThreadPool *pool) -> void {
+  this->m_batches.clear();
+  this->m_instances.clear();
+  if (this->m_entries.empty()) {
+    return;
+  }
+  this->radix_sort(pool);
+
+  this->m_instances.reserve(this->m_entries.size());
+  for (const auto &entry : this->m_entries) {
+    const DrawItem &item = this->m_items[entry.item];
+    // the ids are compared rather than the keys, transparent keys only carry
+    // part of them and depth differs between instances anyway
+    if (!this->m_batches.empty()) {
+      DrawBatch &batch = this->m_batches.back();
+      if (batch.bucket == item.bucket && batch.pipeline == item.pipeline &&
+          batch.material == item.material && batch.mesh == item.mesh) {
+        batch.instanceCount++;
+        this->m_instances.push_back(item.instance);
+        continue;
+      }
+    }
+    this->m_batches.push_back({
+        .bucket = item.bucket,
+        .pipeline = item.pipeline,
+        .material = item.material,
+        .mesh = item.mesh,
+        .firstInstance = static_cast<uint32_t>(this->m_instances.size()),
+        .instanceCount = 1,
+    });
+    this->m_instances.push_back(item.instance);
+  }
+}
+#pragma endregion
+} // namespace SFT::Renderer::VK
@@ -0,0 +1,124 @@
+//
+// Created by sturd on 10/18/2026.
+//
+
+#ifndef DRAWLIST_H
+#define DRAWLIST_H
+
+#include "Core/Threading/ThreadPool.h"
+#include <cstdint>
+#include <span>
+#include <vector>
+
+using std::vector;
+
+namespace SFT::Renderer::VK {
+/*!
+ * @brief Which group a draw is sorted into, groups render in this order
+ */
+enum class DrawBucket : uint8_t {
+  Opaque = 0,
+  AlphaTest = 1,
+  // sorted back to front before anything else, so state changes follow depth
+  Transparent = 2,
+  Overlay = 3,
+};
+
+// widths of the ids packed into a sort key, see make_sort_key
+constexpr uint32_t DrawPipelineBits = 12;
+constexpr uint32_t DrawMaterialBits = 16;
+constexpr uint32_t DrawMeshBits = 16;
+constexpr uint32_t DrawDepthBits = 16;
+
+/*!
+ * @brief One object to draw, the ids are dense indices the renderer assigns to
+ * pipelines, materials and meshes
+ */
+struct DrawItem {
+  DrawBucket bucket = DrawBucket::Opaque;
+  uint32_t pipeline = 0;
+  uint32_t material = 0;
+  uint32_t mesh = 0;
+  // view space distance, normalized to [0, 1] over the depth range
+  float depth = 0.0f;
+  // what the instance reads its per-object data from, like a transform index
+  uint32_t instance = 0;
+};
+
+/*!
+ * @brief A run of draws that share pipeline, material and mesh, drawn with one
+ * instanced call whose instances are instances()[firstInstance, +count)
+ */
+struct DrawBatch {
+  DrawBucket bucket = DrawBucket::Opaque;
+  uint32_t pipeline = 0;
+  uint32_t material = 0;
+  uint32_t mesh = 0;
+  uint32_t firstInstance = 0;
+  uint32_t instanceCount = 0;
+};
+
+/*!
+ * @brief Packs a draw into a key whose order is the submission order, from the
+ * top: 4 bits of bucket, then pipeline, material, mesh and quantized depth,
+ * so pipeline switches are the rarest and identical meshes end up next to
+ * each other front to back. Transparent draws put inverted depth right under
+ * the bucket instead, their order is what blending needs
+ * @param item the draw
+ * @return the key
+ */
+auto make_sort_key(const DrawItem &item) -> uint64_t;
+
+/*!
+ * @brief Collects a frame's draws, sorts them by key and merges them into
+ * instanced batches. The storage is kept between frames so a steady scene
+ * doesn't allocate
+ */
+class DrawList {
+private:
+  struct Entry {
+    uint64_t key;
+    uint32_t item;
+  };
+  vector<DrawItem> m_items;
+  vector<Entry> m_entries;
+  vector<Entry> m_scratch;
+  vector<DrawBatch> m_batches;
+  vector<uint32_t> m_instances;
+  // one 256 bucket histogram per chunk for the parallel sort
+  vector<uint32_t> m_histograms;
+
+  auto radix_sort(Threading::ThreadPool *pool) -> void;
+
+public:
+  /*!
+   * @brief Forgets the previous frame's draws, keeping the memory
+   */
+  auto clear() -> void;
+  auto add(const DrawItem &item) -> void;
+  /*!
+   * @brief Sorts the draws and builds the batches
+   * @param pool spreads the sort over its workers when there are enough draws
+   * to make it worth it, may be null
+   */
+  auto build(Threading::ThreadPool *pool) -> void;
+  /*!
+   * @brief The batches in submission order, valid until the next clear
+   */
+  [[nodiscard]] auto batches() const -> std::span<const DrawBatch> {
+    return this->m_batches;
+  }
+  /*!
+   * @brief DrawItem::instance of every draw in batch order, upload it as the
+   * per instance data the batches index with firstInstance
+   */
+  [[nodiscard]] auto instances() const -> std::span<const uint32_t> {
+    return this->m_instances;
+  }
+  [[nodiscard]] auto draw_count() const -> size_t {
+    return this->m_items.size();
+  }
+};
+} // namespace SFT::Renderer::VK
+
+#endif // DRAWLIST_H
@@ -0,0 +1,63 @@
+//
+// Created by sturd on 10/18/2026.
+//
+
+#include "LodSelection.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace SFT::Renderer::VK {
+#pragma region additional functions
+namespace {
+// below this a camera is inside the bounds, everything is the finest LOD
+constexpr float minLodDistance = 1e-4f;
+} // namespace
+#pragma endregion
+
+#pragma region LodSelection Functions
+auto make_lod_metric(const float p11, const float viewportHeight,
+                     const float thresholdPixels, const float fadeBand)
+    -> LodMetric {
+  LodMetric metric;
+  metric.pixelsPerUnit = viewportHeight * 0.5f * std::abs(p11);
+  metric.thresholdPixels = std::max(thresholdPixels, 1e-3f);
+  metric.fadeBand = std::clamp(fadeBand, 0.0f, 1.0f);
+  return metric;
+}
+
+auto select_lod(const std::span<const Assets::CookedMeshLod> lods,
+                const float distance, const float objectScale,
+                const LodMetric &metric) -> LodSelection {
+  LodSelection selection;
+  if (lods.size() < 2 || distance <= minLodDistance) {
+    return selection;
+  }
+  const float pixelsPerError = metric.pixelsPerUnit * objectScale / distance;
+  // errors grow along the chain, the last one under the threshold wins
+  uint32_t lod = 0;
+  for (uint32_t level = 1; level < lods.size(); level++) {
+    if (lods[level].error * pixelsPerError > metric.thresholdPixels) {
+      break;
+    }
+    lod = level;
+  }
+  selection.lod = lod;
+  selection.fadeLod = lod;
+  if (lod == 0 || metric.fadeBand <= 0.0f) {
+    return selection;
+  }
+  // close to the threshold the finer LOD fades in, so by the time this one
+  // would be too coarse the switch is already done
+  const float pixels = lods[lod].error * pixelsPerError;
+  const float fadeStart = metric.thresholdPixels * (1.0f - metric.fadeBand);
+  if (pixels > fadeStart) {
+    selection.fadeLod = lod - 1;
+    selection.fade = std::clamp((pixels - fadeStart) /
+                                    (metric.thresholdPixels - fadeStart),
+                                0.0f, 1.0f);
+  }
+  return selection;
+}
+#pragma endregion
+} // namespace SFT::Renderer::VK
@@ -0,0 +1,68 @@
+//
+// Created by sturd on 10/18/2026.
+//
+
+#ifndef LODSELECTION_H
+#define LODSELECTION_H
+
+#include "Core/Assets/CookedMesh.h"
+#include <cstdint>
+#include <span>
+
+namespace SFT::Renderer::VK {
+/*!
+ * @brief Turns world space errors into pixels for one view, made once per view
+ * with make_lod_metric
+ */
+struct LodMetric {
+  // pixels a unit long error covers at a distance of one
+  float pixelsPerUnit = 0.0f;
+  // the most pixels an LOD's error may cover
+  float thresholdPixels = 1.0f;
+  // fraction of the threshold under it where the next finer LOD fades in
+  float fadeBand = 0.0f;
+};
+
+/*!
+ * @brief The LOD an instance draws, and while it is close to switching, the
+ * LOD it fades towards
+ */
+struct LodSelection {
+  uint32_t lod = 0;
+  // the finer LOD the instance is fading to, same as lod when not fading
+  uint32_t fadeLod = 0;
+  // how far the fade is, 0 draws only lod, 1 would be only fadeLod. Draw lod
+  // with -fade and fadeLod with fade as DrawConstants::lodFade (main.frag)
+  float fade = 0.0f;
+};
+
+/*!
+ * @brief Builds the metric of a view
+ * @param p11 the projection matrix' [1][1], the cotangent of half the vertical
+ * field of view
+ * @param viewportHeight the height of the render target in pixels
+ * @param thresholdPixels the most pixels an LOD's error may cover, 1 keeps
+ * switches invisible
+ * @param fadeBand fraction of the threshold over which LODs cross-fade, 0
+ * switches without fading
+ * @return the metric
+ */
+auto make_lod_metric(float p11, float viewportHeight, float thresholdPixels,
+                     float fadeBand) -> LodMetric;
+
+/*!
+ * @brief Picks the coarsest LOD whose error projects to no more than the
+ * threshold, every (mesh, lod) pair is a mesh of its own to the DrawList so
+ * instances on the same LOD still batch together
+ * @param lods the LOD chain of the mesh, finest first, errors not decreasing
+ * @param distance view space distance from the camera to the bounding sphere,
+ * the nearest point of it is the conservative choice
+ * @param objectScale the largest scale of the instance's transform
+ * @param metric the view's metric
+ * @return the LOD to draw
+ */
+auto select_lod(std::span<const Assets::CookedMeshLod> lods, float distance,
+                float objectScale, const LodMetric &metric) -> LodSelection;
+} // namespace SFT::Renderer::VK
+
+#endif // LODSELECTION_H
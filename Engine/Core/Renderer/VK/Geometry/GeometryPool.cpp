@@ -0,0 +1,565 @@
+//
+// Created by sturd on 10/18/2026.
+//
+
+#include "GeometryPool.h"
+
+#include "Core/Renderer/VK/Memory/DeviceMemory.h"
+#include "Core/Renderer/VK/RenderGraph/Barriers.h"
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+namespace SFT::Renderer::VK {
+#pragma region additional functions
+namespace {
+// vkCmdDrawIndexed takes the vertex offset signed
+constexpr uint64_t maxElements = std::numeric_limits<int32_t>::max();
+
+/*!
+ * @brief Appends a copy, extending the previous one when both sides continue
+ * where it ended, packed meshes mostly collapse into a handful of regions
+ */
+auto add_copy(vector<VkBufferCopy> &copies, const VkDeviceSize src,
+              const VkDeviceSize dst, const VkDeviceSize size) -> void {
+  if (size == 0) {
+    return;
+  }
+  if (!copies.empty()) {
+    auto &last = copies.back();
+    if (last.srcOffset + last.size == src && last.dstOffset + last.size == dst) {
+      last.size += size;
+      return;
+    }
+  }
+  copies.push_back({src, dst, size});
+}
+
+/*!
+ * @brief The capacity to compact into, doubled until the live elements and
+ * the new ones fit
+ */
+auto grown_capacity(const uint32_t capacity, const uint64_t needed)
+    -> expected<uint32_t, string> {
+  if (needed > maxElements) {
+    return unexpected("geometry pool can't hold " + std::to_string(needed) +
+                      " elements");
+  }
+  uint64_t grown = std::max(capacity, 1u);
+  while (grown < needed) {
+    grown *= 2;
+  }
+  return static_cast<uint32_t>(std::min(grown, maxElements));
+}
+} // namespace
+#pragma endregion
+
+#pragma region FreeList Functions
+auto GeometryPool::FreeList::reset(const uint32_t newCapacity,
+                                   const uint32_t newUsed) -> void {
+  this->blocks.clear();
+  this->capacity = newCapacity;
+  this->used = newUsed;
+  if (newCapacity > newUsed) {
+    this->blocks.push_back({newUsed, newCapacity - newUsed});
+  }
+}
+
+auto GeometryPool::FreeList::allocate(const uint32_t size)
+    -> expected<uint32_t, string> {
+  // first fit, blocks are in offset order so allocations stay packed towards
+  // the start and the tail stays one big block
+  for (auto it = this->blocks.begin(); it != this->blocks.end(); ++it) {
+    if (it->size < size) {
+      continue;
+    }
+    const uint32_t offset = it->offset;
+    it->offset += size;
+    it->size -= size;
+    if (it->size == 0) {
+      this->blocks.erase(it);
+    }
+    this->used += size;
+    return offset;
+  }
+  return unexpected("no free block of " + std::to_string(size) + " elements");
+}
+
+auto GeometryPool::FreeList::free(const uint32_t offset, const uint32_t size)
+    -> void {
+  if (size == 0) {
+    return;
+  }
+  this->used -= size;
+  auto next = std::ranges::lower_bound(this->blocks, offset, {}, &Block::offset);
+  const bool joinsPrevious =
+      next != this->blocks.begin() &&
+      std::prev(next)->offset + std::prev(next)->size == offset;
+  const bool joinsNext =
+      next != this->blocks.end() && offset + size == next->offset;
+  if (joinsPrevious && joinsNext) {
+    std::prev(next)->size += size + next->size;
+    this->blocks.erase(next);
+  } else if (joinsPrevious) {
+    std::prev(next)->size += size;
+  } else if (joinsNext) {
+    next->offset = offset;
+    next->size += size;
+  } else {
+    this->blocks.insert(next, {offset, size});
+  }
+}
+#pragma endregion
+
+#pragma region GeometryPool Functions
+auto GeometryPool::create_buffers(const uint32_t vertexCapacity,
+                                  const uint32_t indexCapacity,
+                                  GpuBuffer &vertexBuffer,
+                                  GpuBuffer &indexBuffer)
+    -> expected<void, string> {
+  constexpr VkBufferUsageFlags shared =
+      VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT |
+      VK_BUFFER_USAGE_TRANSFER_DST_BIT |
+      VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT;
+  auto vertices = create_gpu_buffer(
+      this->m_device, this->m_memoryProperties,
+      static_cast<VkDeviceSize>(vertexCapacity) * this->m_vertexStride,
+      VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | shared,
+      VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+  if (!vertices.has_value()) {
+    return unexpected("failed to create geometry vertex buffer: " +
+                      vertices.error());
+  }
+  auto indices = create_gpu_buffer(
+      this->m_device, this->m_memoryProperties,
+      static_cast<VkDeviceSize>(indexCapacity) * sizeof(uint32_t),
+      VK_BUFFER_USAGE_INDEX_BUFFER_BIT | shared,
+      VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+  if (!indices.has_value()) {
+    destroy_gpu_buffer(this->m_device, vertices.value());
+    return unexpected("failed to create geometry index buffer: " +
+                      indices.error());
+  }
+  vertexBuffer = vertices.value();
+  indexBuffer = indices.value();
+  return {};
+}
+
+auto GeometryPool::retire(GpuBuffer &buffer) -> void {
+  if (buffer.buffer != VK_NULL_HANDLE) {
+    this->m_retired.push_back({this->m_frame, buffer});
+  }
+  buffer = {};
+}
+
+auto GeometryPool::compact(const uint32_t extraVertices,
+                           const uint32_t extraIndices)
+    -> expected<void, string> {
+  uint64_t liveVertices = 0;
+  uint64_t liveIndices = 0;
+  for (const auto &mesh : this->m_meshes) {
+    if (mesh.state != MeshState::Free) {
+      liveVertices += mesh.range.vertexCount;
+      liveIndices += mesh.range.indexCount;
+    }
+  }
+  auto vertexCapacity = grown_capacity(this->m_vertexFree.capacity,
+                                       liveVertices + extraVertices);
+  if (!vertexCapacity.has_value()) {
+    return unexpected(vertexCapacity.error());
+  }
+  auto indexCapacity =
+      grown_capacity(this->m_indexFree.capacity, liveIndices + extraIndices);
+  if (!indexCapacity.has_value()) {
+    return unexpected(indexCapacity.error());
+  }
+  GpuBuffer vertexBuffer;
+  GpuBuffer indexBuffer;
+  if (auto result = this->create_buffers(vertexCapacity.value(),
+                                         indexCapacity.value(), vertexBuffer,
+                                         indexBuffer);
+      !result.has_value()) {
+    return unexpected(result.error());
+  }
+
+  // meshes are copied out of the buffers the GPU last saw, buffers from an
+  // earlier compaction since the last update never received anything
+  if (this->m_moveVertex.buffer == VK_NULL_HANDLE) {
+    this->m_moveVertex = this->m_vertexBuffer;
+    this->m_moveIndex = this->m_indexBuffer;
+    this->m_vertexBuffer = {};
+    this->m_indexBuffer = {};
+  } else {
+    this->retire(this->m_vertexBuffer);
+    this->retire(this->m_indexBuffer);
+  }
+  this->m_vertexBuffer = vertexBuffer;
+  this->m_indexBuffer = indexBuffer;
+
+  uint32_t vertexCursor = 0;
+  uint32_t indexCursor = 0;
+  for (auto &mesh : this->m_meshes) {
+    if (mesh.state == MeshState::Free) {
+      continue;
+    }
+    if (mesh.state == MeshState::Resident) {
+      mesh.state = MeshState::Moving;
+      mesh.sourceVertex = static_cast<uint32_t>(mesh.range.vertexOffset);
+      mesh.sourceIndex = mesh.range.firstIndex;
+    }
+    mesh.range.vertexOffset = static_cast<int32_t>(vertexCursor);
+    mesh.range.firstIndex = indexCursor;
+    vertexCursor += mesh.range.vertexCount;
+    indexCursor += mesh.range.indexCount;
+  }
+  this->m_vertexFree.reset(vertexCapacity.value(), vertexCursor);
+  this->m_indexFree.reset(indexCapacity.value(), indexCursor);
+  // pending releases were ranges of the old buffers, the new ones don't have
+  // them
+  this->m_releases.clear();
+  this->m_compactions++;
+  return {};
+}
+
+auto GeometryPool::init(VkDevice device, VkPhysicalDevice physicalDevice,
+                        const uint32_t vertexStride,
+                        const uint32_t vertexCapacity,
+                        const uint32_t indexCapacity,
+                        const uint32_t framesInFlight)
+    -> expected<void, string> {
+  if (vertexStride == 0 || vertexCapacity == 0 || indexCapacity == 0) {
+    return unexpected("geometry pool needs a vertex stride and capacities");
+  }
+  this->m_device = device;
+  vkGetPhysicalDeviceMemoryProperties(physicalDevice,
+                                      &this->m_memoryProperties);
+  this->m_vertexStride = vertexStride;
+  this->m_framesInFlight = std::max(1u, framesInFlight);
+  const auto vertexElements = static_cast<uint32_t>(
+      std::min<uint64_t>(vertexCapacity, maxElements));
+  const auto indexElements = static_cast<uint32_t>(
+      std::min<uint64_t>(indexCapacity, maxElements));
+  if (auto result = this->create_buffers(vertexElements, indexElements,
+                                         this->m_vertexBuffer,
+                                         this->m_indexBuffer);
+      !result.has_value()) {
+    return unexpected(result.error());
+  }
+  this->m_vertexFree.reset(vertexElements, 0);
+  this->m_indexFree.reset(indexElements, 0);
+  for (uint32_t i = 0; i < this->m_framesInFlight; i++) {
+    auto staging = create_gpu_buffer(
+        device, this->m_memoryProperties, StagingSize,
+        VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
+            VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+        DeviceMemoryCategory::Staging);
+    if (!staging.has_value()) {
+      return unexpected("failed to create geometry staging buffer: " +
+                        staging.error());
+    }
+    this->m_staging.push_back(staging.value());
+  }
+  return {};
+}
+
+auto GeometryPool::destroy() -> void {
+  if (this->m_device == VK_NULL_HANDLE) {
+    return;
+  }
+  for (auto &retired : this->m_retired) {
+    destroy_gpu_buffer(this->m_device, retired.buffer);
+  }
+  for (auto &staging : this->m_staging) {
+    destroy_gpu_buffer(this->m_device, staging);
+  }
+  destroy_gpu_buffer(this->m_device, this->m_moveVertex);
+  destroy_gpu_buffer(this->m_device, this->m_moveIndex);
+  destroy_gpu_buffer(this->m_device, this->m_vertexBuffer);
+  destroy_gpu_buffer(this->m_device, this->m_indexBuffer);
+  this->m_retired.clear();
+  this->m_staging.clear();
+  this->m_meshes.clear();
+  this->m_freeHandles.clear();
+  this->m_uploads.clear();
+  this->m_releases.clear();
+  this->m_vertexFree = {};
+  this->m_indexFree = {};
+  this->m_device = VK_NULL_HANDLE;
+}
+
+auto GeometryPool::add_mesh(const std::span<const std::byte> vertices,
+                            const std::span<const uint32_t> indices)
+    -> expected<MeshHandle, string> {
+  if (this->m_staging.empty()) {
+    return unexpected("geometry pool is not initialized");
+  }
+  if (vertices.empty() || indices.empty() ||
+      vertices.size() % this->m_vertexStride != 0) {
+    return unexpected("mesh data doesn't match the pool's vertex stride");
+  }
+  if (vertices.size() + indices.size_bytes() + 16 > StagingSize) {
+    return unexpected("mesh of " +
+                      std::to_string(vertices.size() + indices.size_bytes()) +
+                      " bytes doesn't fit the geometry staging buffer");
+  }
+  const auto vertexCount =
+      static_cast<uint32_t>(vertices.size() / this->m_vertexStride);
+  const auto indexCount = static_cast<uint32_t>(indices.size());
+  if (std::ranges::any_of(indices, [vertexCount](const uint32_t index) {
+        return index >= vertexCount;
+      })) {
+    return unexpected("mesh indexes past its " + std::to_string(vertexCount) +
+                      " vertices");
+  }
+
+  auto vertexOffset = this->m_vertexFree.allocate(vertexCount);
+  auto firstIndex = this->m_indexFree.allocate(indexCount);
+  if (!vertexOffset.has_value() || !firstIndex.has_value()) {
+    if (vertexOffset.has_value()) {
+      this->m_vertexFree.free(vertexOffset.value(), vertexCount);
+    }
+    if (firstIndex.has_value()) {
+      this->m_indexFree.free(firstIndex.value(), indexCount);
+    }
+    if (auto result = this->compact(vertexCount, indexCount);
+        !result.has_value()) {
+      return unexpected(result.error());
+    }
+    // compaction leaves one free block at the end with room for both
+    vertexOffset = this->m_vertexFree.allocate(vertexCount);
+    firstIndex = this->m_indexFree.allocate(indexCount);
+  }
+
+  uint32_t index;
+  if (!this->m_freeHandles.empty()) {
+    index = this->m_freeHandles.back();
+    this->m_freeHandles.pop_back();
+  } else {
+    index = static_cast<uint32_t>(this->m_meshes.size());
+    this->m_meshes.emplace_back();
+  }
+  auto &mesh = this->m_meshes[index];
+  mesh.range.vertexOffset = static_cast<int32_t>(vertexOffset.value());
+  mesh.range.vertexCount = vertexCount;
+  mesh.range.firstIndex = firstIndex.value();
+  mesh.range.indexCount = indexCount;
+  mesh.state = MeshState::Uploading;
+  this->m_uploads.push_back({index, {vertices.begin(), vertices.end()},
+                             {indices.begin(), indices.end()}});
+  return MeshHandle{index};
+}
+
+auto GeometryPool::remove_mesh(const MeshHandle mesh) -> void {
+  if (!mesh.valid() || mesh.index >= this->m_meshes.size() ||
+      this->m_meshes[mesh.index].state == MeshState::Free) {
+    return;
+  }
+  auto &entry = this->m_meshes[mesh.index];
+  if (entry.state == MeshState::Uploading) {
+    std::erase_if(this->m_uploads, [&mesh](const Upload &upload) {
+      return upload.mesh == mesh.index;
+    });
+  }
+  // the ranges may still be read by frames in flight even if this mesh never
+  // made it in, a removed mesh's ranges are handed out only after they finish
+  this->m_releases.push_back(
+      {this->m_frame,
+       {static_cast<uint32_t>(entry.range.vertexOffset),
+        entry.range.vertexCount},
+       {entry.range.firstIndex, entry.range.indexCount}});
+  entry = {};
+  this->m_freeHandles.push_back(mesh.index);
+}
+
+auto GeometryPool::defragment() -> expected<void, string> {
+  if (this->m_staging.empty()) {
+    return unexpected("geometry pool is not initialized");
+  }
+  const auto packed = [](const FreeList &list) {
+    return list.blocks.empty() ||
+           (list.blocks.size() == 1 &&
+            list.blocks.front().offset + list.blocks.front().size ==
+                list.capacity);
+  };
+  if (packed(this->m_vertexFree) && packed(this->m_indexFree) &&
+      this->m_releases.empty()) {
+    return {};
+  }
+  return this->compact(0, 0);
+}
+
+auto GeometryPool::update(VkCommandBuffer commandBuffer,
+                          const uint32_t frameSlot) -> expected<void, string> {
+  if (this->m_staging.empty()) {
+    return unexpected("geometry pool is not initialized");
+  }
+  // everything retired before the oldest frame still in flight is unused
+  std::erase_if(this->m_retired, [this](Retired &retired) {
+    if (retired.frame + this->m_framesInFlight > this->m_frame) {
+      return false;
+    }
+    destroy_gpu_buffer(this->m_device, retired.buffer);
+    return true;
+  });
+  std::erase_if(this->m_releases, [this](const Release &release) {
+    if (release.frame + this->m_framesInFlight > this->m_frame) {
+      return false;
+    }
+    this->m_vertexFree.free(release.vertices.offset, release.vertices.size);
+    this->m_indexFree.free(release.indices.offset, release.indices.size);
+    return true;
+  });
+
+  bool copied = false;
+  const VkDeviceSize stride = this->m_vertexStride;
+  if (this->m_moveVertex.buffer != VK_NULL_HANDLE) {
+    vector<VkBufferCopy> vertexCopies;
+    vector<VkBufferCopy> indexCopies;
+    for (auto &mesh : this->m_meshes) {
+      if (mesh.state != MeshState::Moving) {
+        continue;
+      }
+      add_copy(vertexCopies, mesh.sourceVertex * stride,
+               static_cast<VkDeviceSize>(mesh.range.vertexOffset) * stride,
+               mesh.range.vertexCount * stride);
+      add_copy(indexCopies, mesh.sourceIndex * sizeof(uint32_t),
+               mesh.range.firstIndex * sizeof(uint32_t),
+               mesh.range.indexCount * sizeof(uint32_t));
+      mesh.state = MeshState::Resident;
+    }
+    if (!vertexCopies.empty()) {
+      vkCmdCopyBuffer(commandBuffer, this->m_moveVertex.buffer,
+                      this->m_vertexBuffer.buffer,
+                      static_cast<uint32_t>(vertexCopies.size()),
+                      vertexCopies.data());
+      vkCmdCopyBuffer(commandBuffer, this->m_moveIndex.buffer,
+                      this->m_indexBuffer.buffer,
+                      static_cast<uint32_t>(indexCopies.size()),
+                      indexCopies.data());
+      copied = true;
+    }
+    this->retire(this->m_moveVertex);
+    this->retire(this->m_moveIndex);
+  }
+
+  auto &staging = this->m_staging[frameSlot % this->m_staging.size()];
+  VkDeviceSize used = 0;
+  vector<VkBufferCopy> vertexCopies;
+  vector<VkBufferCopy> indexCopies;
+  size_t uploaded = 0;
+  for (; uploaded < this->m_uploads.size(); uploaded++) {
+    const auto &upload = this->m_uploads[uploaded];
+    const VkDeviceSize indexStart =
+        (used + upload.vertices.size() + 15) & ~VkDeviceSize{15};
+    const VkDeviceSize end =
+        indexStart + upload.indices.size() * sizeof(uint32_t);
+    if (end > StagingSize) {
+      // out of staging space for this frame, the rest goes next frame
+      break;
+    }
+    auto &mesh = this->m_meshes[upload.mesh];
+    std::memcpy(staging.mapped + used, upload.vertices.data(),
+                upload.vertices.size());
+    std::memcpy(staging.mapped + indexStart, upload.indices.data(),
+                upload.indices.size() * sizeof(uint32_t));
+    vertexCopies.push_back(
+        {used, static_cast<VkDeviceSize>(mesh.range.vertexOffset) * stride,
+         upload.vertices.size()});
+    indexCopies.push_back({indexStart,
+                           mesh.range.firstIndex * sizeof(uint32_t),
+                           upload.indices.size() * sizeof(uint32_t)});
+    mesh.state = MeshState::Resident;
+    used = (end + 15) & ~VkDeviceSize{15};
+  }
+  this->m_uploads.erase(this->m_uploads.begin(),
+                        this->m_uploads.begin() +
+                            static_cast<std::ptrdiff_t>(uploaded));
+  if (!vertexCopies.empty()) {
+    vkCmdCopyBuffer(commandBuffer, staging.buffer, this->m_vertexBuffer.buffer,
+                    static_cast<uint32_t>(vertexCopies.size()),
+                    vertexCopies.data());
+    vkCmdCopyBuffer(commandBuffer, staging.buffer, this->m_indexBuffer.buffer,
+                    static_cast<uint32_t>(indexCopies.size()),
+                    indexCopies.data());
+    copied = true;
+  }
+  if (copied) {
+    // the next update's copies count too, a compaction reads these buffers
+    // back as its move source and later uploads write them again
+    memory_barrier(commandBuffer, VK_PIPELINE_STAGE_2_TRANSFER_BIT,
+                   VK_ACCESS_2_TRANSFER_WRITE_BIT,
+                   VK_PIPELINE_STAGE_2_VERTEX_ATTRIBUTE_INPUT_BIT |
+                       VK_PIPELINE_STAGE_2_INDEX_INPUT_BIT |
+                       VK_PIPELINE_STAGE_2_VERTEX_SHADER_BIT |
+                       VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT |
+                       VK_PIPELINE_STAGE_2_TRANSFER_BIT,
+                   VK_ACCESS_2_VERTEX_ATTRIBUTE_READ_BIT |
+                       VK_ACCESS_2_INDEX_READ_BIT |
+                       VK_ACCESS_2_SHADER_STORAGE_READ_BIT |
+                       VK_ACCESS_2_TRANSFER_READ_BIT |
+                       VK_ACCESS_2_TRANSFER_WRITE_BIT);
+  }
+  this->m_frame++;
+  return {};
+}
+
+auto GeometryPool::bind(VkCommandBuffer commandBuffer) const -> void {
+  if (this->m_vertexBuffer.buffer == VK_NULL_HANDLE) {
+    return;
+  }
+  constexpr VkDeviceSize offset = 0;
+  vkCmdBindVertexBuffers(commandBuffer, 0, 1, &this->m_vertexBuffer.buffer,
+                         &offset);
+  vkCmdBindIndexBuffer(commandBuffer, this->m_indexBuffer.buffer, 0,
+                       VK_INDEX_TYPE_UINT32);
+}
+
+auto GeometryPool::range(const MeshHandle mesh) const -> MeshRange {
+  if (!mesh.valid() || mesh.index >= this->m_meshes.size()) {
+    return {};
+  }
+  return this->m_meshes[mesh.index].range;
+}
+
+auto GeometryPool::is_ready(const MeshHandle mesh) const -> bool {
+  if (!mesh.valid() || mesh.index >= this->m_meshes.size()) {
+    return false;
+  }
+  return this->m_meshes[mesh.index].state == MeshState::Resident;
+}
+
+auto GeometryPool::draw_command(const MeshHandle mesh,
+                                const uint32_t instanceCount,
+                                const uint32_t firstInstance) const
+    -> VkDrawIndexedIndirectCommand {
+  VkDrawIndexedIndirectCommand command{};
+  if (!this->is_ready(mesh)) {
+    return command;
+  }
+  const MeshRange &range = this->m_meshes[mesh.index].range;
+  command.indexCount = range.indexCount;
+  command.instanceCount = instanceCount;
+  command.firstIndex = range.firstIndex;
+  command.vertexOffset = range.vertexOffset;
+  command.firstInstance = firstInstance;
+  return command;
+}
+
+auto GeometryPool::stats() const -> GeometryPoolStats {
+  GeometryPoolStats stats;
+  stats.meshes = static_cast<uint32_t>(this->m_meshes.size() -
+                                       this->m_freeHandles.size());
+  stats.vertexCapacity = this->m_vertexFree.capacity;
+  stats.verticesUsed = this->m_vertexFree.used;
+  stats.indexCapacity = this->m_indexFree.capacity;
+  stats.indicesUsed = this->m_indexFree.used;
+  stats.vertexFreeBlocks =
+      static_cast<uint32_t>(this->m_vertexFree.blocks.size());
+  stats.indexFreeBlocks = static_cast<uint32_t>(this->m_indexFree.blocks.size());
+  stats.pendingUploads = static_cast<uint32_t>(this->m_uploads.size());
+  stats.compactions = this->m_compactions;
+  return stats;
+}
+#pragma endregion
+} // namespace SFT::Renderer::VK
@@ -0,0 +1,247 @@
+//
+// Created by sturd on 10/18/2026.
+//
+
+#ifndef GEOMETRYPOOL_H
+#define GEOMETRYPOOL_H
+
+#include "Core/Renderer/VK/Memory/GpuBuffer.h"
+#include "Core/Renderer/VK/VulkanDispatch.h"
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <span>
+#include <string>
+#include <vector>
+
+using std::expected;
+using std::string;
+using std::unexpected;
+using std::vector;
+
+namespace SFT::Renderer::VK {
+struct MeshHandle {
+  uint32_t index = UINT32_MAX;
+
+  [[nodiscard]] auto valid() const -> bool { return index != UINT32_MAX; }
+};
+
+/*!
+ * @brief Where a mesh lives in the pool's buffers, the values vkCmdDrawIndexed
+ * takes, indices are relative to the mesh's first vertex
+ */
+struct MeshRange {
+  int32_t vertexOffset = 0;
+  uint32_t vertexCount = 0;
+  uint32_t firstIndex = 0;
+  uint32_t indexCount = 0;
+};
+
+struct GeometryPoolStats {
+  uint32_t meshes = 0;
+  uint32_t vertexCapacity = 0;
+  uint32_t verticesUsed = 0;
+  uint32_t indexCapacity = 0;
+  uint32_t indicesUsed = 0;
+  // holes in the free lists, one means no fragmentation
+  uint32_t vertexFreeBlocks = 0;
+  uint32_t indexFreeBlocks = 0;
+  uint32_t pendingUploads = 0;
+  uint64_t compactions = 0;
+};
+
+/*!
+ * @brief One vertex buffer and one index buffer every mesh is sub-allocated
+ * from, so a whole scene draws with a single binding and indirect commands
+ * can cover any mesh. Ranges come from first-fit free lists that merge
+ * neighbours on free, when an allocation doesn't fit the live meshes are
+ * packed into fresh buffers, grown if they have to be, and the old ones are
+ * retired once the frames in flight are done with them
+ */
+class GeometryPool {
+private:
+  struct Block {
+    uint32_t offset = 0;
+    uint32_t size = 0;
+  };
+  /*!
+   * @brief Free ranges of one buffer in elements, sorted by offset with no
+   * two blocks touching
+   */
+  struct FreeList {
+    vector<Block> blocks;
+    uint32_t capacity = 0;
+    uint32_t used = 0;
+
+    auto reset(uint32_t newCapacity, uint32_t newUsed) -> void;
+    auto allocate(uint32_t size) -> expected<uint32_t, string>;
+    auto free(uint32_t offset, uint32_t size) -> void;
+  };
+  enum class MeshState : uint8_t {
+    Free,
+    // data is in the current buffers
+    Resident,
+    // data is waiting in m_uploads
+    Uploading,
+    // data is in m_moveVertex and m_moveIndex at the source offsets, copied
+    // over by the next update
+    Moving,
+  };
+  struct Mesh {
+    MeshRange range{};
+    MeshState state = MeshState::Free;
+    uint32_t sourceVertex = 0;
+    uint32_t sourceIndex = 0;
+  };
+  struct Upload {
+    uint32_t mesh = 0;
+    vector<std::byte> vertices;
+    vector<uint32_t> indices;
+  };
+  struct Release {
+    uint64_t frame = 0;
+    Block vertices{};
+    Block indices{};
+  };
+  struct Retired {
+    uint64_t frame = 0;
+    GpuBuffer buffer{};
+  };
+
+  VkDevice m_device = VK_NULL_HANDLE;
+  VkPhysicalDeviceMemoryProperties m_memoryProperties{};
+  uint32_t m_vertexStride = 0;
+  uint32_t m_framesInFlight = 1;
+  GpuBuffer m_vertexBuffer{};
+  GpuBuffer m_indexBuffer{};
+  FreeList m_vertexFree;
+  FreeList m_indexFree;
+  vector<Mesh> m_meshes;
+  vector<uint32_t> m_freeHandles;
+  vector<Upload> m_uploads;
+  vector<Release> m_releases;
+  vector<GpuBuffer> m_staging;
+  // the buffers moving meshes are copied out of, set between a compaction
+  // and the next update
+  GpuBuffer m_moveVertex{};
+  GpuBuffer m_moveIndex{};
+  vector<Retired> m_retired;
+  uint64_t m_frame = 0;
+  uint64_t m_compactions = 0;
+
+  auto create_buffers(uint32_t vertexCapacity, uint32_t indexCapacity,
+                      GpuBuffer &vertexBuffer, GpuBuffer &indexBuffer)
+      -> expected<void, string>;
+  auto retire(GpuBuffer &buffer) -> void;
+  auto compact(uint32_t extraVertices, uint32_t extraIndices)
+      -> expected<void, string>;
+
+public:
+  static constexpr VkDeviceSize StagingSize = 16ull * 1024 * 1024;
+
+  GeometryPool() = default;
+  ~GeometryPool() = default;
+  GeometryPool(const GeometryPool &) = delete;
+  auto operator=(const GeometryPool &) -> GeometryPool & = delete;
+
+  /*!
+   * @brief Creates the vertex and index buffers and one staging buffer per
+   * frame in flight
+   * @param device the logical device
+   * @param physicalDevice the device memory types come from
+   * @param vertexStride the size of one vertex, every mesh shares the layout
+   * @param vertexCapacity how many vertices fit before the pool has to grow
+   * @param indexCapacity how many 32 bit indices fit before the pool has to
+   * grow
+   * @param framesInFlight how many frames the CPU records ahead of the GPU
+   * @return On success, returns void, on failure, returns unexpected with
+   * error message
+   */
+  auto init(VkDevice device, VkPhysicalDevice physicalDevice,
+            uint32_t vertexStride, uint32_t vertexCapacity,
+            uint32_t indexCapacity, uint32_t framesInFlight)
+      -> expected<void, string>;
+  /*!
+   * @brief Destroys every buffer, the GPU must be idle
+   */
+  auto destroy() -> void;
+  /*!
+   * @brief Reserves ranges for a mesh and queues its data for upload, a
+   * cooked mesh goes in whole with the indices of every LOD, its LOD ranges
+   * are then relative to range().firstIndex. May compact the pool, which
+   * changes buffers and the ranges of other meshes and leaves every mesh
+   * unready until the next update, so call it before update in a frame
+   * @param vertices the vertex data, a multiple of the vertex stride
+   * @param indices the indices, relative to the mesh's first vertex
+   * @return On success, returns the handle of the mesh, on failure, returns
+   * unexpected with error message
+   */
+  auto add_mesh(std::span<const std::byte> vertices,
+                std::span<const uint32_t> indices)
+      -> expected<MeshHandle, string>;
+  /*!
+   * @brief Gives a mesh's ranges back, they are reused once the frames in
+   * flight that may still draw the mesh are done
+   */
+  auto remove_mesh(MeshHandle mesh) -> void;
+  /*!
+   * @brief Packs every mesh to the start of the buffers so the free space is
+   * one block, the copies happen in the next update and no mesh is ready
+   * until then, so call it before update in a frame
+   * @return On success, returns void, on failure, returns unexpected with
+   * error message and the pool is unchanged
+   */
+  auto defragment() -> expected<void, string>;
+  /*!
+   * @brief Records the copies of compactions and the uploads of new meshes,
+   * and frees what the finished frames no longer use. Call it before
+   * anything of the frame binds the pool, the GPU must be done with the
+   * previous frame that used the slot
+   * @param commandBuffer the command buffer copies are recorded to, it must
+   * execute before the frame's draws
+   * @param frameSlot the frame in flight being recorded
+   * @return On success, returns void, on failure, returns unexpected with
+   * error message
+   */
+  auto update(VkCommandBuffer commandBuffer, uint32_t frameSlot)
+      -> expected<void, string>;
+  /*!
+   * @brief Binds the vertex buffer to binding 0 and the index buffer, once
+   * for every mesh of the pool
+   */
+  auto bind(VkCommandBuffer commandBuffer) const -> void;
+  /*!
+   * @brief Gets where a mesh is, it changes when the pool compacts so it must
+   * be fetched after update every frame
+   */
+  [[nodiscard]] auto range(MeshHandle mesh) const -> MeshRange;
+  /*!
+   * @brief Whether a mesh's data has been uploaded by an update, false for
+   * every mesh between a compaction and the update that records its copies
+   */
+  [[nodiscard]] auto is_ready(MeshHandle mesh) const -> bool;
+  /*!
+   * @brief Builds the indirect command that draws a mesh
+   * @param mesh the mesh
+   * @param instanceCount how many instances to draw
+   * @param firstInstance the first instance index
+   * @return the command, drawing nothing for meshes that aren't ready
+   */
+  [[nodiscard]] auto draw_command(MeshHandle mesh, uint32_t instanceCount,
+                                  uint32_t firstInstance) const
+      -> VkDrawIndexedIndirectCommand;
+  /*!
+   * @brief The address of vertex 0, for shaders that fetch vertices through a
+   * buffer_reference instead of vertex input
+   */
+  [[nodiscard]] auto vertex_address() const -> VkDeviceAddress {
+    return this->m_vertexBuffer.address;
+  }
+  [[nodiscard]] auto index_address() const -> VkDeviceAddress {
+    return this->m_indexBuffer.address;
+  }
+  [[nodiscard]] auto stats() const -> GeometryPoolStats;
+};
+} // namespace SFT::Renderer::VK
+
+#endif // GEOMETRYPOOL_H
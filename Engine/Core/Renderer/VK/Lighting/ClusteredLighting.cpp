@@ -0,0 +1,229 @@
+//
+// Created by sturd on 10/18/2026.
+//
+
+#include "ClusteredLighting.h"
+
+#include "Core/Renderer/VK/RenderGraph/Barriers.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace SFT::Renderer::VK {
+#pragma region additional functions
+namespace {
+constexpr uint32_t groupSize = 64;
+constexpr uint32_t phaseTransform = 0;
+constexpr uint32_t phaseBin = 1;
+
+// mirrors the ClusterFrame block of light_cluster.comp and main.frag
+struct ClusterFrame {
+  float view[16];
+  float projection[4];
+  uint32_t grid[4];
+  // width, height, slice scale and slice bias
+  float screen[4];
+  VkDeviceAddress lights;
+  VkDeviceAddress viewLights;
+  VkDeviceAddress clusterGrid;
+  VkDeviceAddress lightIndices;
+  uint32_t indexCapacity;
+  uint32_t padding[3];
+};
+// the lights follow the block in the same buffer
+constexpr VkDeviceSize lightsOffset = 256;
+static_assert(sizeof(ClusterFrame) <= lightsOffset);
+
+// mirrors the push constant block of light_cluster.comp
+struct BinConstants {
+  VkDeviceAddress frame;
+  uint32_t phase;
+  uint32_t padding;
+};
+
+// the grid buffer starts with the index list's fill level
+constexpr VkDeviceSize gridHeaderSize = 16;
+} // namespace
+#pragma endregion
+
+#pragma region ClusteredLighting Functions
+auto ClusteredLighting::init(VkDevice device, VkPhysicalDevice physicalDevice,
+                             PipelineLayoutCache &layoutCache,
+                             const std::span<const std::byte> binCode,
+                             const uint32_t maxLights,
+                             const uint32_t averageLightsPerCluster,
+                             const uint32_t framesInFlight)
+    -> expected<void, string> {
+  this->m_device = device;
+  this->m_maxLights = maxLights;
+  this->m_indexCapacity = clusterCount * averageLightsPerCluster;
+  auto pipeline = create_compute_pipeline(device, layoutCache, binCode);
+  if (!pipeline.has_value()) {
+    return unexpected("light binning: " + pipeline.error());
+  }
+  this->m_bin = std::move(pipeline.value());
+
+  VkPhysicalDeviceMemoryProperties memoryProperties;
+  vkGetPhysicalDeviceMemoryProperties(physicalDevice, &memoryProperties);
+  const VkDeviceSize lightBytes =
+      static_cast<VkDeviceSize>(maxLights) * sizeof(PointLight);
+  this->m_frames.resize(framesInFlight);
+  this->m_lightCounts.assign(framesInFlight, 0);
+  for (auto &frame : this->m_frames) {
+    auto buffer = create_gpu_buffer(
+        device, memoryProperties, lightsOffset + lightBytes,
+        VK_BUFFER_USAGE_STORAGE_BUFFER_BIT |
+            VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT,
+        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
+            VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+        DeviceMemoryCategory::Uniforms);
+    if (!buffer.has_value()) {
+      return unexpected(buffer.error());
+    }
+    frame = buffer.value();
+  }
+  const struct {
+    GpuBuffer *buffer;
+    VkDeviceSize size;
+  } buffers[] = {
+      // at least one light so the buffer is never empty
+      {&this->m_viewLights,
+       std::max<VkDeviceSize>(lightBytes, sizeof(PointLight))},
+      {&this->m_grid, gridHeaderSize + clusterCount * 2 * sizeof(uint32_t)},
+      {&this->m_indices,
+       std::max<VkDeviceSize>(this->m_indexCapacity, 1) * sizeof(uint32_t)},
+  };
+  for (const auto &[buffer, size] : buffers) {
+    auto created = create_gpu_buffer(
+        device, memoryProperties, size,
+        VK_BUFFER_USAGE_STORAGE_BUFFER_BIT |
+            VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT,
+        VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+    if (!created.has_value()) {
+      return unexpected(created.error());
+    }
+    *buffer = created.value();
+  }
+  return {};
+}
+
+auto ClusteredLighting::destroy() -> void {
+  for (auto &frame : this->m_frames) {
+    destroy_gpu_buffer(this->m_device, frame);
+  }
+  this->m_frames.clear();
+  this->m_lightCounts.clear();
+  destroy_gpu_buffer(this->m_device, this->m_viewLights);
+  destroy_gpu_buffer(this->m_device, this->m_grid);
+  destroy_gpu_buffer(this->m_device, this->m_indices);
+  destroy_compute_pipeline(this->m_device, this->m_bin);
+  this->m_maxLights = 0;
+}
+
+auto ClusteredLighting::set_lights(const uint32_t frameSlot,
+                                   const std::span<const PointLight> lights)
+    -> expected<void, string> {
+  if (frameSlot >= this->m_frames.size()) {
+    return unexpected("clustered lighting has no frame slot " +
+                      std::to_string(frameSlot));
+  }
+  if (lights.size() > this->m_maxLights) {
+    return unexpected("clustered lighting got " +
+                      std::to_string(lights.size()) +
+                      " lights, it was created for " +
+                      std::to_string(this->m_maxLights));
+  }
+  if (!lights.empty()) {
+    std::memcpy(this->m_frames[frameSlot].mapped + lightsOffset,
+                lights.data(), lights.size_bytes());
+  }
+  this->m_lightCounts[frameSlot] = static_cast<uint32_t>(lights.size());
+  return {};
+}
+
+auto ClusteredLighting::record_binning(VkCommandBuffer commandBuffer,
+                                       const uint32_t frameSlot,
+                                       const ClusterView &view,
+                                       const VkExtent2D screen)
+    -> expected<void, string> {
+  if (frameSlot >= this->m_frames.size()) {
+    return unexpected("clustered lighting has no frame slot " +
+                      std::to_string(frameSlot));
+  }
+  if (view.znear <= 0.0f || view.zfar <= view.znear) {
+    return unexpected("clustered lighting needs 0 < znear < zfar");
+  }
+  const GpuBuffer &buffer = this->m_frames[frameSlot];
+  const uint32_t lightCount = this->m_lightCounts[frameSlot];
+
+  ClusterFrame frame{};
+  std::memcpy(frame.view, view.view, sizeof(frame.view));
+  frame.projection[0] = view.p00;
+  frame.projection[1] = view.p11;
+  frame.projection[2] = view.znear;
+  frame.projection[3] = view.zfar;
+  frame.grid[0] = gridX;
+  frame.grid[1] = gridY;
+  frame.grid[2] = gridZ;
+  frame.grid[3] = lightCount;
+  frame.screen[0] = static_cast<float>(screen.width);
+  frame.screen[1] = static_cast<float>(screen.height);
+  // slice = log(depth) * scale + bias puts znear at 0 and zfar at gridZ
+  const float logRange = std::log(view.zfar / view.znear);
+  frame.screen[2] = static_cast<float>(gridZ) / logRange;
+  frame.screen[3] =
+      -static_cast<float>(gridZ) * std::log(view.znear) / logRange;
+  frame.lights = buffer.address + lightsOffset;
+  frame.viewLights = this->m_viewLights.address;
+  frame.clusterGrid = this->m_grid.address;
+  frame.lightIndices = this->m_indices.address;
+  frame.indexCapacity = this->m_indexCapacity;
+  std::memcpy(buffer.mapped, &frame, sizeof(frame));
+
+  // the previous frame's shading still reads the lists this rebuilds
+  memory_barrier(commandBuffer,
+                 VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT |
+                     VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+                 VK_ACCESS_2_SHADER_STORAGE_READ_BIT |
+                     VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT,
+                 VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+                 VK_ACCESS_2_SHADER_STORAGE_READ_BIT |
+                     VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT);
+  vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE,
+                    this->m_bin.pipeline);
+  BinConstants constants{};
+  constants.frame = buffer.address;
+  constants.phase = phaseTransform;
+  vkCmdPushConstants(commandBuffer, this->m_bin.layout,
+                     VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(constants),
+                     &constants);
+  // at least one group, it also resets the index list
+  vkCmdDispatch(commandBuffer,
+                std::max(1u, (lightCount + groupSize - 1) / groupSize), 1, 1);
+  memory_barrier(commandBuffer, VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+                 VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT,
+                 VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+                 VK_ACCESS_2_SHADER_STORAGE_READ_BIT |
+                     VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT);
+  constants.phase = phaseBin;
+  vkCmdPushConstants(commandBuffer, this->m_bin.layout,
+                     VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(constants),
+                     &constants);
+  vkCmdDispatch(commandBuffer, (clusterCount + groupSize - 1) / groupSize, 1,
+                1);
+  memory_barrier(commandBuffer, VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+                 VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT,
+                 VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT,
+                 VK_ACCESS_2_SHADER_STORAGE_READ_BIT);
+  return {};
+}
+
+auto ClusteredLighting::frame_address(const uint32_t frameSlot) const
+    -> VkDeviceAddress {
+  if (frameSlot >= this->m_frames.size()) {
+    return 0;
+  }
+  return this->m_frames[frameSlot].address;
+}
+#pragma endregion
+} // namespace SFT::Renderer::VK
@@ -0,0 +1,141 @@
+//
+// Created by sturd on 10/18/2026.
+//
+
+#ifndef CLUSTEREDLIGHTING_H
+#define CLUSTEREDLIGHTING_H
+
+#include "../Memory/GpuBuffer.h"
+#include "../Pipeline/ComputePipeline.h"
+#include "../Pipeline/PipelineLayoutCache.h"
+#include "Core/Renderer/VK/VulkanDispatch.h"
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <span>
+#include <string>
+#include <vector>
+
+using std::expected;
+using std::string;
+using std::unexpected;
+using std::vector;
+
+namespace SFT::Renderer::VK {
+/*!
+ * @brief One point light, mirrors PointLight in light_cluster.comp
+ */
+struct PointLight {
+  // world space
+  float position[3];
+  // the light reaches exactly zero here
+  float radius;
+  // linear RGB
+  float color[3];
+  float intensity;
+};
+static_assert(sizeof(PointLight) == 32);
+
+/*!
+ * @brief The camera as the light binning wants it
+ */
+struct ClusterView {
+  // column major world to view matrix, the view looks down -Z
+  float view[16];
+  // the projection's x and y scale, elements [0][0] and [1][1], p11 keeps
+  // its sign so a flipped Y projection bins the right tiles
+  float p00;
+  float p11;
+  float znear;
+  // where the last depth slice ends, anything further shares that slice
+  float zfar;
+};
+
+/*!
+ * @brief Clustered forward lighting. The view frustum is split into screen
+ * tiles and exponentially spaced depth slices, a compute pass bins the lights
+ * into those clusters and writes one compact index list with an offset and
+ * count per cluster, so the forward shader only visits the lights that can
+ * reach its pixel. Everything the shaders need is in one per frame block,
+ * frame_address() goes in the draw's push constants next to its constants
+ */
+class ClusteredLighting {
+private:
+  VkDevice m_device = VK_NULL_HANDLE;
+  ComputePipeline m_bin;
+  // one per frame in flight, the ClusterFrame block followed by the lights
+  // in world space, host visible so set_lights writes straight into it
+  vector<GpuBuffer> m_frames;
+  vector<uint32_t> m_lightCounts;
+  GpuBuffer m_viewLights;
+  GpuBuffer m_grid;
+  GpuBuffer m_indices;
+  uint32_t m_maxLights = 0;
+  uint32_t m_indexCapacity = 0;
+
+public:
+  // tiles across and down the screen and depth slices
+  static constexpr uint32_t gridX = 16;
+  static constexpr uint32_t gridY = 9;
+  static constexpr uint32_t gridZ = 24;
+  static constexpr uint32_t clusterCount = gridX * gridY * gridZ;
+
+  /*!
+   * @brief Creates the binning pipeline and the light, grid and index
+   * buffers
+   * @param device the logical device
+   * @param physicalDevice the device the buffers come from
+   * @param layoutCache the cache the pipeline layout comes from
+   * @param binCode SPIR-V of light_cluster.comp
+   * @param maxLights the most lights a frame can have
+   * @param averageLightsPerCluster sizes the shared index list, clusters
+   * past its end get no lights
+   * @param framesInFlight how many frames can be recorded ahead of the GPU
+   * @return On success, returns void, on failure, returns unexpected with
+   * error message
+   */
+  auto init(VkDevice device, VkPhysicalDevice physicalDevice,
+            PipelineLayoutCache &layoutCache,
+            std::span<const std::byte> binCode, uint32_t maxLights,
+            uint32_t averageLightsPerCluster, uint32_t framesInFlight)
+      -> expected<void, string>;
+  auto destroy() -> void;
+  /*!
+   * @brief Sets the lights of a frame, the GPU must be done with the frame
+   * slot's previous use
+   * @param frameSlot the frame in flight being recorded
+   * @param lights the frame's lights
+   * @return On success, returns void, on failure (too many lights), returns
+   * unexpected with error message
+   */
+  auto set_lights(uint32_t frameSlot, std::span<const PointLight> lights)
+      -> expected<void, string>;
+  /*!
+   * @brief Records the light binning, frame_address() can be read by
+   * fragment shaders once it's done, the binning waits for the previous
+   * frame's shading
+   * @param commandBuffer the command buffer being recorded, outside of
+   * rendering
+   * @param frameSlot the frame in flight being recorded
+   * @param view the camera
+   * @param screen the size of the attachments being shaded
+   * @return On success, returns void, on failure, returns unexpected with
+   * error message
+   */
+  auto record_binning(VkCommandBuffer commandBuffer, uint32_t frameSlot,
+                      const ClusterView &view, VkExtent2D screen)
+      -> expected<void, string>;
+  /*!
+   * @brief Returns the device address of the frame's ClusterFrame block
+   * @param frameSlot the frame in flight being recorded
+   * @return the address, 0 before init
+   */
+  [[nodiscard]] auto frame_address(uint32_t frameSlot) const
+      -> VkDeviceAddress;
+  [[nodiscard]] auto max_lights() const -> uint32_t {
+    return this->m_maxLights;
+  }
+};
+} // namespace SFT::Renderer::VK
+
+#endif // CLUSTEREDLIGHTING_H
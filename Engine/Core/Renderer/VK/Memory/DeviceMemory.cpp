@@ -0,0 +1,103 @@
+//
+// Created by sturd on 10/18/2026.
+//
+
+#include "DeviceMemory.h"
+
+#include <algorithm>
+#include <array>
+#include <mutex>
+#include <unordered_map>
+
+namespace SFT::Renderer::VK {
+#pragma region additional functions
+namespace {
+struct Allocation {
+  VkDeviceSize size;
+  DeviceMemoryCategory category;
+};
+
+// allocations are rare and large, a lock is cheaper than getting the free
+// path to carry the size and category around
+struct Tracker {
+  std::mutex mutex;
+  std::unordered_map<VkDeviceMemory, Allocation> allocations;
+  std::array<Memory::MemoryTagStats,
+             static_cast<size_t>(DeviceMemoryCategory::Count)>
+      stats{};
+};
+
+auto tracker() -> Tracker & {
+  static Tracker instance;
+  return instance;
+}
+} // namespace
+#pragma endregion
+
+#pragma region DeviceMemory Functions
+auto allocate_device_memory(VkDevice device,
+                            const VkMemoryAllocateInfo &allocInfo,
+                            const DeviceMemoryCategory category,
+                            VkDeviceMemory *memory) -> VkResult {
+  const VkResult result = vkAllocateMemory(device, &allocInfo, nullptr, memory);
+  if (result != VK_SUCCESS) {
+    return result;
+  }
+  auto &state = tracker();
+  std::lock_guard lock(state.mutex);
+  state.allocations.emplace(*memory,
+                            Allocation{allocInfo.allocationSize, category});
+  auto &stats = state.stats[static_cast<size_t>(category)];
+  stats.currentBytes += allocInfo.allocationSize;
+  stats.peakBytes = std::max(stats.peakBytes, stats.currentBytes);
+  stats.liveAllocations++;
+  stats.totalAllocations++;
+  return result;
+}
+
+auto free_device_memory(VkDevice device, VkDeviceMemory memory) -> void {
+  if (memory == VK_NULL_HANDLE) {
+    return;
+  }
+  // the handle is untracked before it's freed, once freed the driver may hand
+  // it straight back to another thread's allocation
+  {
+    auto &state = tracker();
+    std::lock_guard lock(state.mutex);
+    if (const auto it = state.allocations.find(memory);
+        it != state.allocations.end()) {
+      auto &stats = state.stats[static_cast<size_t>(it->second.category)];
+      stats.currentBytes -= it->second.size;
+      stats.liveAllocations--;
+      state.allocations.erase(it);
+    }
+  }
+  vkFreeMemory(device, memory, nullptr);
+}
+
+auto device_memory_stats(const DeviceMemoryCategory category)
+    -> Memory::MemoryTagStats {
+  auto &state = tracker();
+  std::lock_guard lock(state.mutex);
+  return state.stats[static_cast<size_t>(category)];
+}
+
+auto device_memory_category_name(const DeviceMemoryCategory category)
+    -> const char * {
+  switch (category) {
+  case DeviceMemoryCategory::Textures:
+    return "Textures";
+  case DeviceMemoryCategory::RenderTargets:
+    return "RenderTargets";
+  case DeviceMemoryCategory::Buffers:
+    return "Buffers";
+  case DeviceMemoryCategory::Uniforms:
+    return "Uniforms";
+  case DeviceMemoryCategory::Staging:
+    return "Staging";
+  default:
+    return "Unknown";
+  }
+}
+#pragma endregion
+} // namespace SFT::Renderer::VK
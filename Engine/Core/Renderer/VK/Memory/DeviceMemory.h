@@ -0,0 +1,50 @@
+//
+// Created by sturd on 10/18/2026.
+//
+
+#ifndef DEVICEMEMORY_H
+#define DEVICEMEMORY_H
+
+#include "Core/Memory/MemoryStats.h"
+#include "Core/Renderer/VK/VulkanDispatch.h"
+#include <cstdint>
+
+namespace SFT::Renderer::VK {
+/*!
+ * @brief What a device memory allocation backs
+ */
+enum class DeviceMemoryCategory : uint8_t {
+  Textures,
+  RenderTargets,
+  Buffers,
+  Uniforms,
+  Staging,
+  Count,
+};
+
+/*!
+ * @brief vkAllocateMemory that charges the allocation to a category, every
+ * renderer allocation goes through here so telemetry sees all of it
+ * @param device the logical device
+ * @param allocInfo what to allocate
+ * @param category what the memory backs
+ * @param memory receives the allocation
+ * @return the result of vkAllocateMemory
+ */
+auto allocate_device_memory(VkDevice device,
+                            const VkMemoryAllocateInfo &allocInfo,
+                            DeviceMemoryCategory category,
+                            VkDeviceMemory *memory) -> VkResult;
+/*!
+ * @brief vkFreeMemory for memory from allocate_device_memory, null memory is
+ * ignored
+ */
+auto free_device_memory(VkDevice device, VkDeviceMemory memory) -> void;
+/*!
+ * @brief The counters of a category, in the same shape as the CPU tags
+ */
+auto device_memory_stats(DeviceMemoryCategory category) -> Memory::MemoryTagStats;
+auto device_memory_category_name(DeviceMemoryCategory category) -> const char *;
+} // namespace SFT::Renderer::VK
+
+#endif // DEVICEMEMORY_H
@@ -0,0 +1,88 @@
+//
+// Created by sturd on 10/18/2026.
+//
+
+#include "GpuBuffer.h"
+
+namespace SFT::Renderer::VK {
+auto create_gpu_buffer(VkDevice device,
+                       const VkPhysicalDeviceMemoryProperties &memoryProperties,
+                       const VkDeviceSize size, const VkBufferUsageFlags usage,
+                       const VkMemoryPropertyFlags properties,
+                       const DeviceMemoryCategory category)
+    -> expected<GpuBuffer, string> {
+  GpuBuffer result;
+  result.size = size;
+  VkBufferCreateInfo bufferInfo{};
+  bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+  bufferInfo.size = size;
+  bufferInfo.usage = usage;
+  bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+  if (vkCreateBuffer(device, &bufferInfo, nullptr, &result.buffer) !=
+      VK_SUCCESS) {
+    return unexpected("failed to create buffer");
+  }
+  VkMemoryRequirements requirements;
+  vkGetBufferMemoryRequirements(device, result.buffer, &requirements);
+  uint32_t memoryType = UINT32_MAX;
+  for (uint32_t i = 0; i < memoryProperties.memoryTypeCount; i++) {
+    if ((requirements.memoryTypeBits & (1u << i)) &&
+        (memoryProperties.memoryTypes[i].propertyFlags & properties) ==
+            properties) {
+      memoryType = i;
+      break;
+    }
+  }
+  if (memoryType == UINT32_MAX) {
+    destroy_gpu_buffer(device, result);
+    return unexpected("no memory type fits the buffer");
+  }
+
+  const bool addressable = usage & VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT;
+  VkMemoryAllocateFlagsInfo flagsInfo{};
+  flagsInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_FLAGS_INFO;
+  flagsInfo.flags = VK_MEMORY_ALLOCATE_DEVICE_ADDRESS_BIT;
+  VkMemoryAllocateInfo allocInfo{};
+  allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+  allocInfo.pNext = addressable ? &flagsInfo : nullptr;
+  allocInfo.allocationSize = requirements.size;
+  allocInfo.memoryTypeIndex = memoryType;
+  if (allocate_device_memory(device, allocInfo, category, &result.memory) !=
+      VK_SUCCESS) {
+    destroy_gpu_buffer(device, result);
+    return unexpected("failed to allocate buffer memory");
+  }
+  if (vkBindBufferMemory(device, result.buffer, result.memory, 0) !=
+      VK_SUCCESS) {
+    destroy_gpu_buffer(device, result);
+    return unexpected("failed to bind buffer memory");
+  }
+
+  if (memoryProperties.memoryTypes[memoryType].propertyFlags &
+      VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT) {
+    void *mapped = nullptr;
+    if (vkMapMemory(device, result.memory, 0, VK_WHOLE_SIZE, 0, &mapped) !=
+        VK_SUCCESS) {
+      destroy_gpu_buffer(device, result);
+      return unexpected("failed to map buffer memory");
+    }
+    result.mapped = static_cast<std::byte *>(mapped);
+  }
+  if (addressable) {
+    VkBufferDeviceAddressInfo addressInfo{};
+    addressInfo.sType = VK_STRUCTURE_TYPE_BUFFER_DEVICE_ADDRESS_INFO;
+    addressInfo.buffer = result.buffer;
+    result.address = vkGetBufferDeviceAddress(device, &addressInfo);
+  }
+  return result;
+}
+
+auto destroy_gpu_buffer(VkDevice device, GpuBuffer &buffer) -> void {
+  if (buffer.buffer != VK_NULL_HANDLE) {
+    vkDestroyBuffer(device, buffer.buffer, nullptr);
+  }
+  // freeing mapped memory unmaps it
+  free_device_memory(device, buffer.memory);
+  buffer = GpuBuffer{};
+}
+} // namespace SFT::Renderer::VK
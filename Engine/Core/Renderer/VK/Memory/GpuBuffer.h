@@ -0,0 +1,61 @@
+//
+// Created by sturd on 10/18/2026.
+//
+
+#ifndef GPUBUFFER_H
+#define GPUBUFFER_H
+
+#include "Core/Renderer/VK/VulkanDispatch.h"
+#include "DeviceMemory.h"
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <string>
+
+using std::expected;
+using std::string;
+using std::unexpected;
+
+namespace SFT::Renderer::VK {
+/*!
+ * @brief A buffer with its own dedicated allocation, for the long lived
+ * buffers renderer subsystems keep for their whole life
+ */
+struct GpuBuffer {
+  VkBuffer buffer = VK_NULL_HANDLE;
+  VkDeviceMemory memory = VK_NULL_HANDLE;
+  // set when the memory is host visible, it stays mapped
+  std::byte *mapped = nullptr;
+  // set when the usage includes SHADER_DEVICE_ADDRESS
+  VkDeviceAddress address = 0;
+  VkDeviceSize size = 0;
+};
+
+/*!
+ * @brief Creates a buffer and binds it to memory of its own, host visible
+ * memory is mapped persistently
+ * @param device the logical device
+ * @param memoryProperties the memory types of the physical device
+ * @param size the size in bytes
+ * @param usage the buffer usage, SHADER_DEVICE_ADDRESS also makes the memory
+ * addressable and fills GpuBuffer::address
+ * @param properties the memory properties the memory type must have
+ * @param category what telemetry charges the memory to
+ * @return On success, returns the buffer, on failure, returns unexpected with
+ * error message, nothing is left allocated then
+ */
+auto create_gpu_buffer(VkDevice device,
+                       const VkPhysicalDeviceMemoryProperties &memoryProperties,
+                       VkDeviceSize size, VkBufferUsageFlags usage,
+                       VkMemoryPropertyFlags properties,
+                       DeviceMemoryCategory category =
+                           DeviceMemoryCategory::Buffers)
+    -> expected<GpuBuffer, string>;
+/*!
+ * @brief Destroys a buffer from create_gpu_buffer and resets it, null buffers
+ * are ignored
+ */
+auto destroy_gpu_buffer(VkDevice device, GpuBuffer &buffer) -> void;
+} // namespace SFT::Renderer::VK
+
+#endif // GPUBUFFER_H
@@ -0,0 +1,46 @@
+//
+// Created by sturd on 10/18/2026.
+//
+
+#include "MemoryBudget.h"
+
+namespace SFT::Renderer::VK {
+auto query_heap_budgets(VkPhysicalDevice physicalDevice,
+                        const bool hasMemoryBudget) -> vector<HeapBudget> {
+  VkPhysicalDeviceMemoryBudgetPropertiesEXT budgetProperties{};
+  budgetProperties.sType =
+      VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_BUDGET_PROPERTIES_EXT;
+  VkPhysicalDeviceMemoryProperties2 memoryProperties{};
+  memoryProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_PROPERTIES_2;
+  memoryProperties.pNext = hasMemoryBudget ? &budgetProperties : nullptr;
+  vkGetPhysicalDeviceMemoryProperties2(physicalDevice, &memoryProperties);
+
+  const auto &properties = memoryProperties.memoryProperties;
+  vector<HeapBudget> heaps(properties.memoryHeapCount);
+  for (uint32_t i = 0; i < properties.memoryHeapCount; i++) {
+    auto &heap = heaps[i];
+    heap.size = properties.memoryHeaps[i].size;
+    heap.deviceLocal =
+        properties.memoryHeaps[i].flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT;
+    heap.fromExtension = hasMemoryBudget;
+    if (hasMemoryBudget) {
+      heap.budget = budgetProperties.heapBudget[i];
+      heap.usage = budgetProperties.heapUsage[i];
+    } else {
+      heap.budget = heap.size;
+    }
+  }
+  return heaps;
+}
+
+auto primary_device_local_heap(const vector<HeapBudget> &heaps) -> size_t {
+  size_t best = heaps.size();
+  for (size_t i = 0; i < heaps.size(); i++) {
+    if (heaps[i].deviceLocal &&
+        (best == heaps.size() || heaps[i].size > heaps[best].size)) {
+      best = i;
+    }
+  }
+  return best;
+}
+} // namespace SFT::Renderer::VK
@@ -0,0 +1,47 @@
+//
+// Created by sturd on 10/18/2026.
+//
+
+#ifndef MEMORYBUDGET_H
+#define MEMORYBUDGET_H
+
+#include "Core/Renderer/VK/VulkanDispatch.h"
+#include <cstdint>
+#include <vector>
+
+using std::vector;
+
+namespace SFT::Renderer::VK {
+/*!
+ * @brief How much of a memory heap the process may use and how much it uses,
+ * without VK_EXT_memory_budget the budget is the heap size and the usage is
+ * unknown (reported as 0)
+ */
+struct HeapBudget {
+  VkDeviceSize size = 0;
+  VkDeviceSize budget = 0;
+  VkDeviceSize usage = 0;
+  bool deviceLocal = false;
+  bool fromExtension = false;
+};
+
+/*!
+ * @brief Queries the budget of every memory heap, the values move as other
+ * processes allocate so this should be called again whenever it matters
+ * @param physicalDevice the device to query
+ * @param hasMemoryBudget whether VK_EXT_memory_budget was enabled on the device
+ * @return one entry per memory heap, in heap order
+ */
+auto query_heap_budgets(VkPhysicalDevice physicalDevice, bool hasMemoryBudget)
+    -> vector<HeapBudget>;
+
+/*!
+ * @brief Finds the heap VRAM budgets should be taken from, the largest device
+ * local heap, so the small host visible BAR heap some drivers expose is skipped
+ * @param heaps the heaps from query_heap_budgets
+ * @return the index of the heap, or heaps.size() if none is device local
+ */
+auto primary_device_local_heap(const vector<HeapBudget> &heaps) -> size_t;
+} // namespace SFT::Renderer::VK
+
+#endif // MEMORYBUDGET_H
@@ -0,0 +1,222 @@
+//
+// Created by sturd on 10/18/2026.
+//
+
+#include "MemoryTelemetry.h"
+
+#include "spdlog/spdlog.h"
+#include <fmt/format.h>
+#include <fstream>
+
+namespace SFT::Renderer::VK {
+#pragma region additional functions
+namespace {
+constexpr float warningHysteresis = 0.05f;
+
+auto mebibytes(const uint64_t bytes) -> double {
+  return static_cast<double>(bytes) / (1024.0 * 1024.0);
+}
+
+auto append_stats_json(string &out, const char *name,
+                       const Memory::MemoryTagStats &stats) -> void {
+  out += fmt::format("    {{\"name\": \"{}\", \"currentBytes\": {}, "
+                     "\"peakBytes\": {}, \"liveAllocations\": {}, "
+                     "\"totalAllocations\": {}}}",
+                     name, stats.currentBytes, stats.peakBytes,
+                     stats.liveAllocations, stats.totalAllocations);
+}
+} // namespace
+#pragma endregion
+
+#pragma region MemoryTelemetry Functions
+auto MemoryTelemetry::init(VkPhysicalDevice physicalDevice,
+                           const bool hasMemoryBudget,
+                           MemoryTelemetrySettings settings) -> void {
+  this->m_physicalDevice = physicalDevice;
+  this->m_hasMemoryBudget = hasMemoryBudget;
+  this->m_settings = std::move(settings);
+  this->m_start = std::chrono::steady_clock::now();
+  this->m_lastSample = this->m_start;
+  this->m_csvHasHeader = false;
+  MemoryReport report = this->sample(0);
+  this->m_warned.assign(report.heaps.size(), false);
+  {
+    std::lock_guard lock(this->m_latestMutex);
+    this->m_latest = std::move(report);
+  }
+  if (!this->m_settings.csvPath.empty()) {
+    std::error_code error;
+    std::filesystem::remove(this->m_settings.csvPath, error);
+  }
+}
+
+auto MemoryTelemetry::sample(const uint64_t frame) const -> MemoryReport {
+  MemoryReport report;
+  report.frame = frame;
+  report.seconds = std::chrono::duration<double>(
+                       std::chrono::steady_clock::now() - this->m_start)
+                       .count();
+  report.heaps =
+      query_heap_budgets(this->m_physicalDevice, this->m_hasMemoryBudget);
+  for (size_t i = 0; i < report.device.size(); i++) {
+    report.device[i] =
+        device_memory_stats(static_cast<DeviceMemoryCategory>(i));
+  }
+  for (size_t i = 0; i < report.host.size(); i++) {
+    report.host[i] = Memory::memory_stats(static_cast<Memory::MemoryTag>(i));
+  }
+  return report;
+}
+
+auto MemoryTelemetry::update(const uint64_t frame) -> void {
+  const auto now = std::chrono::steady_clock::now();
+  if (now - this->m_lastSample < this->m_settings.interval) {
+    return;
+  }
+  this->m_lastSample = now;
+  MemoryReport report = this->sample(frame);
+  this->check_budgets(report);
+  // telemetry is best effort, a locked or missing file shouldn't stop a frame
+  if (!this->m_settings.jsonPath.empty()) {
+    if (auto result = this->write_json(report); !result.has_value()) {
+      spdlog::debug("memory telemetry: {}", result.error());
+    }
+  }
+  if (!this->m_settings.csvPath.empty()) {
+    if (auto result = this->append_csv(report); !result.has_value()) {
+      spdlog::debug("memory telemetry: {}", result.error());
+    }
+  }
+  std::lock_guard lock(this->m_latestMutex);
+  this->m_latest = std::move(report);
+}
+
+auto MemoryTelemetry::latest() const -> MemoryReport {
+  std::lock_guard lock(this->m_latestMutex);
+  return this->m_latest;
+}
+
+auto MemoryTelemetry::check_budgets(const MemoryReport &report) -> void {
+  if (!this->m_hasMemoryBudget) {
+    // without the extension usage is unknown, there's nothing to compare
+    return;
+  }
+  this->m_warned.resize(report.heaps.size(), false);
+  for (size_t i = 0; i < report.heaps.size(); i++) {
+    const auto &heap = report.heaps[i];
+    if (heap.budget == 0) {
+      continue;
+    }
+    const double fraction = static_cast<double>(heap.usage) /
+                            static_cast<double>(heap.budget);
+    if (!this->m_warned[i] && fraction >= this->m_settings.warnFraction) {
+      spdlog::warn("{} heap {} is at {:.0f}% of its budget, {:.1f} of "
+                   "{:.1f} MiB",
+                   heap.deviceLocal ? "Device local" : "Host", i,
+                   fraction * 100.0, mebibytes(heap.usage),
+                   mebibytes(heap.budget));
+      this->m_warned[i] = true;
+    } else if (this->m_warned[i] &&
+               fraction < this->m_settings.warnFraction - warningHysteresis) {
+      spdlog::info("Heap {} is back under its budget warning, {:.0f}%", i,
+                   fraction * 100.0);
+      this->m_warned[i] = false;
+    }
+  }
+}
+
+auto MemoryTelemetry::write_json(const MemoryReport &report) const
+    -> expected<void, string> {
+  string out = fmt::format("{{\n  \"frame\": {},\n  \"seconds\": {:.3f},\n"
+                           "  \"budgetFromExtension\": {},\n  \"heaps\": [\n",
+                           report.frame, report.seconds,
+                           this->m_hasMemoryBudget);
+  for (size_t i = 0; i < report.heaps.size(); i++) {
+    const auto &heap = report.heaps[i];
+    out += fmt::format("    {{\"index\": {}, \"deviceLocal\": {}, \"sizeBytes\": "
+                       "{}, \"budgetBytes\": {}, \"usageBytes\": {}}}{}\n",
+                       i, heap.deviceLocal, heap.size, heap.budget, heap.usage,
+                       i + 1 < report.heaps.size() ? "," : "");
+  }
+  out += "  ],\n  \"device\": [\n";
+  for (size_t i = 0; i < report.device.size(); i++) {
+    append_stats_json(
+        out, device_memory_category_name(static_cast<DeviceMemoryCategory>(i)),
+        report.device[i]);
+    out += i + 1 < report.device.size() ? ",\n" : "\n";
+  }
+  out += "  ],\n  \"host\": [\n";
+  for (size_t i = 0; i < report.host.size(); i++) {
+    append_stats_json(
+        out, Memory::memory_tag_name(static_cast<Memory::MemoryTag>(i)),
+        report.host[i]);
+    out += i + 1 < report.host.size() ? ",\n" : "\n";
+  }
+  out += "  ]\n}\n";
+
+  // written next to the target and renamed over it, so a reader never sees
+  // half a report
+  std::filesystem::path temporary = this->m_settings.jsonPath;
+  temporary += ".tmp";
+  {
+    std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+      return unexpected("failed to open " + temporary.string());
+    }
+    file.write(out.data(), static_cast<std::streamsize>(out.size()));
+    if (!file) {
+      return unexpected("failed to write " + temporary.string());
+    }
+  }
+  std::error_code error;
+  std::filesystem::rename(temporary, this->m_settings.jsonPath, error);
+  if (error) {
+    return unexpected("failed to move " + temporary.string() + " to " +
+                      this->m_settings.jsonPath.string() + ": " +
+                      error.message());
+  }
+  return {};
+}
+
+auto MemoryTelemetry::append_csv(const MemoryReport &report)
+    -> expected<void, string> {
+  std::ofstream file(this->m_settings.csvPath,
+                     std::ios::binary | std::ios::app);
+  if (!file.is_open()) {
+    return unexpected("failed to open " + this->m_settings.csvPath.string());
+  }
+  // one row per heap, category and tag, budget is only meaningful for heaps
+  // and peak only for allocators
+  string out;
+  if (!this->m_csvHasHeader) {
+    out += "seconds,frame,source,name,used_bytes,budget_bytes,peak_bytes,"
+           "live_allocations\n";
+  }
+  for (size_t i = 0; i < report.heaps.size(); i++) {
+    const auto &heap = report.heaps[i];
+    out += fmt::format("{:.3f},{},heap,{},{},{},,\n", report.seconds,
+                       report.frame, i, heap.usage, heap.budget);
+  }
+  for (size_t i = 0; i < report.device.size(); i++) {
+    const auto &stats = report.device[i];
+    out += fmt::format(
+        "{:.3f},{},device,{},{},,{},{}\n", report.seconds, report.frame,
+        device_memory_category_name(static_cast<DeviceMemoryCategory>(i)),
+        stats.currentBytes, stats.peakBytes, stats.liveAllocations);
+  }
+  for (size_t i = 0; i < report.host.size(); i++) {
+    const auto &stats = report.host[i];
+    out += fmt::format(
+        "{:.3f},{},host,{},{},,{},{}\n", report.seconds, report.frame,
+        Memory::memory_tag_name(static_cast<Memory::MemoryTag>(i)),
+        stats.currentBytes, stats.peakBytes, stats.liveAllocations);
+  }
+  file.write(out.data(), static_cast<std::streamsize>(out.size()));
+  if (!file) {
+    return unexpected("failed to write " + this->m_settings.csvPath.string());
+  }
+  this->m_csvHasHeader = true;
+  return {};
+}
+#pragma endregion
+} // namespace SFT::Renderer::VK
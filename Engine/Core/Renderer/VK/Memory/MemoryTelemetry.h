@@ -0,0 +1,106 @@
+//
+// Created by sturd on 10/18/2026.
+//
+
+#ifndef MEMORYTELEMETRY_H
+#define MEMORYTELEMETRY_H
+
+#include "Core/Memory/MemoryStats.h"
+#include "DeviceMemory.h"
+#include "MemoryBudget.h"
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <expected>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <vector>
+
+using std::expected;
+using std::string;
+using std::unexpected;
+using std::vector;
+
+namespace SFT::Renderer::VK {
+/*!
+ * @brief Everything known about memory use at one moment
+ */
+struct MemoryReport {
+  uint64_t frame = 0;
+  // since the telemetry was initialized
+  double seconds = 0.0;
+  vector<HeapBudget> heaps;
+  std::array<Memory::MemoryTagStats,
+             static_cast<size_t>(DeviceMemoryCategory::Count)>
+      device{};
+  std::array<Memory::MemoryTagStats,
+             static_cast<size_t>(Memory::MemoryTag::Count)>
+      host{};
+};
+
+struct MemoryTelemetrySettings {
+  // a heap warns once its usage passes this fraction of its budget
+  float warnFraction = 0.9f;
+  // how often update samples, checks budgets and writes the files
+  std::chrono::milliseconds interval{5000};
+  // the latest report, rewritten every interval, empty to disable
+  std::filesystem::path jsonPath;
+  // every report appended as rows, empty to disable
+  std::filesystem::path csvPath;
+};
+
+/*!
+ * @brief Samples heap budgets from VK_EXT_memory_budget, device memory per
+ * category and the CPU allocator tags. Warns when a heap nears its budget,
+ * since oversubscribing VRAM doesn't fail, the driver silently pages to
+ * system memory and frame times fall off a cliff
+ */
+class MemoryTelemetry {
+private:
+  VkPhysicalDevice m_physicalDevice = VK_NULL_HANDLE;
+  bool m_hasMemoryBudget = false;
+  MemoryTelemetrySettings m_settings;
+  std::chrono::steady_clock::time_point m_start;
+  std::chrono::steady_clock::time_point m_lastSample;
+  // heaps currently over the warning line, so each crossing warns once
+  vector<bool> m_warned;
+  bool m_csvHasHeader = false;
+  // update runs on the render thread, latest may be read from any thread
+  mutable std::mutex m_latestMutex;
+  MemoryReport m_latest;
+
+  auto check_budgets(const MemoryReport &report) -> void;
+  auto write_json(const MemoryReport &report) const -> expected<void, string>;
+  auto append_csv(const MemoryReport &report) -> expected<void, string>;
+
+public:
+  /*!
+   * @brief Starts the telemetry, the CSV file is started over
+   * @param physicalDevice the device whose heaps are reported
+   * @param hasMemoryBudget whether VK_EXT_memory_budget was enabled
+   * @param settings thresholds, interval and output files
+   */
+  auto init(VkPhysicalDevice physicalDevice, bool hasMemoryBudget,
+            MemoryTelemetrySettings settings) -> void;
+  /*!
+   * @brief Takes a report now, never touches the files
+   * @param frame the frame number stored in the report
+   * @return the report
+   */
+  [[nodiscard]] auto sample(uint64_t frame) const -> MemoryReport;
+  /*!
+   * @brief Call once a frame, once the interval passed it samples, warns
+   * about heaps near their budget and writes the files
+   * @param frame the current frame number
+   */
+  auto update(uint64_t frame) -> void;
+  /*!
+   * @brief The report update took last, copied so it can be read from any
+   * thread while update replaces it
+   */
+  [[nodiscard]] auto latest() const -> MemoryReport;
+};
+} // namespace SFT::Renderer::VK
+
+#endif // MEMORYTELEMETRY_H
@@ -0,0 +1,169 @@
+//
+// Created by sturd on 10/18/2026.
+//
+
+#include "UniformRing.h"
+
+#include "DeviceMemory.h"
+#include <algorithm>
+#include <optional>
+
+namespace SFT::Renderer::VK {
+#pragma region additional functions
+namespace {
+// std140 and std430 both need vec4 alignment for anything interesting
+constexpr VkDeviceSize minimumAlignment = 16;
+// a dynamic uniform binding covers at most this much of the buffer
+constexpr uint32_t maxDynamicRange = 64 * 1024;
+
+auto find_ring_memory_type(const VkPhysicalDeviceMemoryProperties &properties,
+                           const uint32_t typeBits)
+    -> std::optional<uint32_t> {
+  constexpr VkMemoryPropertyFlags required =
+      VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+  std::optional<uint32_t> fallback;
+  for (uint32_t i = 0; i < properties.memoryTypeCount; i++) {
+    const VkMemoryPropertyFlags flags = properties.memoryTypes[i].propertyFlags;
+    if (!(typeBits & (1u << i)) || (flags & required) != required) {
+      continue;
+    }
+    // the BAR (or all of VRAM with resizable BAR) is written by the CPU and
+    // read by shaders at full speed
+    if (flags & VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT) {
+      return i;
+    }
+    if (!fallback.has_value()) {
+      fallback = i;
+    }
+  }
+  return fallback;
+}
+} // namespace
+#pragma endregion
+
+#pragma region UniformRing Functions
+auto UniformRing::init(VkDevice device, VkPhysicalDevice physicalDevice,
+                       const uint32_t framesInFlight,
+                       const VkDeviceSize bytesPerFrame)
+    -> expected<void, string> {
+  this->m_device = device;
+  this->m_framesInFlight = std::max(1u, framesInFlight);
+  VkPhysicalDeviceProperties properties;
+  vkGetPhysicalDeviceProperties(physicalDevice, &properties);
+  this->m_alignment =
+      std::max({minimumAlignment, properties.limits.minUniformBufferOffsetAlignment,
+                properties.limits.minStorageBufferOffsetAlignment});
+  this->m_dynamicRange =
+      std::min(maxDynamicRange, properties.limits.maxUniformBufferRange);
+  this->m_regionSize = (bytesPerFrame + this->m_alignment - 1) /
+                       this->m_alignment * this->m_alignment;
+
+  // the tail padding keeps a dynamic range starting anywhere inside the last
+  // region within the buffer
+  VkBufferCreateInfo bufferInfo{};
+  bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+  bufferInfo.size =
+      this->m_regionSize * this->m_framesInFlight + this->m_dynamicRange;
+  bufferInfo.usage = VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT |
+                     VK_BUFFER_USAGE_STORAGE_BUFFER_BIT |
+                     VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT;
+  bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+  if (vkCreateBuffer(device, &bufferInfo, nullptr, &this->m_buffer) !=
+      VK_SUCCESS) {
+    return unexpected("failed to create the uniform ring buffer");
+  }
+  VkMemoryRequirements requirements;
+  vkGetBufferMemoryRequirements(device, this->m_buffer, &requirements);
+  VkPhysicalDeviceMemoryProperties memoryProperties;
+  vkGetPhysicalDeviceMemoryProperties(physicalDevice, &memoryProperties);
+  const auto memoryType =
+      find_ring_memory_type(memoryProperties, requirements.memoryTypeBits);
+  if (!memoryType.has_value()) {
+    return unexpected("no host visible memory type fits the uniform ring");
+  }
+
+  VkMemoryAllocateFlagsInfo flagsInfo{};
+  flagsInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_FLAGS_INFO;
+  flagsInfo.flags = VK_MEMORY_ALLOCATE_DEVICE_ADDRESS_BIT;
+  VkMemoryAllocateInfo allocInfo{};
+  allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+  allocInfo.pNext = &flagsInfo;
+  allocInfo.allocationSize = requirements.size;
+  allocInfo.memoryTypeIndex = memoryType.value();
+  if (allocate_device_memory(device, allocInfo, DeviceMemoryCategory::Uniforms,
+                             &this->m_memory) != VK_SUCCESS) {
+    return unexpected("failed to allocate uniform ring memory");
+  }
+  if (vkBindBufferMemory(device, this->m_buffer, this->m_memory, 0) !=
+      VK_SUCCESS) {
+    // not mapped yet, so destroy() can't be used
+    free_device_memory(device, this->m_memory);
+    vkDestroyBuffer(device, this->m_buffer, nullptr);
+    this->m_memory = VK_NULL_HANDLE;
+    this->m_buffer = VK_NULL_HANDLE;
+    return unexpected("failed to bind uniform ring memory");
+  }
+  // mapped for the ring's whole life, coherent memory needs no flushes
+  void *mapped = nullptr;
+  if (vkMapMemory(device, this->m_memory, 0, VK_WHOLE_SIZE, 0, &mapped) !=
+      VK_SUCCESS) {
+    return unexpected("failed to map uniform ring memory");
+  }
+  this->m_mapped = static_cast<std::byte *>(mapped);
+
+  VkBufferDeviceAddressInfo addressInfo{};
+  addressInfo.sType = VK_STRUCTURE_TYPE_BUFFER_DEVICE_ADDRESS_INFO;
+  addressInfo.buffer = this->m_buffer;
+  this->m_address = vkGetBufferDeviceAddress(device, &addressInfo);
+  this->m_frameSlot = 0;
+  this->m_cursor.store(0, std::memory_order_relaxed);
+  return {};
+}
+
+auto UniformRing::destroy() -> void {
+  if (this->m_memory != VK_NULL_HANDLE) {
+    vkUnmapMemory(this->m_device, this->m_memory);
+    free_device_memory(this->m_device, this->m_memory);
+  }
+  if (this->m_buffer != VK_NULL_HANDLE) {
+    vkDestroyBuffer(this->m_device, this->m_buffer, nullptr);
+  }
+  this->m_memory = VK_NULL_HANDLE;
+  this->m_buffer = VK_NULL_HANDLE;
+  this->m_mapped = nullptr;
+  this->m_address = 0;
+}
+
+auto UniformRing::begin_frame(const uint32_t frameSlot) -> void {
+  // the cursor runs past the region end when an allocation fails
+  const VkDeviceSize regionStart = this->m_regionSize * this->m_frameSlot;
+  const VkDeviceSize cursor = std::min(
+      this->m_cursor.load(std::memory_order_relaxed),
+      regionStart + this->m_regionSize);
+  this->m_peakUsage = std::max(this->m_peakUsage, cursor - regionStart);
+  this->m_frameSlot = frameSlot % this->m_framesInFlight;
+  this->m_cursor.store(this->m_regionSize * this->m_frameSlot,
+                       std::memory_order_relaxed);
+}
+
+auto UniformRing::allocate(const VkDeviceSize size)
+    -> expected<UniformAllocation, string> {
+  const VkDeviceSize aligned =
+      (size + this->m_alignment - 1) / this->m_alignment * this->m_alignment;
+  const VkDeviceSize offset =
+      this->m_cursor.fetch_add(aligned, std::memory_order_relaxed);
+  const VkDeviceSize regionEnd = this->m_regionSize * (this->m_frameSlot + 1);
+  if (offset + aligned > regionEnd) {
+    return unexpected("the uniform ring's frame region is full, raise its "
+                      "size past " +
+                      std::to_string(this->m_regionSize) + " bytes");
+  }
+  return UniformAllocation{
+      .data = this->m_mapped + offset,
+      .offset = static_cast<uint32_t>(offset),
+      .size = static_cast<uint32_t>(size),
+      .address = this->m_address + offset,
+  };
+}
+#pragma endregion
+} // namespace SFT::Renderer::VK
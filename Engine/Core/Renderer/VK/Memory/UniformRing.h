@@ -0,0 +1,121 @@
+//
+// Created by sturd on 10/18/2026.
+//
+
+#ifndef UNIFORMRING_H
+#define UNIFORMRING_H
+
+#include "Core/Renderer/VK/VulkanDispatch.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <expected>
+#include <memory>
+#include <string>
+#include <type_traits>
+
+using std::expected;
+using std::string;
+using std::unexpected;
+
+namespace SFT::Renderer::VK {
+/*!
+ * @brief A slice of the uniform ring, valid until the frame slot it came from
+ * is begun again
+ */
+struct UniformAllocation {
+  std::byte *data = nullptr;
+  // from the start of the ring buffer, pass it as the dynamic offset of a
+  // UNIFORM_BUFFER_DYNAMIC or STORAGE_BUFFER_DYNAMIC binding of buffer()
+  uint32_t offset = 0;
+  uint32_t size = 0;
+  // for shaders that read the data through a buffer_reference
+  VkDeviceAddress address = 0;
+};
+
+/*!
+ * @brief One persistently mapped, host coherent buffer split into a region per
+ * frame in flight, per draw constants are bump allocated out of the frame's
+ * region and written in place, nothing is mapped, flushed or created per draw.
+ * Allocating is a single atomic add so several threads may record at once
+ */
+class UniformRing {
+private:
+  VkDevice m_device = VK_NULL_HANDLE;
+  VkBuffer m_buffer = VK_NULL_HANDLE;
+  VkDeviceMemory m_memory = VK_NULL_HANDLE;
+  std::byte *m_mapped = nullptr;
+  VkDeviceAddress m_address = 0;
+  VkDeviceSize m_regionSize = 0;
+  VkDeviceSize m_alignment = 0;
+  uint32_t m_dynamicRange = 0;
+  uint32_t m_framesInFlight = 0;
+  uint32_t m_frameSlot = 0;
+  std::atomic<VkDeviceSize> m_cursor = 0;
+  VkDeviceSize m_peakUsage = 0;
+
+public:
+  /*!
+   * @brief Creates and maps the buffer, device local host visible memory is
+   * preferred when the device has it so shaders read without crossing the bus
+   * @param device the logical device
+   * @param physicalDevice the physical device, for memory types and limits
+   * @param framesInFlight how many regions the ring is split into
+   * @param bytesPerFrame the size of each region
+   * @return On success, returns void, on failure, returns unexpected with
+   * error message
+   */
+  auto init(VkDevice device, VkPhysicalDevice physicalDevice,
+            uint32_t framesInFlight, VkDeviceSize bytesPerFrame)
+      -> expected<void, string>;
+  /*!
+   * @brief Destroys the buffer, the GPU must be done with it
+   */
+  auto destroy() -> void;
+  /*!
+   * @brief Starts allocating from the slot's region, everything allocated
+   * from it before is overwritten, so the fence of the previous frame that
+   * used the slot must have signaled
+   * @param frameSlot the frame in flight being recorded
+   */
+  auto begin_frame(uint32_t frameSlot) -> void;
+  /*!
+   * @brief Takes space from the current frame's region
+   * @param size the number of bytes, at most dynamic_range() for data bound
+   * through a dynamic offset
+   * @return On success, returns the allocation, on failure (the region is
+   * full), returns unexpected with error message
+   */
+  auto allocate(VkDeviceSize size) -> expected<UniformAllocation, string>;
+  /*!
+   * @brief Allocates and copies a value in one go
+   * @param value the constants, laid out the way the shader expects them
+   */
+  template <typename T>
+  auto push(const T &value) -> expected<UniformAllocation, string> {
+    static_assert(std::is_trivially_copyable_v<T>);
+    auto allocation = this->allocate(sizeof(T));
+    if (allocation.has_value()) {
+      std::memcpy(allocation->data, std::addressof(value), sizeof(T));
+    }
+    return allocation;
+  }
+  [[nodiscard]] auto buffer() const -> VkBuffer { return this->m_buffer; }
+  /*!
+   * @brief The range to give dynamic descriptors of buffer(), every offset
+   * handed out leaves this many bytes inside the buffer
+   */
+  [[nodiscard]] auto dynamic_range() const -> uint32_t {
+    return this->m_dynamicRange;
+  }
+  /*!
+   * @brief The most bytes any frame has taken so far, for sizing the regions
+   */
+  [[nodiscard]] auto peak_usage() const -> VkDeviceSize {
+    return this->m_peakUsage;
+  }
+};
+} // namespace SFT::Renderer::VK
+
+#endif // UNIFORMRING_H
@@ -0,0 +1,308 @@
+//
+// Created by sturd on 10/18/2026.
+//
+
+#include "ParticleSystem.h"
+
+#include "Core/Renderer/VK/RenderGraph/Barriers.h"
+#include <algorithm>
+#include <cstring>
+
+namespace SFT::Renderer::VK {
+#pragma region additional functions
+namespace {
+constexpr uint32_t groupSize = 64;
+// one VkDrawIndirectCommand per alive list, its instance count is the list's
+// size, then the dead count and the simulate dispatch
+constexpr VkDeviceSize simulateArgsOffset =
+    2 * sizeof(VkDrawIndirectCommand) + sizeof(int32_t);
+constexpr VkDeviceSize countersSize =
+    simulateArgsOffset + sizeof(VkDispatchIndirectCommand);
+
+// the stages of particle_update.comp
+constexpr uint32_t stageInit = 0;
+constexpr uint32_t stageEmit = 1;
+constexpr uint32_t stagePrepare = 2;
+constexpr uint32_t stageSimulate = 3;
+
+// mirrors the push constant block of particle_update.comp
+struct UpdateConstants {
+  VkDeviceAddress particles;
+  VkDeviceAddress deadList;
+  VkDeviceAddress aliveLists;
+  VkDeviceAddress counters;
+  uint32_t stage;
+  uint32_t current;
+  uint32_t count;
+  uint32_t maxParticles;
+  uint32_t seed;
+  float deltaTime;
+  float drag;
+  float gravity;
+  float emitPosition[4];
+  float emitVelocity[4];
+  float color[4];
+  float lifetime;
+  float lifetimeJitter;
+  float size;
+  float sizeEnd;
+};
+static_assert(sizeof(UpdateConstants) == 128,
+              "128 bytes is all the push constant space Vulkan guarantees");
+
+// mirrors the push constant block of particle.vert
+struct DrawConstants {
+  float viewProjection[16];
+  float right[4];
+  float up[4];
+  VkDeviceAddress particles;
+  VkDeviceAddress alive;
+};
+static_assert(sizeof(DrawConstants) <= 128,
+              "128 bytes is all the push constant space Vulkan guarantees");
+
+// mirrors Particle in the particle shaders
+constexpr VkDeviceSize particleSize = 64;
+
+auto compute_to_compute(VkCommandBuffer commandBuffer) -> void {
+  memory_barrier(commandBuffer, VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+                 VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT,
+                 VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+                 VK_ACCESS_2_SHADER_STORAGE_READ_BIT |
+                     VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT);
+}
+} // namespace
+#pragma endregion
+
+#pragma region ParticleSystem Functions
+auto ParticleSystem::init(VkDevice device, VkPhysicalDevice physicalDevice,
+                          PipelineLayoutCache &layoutCache,
+                          PipelineManager &pipelineManager,
+                          const std::span<const std::byte> updateCode,
+                          const uint64_t vertexShader,
+                          const uint64_t fragmentShader,
+                          const VkFormat colorFormat,
+                          const VkFormat depthFormat,
+                          const uint32_t maxParticles)
+    -> expected<void, string> {
+  this->m_device = device;
+  this->m_pipelineManager = &pipelineManager;
+  this->m_maxParticles = maxParticles;
+  if (maxParticles == 0) {
+    return unexpected("particle system needs room for at least one particle");
+  }
+  auto pipeline = create_compute_pipeline(device, layoutCache, updateCode);
+  if (!pipeline.has_value()) {
+    return unexpected("particle update: " + pipeline.error());
+  }
+  this->m_update = std::move(pipeline.value());
+
+  VkPhysicalDeviceMemoryProperties memoryProperties;
+  vkGetPhysicalDeviceMemoryProperties(physicalDevice, &memoryProperties);
+  const VkDeviceSize indexBytes = static_cast<VkDeviceSize>(maxParticles) * 4;
+  const struct {
+    GpuBuffer *buffer;
+    VkDeviceSize size;
+    VkBufferUsageFlags usage;
+  } buffers[] = {
+      {&this->m_particles, maxParticles * particleSize, 0},
+      {&this->m_deadList, indexBytes, 0},
+      {&this->m_aliveLists, indexBytes * 2, 0},
+      {&this->m_counters, countersSize, VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT},
+  };
+  for (const auto &[buffer, size, usage] : buffers) {
+    auto created = create_gpu_buffer(
+        device, memoryProperties, size,
+        usage | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT |
+            VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT,
+        VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+    if (!created.has_value()) {
+      return unexpected(created.error());
+    }
+    *buffer = created.value();
+  }
+
+  // soft sprites blend over the scene without writing depth, and the quads
+  // always face the camera so there is nothing to cull
+  this->m_drawKey.vertexShader = vertexShader;
+  this->m_drawKey.fragmentShader = fragmentShader;
+  this->m_drawKey.state.cullMode = VK_CULL_MODE_NONE;
+  this->m_drawKey.state.blendEnable = VK_TRUE;
+  this->m_drawKey.state.depthTest =
+      depthFormat != VK_FORMAT_UNDEFINED ? VK_TRUE : VK_FALSE;
+  this->m_drawKey.state.depthWrite = VK_FALSE;
+  this->m_drawKey.state.colorFormatCount = 1;
+  this->m_drawKey.state.colorFormats[0] = colorFormat;
+  this->m_drawKey.state.depthFormat = depthFormat;
+  if (auto queued = pipelineManager.request(this->m_drawKey);
+      !queued.has_value()) {
+    return unexpected("particle draw: " + queued.error());
+  }
+  this->m_current = 0;
+  this->m_initialized = false;
+  return {};
+}
+
+auto ParticleSystem::destroy() -> void {
+  destroy_gpu_buffer(this->m_device, this->m_particles);
+  destroy_gpu_buffer(this->m_device, this->m_deadList);
+  destroy_gpu_buffer(this->m_device, this->m_aliveLists);
+  destroy_gpu_buffer(this->m_device, this->m_counters);
+  destroy_compute_pipeline(this->m_device, this->m_update);
+  this->m_pending.clear();
+  this->m_maxParticles = 0;
+}
+
+auto ParticleSystem::emit(const ParticleEmitter &emitter, const uint32_t count)
+    -> void {
+  if (count == 0 || this->m_maxParticles == 0) {
+    return;
+  }
+  // a burst bigger than the pool could never fit anyway
+  this->m_pending.push_back({emitter, std::min(count, this->m_maxParticles)});
+}
+
+auto ParticleSystem::set_forces(const float gravity, const float drag)
+    -> void {
+  this->m_gravity = gravity;
+  this->m_drag = drag;
+}
+
+auto ParticleSystem::dispatch(VkCommandBuffer commandBuffer,
+                              const uint32_t stage, const uint32_t count,
+                              const float deltaTime,
+                              const ParticleEmitter *emitter) -> void {
+  UpdateConstants constants{};
+  constants.particles = this->m_particles.address;
+  constants.deadList = this->m_deadList.address;
+  constants.aliveLists = this->m_aliveLists.address;
+  constants.counters = this->m_counters.address;
+  constants.stage = stage;
+  constants.current = this->m_current;
+  constants.count = count;
+  constants.maxParticles = this->m_maxParticles;
+  // every burst gets different random numbers
+  constants.seed = this->m_seed++ * 0x9e3779b9u;
+  constants.deltaTime = deltaTime;
+  constants.drag = this->m_drag;
+  constants.gravity = this->m_gravity;
+  if (emitter != nullptr) {
+    std::memcpy(constants.emitPosition, emitter->position,
+                sizeof(emitter->position));
+    constants.emitPosition[3] = emitter->radius;
+    std::memcpy(constants.emitVelocity, emitter->velocity,
+                sizeof(emitter->velocity));
+    constants.emitVelocity[3] = emitter->velocityJitter;
+    std::memcpy(constants.color, emitter->color, sizeof(constants.color));
+    constants.lifetime = emitter->lifetime;
+    constants.lifetimeJitter = emitter->lifetimeJitter;
+    constants.size = emitter->size;
+    constants.sizeEnd = emitter->sizeEnd;
+  }
+  vkCmdPushConstants(commandBuffer, this->m_update.layout,
+                     VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(constants),
+                     &constants);
+  if (stage == stageSimulate) {
+    // sized by the prepare stage from the number of particles alive
+    vkCmdDispatchIndirect(commandBuffer, this->m_counters.buffer,
+                          simulateArgsOffset);
+  } else {
+    vkCmdDispatch(commandBuffer, (count + groupSize - 1) / groupSize, 1, 1);
+  }
+}
+
+auto ParticleSystem::record_update(VkCommandBuffer commandBuffer,
+                                   const float deltaTime) -> void {
+  if (this->m_maxParticles == 0) {
+    return;
+  }
+  // the previous frame's draw still reads the alive list and counters
+  memory_barrier(commandBuffer,
+                 VK_PIPELINE_STAGE_2_DRAW_INDIRECT_BIT |
+                     VK_PIPELINE_STAGE_2_VERTEX_SHADER_BIT |
+                     VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+                 VK_ACCESS_2_INDIRECT_COMMAND_READ_BIT |
+                     VK_ACCESS_2_SHADER_STORAGE_READ_BIT |
+                     VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT,
+                 VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+                 VK_ACCESS_2_SHADER_STORAGE_READ_BIT |
+                     VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT);
+  vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE,
+                    this->m_update.pipeline);
+  if (!this->m_initialized) {
+    // every particle starts out dead
+    this->dispatch(commandBuffer, stageInit, this->m_maxParticles, 0.0f,
+                   nullptr);
+    compute_to_compute(commandBuffer);
+    this->m_initialized = true;
+  }
+  // bursts only meet through atomics on the counters, so they can overlap
+  for (const auto &pending : this->m_pending) {
+    this->dispatch(commandBuffer, stageEmit, pending.count, 0.0f,
+                   &pending.emitter);
+  }
+  if (!this->m_pending.empty()) {
+    compute_to_compute(commandBuffer);
+  }
+  this->m_pending.clear();
+
+  this->dispatch(commandBuffer, stagePrepare, 1, deltaTime, nullptr);
+  memory_barrier(commandBuffer, VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+                 VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT,
+                 VK_PIPELINE_STAGE_2_DRAW_INDIRECT_BIT |
+                     VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+                 VK_ACCESS_2_INDIRECT_COMMAND_READ_BIT |
+                     VK_ACCESS_2_SHADER_STORAGE_READ_BIT |
+                     VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT);
+  this->dispatch(commandBuffer, stageSimulate, 0, deltaTime, nullptr);
+  memory_barrier(commandBuffer, VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+                 VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT,
+                 VK_PIPELINE_STAGE_2_DRAW_INDIRECT_BIT |
+                     VK_PIPELINE_STAGE_2_VERTEX_SHADER_BIT,
+                 VK_ACCESS_2_INDIRECT_COMMAND_READ_BIT |
+                     VK_ACCESS_2_SHADER_STORAGE_READ_BIT);
+  // the survivors were compacted into the other list, it's drawn and the
+  // next update simulates from it
+  this->m_current ^= 1;
+}
+
+auto ParticleSystem::record_draw(VkCommandBuffer commandBuffer,
+                                 const ParticleCamera &camera)
+    -> expected<void, string> {
+  if (this->m_maxParticles == 0 || !this->m_initialized) {
+    return {};
+  }
+  auto pipeline = this->m_pipelineManager->request(this->m_drawKey);
+  if (!pipeline.has_value()) {
+    return unexpected("particle draw: " + pipeline.error());
+  }
+  // still compiling and no fallback shares the particle layout
+  if (pipeline.value() == VK_NULL_HANDLE) {
+    return {};
+  }
+  auto layout = this->m_pipelineManager->layout_for(this->m_drawKey);
+  if (!layout.has_value()) {
+    return unexpected("particle draw: " + layout.error());
+  }
+  DrawConstants constants{};
+  std::memcpy(constants.viewProjection, camera.viewProjection,
+              sizeof(constants.viewProjection));
+  std::memcpy(constants.right, camera.right, sizeof(camera.right));
+  std::memcpy(constants.up, camera.up, sizeof(camera.up));
+  constants.particles = this->m_particles.address;
+  constants.alive = this->m_aliveLists.address +
+                    static_cast<VkDeviceAddress>(this->m_current) *
+                        this->m_maxParticles * 4;
+  vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
+                    pipeline.value());
+  vkCmdPushConstants(commandBuffer, layout.value(),
+                     VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(constants),
+                     &constants);
+  // six vertices per quad and one instance per particle alive
+  vkCmdDrawIndirect(commandBuffer, this->m_counters.buffer,
+                    this->m_current * sizeof(VkDrawIndirectCommand), 1,
+                    sizeof(VkDrawIndirectCommand));
+  return {};
+}
+#pragma endregion
+} // namespace SFT::Renderer::VK
@@ -0,0 +1,161 @@
+//
+// Created by sturd on 10/18/2026.
+//
+
+#ifndef PARTICLESYSTEM_H
+#define PARTICLESYSTEM_H
+
+#include "../Memory/GpuBuffer.h"
+#include "../Pipeline/ComputePipeline.h"
+#include "../Pipeline/PipelineLayoutCache.h"
+#include "../Pipeline/PipelineManager.h"
+#include "Core/Renderer/VK/VulkanDispatch.h"
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <span>
+#include <string>
+#include <vector>
+
+using std::expected;
+using std::string;
+using std::unexpected;
+using std::vector;
+
+namespace SFT::Renderer::VK {
+/*!
+ * @brief A burst of particles, everything but the position and velocity
+ * spread is shared by the whole burst
+ */
+struct ParticleEmitter {
+  float position[3] = {0.0f, 0.0f, 0.0f};
+  // particles start anywhere within this distance of the position
+  float radius = 0.0f;
+  float velocity[3] = {0.0f, 0.0f, 0.0f};
+  // up to this much speed is added in a random direction
+  float velocityJitter = 0.0f;
+  // linear RGBA, the alpha fades to zero over a particle's life
+  float color[4] = {1.0f, 1.0f, 1.0f, 1.0f};
+  // seconds, each particle gets lifetime +- lifetimeJitter
+  float lifetime = 1.0f;
+  float lifetimeJitter = 0.0f;
+  // half the width of the quad at birth and at death
+  float size = 0.1f;
+  float sizeEnd = 0.1f;
+};
+
+/*!
+ * @brief The camera as the particle draw wants it
+ */
+struct ParticleCamera {
+  // column major world to clip matrix
+  float viewProjection[16];
+  // world space camera axes the quads are built along
+  float right[3];
+  float up[3];
+};
+
+/*!
+ * @brief Particles that live entirely on the GPU. Emission, simulation and
+ * the recycling of dead particles run in compute shaders on persistent
+ * storage buffers, the CPU never reads them back. Each frame the live
+ * particles are compacted from one alive list into the other, the size of
+ * that list is the instance count of an indirect draw and the simulation of
+ * the next frame is dispatched indirectly from it, so the CPU never needs to
+ * know how many particles are alive
+ */
+class ParticleSystem {
+private:
+  struct PendingEmit {
+    ParticleEmitter emitter;
+    uint32_t count;
+  };
+
+  VkDevice m_device = VK_NULL_HANDLE;
+  PipelineManager *m_pipelineManager = nullptr;
+  ComputePipeline m_update;
+  PipelineKey m_drawKey;
+  GpuBuffer m_particles;
+  GpuBuffer m_deadList;
+  // both alive lists back to back
+  GpuBuffer m_aliveLists;
+  GpuBuffer m_counters;
+  uint32_t m_maxParticles = 0;
+  // the alive list the next update emits into and simulates from
+  uint32_t m_current = 0;
+  uint32_t m_seed = 0;
+  float m_gravity = 9.81f;
+  float m_drag = 0.0f;
+  bool m_initialized = false;
+  vector<PendingEmit> m_pending;
+
+  auto dispatch(VkCommandBuffer commandBuffer, uint32_t stage,
+                uint32_t count, float deltaTime,
+                const ParticleEmitter *emitter) -> void;
+
+public:
+  /*!
+   * @brief Creates the update pipeline, the particle buffers and queues the
+   * draw pipeline
+   * @param device the logical device
+   * @param physicalDevice the device the buffers come from
+   * @param layoutCache the cache the update pipeline layout comes from
+   * @param pipelineManager the manager the draw pipeline is compiled by
+   * @param updateCode SPIR-V of particle_update.comp
+   * @param vertexShader the registered hash of particle.vert
+   * @param fragmentShader the registered hash of particle.frag
+   * @param colorFormat the format of the attachment particles blend onto
+   * @param depthFormat the depth attachment particles are tested against, or
+   * VK_FORMAT_UNDEFINED to draw without depth testing
+   * @param maxParticles the most particles alive at once
+   * @return On success, returns void, on failure, returns unexpected with
+   * error message
+   */
+  auto init(VkDevice device, VkPhysicalDevice physicalDevice,
+            PipelineLayoutCache &layoutCache,
+            PipelineManager &pipelineManager,
+            std::span<const std::byte> updateCode, uint64_t vertexShader,
+            uint64_t fragmentShader, VkFormat colorFormat,
+            VkFormat depthFormat, uint32_t maxParticles)
+      -> expected<void, string>;
+  auto destroy() -> void;
+  /*!
+   * @brief Queues a burst for the next record_update, particles that don't
+   * fit in the pool are dropped on the GPU
+   * @param emitter the burst
+   * @param count how many particles to emit
+   */
+  auto emit(const ParticleEmitter &emitter, uint32_t count) -> void;
+  /*!
+   * @brief Sets the forces every particle is under
+   * @param gravity acceleration along -Y
+   * @param drag the fraction of velocity lost per second
+   */
+  auto set_forces(float gravity, float drag) -> void;
+  /*!
+   * @brief Records the queued emits and one simulation step, the particles
+   * can be drawn once it's done, the step waits for the previous frame's
+   * draw
+   * @param commandBuffer the command buffer being recorded, outside of
+   * rendering
+   * @param deltaTime seconds since the last update
+   */
+  auto record_update(VkCommandBuffer commandBuffer, float deltaTime) -> void;
+  /*!
+   * @brief Draws what the last update left alive, inside dynamic rendering
+   * to attachments of the formats given to init, with the viewport and
+   * scissor set. Nothing is drawn until the pipeline has compiled
+   * @param commandBuffer the command buffer being recorded
+   * @param camera the camera
+   * @return On success, returns void, on failure, returns unexpected with
+   * error message
+   */
+  auto record_draw(VkCommandBuffer commandBuffer,
+                   const ParticleCamera &camera) -> expected<void, string>;
+  [[nodiscard]] auto max_particles() const -> uint32_t {
+    return this->m_maxParticles;
+  }
+};
+} // namespace SFT::Renderer::VK
+
+#endif // PARTICLESYSTEM_H
@@ -0,0 +1,69 @@
+//
+// Created by sturd on 10/18/2026.
+//
+
+#include "ComputePipeline.h"
+
+#include <cstring>
+#include <vector>
+
+namespace SFT::Renderer::VK {
+auto create_compute_pipeline(VkDevice device, PipelineLayoutCache &layoutCache,
+                             const std::span<const std::byte> code)
+    -> expected<ComputePipeline, string> {
+  if (code.empty() || code.size() % sizeof(uint32_t) != 0) {
+    return unexpected("compute shader is not SPIR-V");
+  }
+  // the bytes may come from anywhere, copied so the words are aligned
+  std::vector<uint32_t> words(code.size() / sizeof(uint32_t));
+  std::memcpy(words.data(), code.data(), code.size());
+  auto reflection = reflect_spirv(words);
+  if (!reflection.has_value()) {
+    return unexpected(reflection.error());
+  }
+  if (reflection->stages != VK_SHADER_STAGE_COMPUTE_BIT) {
+    return unexpected("shader is not a compute shader");
+  }
+  auto layout = layoutCache.get_pipeline_layout(reflection.value());
+  if (!layout.has_value()) {
+    return unexpected(layout.error());
+  }
+
+  VkShaderModuleCreateInfo moduleInfo{};
+  moduleInfo.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
+  moduleInfo.codeSize = code.size();
+  moduleInfo.pCode = words.data();
+  VkShaderModule module;
+  if (vkCreateShaderModule(device, &moduleInfo, nullptr, &module) !=
+      VK_SUCCESS) {
+    return unexpected("failed to create compute shader module");
+  }
+  VkComputePipelineCreateInfo pipelineInfo{};
+  pipelineInfo.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+  pipelineInfo.stage.sType =
+      VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+  pipelineInfo.stage.stage = VK_SHADER_STAGE_COMPUTE_BIT;
+  pipelineInfo.stage.module = module;
+  pipelineInfo.stage.pName = "main";
+  pipelineInfo.layout = layout.value();
+  ComputePipeline result;
+  result.layout = layout.value();
+  result.reflection = std::move(reflection.value());
+  const VkResult created = vkCreateComputePipelines(
+      device, VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &result.pipeline);
+  // the pipeline keeps what it needs from the module
+  vkDestroyShaderModule(device, module, nullptr);
+  if (created != VK_SUCCESS) {
+    return unexpected("failed to create compute pipeline");
+  }
+  return result;
+}
+
+auto destroy_compute_pipeline(VkDevice device, ComputePipeline &pipeline)
+    -> void {
+  if (pipeline.pipeline != VK_NULL_HANDLE) {
+    vkDestroyPipeline(device, pipeline.pipeline, nullptr);
+  }
+  pipeline = ComputePipeline{};
+}
+} // namespace SFT::Renderer::VK
@@ -0,0 +1,51 @@
+//
+// Created by sturd on 10/18/2026.
+//
+
+#ifndef COMPUTEPIPELINE_H
+#define COMPUTEPIPELINE_H
+
+#include "PipelineLayoutCache.h"
+#include "SpirvReflection.h"
+#include "Core/Renderer/VK/VulkanDispatch.h"
+#include <cstddef>
+#include <expected>
+#include <span>
+#include <string>
+
+using std::expected;
+using std::string;
+using std::unexpected;
+
+namespace SFT::Renderer::VK {
+/*!
+ * @brief A compute pipeline and the interface it was built from, the layout
+ * belongs to the layout cache
+ */
+struct ComputePipeline {
+  VkPipeline pipeline = VK_NULL_HANDLE;
+  VkPipelineLayout layout = VK_NULL_HANDLE;
+  ShaderReflection reflection;
+};
+
+/*!
+ * @brief Builds a compute pipeline from SPIR-V, the layout comes from the
+ * reflected interface through the cache so compute passes with the same
+ * interface share it
+ * @param device the logical device
+ * @param layoutCache the cache the layout is deduplicated through
+ * @param code the SPIR-V of the module, its entry point must be "main"
+ * @return On success, returns the pipeline, on failure, returns unexpected
+ * with error message
+ */
+auto create_compute_pipeline(VkDevice device, PipelineLayoutCache &layoutCache,
+                             std::span<const std::byte> code)
+    -> expected<ComputePipeline, string>;
+/*!
+ * @brief Destroys the pipeline, the layout stays with the cache
+ */
+auto destroy_compute_pipeline(VkDevice device, ComputePipeline &pipeline)
+    -> void;
+} // namespace SFT::Renderer::VK
+
+#endif // COMPUTEPIPELINE_H
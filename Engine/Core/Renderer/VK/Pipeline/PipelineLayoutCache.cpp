@@ -0,0 +1,173 @@
+//
+// Created by sturd on 10/18/2026.
+//
+
+#include "PipelineLayoutCache.h"
+
+#include "Core/Utility/Utility.h"
+#include "spdlog/spdlog.h"
+#include <ranges>
+
+namespace SFT::Renderer::VK {
+#pragma region additional functions
+namespace {
+using Utility::hash_combine;
+} // namespace
+#pragma endregion
+
+#pragma region Hash Functions
+auto DescriptorSetLayoutKeyHash::operator()(
+    const DescriptorSetLayoutKey &key) const -> size_t {
+  uint64_t seed = key.bindings.size();
+  for (const auto &[binding, type, count, stages] : key.bindings) {
+    seed = hash_combine(seed, binding);
+    seed = hash_combine(seed, static_cast<uint64_t>(type));
+    seed = hash_combine(seed, count);
+    seed = hash_combine(seed, stages);
+  }
+  return static_cast<size_t>(seed);
+}
+
+auto PipelineLayoutKeyHash::operator()(const PipelineLayoutKey &key) const
+    -> size_t {
+  uint64_t seed = key.setLayouts.size();
+  for (const auto setLayout : key.setLayouts) {
+    seed = hash_combine(seed, reinterpret_cast<uint64_t>(setLayout));
+  }
+  seed = hash_combine(seed, key.pushOffset);
+  seed = hash_combine(seed, key.pushSize);
+  seed = hash_combine(seed, key.pushStages);
+  return static_cast<size_t>(seed);
+}
+#pragma endregion
+
+#pragma region PipelineLayoutCache Functions
+auto PipelineLayoutCache::init(VkDevice device) -> void {
+  this->m_device = device;
+}
+
+auto PipelineLayoutCache::destroy() -> void {
+  for (const auto layout : this->m_pipelineLayouts | std::views::values) {
+    vkDestroyPipelineLayout(this->m_device, layout, nullptr);
+  }
+  for (const auto layout : this->m_setLayouts | std::views::values) {
+    vkDestroyDescriptorSetLayout(this->m_device, layout, nullptr);
+  }
+  this->m_pipelineLayouts.clear();
+  this->m_setLayouts.clear();
+}
+
+auto PipelineLayoutCache::get_descriptor_set_layout(
+    const std::span<const ReflectedBinding> bindings)
+    -> expected<VkDescriptorSetLayout, string> {
+  DescriptorSetLayoutKey key;
+  key.bindings.reserve(bindings.size());
+  for (const auto &binding : bindings) {
+    key.bindings.push_back(
+        {binding.binding, binding.type, binding.count, binding.stages});
+  }
+  if (const auto it = this->m_setLayouts.find(key);
+      it != this->m_setLayouts.end()) {
+    this->m_hits++;
+    return it->second;
+  }
+  this->m_misses++;
+
+  vector<VkDescriptorSetLayoutBinding> layoutBindings;
+  layoutBindings.reserve(key.bindings.size());
+  for (const auto &[binding, type, count, stages] : key.bindings) {
+    VkDescriptorSetLayoutBinding layoutBinding{};
+    layoutBinding.binding = binding;
+    layoutBinding.descriptorType = type;
+    layoutBinding.descriptorCount = count;
+    layoutBinding.stageFlags = stages;
+    layoutBinding.pImmutableSamplers = nullptr;
+    layoutBindings.push_back(layoutBinding);
+  }
+
+  VkDescriptorSetLayoutCreateInfo createInfo{};
+  createInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+  createInfo.bindingCount = static_cast<uint32_t>(layoutBindings.size());
+  createInfo.pBindings = layoutBindings.data();
+
+  VkDescriptorSetLayout layout;
+  if (vkCreateDescriptorSetLayout(this->m_device, &createInfo, nullptr,
+                                  &layout) != VK_SUCCESS) {
+    return unexpected("failed to create descriptor set layout!");
+  }
+  this->m_setLayouts.emplace(std::move(key), layout);
+  return layout;
+}
+
+auto PipelineLayoutCache::get_pipeline_layout(const ShaderReflection &program)
+    -> expected<VkPipelineLayout, string> {
+  PipelineLayoutKey key{};
+  if (!program.sets.empty()) {
+    const uint32_t setCount = program.sets.rbegin()->first + 1;
+    key.setLayouts.reserve(setCount);
+    for (uint32_t set = 0; set < setCount; set++) {
+      auto it = program.sets.find(set);
+      auto setLayout =
+          it == program.sets.end()
+              ? this->get_descriptor_set_layout({})
+              : this->get_descriptor_set_layout(it->second);
+      if (!setLayout.has_value()) {
+        return unexpected(setLayout.error());
+      }
+      key.setLayouts.push_back(setLayout.value());
+    }
+  }
+  key.pushOffset = program.pushConstants.offset;
+  key.pushSize = program.pushConstants.size;
+  key.pushStages = program.pushConstants.stageFlags;
+
+  if (const auto it = this->m_pipelineLayouts.find(key);
+      it != this->m_pipelineLayouts.end()) {
+    this->m_hits++;
+    return it->second;
+  }
+  this->m_misses++;
+
+  VkPipelineLayoutCreateInfo createInfo{};
+  createInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+  createInfo.setLayoutCount = static_cast<uint32_t>(key.setLayouts.size());
+  createInfo.pSetLayouts = key.setLayouts.data();
+  if (key.pushStages != 0) {
+    createInfo.pushConstantRangeCount = 1;
+    createInfo.pPushConstantRanges = &program.pushConstants;
+  }
+
+  VkPipelineLayout layout;
+  if (vkCreatePipelineLayout(this->m_device, &createInfo, nullptr, &layout) !=
+      VK_SUCCESS) {
+    return unexpected("failed to create pipeline layout!");
+  }
+  spdlog::debug("Created pipeline layout with {} set(s), {} layout(s) cached",
+                key.setLayouts.size(), this->m_pipelineLayouts.size() + 1);
+  this->m_pipelineLayouts.emplace(std::move(key), layout);
+  return layout;
+}
+
+auto PipelineLayoutCache::get_set_layout_for(const ShaderReflection &program,
+                                             const uint32_t set)
+    -> expected<VkDescriptorSetLayout, string> {
+  const auto it = program.sets.find(set);
+  if (it == program.sets.end()) {
+    return this->get_descriptor_set_layout({});
+  }
+  return this->get_descriptor_set_layout(it->second);
+}
+
+auto PipelineLayoutCache::set_layout_count() const -> size_t {
+  return this->m_setLayouts.size();
+}
+
+auto PipelineLayoutCache::pipeline_layout_count() const -> size_t {
+  return this->m_pipelineLayouts.size();
+}
+
+auto PipelineLayoutCache::hit_count() const -> uint64_t {
+  return this->m_hits;
+}
+#pragma endregion
+} // namespace SFT::Renderer::VK
@@ -0,0 +1,132 @@
+//
+// Created by sturd on 10/18/2026.
+//
+
+#ifndef PIPELINELAYOUTCACHE_H
+#define PIPELINELAYOUTCACHE_H
+
+#include "SpirvReflection.h"
+#include "Core/Renderer/VK/VulkanDispatch.h"
+#include <cstdint>
+#include <expected>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using std::expected;
+using std::string;
+using std::unordered_map;
+using std::vector;
+
+namespace SFT::Renderer::VK {
+/*!
+ * @brief The parts of a VkDescriptorSetLayoutBinding that make two set layouts
+ * equal, immutable samplers are not reflected so they don't take part
+ */
+struct DescriptorBindingKey {
+  uint32_t binding;
+  VkDescriptorType type;
+  uint32_t count;
+  VkShaderStageFlags stages;
+
+  auto operator==(const DescriptorBindingKey &) const -> bool = default;
+};
+
+struct DescriptorSetLayoutKey {
+  vector<DescriptorBindingKey> bindings;
+
+  auto operator==(const DescriptorSetLayoutKey &) const -> bool = default;
+};
+
+/*!
+ * @brief Set layouts are hash-consed before pipeline layouts are, so a
+ * pipeline layout is fully described by its set layout handles and its push
+ * constant range
+ */
+struct PipelineLayoutKey {
+  vector<VkDescriptorSetLayout> setLayouts;
+  uint32_t pushOffset;
+  uint32_t pushSize;
+  VkShaderStageFlags pushStages;
+
+  auto operator==(const PipelineLayoutKey &) const -> bool = default;
+};
+
+struct DescriptorSetLayoutKeyHash {
+  auto operator()(const DescriptorSetLayoutKey &key) const -> size_t;
+};
+
+struct PipelineLayoutKeyHash {
+  auto operator()(const PipelineLayoutKey &key) const -> size_t;
+};
+
+/*!
+ * @brief Deduplicates descriptor set layouts and pipeline layouts, every
+ * pipeline whose shaders declare the same interface gets the very same
+ * handles, which keeps descriptor sets compatible across pipelines (no
+ * rebinding on pipeline switches) and keeps the number of Vulkan objects small
+ */
+class PipelineLayoutCache {
+private:
+  VkDevice m_device = VK_NULL_HANDLE;
+  unordered_map<DescriptorSetLayoutKey, VkDescriptorSetLayout,
+                DescriptorSetLayoutKeyHash>
+      m_setLayouts;
+  unordered_map<PipelineLayoutKey, VkPipelineLayout, PipelineLayoutKeyHash>
+      m_pipelineLayouts;
+  uint64_t m_hits = 0;
+  uint64_t m_misses = 0;
+
+public:
+  PipelineLayoutCache() = default;
+  ~PipelineLayoutCache() = default;
+  PipelineLayoutCache(const PipelineLayoutCache &) = delete;
+  auto operator=(const PipelineLayoutCache &) -> PipelineLayoutCache & = delete;
+
+  /*!
+   * @brief Binds the cache to a logical device, must be called before any
+   * layouts are requested
+   * @param device the logical device layouts are created on
+   */
+  auto init(VkDevice device) -> void;
+  /*!
+   * @brief Destroys every layout the cache created, call before the device is
+   * destroyed
+   */
+  auto destroy() -> void;
+  /*!
+   * @brief Returns the shared set layout for the given bindings, creating it
+   * on first use
+   * @param bindings the reflected bindings of a single set, sorted by binding
+   * @return On success, returns the set layout, on failure, returns unexpected
+   * with error message
+   */
+  auto get_descriptor_set_layout(std::span<const ReflectedBinding> bindings)
+      -> expected<VkDescriptorSetLayout, string>;
+  /*!
+   * @brief Returns the shared pipeline layout for a reflected program, sets the
+   * program skips are filled with the (equally shared) empty set layout
+   * @param program the merged reflection of every stage of the pipeline
+   * @return On success, returns the pipeline layout, on failure, returns
+   * unexpected with error message
+   */
+  auto get_pipeline_layout(const ShaderReflection &program)
+      -> expected<VkPipelineLayout, string>;
+  /*!
+   * @brief Looks up the set layouts of a pipeline layout previously returned by
+   * get_pipeline_layout, used to allocate descriptor sets against it
+   * @param program the same reflection the pipeline layout was built from
+   * @param set the set index
+   * @return On success, returns the set layout, on failure, returns unexpected
+   * with error message
+   */
+  auto get_set_layout_for(const ShaderReflection &program, uint32_t set)
+      -> expected<VkDescriptorSetLayout, string>;
+  [[nodiscard]] auto set_layout_count() const -> size_t;
+  [[nodiscard]] auto pipeline_layout_count() const -> size_t;
+  [[nodiscard]] auto hit_count() const -> uint64_t;
+};
+} // namespace SFT::Renderer::VK
+
+#endif // PIPELINELAYOUTCACHE_H
@@ -0,0 +1,614 @@
+//
+// Created by sturd on 10/18/2026.
+//
+
+#include "PipelineManager.h"
+
+#include "Core/Utility/Utility.h"
+#include "spdlog/spdlog.h"
+#include <algorithm>
+#include <fstream>
+#include <ranges>
+
+namespace SFT::Renderer::VK {
+#pragma region additional functions
+namespace {
+constexpr uint32_t ManifestMagic = 0x4D544653; // "SFTM"
+constexpr uint32_t ManifestVersion = 2;
+constexpr size_t ManifestRecordWords =
+    15 + 2 * Shaders::Shader::MaxSpecializationConstants +
+    MaxColorAttachments + 1;
+
+using KeyRecord = std::array<uint32_t, ManifestRecordWords>;
+
+using Utility::fnv1a;
+using Utility::read_file;
+
+auto serialize_key(const PipelineKey &key) -> KeyRecord {
+  const auto &state = key.state;
+  KeyRecord record{};
+  size_t i = 0;
+  record[i++] = static_cast<uint32_t>(key.vertexShader);
+  record[i++] = static_cast<uint32_t>(key.vertexShader >> 32);
+  record[i++] = static_cast<uint32_t>(key.fragmentShader);
+  record[i++] = static_cast<uint32_t>(key.fragmentShader >> 32);
+  const auto constants = key.permutation.constants();
+  record[i++] = static_cast<uint32_t>(constants.size());
+  for (uint32_t c = 0; c < Shaders::Shader::MaxSpecializationConstants; c++) {
+    record[i++] = c < constants.size() ? constants[c].id : 0;
+    record[i++] = c < constants.size() ? constants[c].value : 0;
+  }
+  record[i++] = state.topology;
+  record[i++] = state.polygonMode;
+  record[i++] = state.cullMode;
+  record[i++] = state.frontFace;
+  record[i++] = state.samples;
+  record[i++] = state.depthTest;
+  record[i++] = state.depthWrite;
+  record[i++] = state.depthCompare;
+  record[i++] = state.blendEnable;
+  record[i++] = state.colorFormatCount;
+  for (const auto format : state.colorFormats) {
+    record[i++] = format;
+  }
+  record[i++] = state.depthFormat;
+  return record;
+}
+
+auto deserialize_key(const KeyRecord &record) -> PipelineKey {
+  PipelineKey key{};
+  auto &state = key.state;
+  size_t i = 0;
+  key.vertexShader = record[i] | static_cast<uint64_t>(record[i + 1]) << 32;
+  i += 2;
+  key.fragmentShader = record[i] | static_cast<uint64_t>(record[i + 1]) << 32;
+  i += 2;
+  const uint32_t constantCount =
+      std::min(record[i++], Shaders::Shader::MaxSpecializationConstants);
+  for (uint32_t c = 0; c < Shaders::Shader::MaxSpecializationConstants; c++) {
+    if (c < constantCount) {
+      (void)key.permutation.set(record[i], record[i + 1]);
+    }
+    i += 2;
+  }
+  state.topology = static_cast<VkPrimitiveTopology>(record[i++]);
+  state.polygonMode = static_cast<VkPolygonMode>(record[i++]);
+  state.cullMode = record[i++];
+  state.frontFace = static_cast<VkFrontFace>(record[i++]);
+  state.samples = static_cast<VkSampleCountFlagBits>(record[i++]);
+  state.depthTest = record[i++];
+  state.depthWrite = record[i++];
+  state.depthCompare = static_cast<VkCompareOp>(record[i++]);
+  state.blendEnable = record[i++];
+  state.colorFormatCount = std::min(record[i++], MaxColorAttachments);
+  for (auto &format : state.colorFormats) {
+    format = static_cast<VkFormat>(record[i++]);
+  }
+  state.depthFormat = static_cast<VkFormat>(record[i++]);
+  return key;
+}
+
+auto to_vk_stage(const Shaders::Shader::ShaderStage stage)
+    -> VkShaderStageFlagBits {
+  using Shaders::Shader::ShaderStage;
+  switch (stage) {
+  case ShaderStage::Vertex:
+    return VK_SHADER_STAGE_VERTEX_BIT;
+  case ShaderStage::TessellationControl:
+    return VK_SHADER_STAGE_TESSELLATION_CONTROL_BIT;
+  case ShaderStage::TessellationEvaluation:
+    return VK_SHADER_STAGE_TESSELLATION_EVALUATION_BIT;
+  case ShaderStage::Geometry:
+    return VK_SHADER_STAGE_GEOMETRY_BIT;
+  case ShaderStage::Fragment:
+    return VK_SHADER_STAGE_FRAGMENT_BIT;
+  case ShaderStage::Compute:
+  default:
+    return VK_SHADER_STAGE_COMPUTE_BIT;
+  }
+}
+
+auto write_binary(const string &path, const void *data, const size_t size)
+    -> bool {
+  std::ofstream file(path, std::ios::binary | std::ios::trunc);
+  if (!file.is_open()) {
+    return false;
+  }
+  file.write(static_cast<const char *>(data),
+             static_cast<std::streamsize>(size));
+  return file.good();
+}
+} // namespace
+#pragma endregion
+
+#pragma region PipelineKeyHash Functions
+auto PipelineKeyHash::operator()(const PipelineKey &key) const -> size_t {
+  const KeyRecord record = serialize_key(key);
+  return fnv1a(record.data(), sizeof(record));
+}
+#pragma endregion
+
+#pragma region PipelineManager Functions
+auto PipelineManager::init(VkDevice device, PipelineLayoutCache *layoutCache,
+                           const string &cachePath,
+                           const uint32_t workerCount)
+    -> expected<void, string> {
+  this->m_device = device;
+  this->m_layoutCache = layoutCache;
+
+  const auto cacheData = read_file(cachePath);
+  VkPipelineCacheCreateInfo createInfo{};
+  createInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+  if (cacheData.has_value()) {
+    // the driver validates the header and ignores blobs from other devices or
+    // driver versions
+    createInfo.initialDataSize = cacheData->size();
+    createInfo.pInitialData = cacheData->data();
+  }
+  if (vkCreatePipelineCache(device, &createInfo, nullptr,
+                            &this->m_pipelineCache) != VK_SUCCESS) {
+    createInfo.initialDataSize = 0;
+    createInfo.pInitialData = nullptr;
+    if (vkCreatePipelineCache(device, &createInfo, nullptr,
+                              &this->m_pipelineCache) != VK_SUCCESS) {
+      return unexpected("failed to create pipeline cache!");
+    }
+  }
+  spdlog::debug("Pipeline cache seeded with {} bytes",
+                createInfo.initialDataSize);
+  this->m_compilers = std::make_unique<Threading::ThreadPool>(workerCount);
+  return {};
+}
+
+auto PipelineManager::shutdown(const string &cachePath,
+                               const string &manifestPath) -> void {
+  // finishes whatever is still queued, nothing may be destroyed under a worker
+  this->m_compilers.reset();
+
+  size_t cacheSize = 0;
+  vkGetPipelineCacheData(this->m_device, this->m_pipelineCache, &cacheSize,
+                         nullptr);
+  vector<char> cacheData(cacheSize);
+  if (cacheSize != 0 &&
+      vkGetPipelineCacheData(this->m_device, this->m_pipelineCache, &cacheSize,
+                             cacheData.data()) == VK_SUCCESS) {
+    if (!write_binary(cachePath, cacheData.data(), cacheSize)) {
+      spdlog::warn("Failed to write pipeline cache to \"{}\"", cachePath);
+    }
+  }
+  if (auto result = this->save_manifest(manifestPath); !result.has_value()) {
+    spdlog::warn("Failed to write pipeline manifest: {}", result.error());
+  }
+
+  for (const auto &entry : this->m_pipelines | std::views::values) {
+    if (VkPipeline pipeline = entry->pipeline.load();
+        pipeline != VK_NULL_HANDLE) {
+      vkDestroyPipeline(this->m_device, pipeline, nullptr);
+    }
+  }
+  for (const auto &shader : this->m_shaders | std::views::values) {
+    vkDestroyShaderModule(this->m_device, shader.module, nullptr);
+  }
+  vkDestroyPipelineCache(this->m_device, this->m_pipelineCache, nullptr);
+  this->m_pipelines.clear();
+  this->m_fallbacks.clear();
+  this->m_shaders.clear();
+}
+
+auto PipelineManager::register_shader(
+    const Shaders::Shader::Shader &shader,
+    const Shaders::Shader::ShaderStage stage) -> expected<uint64_t, string> {
+  if (!shader.has_stage(stage)) {
+    return unexpected("shader has no code for the requested stage");
+  }
+  const std::span<const uint32_t> code = shader.get_stage(stage);
+  const uint64_t hash = shader.stage_hash(stage);
+  const VkShaderStageFlagBits vkStage = to_vk_stage(stage);
+  std::lock_guard lock(this->m_mutex);
+  if (this->m_shaders.contains(hash)) {
+    return hash;
+  }
+  auto reflection = reflect_spirv(code);
+  if (!reflection.has_value()) {
+    return unexpected("failed to reflect shader: " + reflection.error());
+  }
+  if (reflection->stages != static_cast<VkShaderStageFlags>(vkStage)) {
+    return unexpected("shader entry point doesn't match the requested stage");
+  }
+
+  VkShaderModuleCreateInfo createInfo{};
+  createInfo.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
+  createInfo.codeSize = code.size_bytes();
+  createInfo.pCode = code.data();
+  VkShaderModule module;
+  if (vkCreateShaderModule(this->m_device, &createInfo, nullptr, &module) !=
+      VK_SUCCESS) {
+    return unexpected("failed to create shader module!");
+  }
+  const auto specializationIds = shader.specialization_ids(stage);
+  this->m_shaders.emplace(
+      hash, ShaderEntry{vkStage, module, std::move(reflection.value()),
+                        {specializationIds.begin(), specializationIds.end()}});
+
+  // manifest entries waiting on this shader can be compiled now
+  std::erase_if(this->m_deferredPrewarm, [this](const PipelineKey &key) {
+    if (!this->keys_resolvable(key)) {
+      return false;
+    }
+    if (auto entry = this->get_or_queue(key); !entry.has_value()) {
+      spdlog::warn("Failed to pre-warm pipeline: {}", entry.error());
+      this->m_manifest.erase(key);
+    }
+    return true;
+  });
+  return hash;
+}
+
+auto PipelineManager::keys_resolvable(const PipelineKey &key) const -> bool {
+  return this->m_shaders.contains(key.vertexShader) &&
+         (key.fragmentShader == 0 ||
+          this->m_shaders.contains(key.fragmentShader));
+}
+
+auto PipelineManager::validate_permutation(const PipelineKey &key) const
+    -> expected<void, string> {
+  // catches typos in feature ids before a pipeline is built with them
+  const auto declares = [this](const uint64_t shader, const uint32_t id) {
+    return shader != 0 && std::ranges::binary_search(
+                              this->m_shaders.at(shader).specializationIds, id);
+  };
+  for (const auto &constant : key.permutation.constants()) {
+    if (!declares(key.vertexShader, constant.id) &&
+        !declares(key.fragmentShader, constant.id)) {
+      return unexpected("specialization constant " +
+                        std::to_string(constant.id) +
+                        " is not declared by any stage");
+    }
+  }
+  return {};
+}
+
+auto PipelineManager::fallback_signature(const GraphicsPipelineState &state,
+                                         VkPipelineLayout layout)
+    -> uint64_t {
+  uint64_t hash = fnv1a(&state.samples, sizeof(state.samples));
+  hash = fnv1a(&state.colorFormatCount, sizeof(state.colorFormatCount), hash);
+  hash = fnv1a(state.colorFormats.data(),
+               state.colorFormatCount * sizeof(VkFormat), hash);
+  hash = fnv1a(&state.depthFormat, sizeof(state.depthFormat), hash);
+  // layouts are deduplicated by the layout cache, the same handle means the
+  // same descriptor sets and push constants
+  return fnv1a(&layout, sizeof(layout), hash);
+}
+
+auto PipelineManager::get_or_queue(const PipelineKey &key)
+    -> expected<PipelineEntry *, string> {
+  if (const auto it = this->m_pipelines.find(key);
+      it != this->m_pipelines.end()) {
+    return it->second.get();
+  }
+  if (!this->keys_resolvable(key)) {
+    return unexpected("pipeline references a shader that isn't registered");
+  }
+  if (auto valid = this->validate_permutation(key); !valid.has_value()) {
+    return unexpected(valid.error());
+  }
+  const ShaderEntry &vertex = this->m_shaders.at(key.vertexShader);
+  ShaderReflection program = vertex.reflection;
+  VkShaderModule fragmentModule = VK_NULL_HANDLE;
+  if (key.fragmentShader != 0) {
+    const ShaderEntry &fragment = this->m_shaders.at(key.fragmentShader);
+    if (auto merged = program.merge(fragment.reflection); !merged.has_value()) {
+      return unexpected(merged.error());
+    }
+    fragmentModule = fragment.module;
+  }
+  auto layout = this->m_layoutCache->get_pipeline_layout(program);
+  if (!layout.has_value()) {
+    return unexpected(layout.error());
+  }
+
+  auto entry = std::make_unique<PipelineEntry>();
+  entry->layout = layout.value();
+  PipelineEntry *queued = entry.get();
+  this->m_pipelines.emplace(key, std::move(entry));
+
+  this->m_inFlight++;
+  this->m_compilers->submit([this, key, queued, vertexModule = vertex.module,
+                             fragmentModule] {
+    auto pipeline =
+        this->compile(key, queued->layout, vertexModule, fragmentModule);
+    if (pipeline.has_value()) {
+      queued->pipeline.store(pipeline.value());
+      queued->status.store(PipelineStatus::Ready);
+    } else {
+      spdlog::error("Failed to compile pipeline: {}", pipeline.error());
+      queued->status.store(PipelineStatus::Failed);
+    }
+    queued->status.notify_all();
+    this->m_inFlight--;
+  });
+  return queued;
+}
+
+auto PipelineManager::compile(const PipelineKey &key,
+                              const VkPipelineLayout layout,
+                              const VkShaderModule vertexModule,
+                              const VkShaderModule fragmentModule) const
+    -> expected<VkPipeline, string> {
+  const auto &state = key.state;
+
+  // feature variants are specialized here instead of being shipped as
+  // separate binaries, constants a stage doesn't declare are ignored by it
+  const auto constants = key.permutation.constants();
+  std::array<VkSpecializationMapEntry,
+             Shaders::Shader::MaxSpecializationConstants>
+      mapEntries{};
+  std::array<uint32_t, Shaders::Shader::MaxSpecializationConstants> values{};
+  for (uint32_t i = 0; i < constants.size(); i++) {
+    mapEntries[i].constantID = constants[i].id;
+    mapEntries[i].offset = i * sizeof(uint32_t);
+    mapEntries[i].size = sizeof(uint32_t);
+    values[i] = constants[i].value;
+  }
+  VkSpecializationInfo specialization{};
+  specialization.mapEntryCount = static_cast<uint32_t>(constants.size());
+  specialization.pMapEntries = mapEntries.data();
+  specialization.dataSize = constants.size() * sizeof(uint32_t);
+  specialization.pData = values.data();
+  const VkSpecializationInfo *pSpecialization =
+      constants.empty() ? nullptr : &specialization;
+
+  VkPipelineShaderStageCreateInfo stages[2]{};
+  uint32_t stageCount = 1;
+  stages[0].sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+  stages[0].stage = VK_SHADER_STAGE_VERTEX_BIT;
+  stages[0].module = vertexModule;
+  stages[0].pName = "main";
+  stages[0].pSpecializationInfo = pSpecialization;
+  if (fragmentModule != VK_NULL_HANDLE) {
+    stages[1].sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+    stages[1].stage = VK_SHADER_STAGE_FRAGMENT_BIT;
+    stages[1].module = fragmentModule;
+    stages[1].pName = "main";
+    stages[1].pSpecializationInfo = pSpecialization;
+    stageCount++;
+  }
+
+  // vertices are pulled from storage buffers, there is no fixed vertex input
+  VkPipelineVertexInputStateCreateInfo vertexInput{};
+  vertexInput.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
+
+  VkPipelineInputAssemblyStateCreateInfo inputAssembly{};
+  inputAssembly.sType =
+      VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO;
+  inputAssembly.topology = state.topology;
+
+  VkPipelineViewportStateCreateInfo viewportState{};
+  viewportState.sType = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO;
+  viewportState.viewportCount = 1;
+  viewportState.scissorCount = 1;
+
+  VkPipelineRasterizationStateCreateInfo rasterizer{};
+  rasterizer.sType = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO;
+  rasterizer.polygonMode = state.polygonMode;
+  rasterizer.cullMode = state.cullMode;
+  rasterizer.frontFace = state.frontFace;
+  rasterizer.lineWidth = 1.0f;
+
+  VkPipelineMultisampleStateCreateInfo multisampling{};
+  multisampling.sType =
+      VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO;
+  multisampling.rasterizationSamples = state.samples;
+
+  VkPipelineDepthStencilStateCreateInfo depthStencil{};
+  depthStencil.sType =
+      VK_STRUCTURE_TYPE_PIPELINE_DEPTH_STENCIL_STATE_CREATE_INFO;
+  depthStencil.depthTestEnable = state.depthTest;
+  depthStencil.depthWriteEnable = state.depthWrite;
+  depthStencil.depthCompareOp = state.depthCompare;
+
+  std::array<VkPipelineColorBlendAttachmentState, MaxColorAttachments>
+      blendAttachments{};
+  for (uint32_t i = 0; i < state.colorFormatCount; i++) {
+    auto &attachment = blendAttachments[i];
+    attachment.colorWriteMask =
+        VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT |
+        VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT;
+    attachment.blendEnable = state.blendEnable;
+    attachment.srcColorBlendFactor = VK_BLEND_FACTOR_SRC_ALPHA;
+    attachment.dstColorBlendFactor = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
+    attachment.colorBlendOp = VK_BLEND_OP_ADD;
+    attachment.srcAlphaBlendFactor = VK_BLEND_FACTOR_ONE;
+    attachment.dstAlphaBlendFactor = VK_BLEND_FACTOR_ZERO;
+    attachment.alphaBlendOp = VK_BLEND_OP_ADD;
+  }
+  VkPipelineColorBlendStateCreateInfo colorBlending{};
+  colorBlending.sType = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO;
+  colorBlending.attachmentCount = state.colorFormatCount;
+  colorBlending.pAttachments = blendAttachments.data();
+
+  constexpr VkDynamicState dynamicStates[] = {VK_DYNAMIC_STATE_VIEWPORT,
+                                              VK_DYNAMIC_STATE_SCISSOR};
+  VkPipelineDynamicStateCreateInfo dynamicState{};
+  dynamicState.sType = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO;
+  dynamicState.dynamicStateCount = 2;
+  dynamicState.pDynamicStates = dynamicStates;
+
+  VkPipelineRenderingCreateInfo renderingInfo{};
+  renderingInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_RENDERING_CREATE_INFO;
+  renderingInfo.colorAttachmentCount = state.colorFormatCount;
+  renderingInfo.pColorAttachmentFormats = state.colorFormats.data();
+  renderingInfo.depthAttachmentFormat = state.depthFormat;
+
+  VkGraphicsPipelineCreateInfo pipelineInfo{};
+  pipelineInfo.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
+  pipelineInfo.pNext = &renderingInfo;
+  pipelineInfo.stageCount = stageCount;
+  pipelineInfo.pStages = stages;
+  pipelineInfo.pVertexInputState = &vertexInput;
+  pipelineInfo.pInputAssemblyState = &inputAssembly;
+  pipelineInfo.pViewportState = &viewportState;
+  pipelineInfo.pRasterizationState = &rasterizer;
+  pipelineInfo.pMultisampleState = &multisampling;
+  pipelineInfo.pDepthStencilState = &depthStencil;
+  pipelineInfo.pColorBlendState = &colorBlending;
+  pipelineInfo.pDynamicState = &dynamicState;
+  pipelineInfo.layout = layout;
+
+  VkPipeline pipeline;
+  // the pipeline cache is internally synchronized, workers share it
+  if (vkCreateGraphicsPipelines(this->m_device, this->m_pipelineCache, 1,
+                                &pipelineInfo, nullptr,
+                                &pipeline) != VK_SUCCESS) {
+    return unexpected("failed to create graphics pipeline!");
+  }
+  return pipeline;
+}
+
+auto PipelineManager::set_fallback(const PipelineKey &key)
+    -> expected<void, string> {
+  PipelineEntry *entry = nullptr;
+  {
+    std::lock_guard lock(this->m_mutex);
+    auto queued = this->get_or_queue(key);
+    if (!queued.has_value()) {
+      return unexpected(queued.error());
+    }
+    entry = queued.value();
+  }
+  // the fallback must exist before anything can fall back to it, entries live
+  // until shutdown so it's waited on without holding up other requests
+  entry->status.wait(PipelineStatus::Queued);
+  if (entry->status.load() == PipelineStatus::Failed) {
+    return unexpected("fallback pipeline failed to compile");
+  }
+  std::lock_guard lock(this->m_mutex);
+  this->m_fallbacks[fallback_signature(key.state, entry->layout)] =
+      entry->pipeline.load();
+  return {};
+}
+
+auto PipelineManager::request(const PipelineKey &key)
+    -> expected<VkPipeline, string> {
+  std::lock_guard lock(this->m_mutex);
+  auto entry = this->get_or_queue(key);
+  if (!entry.has_value()) {
+    return unexpected(entry.error());
+  }
+  // only keys that got as far as compiling are recorded, the ones that fail
+  // to compile are dropped again when the manifest is written
+  this->m_manifest.insert(key);
+  switch (entry.value()->status.load()) {
+  case PipelineStatus::Ready:
+    return entry.value()->pipeline.load();
+  case PipelineStatus::Failed:
+    return unexpected("pipeline failed to compile");
+  case PipelineStatus::Queued:
+  default:
+    break;
+  }
+  const auto fallback = this->m_fallbacks.find(
+      fallback_signature(key.state, entry.value()->layout));
+  return fallback != this->m_fallbacks.end() ? fallback->second
+                                             : VK_NULL_HANDLE;
+}
+
+auto PipelineManager::layout_for(const PipelineKey &key)
+    -> expected<VkPipelineLayout, string> {
+  std::lock_guard lock(this->m_mutex);
+  auto entry = this->get_or_queue(key);
+  if (!entry.has_value()) {
+    return unexpected(entry.error());
+  }
+  return entry.value()->layout;
+}
+
+auto PipelineManager::status(const PipelineKey &key) -> PipelineStatus {
+  std::lock_guard lock(this->m_mutex);
+  const auto it = this->m_pipelines.find(key);
+  if (it == this->m_pipelines.end()) {
+    return PipelineStatus::Queued;
+  }
+  return it->second->status.load();
+}
+
+auto PipelineManager::prewarm_from_manifest(const string &manifestPath)
+    -> expected<size_t, string> {
+  const auto data = read_file(manifestPath);
+  if (!data.has_value()) {
+    // first launch, nothing recorded yet
+    return 0;
+  }
+  const size_t words = data->size() / sizeof(uint32_t);
+  const auto *header = reinterpret_cast<const uint32_t *>(data->data());
+  if (words < 4 || header[0] != ManifestMagic ||
+      header[1] != ManifestVersion || header[3] != ManifestRecordWords) {
+    return unexpected("pipeline manifest is corrupt or from another version");
+  }
+  const uint32_t count = header[2];
+  if (words < 4 + static_cast<size_t>(count) * ManifestRecordWords) {
+    return unexpected("pipeline manifest is truncated");
+  }
+
+  std::lock_guard lock(this->m_mutex);
+  for (uint32_t i = 0; i < count; i++) {
+    KeyRecord record;
+    std::copy_n(header + 4 + i * ManifestRecordWords, ManifestRecordWords,
+                record.begin());
+    const PipelineKey key = deserialize_key(record);
+    if (!this->keys_resolvable(key)) {
+      // kept so the record survives a session that never registers its
+      // shaders, see save_manifest
+      this->m_manifest.insert(key);
+      this->m_deferredPrewarm.push_back(key);
+      continue;
+    }
+    if (auto entry = this->get_or_queue(key); !entry.has_value()) {
+      spdlog::warn("Failed to pre-warm pipeline: {}", entry.error());
+      continue;
+    }
+    this->m_manifest.insert(key);
+  }
+  spdlog::info("Pre-warming {} pipeline(s) from \"{}\"", count, manifestPath);
+  return count;
+}
+
+auto PipelineManager::save_manifest(const string &manifestPath)
+    -> expected<void, string> {
+  std::lock_guard lock(this->m_mutex);
+  vector<uint32_t> words = {ManifestMagic, ManifestVersion, 0,
+                            ManifestRecordWords};
+  uint32_t count = 0;
+  for (const auto &key : this->m_manifest) {
+    // keys whose shaders weren't registered this session are carried through
+    // as they were loaded, a short session mustn't forget what longer ones
+    // used, only pipelines that failed to compile are dropped
+    if (const auto it = this->m_pipelines.find(key);
+        it != this->m_pipelines.end() &&
+        it->second->status.load() == PipelineStatus::Failed) {
+      continue;
+    }
+    const KeyRecord record = serialize_key(key);
+    words.insert(words.end(), record.begin(), record.end());
+    count++;
+  }
+  words[2] = count;
+  if (!write_binary(manifestPath, words.data(),
+                    words.size() * sizeof(uint32_t))) {
+    return unexpected("failed to write \"" + manifestPath + "\"");
+  }
+  return {};
+}
+
+auto PipelineManager::compiles_in_flight() const -> uint32_t {
+  return this->m_inFlight.load();
+}
+
+auto PipelineManager::wait_idle() -> void {
+  if (this->m_compilers) {
+    this->m_compilers->wait_idle();
+  }
+}
+#pragma endregion
+} // namespace SFT::Renderer::VK
@@ -0,0 +1,229 @@
+//
+// Created by sturd on 10/18/2026.
+//
+
+#ifndef PIPELINEMANAGER_H
+#define PIPELINEMANAGER_H
+
+#include "Core/Shaders/Shader/Shader.h"
+#include "Core/Threading/ThreadPool.h"
+#include "PipelineLayoutCache.h"
+#include "SpirvReflection.h"
+#include "Core/Renderer/VK/VulkanDispatch.h"
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <expected>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+using std::expected;
+using std::string;
+using std::unexpected;
+using std::unordered_map;
+using std::vector;
+
+namespace SFT::Renderer::VK {
+constexpr uint32_t MaxColorAttachments = 8;
+
+/*!
+ * @brief The fixed function state a graphics pipeline is baked with, viewport
+ * and scissor are always dynamic so pipelines don't depend on the render size,
+ * pipelines render through dynamic rendering so only attachment formats matter
+ */
+struct GraphicsPipelineState {
+  VkPrimitiveTopology topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+  VkPolygonMode polygonMode = VK_POLYGON_MODE_FILL;
+  VkCullModeFlags cullMode = VK_CULL_MODE_BACK_BIT;
+  VkFrontFace frontFace = VK_FRONT_FACE_CLOCKWISE;
+  VkSampleCountFlagBits samples = VK_SAMPLE_COUNT_1_BIT;
+  VkBool32 depthTest = VK_FALSE;
+  VkBool32 depthWrite = VK_FALSE;
+  // reversed Z, near is 1 and far is 0
+  VkCompareOp depthCompare = VK_COMPARE_OP_GREATER_OR_EQUAL;
+  VkBool32 blendEnable = VK_FALSE;
+  uint32_t colorFormatCount = 0;
+  std::array<VkFormat, MaxColorAttachments> colorFormats{};
+  VkFormat depthFormat = VK_FORMAT_UNDEFINED;
+
+  auto operator==(const GraphicsPipelineState &) const -> bool = default;
+};
+
+/*!
+ * @brief Everything needed to build a pipeline, shaders are referenced by the
+ * content hash register_shader returned for them, so a key is plain data that
+ * can be written to the manifest and resolved again on the next launch, the
+ * permutation's specialization constants apply to every stage
+ */
+struct PipelineKey {
+  uint64_t vertexShader = 0;
+  uint64_t fragmentShader = 0;
+  Shaders::Shader::ShaderPermutation permutation{};
+  GraphicsPipelineState state{};
+
+  auto operator==(const PipelineKey &) const -> bool = default;
+};
+
+struct PipelineKeyHash {
+  auto operator()(const PipelineKey &key) const -> size_t;
+};
+
+enum class PipelineStatus : uint8_t {
+  Queued,
+  Ready,
+  Failed,
+};
+
+/*!
+ * @brief Owns every graphics pipeline the renderer uses, pipelines are
+ * compiled on worker threads and a fallback is served until they are ready so
+ * that the first use of a new material never hitches the frame, every key used
+ * is recorded to a manifest which is pre-compiled in the background on the
+ * next launch
+ */
+class PipelineManager {
+private:
+  struct ShaderEntry {
+    VkShaderStageFlagBits stage;
+    VkShaderModule module;
+    ShaderReflection reflection;
+    // the SpecId decorations of the stage, sorted
+    vector<uint32_t> specializationIds;
+  };
+  struct PipelineEntry {
+    VkPipelineLayout layout = VK_NULL_HANDLE;
+    std::atomic<VkPipeline> pipeline = VK_NULL_HANDLE;
+    std::atomic<PipelineStatus> status = PipelineStatus::Queued;
+  };
+
+  VkDevice m_device = VK_NULL_HANDLE;
+  VkPipelineCache m_pipelineCache = VK_NULL_HANDLE;
+  PipelineLayoutCache *m_layoutCache = nullptr;
+  std::unique_ptr<Threading::ThreadPool> m_compilers;
+  std::atomic<uint32_t> m_inFlight = 0;
+
+  // guards everything below, workers only ever touch their own entry
+  std::mutex m_mutex;
+  unordered_map<uint64_t, ShaderEntry> m_shaders;
+  unordered_map<PipelineKey, std::unique_ptr<PipelineEntry>, PipelineKeyHash>
+      m_pipelines;
+  // keyed by fallback_signature, a fallback only stands in for pipelines it
+  // can be bound in place of
+  unordered_map<uint64_t, VkPipeline> m_fallbacks;
+  std::unordered_set<PipelineKey, PipelineKeyHash> m_manifest;
+  vector<PipelineKey> m_deferredPrewarm;
+
+  auto get_or_queue(const PipelineKey &key)
+      -> expected<PipelineEntry *, string>;
+  auto compile(const PipelineKey &key, VkPipelineLayout layout,
+               VkShaderModule vertexModule,
+               VkShaderModule fragmentModule) const
+      -> expected<VkPipeline, string>;
+  auto keys_resolvable(const PipelineKey &key) const -> bool;
+  auto validate_permutation(const PipelineKey &key) const
+      -> expected<void, string>;
+  static auto fallback_signature(const GraphicsPipelineState &state,
+                                 VkPipelineLayout layout) -> uint64_t;
+
+public:
+  PipelineManager() = default;
+  ~PipelineManager() = default;
+  PipelineManager(const PipelineManager &) = delete;
+  auto operator=(const PipelineManager &) -> PipelineManager & = delete;
+
+  /*!
+   * @brief Creates the pipeline cache (seeded from disk when possible) and the
+   * compiler threads
+   * @param device the logical device pipelines are created on
+   * @param layoutCache the cache pipeline layouts are deduplicated through
+   * @param cachePath where the VkPipelineCache blob is persisted
+   * @param workerCount how many compiler threads to spawn
+   * @return On success, returns void, on failure, returns unexpected with error
+   * message
+   */
+  auto init(VkDevice device, PipelineLayoutCache *layoutCache,
+            const string &cachePath, uint32_t workerCount)
+      -> expected<void, string>;
+  /*!
+   * @brief Waits for in flight compiles, persists the pipeline cache and the
+   * manifest, then destroys every pipeline and shader module
+   * @param cachePath where the VkPipelineCache blob is persisted
+   * @param manifestPath where the manifest of used pipelines is written
+   */
+  auto shutdown(const string &cachePath, const string &manifestPath) -> void;
+  /*!
+   * @brief Creates a shader module for one stage of a shader and reflects it,
+   * registering the same code twice returns the same hash without creating a
+   * second module
+   * @param shader the shader owning the code
+   * @param stage the stage of the shader to register
+   * @return On success, returns the content hash pipelines reference the
+   * stage by, on failure, returns unexpected with error message
+   */
+  auto register_shader(const Shaders::Shader::Shader &shader,
+                       Shaders::Shader::ShaderStage stage)
+      -> expected<uint64_t, string>;
+  /*!
+   * @brief Compiles a pipeline synchronously and serves it in place of any
+   * pipeline with the same attachment formats and pipeline layout while those
+   * are compiling, the shared layout keeps descriptor sets and push constants
+   * bound for the requested pipeline valid for the fallback
+   * @param key the pipeline to use as the fallback
+   * @return On success, returns void, on failure, returns unexpected with error
+   * message
+   */
+  auto set_fallback(const PipelineKey &key) -> expected<void, string>;
+  /*!
+   * @brief Returns the pipeline for the key, the first request queues it for
+   * compilation and records it in the manifest, until it is ready the fallback
+   * for its attachment formats and layout is returned, or VK_NULL_HANDLE if
+   * there is none in which case the draw should be skipped
+   * @param key the pipeline to get
+   * @return On success, returns the pipeline to bind, on failure (the shaders
+   * are unknown, the permutation overrides a constant neither stage declares
+   * or the pipeline failed to compile), returns unexpected with error message
+   */
+  auto request(const PipelineKey &key) -> expected<VkPipeline, string>;
+  /*!
+   * @brief Returns the shared layout of the pipeline for the key, it is known
+   * as soon as the pipeline is requested, long before the pipeline is ready
+   * @param key the pipeline whose layout to get
+   * @return On success, returns the layout, on failure, returns unexpected
+   * with error message
+   */
+  auto layout_for(const PipelineKey &key) -> expected<VkPipelineLayout, string>;
+  [[nodiscard]] auto status(const PipelineKey &key) -> PipelineStatus;
+  /*!
+   * @brief Reads a manifest written by a previous session and queues every
+   * pipeline in it for background compilation, entries whose shaders aren't
+   * registered yet are compiled as soon as those shaders are registered
+   * @param manifestPath the manifest to read
+   * @return On success, returns how many pipelines were queued or deferred, on
+   * failure, returns unexpected with error message
+   */
+  auto prewarm_from_manifest(const string &manifestPath)
+      -> expected<size_t, string>;
+  /*!
+   * @brief Writes every pipeline used this session to the manifest along with
+   * every entry loaded from older sessions, whether or not its shaders were
+   * registered this session, pipelines that failed to compile are dropped
+   * @param manifestPath the manifest to write
+   * @return On success, returns void, on failure, returns unexpected with error
+   * message
+   */
+  auto save_manifest(const string &manifestPath) -> expected<void, string>;
+  [[nodiscard]] auto compiles_in_flight() const -> uint32_t;
+  /*!
+   * @brief Blocks until every queued pipeline is compiled, meant for loading
+   * screens that would rather wait than show fallbacks
+   */
+  auto wait_idle() -> void;
+};
+} // namespace SFT::Renderer::VK
+
+#endif // PIPELINEMANAGER_H
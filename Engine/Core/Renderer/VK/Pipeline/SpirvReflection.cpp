@@ -0,0 +1,522 @@
+//
+// Created by sturd on 10/18/2026.
+//
+
+#include "SpirvReflection.h"
+
+#include <algorithm>
+#include <fmt/format.h>
+#include <ranges>
+
+namespace SFT::Renderer::VK {
+#pragma region additional functions
+namespace {
+// the handful of SPIR-V enumerants we need, taken from the SPIR-V spec, we
+// don't pull in spirv.hpp just for these
+constexpr uint32_t SpvMagicNumber = 0x07230203;
+constexpr uint32_t SpvHeaderWords = 5;
+
+enum SpvOp : uint32_t {
+  OpEntryPoint = 15,
+  OpTypeInt = 21,
+  OpTypeFloat = 22,
+  OpTypeVector = 23,
+  OpTypeMatrix = 24,
+  OpTypeImage = 25,
+  OpTypeSampler = 26,
+  OpTypeSampledImage = 27,
+  OpTypeArray = 28,
+  OpTypeRuntimeArray = 29,
+  OpTypeStruct = 30,
+  OpTypePointer = 32,
+  OpConstant = 43,
+  OpSpecConstantTrue = 48,
+  OpSpecConstantFalse = 49,
+  OpSpecConstant = 50,
+  OpSpecConstantComposite = 51,
+  OpSpecConstantOp = 52,
+  OpVariable = 59,
+  OpDecorate = 71,
+  OpMemberDecorate = 72,
+  OpTypeAccelerationStructureKHR = 5341,
+};
+
+enum SpvDecoration : uint32_t {
+  DecorationBlock = 2,
+  DecorationBufferBlock = 3,
+  DecorationArrayStride = 6,
+  DecorationMatrixStride = 7,
+  DecorationBinding = 33,
+  DecorationDescriptorSet = 34,
+  DecorationOffset = 35,
+};
+
+enum SpvStorageClass : uint32_t {
+  StorageClassUniformConstant = 0,
+  StorageClassUniform = 2,
+  StorageClassPushConstant = 9,
+  StorageClassStorageBuffer = 12,
+};
+
+enum SpvDim : uint32_t {
+  DimBuffer = 5,
+  DimSubpassData = 6,
+};
+
+constexpr uint32_t NoValue = ~0u;
+// types nest far less than this, deeper means the module refers to itself
+constexpr uint32_t MaxTypeDepth = 64;
+
+/*!
+ * @brief What we remember about a single result id, types keep their operands
+ * (everything after the result id) and constants keep their value
+ */
+struct SpvId {
+  uint32_t opcode = 0;
+  vector<uint32_t> operands;
+  uint32_t set = NoValue;
+  uint32_t binding = NoValue;
+  uint32_t arrayStride = 0;
+  bool block = false;
+  bool bufferBlock = false;
+  map<uint32_t, uint32_t> memberOffsets;
+  map<uint32_t, uint32_t> memberMatrixStrides;
+};
+
+struct SpvVariable {
+  uint32_t id;
+  uint32_t pointerType;
+  uint32_t storageClass;
+};
+
+auto execution_model_to_stage(const uint32_t model) -> VkShaderStageFlags {
+  switch (model) {
+  case 0:
+    return VK_SHADER_STAGE_VERTEX_BIT;
+  case 1:
+    return VK_SHADER_STAGE_TESSELLATION_CONTROL_BIT;
+  case 2:
+    return VK_SHADER_STAGE_TESSELLATION_EVALUATION_BIT;
+  case 3:
+    return VK_SHADER_STAGE_GEOMETRY_BIT;
+  case 4:
+    return VK_SHADER_STAGE_FRAGMENT_BIT;
+  case 5:
+    return VK_SHADER_STAGE_COMPUTE_BIT;
+  case 5364:
+    return VK_SHADER_STAGE_TASK_BIT_EXT;
+  case 5365:
+    return VK_SHADER_STAGE_MESH_BIT_EXT;
+  default:
+    return 0;
+  }
+}
+
+/*!
+ * @brief Reads an operand of an id, checking the id and the operand exist so
+ * malformed modules fail instead of reading out of bounds
+ */
+auto operand(const vector<SpvId> &ids, const uint32_t id, const size_t index)
+    -> expected<uint32_t, string> {
+  if (id >= ids.size()) {
+    return unexpected(fmt::format("SPIR-V id {} out of bounds", id));
+  }
+  if (index >= ids[id].operands.size()) {
+    return unexpected(fmt::format(
+        "SPIR-V id {} (opcode {}) has no operand {}", id, ids[id].opcode,
+        index));
+  }
+  return ids[id].operands[index];
+}
+
+/*!
+ * @brief The length of an OpTypeArray, specialization constants count with
+ * their default value since that is what a pipeline without specialization
+ * info gets
+ */
+auto array_length(const vector<SpvId> &ids, const uint32_t arrayType)
+    -> expected<uint32_t, string> {
+  auto lengthId = operand(ids, arrayType, 1);
+  if (!lengthId.has_value()) {
+    return unexpected(lengthId.error());
+  }
+  const uint32_t opcode =
+      lengthId.value() < ids.size() ? ids[lengthId.value()].opcode : 0;
+  if (opcode != OpConstant && opcode != OpSpecConstant) {
+    return unexpected(fmt::format(
+        "array length id {} isn't a constant or a specialization constant "
+        "default (opcode {})",
+        lengthId.value(), opcode));
+  }
+  return operand(ids, lengthId.value(), 0);
+}
+
+auto type_size(const vector<SpvId> &ids, const uint32_t typeId,
+               const uint32_t matrixStride = 0, const uint32_t depth = 0)
+    -> expected<uint32_t, string> {
+  if (typeId >= ids.size()) {
+    return unexpected(fmt::format("SPIR-V type id {} out of bounds", typeId));
+  }
+  if (depth > MaxTypeDepth) {
+    return unexpected("SPIR-V types nest too deeply");
+  }
+  const SpvId &type = ids[typeId];
+  const auto element = [&](const uint32_t index, const uint32_t stride)
+      -> expected<uint32_t, string> {
+    auto elementType = operand(ids, typeId, index);
+    if (!elementType.has_value()) {
+      return unexpected(elementType.error());
+    }
+    return type_size(ids, elementType.value(), stride, depth + 1);
+  };
+  switch (type.opcode) {
+  case OpTypeInt:
+  case OpTypeFloat: {
+    auto width = operand(ids, typeId, 0);
+    if (!width.has_value()) {
+      return unexpected(width.error());
+    }
+    return width.value() / 8;
+  }
+  case OpTypeVector:
+  case OpTypeMatrix: {
+    auto count = operand(ids, typeId, 1);
+    if (!count.has_value()) {
+      return unexpected(count.error());
+    }
+    if (type.opcode == OpTypeMatrix && matrixStride != 0)
+      return count.value() * matrixStride;
+    auto size = element(0, 0);
+    if (!size.has_value()) {
+      return unexpected(size.error());
+    }
+    return count.value() * size.value();
+  }
+  case OpTypeArray: {
+    auto length = array_length(ids, typeId);
+    if (!length.has_value()) {
+      return unexpected(length.error());
+    }
+    uint32_t stride = type.arrayStride;
+    if (stride == 0) {
+      auto size = element(0, 0);
+      if (!size.has_value()) {
+        return unexpected(size.error());
+      }
+      stride = size.value();
+    }
+    return length.value() * stride;
+  }
+  case OpTypeStruct: {
+    uint32_t size = 0;
+    for (uint32_t member = 0; member < type.operands.size(); member++) {
+      const auto offset = type.memberOffsets.find(member);
+      const auto stride = type.memberMatrixStrides.find(member);
+      auto memberSize = element(
+          member,
+          stride != type.memberMatrixStrides.end() ? stride->second : 0);
+      if (!memberSize.has_value()) {
+        return unexpected(memberSize.error());
+      }
+      const uint32_t memberOffset =
+          offset != type.memberOffsets.end() ? offset->second : size;
+      size = std::max(size, memberOffset + memberSize.value());
+    }
+    return size;
+  }
+  case OpTypePointer:
+    // only physical storage buffer pointers can live inside a block
+    return 8;
+  default:
+    return 0;
+  }
+}
+
+auto descriptor_type_for(const vector<SpvId> &ids, const uint32_t typeId,
+                         const uint32_t storageClass)
+    -> expected<VkDescriptorType, string> {
+  if (typeId >= ids.size()) {
+    return unexpected(fmt::format("SPIR-V type id {} out of bounds", typeId));
+  }
+  const SpvId &type = ids[typeId];
+  if (storageClass == StorageClassStorageBuffer) {
+    return VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+  }
+  if (storageClass == StorageClassUniform) {
+    if (type.bufferBlock) {
+      return VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+    }
+    return VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+  }
+  switch (type.opcode) {
+  case OpTypeSampler:
+    return VK_DESCRIPTOR_TYPE_SAMPLER;
+  case OpTypeSampledImage:
+    return VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+  case OpTypeAccelerationStructureKHR:
+    return VK_DESCRIPTOR_TYPE_ACCELERATION_STRUCTURE_KHR;
+  case OpTypeImage: {
+    if (type.operands.size() < 6) {
+      return unexpected("malformed SPIR-V image type");
+    }
+    const uint32_t dim = type.operands[1];
+    const uint32_t sampled = type.operands[5];
+    if (dim == DimSubpassData)
+      return VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT;
+    if (dim == DimBuffer)
+      return sampled == 2 ? VK_DESCRIPTOR_TYPE_STORAGE_TEXEL_BUFFER
+                          : VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER;
+    return sampled == 2 ? VK_DESCRIPTOR_TYPE_STORAGE_IMAGE
+                        : VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE;
+  }
+  default:
+    return unexpected(
+        fmt::format("unsupported descriptor type (opcode {})", type.opcode));
+  }
+}
+} // namespace
+#pragma endregion
+
+#pragma region ShaderReflection Functions
+auto ShaderReflection::merge(const ShaderReflection &other)
+    -> expected<void, string> {
+  this->stages |= other.stages;
+  for (const auto &[set, bindings] : other.sets) {
+    auto &ours = this->sets[set];
+    for (const auto &binding : bindings) {
+      auto it = std::ranges::find(ours, binding.binding,
+                                  &ReflectedBinding::binding);
+      if (it == ours.end()) {
+        ours.push_back(binding);
+        continue;
+      }
+      if (it->type != binding.type) {
+        return unexpected(fmt::format(
+            "set {} binding {} is declared with different descriptor types "
+            "across stages",
+            set, binding.binding));
+      }
+      it->count = std::max(it->count, binding.count);
+      it->stages |= binding.stages;
+    }
+    std::ranges::sort(ours, {}, &ReflectedBinding::binding);
+  }
+  if (other.pushConstants.stageFlags != 0) {
+    if (this->pushConstants.stageFlags == 0) {
+      this->pushConstants = other.pushConstants;
+    } else {
+      const uint32_t begin =
+          std::min(this->pushConstants.offset, other.pushConstants.offset);
+      const uint32_t end = std::max(
+          this->pushConstants.offset + this->pushConstants.size,
+          other.pushConstants.offset + other.pushConstants.size);
+      this->pushConstants.offset = begin;
+      this->pushConstants.size = end - begin;
+      this->pushConstants.stageFlags |= other.pushConstants.stageFlags;
+    }
+  }
+  return {};
+}
+#pragma endregion
+
+auto reflect_spirv(const std::span<const uint32_t> code)
+    -> expected<ShaderReflection, string> {
+  if (code.size() < SpvHeaderWords || code[0] != SpvMagicNumber) {
+    return unexpected("not a SPIR-V module");
+  }
+  // every id is defined by an instruction of at least one word, so a bound
+  // past the module size is malformed and would only inflate the id table
+  const uint32_t bound = code[3];
+  if (bound > code.size()) {
+    return unexpected(fmt::format("SPIR-V id bound {} exceeds module size {}",
+                                  bound, code.size()));
+  }
+  vector<SpvId> ids(bound);
+  vector<SpvVariable> variables;
+  ShaderReflection reflection;
+
+  for (size_t word = SpvHeaderWords; word < code.size();) {
+    const uint32_t wordCount = code[word] >> 16;
+    const uint32_t opcode = code[word] & 0xFFFF;
+    if (wordCount == 0 || word + wordCount > code.size()) {
+      return unexpected("malformed SPIR-V instruction stream");
+    }
+    const uint32_t *ops = &code[word + 1];
+    const uint32_t operandCount = wordCount - 1;
+
+    switch (opcode) {
+    case OpEntryPoint:
+      // the first entry point decides the stage, we only compile "main"
+      if (operandCount < 1)
+        return unexpected("malformed SPIR-V entry point");
+      if (reflection.stages == 0) {
+        reflection.stages = execution_model_to_stage(ops[0]);
+      }
+      break;
+    case OpTypeInt:
+    case OpTypeFloat:
+    case OpTypeVector:
+    case OpTypeMatrix:
+    case OpTypeImage:
+    case OpTypeSampler:
+    case OpTypeSampledImage:
+    case OpTypeArray:
+    case OpTypeRuntimeArray:
+    case OpTypeStruct:
+    case OpTypePointer:
+    case OpTypeAccelerationStructureKHR:
+      if (operandCount < 1 || ops[0] >= bound)
+        return unexpected("SPIR-V id out of bounds");
+      ids[ops[0]].opcode = opcode;
+      ids[ops[0]].operands.assign(ops + 1, ops + operandCount);
+      break;
+    case OpConstant:
+    case OpSpecConstant:
+    case OpSpecConstantTrue:
+    case OpSpecConstantFalse:
+    case OpSpecConstantComposite:
+    case OpSpecConstantOp:
+      // only the value of plain and specialization constants is kept, the
+      // others are recorded so array lengths using them are recognized
+      if (operandCount < 2 || ops[1] >= bound)
+        return unexpected("SPIR-V id out of bounds");
+      ids[ops[1]].opcode = opcode;
+      if (opcode == OpConstant || opcode == OpSpecConstant)
+        ids[ops[1]].operands.assign(ops + 2, ops + operandCount);
+      break;
+    case OpVariable:
+      if (operandCount < 3 || ops[0] >= bound || ops[1] >= bound)
+        return unexpected("malformed SPIR-V variable");
+      variables.push_back({ops[1], ops[0], ops[2]});
+      break;
+    case OpDecorate: {
+      if (operandCount < 2 || ops[0] >= bound)
+        return unexpected("SPIR-V id out of bounds");
+      // every decoration we read carries one literal
+      if (operandCount < 3 &&
+          (ops[1] == DecorationArrayStride || ops[1] == DecorationBinding ||
+           ops[1] == DecorationDescriptorSet))
+        return unexpected("malformed SPIR-V decoration");
+      SpvId &target = ids[ops[0]];
+      switch (ops[1]) {
+      case DecorationBlock:
+        target.block = true;
+        break;
+      case DecorationBufferBlock:
+        target.bufferBlock = true;
+        break;
+      case DecorationArrayStride:
+        target.arrayStride = ops[2];
+        break;
+      case DecorationBinding:
+        target.binding = ops[2];
+        break;
+      case DecorationDescriptorSet:
+        target.set = ops[2];
+        break;
+      default:
+        break;
+      }
+      break;
+    }
+    case OpMemberDecorate: {
+      if (operandCount < 3 || ops[0] >= bound)
+        return unexpected("SPIR-V id out of bounds");
+      SpvId &target = ids[ops[0]];
+      if ((ops[2] == DecorationOffset ||
+           ops[2] == DecorationMatrixStride) &&
+          operandCount < 4)
+        return unexpected("malformed SPIR-V member decoration");
+      if (ops[2] == DecorationOffset)
+        target.memberOffsets[ops[1]] = ops[3];
+      else if (ops[2] == DecorationMatrixStride)
+        target.memberMatrixStrides[ops[1]] = ops[3];
+      break;
+    }
+    default:
+      break;
+    }
+    word += wordCount;
+  }
+
+  if (reflection.stages == 0) {
+    return unexpected("SPIR-V module has no supported entry point");
+  }
+
+  for (const auto &[id, pointerType, storageClass] : variables) {
+    if (storageClass != StorageClassUniformConstant &&
+        storageClass != StorageClassUniform &&
+        storageClass != StorageClassStorageBuffer &&
+        storageClass != StorageClassPushConstant) {
+      continue;
+    }
+    // pointer operands are { storage class, pointee type }
+    auto pointee = operand(ids, pointerType, 1);
+    if (!pointee.has_value()) {
+      return unexpected(pointee.error());
+    }
+    uint32_t typeId = pointee.value();
+    if (typeId >= bound) {
+      return unexpected("SPIR-V id out of bounds");
+    }
+
+    if (storageClass == StorageClassPushConstant) {
+      const SpvId &block = ids[typeId];
+      uint32_t offset = 0;
+      if (!block.memberOffsets.empty()) {
+        offset = std::ranges::min(block.memberOffsets |
+                                  std::views::values);
+      }
+      reflection.pushConstants.stageFlags = reflection.stages;
+      reflection.pushConstants.offset = offset;
+      auto size = type_size(ids, typeId);
+      if (!size.has_value()) {
+        return unexpected(size.error());
+      }
+      reflection.pushConstants.size = size.value() - offset;
+      continue;
+    }
+
+    uint32_t count = 1;
+    for (uint32_t depth = 0; ids[typeId].opcode == OpTypeArray ||
+                             ids[typeId].opcode == OpTypeRuntimeArray;
+         depth++) {
+      if (depth > MaxTypeDepth) {
+        return unexpected("SPIR-V types nest too deeply");
+      }
+      if (ids[typeId].opcode == OpTypeRuntimeArray) {
+        return unexpected(fmt::format(
+            "set {} binding {} is a runtime sized descriptor array, which "
+            "is not supported yet",
+            ids[id].set, ids[id].binding));
+      }
+      auto length = array_length(ids, typeId);
+      if (!length.has_value()) {
+        return unexpected(length.error());
+      }
+      auto elementType = operand(ids, typeId, 0);
+      if (!elementType.has_value()) {
+        return unexpected(elementType.error());
+      }
+      if (elementType.value() >= bound) {
+        return unexpected("SPIR-V id out of bounds");
+      }
+      count *= length.value();
+      typeId = elementType.value();
+    }
+
+    const auto descriptorType = descriptor_type_for(ids, typeId, storageClass);
+    if (!descriptorType.has_value()) {
+      return unexpected(descriptorType.error());
+    }
+    const uint32_t set = ids[id].set == NoValue ? 0 : ids[id].set;
+    const uint32_t binding = ids[id].binding == NoValue ? 0 : ids[id].binding;
+    reflection.sets[set].push_back(
+        {set, binding, descriptorType.value(), count, reflection.stages});
+  }
+  for (auto &bindings : reflection.sets | std::views::values) {
+    std::ranges::sort(bindings, {}, &ReflectedBinding::binding);
+  }
+  return reflection;
+}
+} // namespace SFT::Renderer::VK
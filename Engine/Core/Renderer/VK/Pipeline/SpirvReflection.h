@@ -0,0 +1,68 @@
+//
+// Created by sturd on 10/18/2026.
+//
+
+#ifndef SPIRVREFLECTION_H
+#define SPIRVREFLECTION_H
+
+#include "Core/Renderer/VK/VulkanDispatch.h"
+#include <cstdint>
+#include <expected>
+#include <map>
+#include <span>
+#include <string>
+#include <vector>
+
+using std::expected;
+using std::map;
+using std::string;
+using std::unexpected;
+using std::vector;
+
+namespace SFT::Renderer::VK {
+/*!
+ * @brief A single descriptor binding declared by a shader module
+ */
+struct ReflectedBinding {
+  uint32_t set = 0;
+  uint32_t binding = 0;
+  VkDescriptorType type = VK_DESCRIPTOR_TYPE_MAX_ENUM;
+  uint32_t count = 1;
+  VkShaderStageFlags stages = 0;
+};
+
+/*!
+ * @brief Everything a pipeline layout needs to know about one or more shader
+ * stages, the descriptor sets are keyed by set index and kept sorted by
+ * binding so that identical interfaces always produce identical layouts
+ */
+struct ShaderReflection {
+  VkShaderStageFlags stages = 0;
+  map<uint32_t, vector<ReflectedBinding>> sets;
+  // a single range covering every stage's push constant block, the stage flags
+  // are the union of all stages that declare one
+  VkPushConstantRange pushConstants{};
+
+  /*!
+   * @brief Merges the interface of another stage into this one
+   * @param other the reflection of another stage of the same program
+   * @return On success, returns void, on failure (the two stages disagree on
+   * the type of a binding), returns unexpected with error message
+   */
+  auto merge(const ShaderReflection &other) -> expected<void, string>;
+};
+
+/*!
+ * @brief Parses a SPIR-V module and extracts its descriptor bindings and push
+ * constant block, this is a minimal reflector that only understands what is
+ * needed to build pipeline layouts, it does not need the module to be loaded
+ * onto a device
+ * @param code the SPIR-V words of the module
+ * @return On success, returns the reflection of the module's entry point, on
+ * failure, returns unexpected with error message
+ */
+auto reflect_spirv(std::span<const uint32_t> code)
+    -> expected<ShaderReflection, string>;
+} // namespace SFT::Renderer::VK
+
+#endif // SPIRVREFLECTION_H
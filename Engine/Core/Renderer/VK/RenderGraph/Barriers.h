@@ -0,0 +1,40 @@
+//
+// Created by sturd on 10/18/2026.
+//
+
+#ifndef BARRIERS_H
+#define BARRIERS_H
+
+#include "Core/Renderer/VK/VulkanDispatch.h"
+
+namespace SFT::Renderer::VK {
+/*!
+ * @brief Records a global synchronization2 memory barrier, for work recorded
+ * outside the render graph that orders buffer accesses between its own
+ * dispatches, draws and copies
+ * @param commandBuffer the command buffer to record into
+ * @param srcStage the stages whose work must finish first
+ * @param srcAccess the writes of those stages to make available
+ * @param dstStage the stages that wait
+ * @param dstAccess the accesses of those stages the writes become visible to
+ */
+inline auto memory_barrier(VkCommandBuffer commandBuffer,
+                           const VkPipelineStageFlags2 srcStage,
+                           const VkAccessFlags2 srcAccess,
+                           const VkPipelineStageFlags2 dstStage,
+                           const VkAccessFlags2 dstAccess) -> void {
+  VkMemoryBarrier2 barrier{};
+  barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER_2;
+  barrier.srcStageMask = srcStage;
+  barrier.srcAccessMask = srcAccess;
+  barrier.dstStageMask = dstStage;
+  barrier.dstAccessMask = dstAccess;
+  VkDependencyInfo dependency{};
+  dependency.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO;
+  dependency.memoryBarrierCount = 1;
+  dependency.pMemoryBarriers = &barrier;
+  vkCmdPipelineBarrier2(commandBuffer, &dependency);
+}
+} // namespace SFT::Renderer::VK
+
+#endif // BARRIERS_H
@@ -0,0 +1,602 @@
+//
+// Created by sturd on 10/18/2026.
+//
+
+#include "RenderGraph.h"
+
+#include "spdlog/spdlog.h"
+#include <algorithm>
+
+namespace SFT::Renderer::VK {
+#pragma region additional functions
+namespace {
+/*!
+ * @brief The synchronization state of a resource while barriers are derived,
+ * reads since the last write are tracked so a write waits for all of them,
+ * and the stages the last write is visible to so repeated reads don't barrier
+ */
+struct TrackedState {
+  VkImageLayout layout = VK_IMAGE_LAYOUT_UNDEFINED;
+  VkPipelineStageFlags2 writeStages = VK_PIPELINE_STAGE_2_NONE;
+  VkAccessFlags2 writeAccess = VK_ACCESS_2_NONE;
+  VkPipelineStageFlags2 readStages = VK_PIPELINE_STAGE_2_NONE;
+  VkPipelineStageFlags2 visibleStages = VK_PIPELINE_STAGE_2_NONE;
+  VkAccessFlags2 visibleAccess = VK_ACCESS_2_NONE;
+  bool used = false;
+};
+
+auto image_usage_bits(const ResourceUsage usage) -> VkImageUsageFlags {
+  switch (usage) {
+  case ResourceUsage::ColorAttachment:
+    return VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;
+  case ResourceUsage::DepthStencilAttachment:
+  case ResourceUsage::DepthStencilRead:
+    return VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT;
+  case ResourceUsage::SampledFragment:
+  case ResourceUsage::SampledCompute:
+    return VK_IMAGE_USAGE_SAMPLED_BIT;
+  case ResourceUsage::StorageReadCompute:
+  case ResourceUsage::StorageWriteCompute:
+    return VK_IMAGE_USAGE_STORAGE_BIT;
+  case ResourceUsage::TransferSource:
+    return VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
+  case ResourceUsage::TransferDestination:
+    return VK_IMAGE_USAGE_TRANSFER_DST_BIT;
+  default:
+    return 0;
+  }
+}
+
+auto buffer_usage_bits(const ResourceUsage usage) -> VkBufferUsageFlags {
+  switch (usage) {
+  case ResourceUsage::StorageReadCompute:
+  case ResourceUsage::StorageWriteCompute:
+    return VK_BUFFER_USAGE_STORAGE_BUFFER_BIT;
+  case ResourceUsage::TransferSource:
+    return VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+  case ResourceUsage::TransferDestination:
+    return VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+  case ResourceUsage::VertexBuffer:
+    return VK_BUFFER_USAGE_VERTEX_BUFFER_BIT;
+  case ResourceUsage::IndexBuffer:
+    return VK_BUFFER_USAGE_INDEX_BUFFER_BIT;
+  case ResourceUsage::IndirectBuffer:
+    return VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT;
+  case ResourceUsage::UniformBuffer:
+    return VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT;
+  default:
+    return 0;
+  }
+}
+
+auto emit_barriers(VkCommandBuffer commandBuffer,
+                   const std::vector<VkImageMemoryBarrier2> &images,
+                   const VkMemoryBarrier2 *memory) -> void {
+  if (images.empty() && memory == nullptr) {
+    return;
+  }
+  VkDependencyInfo dependencyInfo{};
+  dependencyInfo.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO;
+  dependencyInfo.memoryBarrierCount = memory != nullptr ? 1 : 0;
+  dependencyInfo.pMemoryBarriers = memory;
+  dependencyInfo.imageMemoryBarrierCount = static_cast<uint32_t>(images.size());
+  dependencyInfo.pImageMemoryBarriers = images.data();
+  vkCmdPipelineBarrier2(commandBuffer, &dependencyInfo);
+}
+} // namespace
+#pragma endregion
+
+auto usage_state(const ResourceUsage usage) -> ResourceState {
+  switch (usage) {
+  case ResourceUsage::ColorAttachment:
+    return {VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT,
+            VK_ACCESS_2_COLOR_ATTACHMENT_READ_BIT |
+                VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT,
+            VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL};
+  case ResourceUsage::DepthStencilAttachment:
+    return {VK_PIPELINE_STAGE_2_EARLY_FRAGMENT_TESTS_BIT |
+                VK_PIPELINE_STAGE_2_LATE_FRAGMENT_TESTS_BIT,
+            VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_READ_BIT |
+                VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT,
+            VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL};
+  case ResourceUsage::DepthStencilRead:
+    return {VK_PIPELINE_STAGE_2_EARLY_FRAGMENT_TESTS_BIT |
+                VK_PIPELINE_STAGE_2_LATE_FRAGMENT_TESTS_BIT,
+            VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_READ_BIT,
+            VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL};
+  case ResourceUsage::SampledFragment:
+    return {VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT,
+            VK_ACCESS_2_SHADER_SAMPLED_READ_BIT,
+            VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL};
+  case ResourceUsage::SampledCompute:
+    return {VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+            VK_ACCESS_2_SHADER_SAMPLED_READ_BIT,
+            VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL};
+  case ResourceUsage::StorageReadCompute:
+    return {VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+            VK_ACCESS_2_SHADER_STORAGE_READ_BIT, VK_IMAGE_LAYOUT_GENERAL};
+  case ResourceUsage::StorageWriteCompute:
+    return {VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+            VK_ACCESS_2_SHADER_STORAGE_READ_BIT |
+                VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT,
+            VK_IMAGE_LAYOUT_GENERAL};
+  case ResourceUsage::TransferSource:
+    return {VK_PIPELINE_STAGE_2_ALL_TRANSFER_BIT, VK_ACCESS_2_TRANSFER_READ_BIT,
+            VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL};
+  case ResourceUsage::TransferDestination:
+    return {VK_PIPELINE_STAGE_2_ALL_TRANSFER_BIT,
+            VK_ACCESS_2_TRANSFER_WRITE_BIT,
+            VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL};
+  case ResourceUsage::VertexBuffer:
+    return {VK_PIPELINE_STAGE_2_VERTEX_ATTRIBUTE_INPUT_BIT,
+            VK_ACCESS_2_VERTEX_ATTRIBUTE_READ_BIT, VK_IMAGE_LAYOUT_UNDEFINED};
+  case ResourceUsage::IndexBuffer:
+    return {VK_PIPELINE_STAGE_2_INDEX_INPUT_BIT, VK_ACCESS_2_INDEX_READ_BIT,
+            VK_IMAGE_LAYOUT_UNDEFINED};
+  case ResourceUsage::IndirectBuffer:
+    return {VK_PIPELINE_STAGE_2_DRAW_INDIRECT_BIT,
+            VK_ACCESS_2_INDIRECT_COMMAND_READ_BIT, VK_IMAGE_LAYOUT_UNDEFINED};
+  case ResourceUsage::UniformBuffer:
+    return {VK_PIPELINE_STAGE_2_VERTEX_SHADER_BIT |
+                VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT |
+                VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+            VK_ACCESS_2_UNIFORM_READ_BIT, VK_IMAGE_LAYOUT_UNDEFINED};
+  case ResourceUsage::Present:
+  default:
+    // presentation is ordered by the semaphore, not by a pipeline stage
+    return {VK_PIPELINE_STAGE_2_NONE, VK_ACCESS_2_NONE,
+            VK_IMAGE_LAYOUT_PRESENT_SRC_KHR};
+  }
+}
+
+auto usage_writes(const ResourceUsage usage) -> bool {
+  switch (usage) {
+  case ResourceUsage::ColorAttachment:
+  case ResourceUsage::DepthStencilAttachment:
+  case ResourceUsage::StorageWriteCompute:
+  case ResourceUsage::TransferDestination:
+    return true;
+  default:
+    return false;
+  }
+}
+
+#pragma region RenderGraph Functions
+auto RenderGraph::init(VkDevice device, VkPhysicalDevice physicalDevice,
+                       const uint32_t framesInFlight) -> void {
+  this->m_device = device;
+  this->m_pools.resize(std::max(1u, framesInFlight));
+  for (auto &pool : this->m_pools) {
+    pool.init(device, physicalDevice);
+  }
+}
+
+auto RenderGraph::destroy() -> void {
+  for (auto &pool : this->m_pools) {
+    pool.destroy();
+  }
+  this->m_pools.clear();
+  this->m_resources.clear();
+  this->m_passes.clear();
+  this->m_executionOrder.clear();
+  this->m_barriers.clear();
+  this->m_compiled = false;
+}
+
+auto RenderGraph::begin_frame(const uint32_t frameSlot) -> void {
+  this->m_frameSlot =
+      frameSlot % std::max<uint32_t>(1, this->m_pools.size());
+  this->m_resources.clear();
+  this->m_passes.clear();
+  this->m_executionOrder.clear();
+  this->m_barriers.clear();
+  this->m_compiled = false;
+}
+
+auto RenderGraph::create_image(const string &name,
+                               const RenderGraphImageDesc &desc)
+    -> ResourceHandle {
+  Resource resource;
+  resource.name = name;
+  resource.image = desc;
+  this->m_resources.push_back(std::move(resource));
+  return {static_cast<uint32_t>(this->m_resources.size() - 1)};
+}
+
+auto RenderGraph::create_buffer(const string &name,
+                                const RenderGraphBufferDesc &desc)
+    -> ResourceHandle {
+  Resource resource;
+  resource.name = name;
+  resource.isImage = false;
+  resource.buffer = desc;
+  this->m_resources.push_back(std::move(resource));
+  return {static_cast<uint32_t>(this->m_resources.size() - 1)};
+}
+
+auto RenderGraph::import_image(const string &name, VkImage image,
+                               VkImageView view,
+                               const RenderGraphImageDesc &desc,
+                               const ResourceState &currentState)
+    -> ResourceHandle {
+  Resource resource;
+  resource.name = name;
+  resource.imported = true;
+  resource.image = desc;
+  resource.vkImage = image;
+  resource.vkImageView = view;
+  resource.initialState = currentState;
+  this->m_resources.push_back(std::move(resource));
+  return {static_cast<uint32_t>(this->m_resources.size() - 1)};
+}
+
+auto RenderGraph::import_buffer(const string &name, VkBuffer buffer,
+                                const RenderGraphBufferDesc &desc,
+                                const ResourceState &currentState)
+    -> ResourceHandle {
+  Resource resource;
+  resource.name = name;
+  resource.isImage = false;
+  resource.imported = true;
+  resource.buffer = desc;
+  resource.vkBuffer = buffer;
+  resource.initialState = currentState;
+  this->m_resources.push_back(std::move(resource));
+  return {static_cast<uint32_t>(this->m_resources.size() - 1)};
+}
+
+auto RenderGraph::set_final_usage(const ResourceHandle resource,
+                                  const ResourceUsage usage)
+    -> expected<void, string> {
+  if (resource.index >= this->m_resources.size()) {
+    return unexpected("invalid render graph resource");
+  }
+  auto &target = this->m_resources[resource.index];
+  if (!target.imported) {
+    return unexpected("only imported resources have a final usage, '" +
+                      target.name + "' is transient");
+  }
+  target.hasFinalUsage = true;
+  target.finalUsage = usage;
+  return {};
+}
+
+auto RenderGraph::add_pass(const string &name, PassExecute execute)
+    -> PassHandle {
+  Pass pass;
+  pass.name = name;
+  pass.execute = std::move(execute);
+  this->m_passes.push_back(std::move(pass));
+  this->m_compiled = false;
+  return {static_cast<uint32_t>(this->m_passes.size() - 1)};
+}
+
+auto RenderGraph::declare_access(const PassHandle pass,
+                                 const ResourceHandle resource,
+                                 const ResourceUsage usage, const bool write)
+    -> expected<void, string> {
+  if (pass.index >= this->m_passes.size() ||
+      resource.index >= this->m_resources.size()) {
+    return unexpected("invalid render graph pass or resource");
+  }
+  auto &target = this->m_passes[pass.index];
+  const auto &declared = this->m_resources[resource.index];
+  if (usage == ResourceUsage::Present) {
+    return unexpected("present is only valid as a final usage");
+  }
+  if (usage_writes(usage) != write) {
+    return unexpected("pass '" + target.name + "' declares a " +
+                      (write ? "write" : "read") + " of '" + declared.name +
+                      "' with a " + (write ? "read-only" : "writing") +
+                      " usage");
+  }
+  const bool applies = declared.isImage ? image_usage_bits(usage) != 0
+                                        : buffer_usage_bits(usage) != 0;
+  if (!applies) {
+    return unexpected("pass '" + target.name + "' uses '" + declared.name +
+                      "' in a way that doesn't apply to " +
+                      (declared.isImage ? "images" : "buffers"));
+  }
+  if (std::ranges::any_of(target.accesses, [&](const Access &access) {
+        return access.resource == resource.index;
+      })) {
+    return unexpected("pass '" + target.name + "' uses '" + declared.name +
+                      "' more than once");
+  }
+  target.accesses.push_back({resource.index, usage, write});
+  this->m_compiled = false;
+  return {};
+}
+
+auto RenderGraph::read(const PassHandle pass, const ResourceHandle resource,
+                       const ResourceUsage usage) -> expected<void, string> {
+  return this->declare_access(pass, resource, usage, false);
+}
+
+auto RenderGraph::write(const PassHandle pass, const ResourceHandle resource,
+                        const ResourceUsage usage) -> expected<void, string> {
+  return this->declare_access(pass, resource, usage, true);
+}
+
+auto RenderGraph::set_side_effect(const PassHandle pass) -> void {
+  if (pass.index < this->m_passes.size()) {
+    this->m_passes[pass.index].sideEffect = true;
+  }
+}
+
+auto RenderGraph::cull() -> vector<bool> {
+  // walk the passes backwards from the imported resources, a pass is kept
+  // when something later needs what it writes, and then everything it touches
+  // is needed too (a write may only update part of a resource)
+  vector<bool> needed(this->m_resources.size(), false);
+  for (size_t i = 0; i < this->m_resources.size(); i++) {
+    needed[i] = this->m_resources[i].imported;
+  }
+  vector<bool> alive(this->m_passes.size(), false);
+  for (size_t p = this->m_passes.size(); p-- > 0;) {
+    const auto &pass = this->m_passes[p];
+    alive[p] = pass.sideEffect ||
+               std::ranges::any_of(pass.accesses, [&](const Access &access) {
+                 return access.write && needed[access.resource];
+               });
+    if (alive[p]) {
+      for (const auto &access : pass.accesses) {
+        needed[access.resource] = true;
+      }
+    }
+  }
+  return alive;
+}
+
+auto RenderGraph::compile() -> expected<void, string> {
+  const vector<bool> alive = this->cull();
+  this->m_executionOrder.clear();
+  for (uint32_t p = 0; p < this->m_passes.size(); p++) {
+    if (alive[p]) {
+      this->m_executionOrder.push_back(p);
+    }
+  }
+
+  // lifetimes of the transients that are still used, and the usage flags
+  // their uses imply
+  vector<TransientRequest> requests;
+  vector<bool> written(this->m_resources.size(), false);
+  for (uint32_t order = 0; order < this->m_executionOrder.size(); order++) {
+    const auto &pass = this->m_passes[this->m_executionOrder[order]];
+    for (const auto &access : pass.accesses) {
+      auto &resource = this->m_resources[access.resource];
+      if (resource.imported) {
+        continue;
+      }
+      if (!access.write && !written[access.resource]) {
+        return unexpected("pass '" + pass.name + "' reads '" + resource.name +
+                          "' before any pass writes it");
+      }
+      written[access.resource] = written[access.resource] || access.write;
+      if (resource.transientIndex == UINT32_MAX) {
+        resource.transientIndex = static_cast<uint32_t>(requests.size());
+        TransientRequest request;
+        request.isImage = resource.isImage;
+        request.image = resource.image;
+        request.buffer = resource.buffer;
+        request.firstPass = order;
+        requests.push_back(request);
+      }
+      auto &request = requests[resource.transientIndex];
+      request.lastPass = order;
+      if (resource.isImage) {
+        request.image.usage |= image_usage_bits(access.usage);
+      } else {
+        request.buffer.usage |= buffer_usage_bits(access.usage);
+      }
+    }
+  }
+
+  auto &pool = this->m_pools[this->m_frameSlot];
+  if (auto result = pool.realize(requests); !result.has_value()) {
+    return unexpected("failed to back render graph transients: " +
+                      result.error());
+  }
+  for (auto &resource : this->m_resources) {
+    if (resource.imported || resource.transientIndex == UINT32_MAX) {
+      continue;
+    }
+    resource.vkImage = pool.image(resource.transientIndex);
+    resource.vkImageView = pool.image_view(resource.transientIndex);
+    resource.vkBuffer = pool.buffer(resource.transientIndex);
+  }
+
+  this->build_barriers();
+  this->m_compiled = true;
+  return {};
+}
+
+auto RenderGraph::build_barriers() -> void {
+  const auto &pool = this->m_pools[this->m_frameSlot];
+  vector<TrackedState> states(this->m_resources.size());
+  vector<uint32_t> resourceOfTransient;
+  for (uint32_t i = 0; i < this->m_resources.size(); i++) {
+    const auto &resource = this->m_resources[i];
+    if (resource.imported) {
+      states[i].layout = resource.initialState.layout;
+      states[i].writeStages = resource.initialState.stages;
+      states[i].writeAccess = resource.initialState.access;
+    } else if (resource.transientIndex != UINT32_MAX) {
+      resourceOfTransient.resize(
+          std::max<size_t>(resourceOfTransient.size(),
+                           resource.transientIndex + 1));
+      resourceOfTransient[resource.transientIndex] = i;
+    }
+  }
+
+  auto image_barrier = [this](const uint32_t index, const TrackedState &from,
+                              const VkPipelineStageFlags2 srcStages,
+                              const VkAccessFlags2 srcAccess,
+                              const ResourceState &to) {
+    const auto &resource = this->m_resources[index];
+    VkImageMemoryBarrier2 barrier{};
+    barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2;
+    barrier.srcStageMask = srcStages;
+    barrier.srcAccessMask = srcAccess;
+    barrier.dstStageMask = to.stages;
+    barrier.dstAccessMask = to.access;
+    barrier.oldLayout = from.layout;
+    barrier.newLayout = to.layout;
+    barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.image = resource.vkImage;
+    barrier.subresourceRange.aspectMask =
+        aspect_from_format(resource.image.format);
+    barrier.subresourceRange.levelCount = VK_REMAINING_MIP_LEVELS;
+    barrier.subresourceRange.layerCount = VK_REMAINING_ARRAY_LAYERS;
+    return barrier;
+  };
+
+  this->m_barriers.assign(this->m_executionOrder.size() + 1, {});
+  for (size_t order = 0; order < this->m_executionOrder.size(); order++) {
+    const auto &pass = this->m_passes[this->m_executionOrder[order]];
+    auto &batch = this->m_barriers[order];
+    for (const auto &access : pass.accesses) {
+      const auto &resource = this->m_resources[access.resource];
+      auto &state = states[access.resource];
+      const ResourceState next = usage_state(access.usage);
+
+      VkPipelineStageFlags2 srcStages = VK_PIPELINE_STAGE_2_NONE;
+      VkAccessFlags2 srcAccess = VK_ACCESS_2_NONE;
+      if (!state.used && !resource.imported) {
+        // the first use of an aliased transient has to wait for whatever
+        // used its memory before, its contents are discarded either way
+        for (const uint32_t previous :
+             pool.aliased_by(resource.transientIndex)) {
+          const auto &previousState = states[resourceOfTransient[previous]];
+          srcStages |= previousState.writeStages | previousState.readStages;
+          srcAccess |= previousState.writeAccess;
+        }
+      }
+      state.used = true;
+
+      const bool layoutChange = resource.isImage && state.layout != next.layout;
+      bool needsBarrier = srcStages != VK_PIPELINE_STAGE_2_NONE;
+      if (access.write || layoutChange) {
+        // write after write/read, or a transition which is a write itself
+        srcStages |= state.writeStages | state.readStages;
+        srcAccess |= state.writeAccess;
+        needsBarrier = needsBarrier || layoutChange ||
+                       srcStages != VK_PIPELINE_STAGE_2_NONE;
+        state.writeStages = next.stages;
+        state.writeAccess = access.write ? next.access : VK_ACCESS_2_NONE;
+        state.readStages = access.write ? VK_PIPELINE_STAGE_2_NONE : next.stages;
+        state.visibleStages = access.write ? VK_PIPELINE_STAGE_2_NONE : next.stages;
+        state.visibleAccess = access.write ? VK_ACCESS_2_NONE : next.access;
+      } else {
+        // read after write, only needed once per stage and access
+        const bool visible = (next.stages & ~state.visibleStages) == 0 &&
+                             (next.access & ~state.visibleAccess) == 0;
+        if (!visible && state.writeStages != VK_PIPELINE_STAGE_2_NONE) {
+          srcStages |= state.writeStages;
+          srcAccess |= state.writeAccess;
+          needsBarrier = true;
+        }
+        state.readStages |= next.stages;
+        state.visibleStages |= next.stages;
+        state.visibleAccess |= next.access;
+      }
+      if (!needsBarrier) {
+        continue;
+      }
+
+      if (resource.isImage) {
+        batch.images.push_back(
+            image_barrier(access.resource, state, srcStages, srcAccess, next));
+        state.layout = next.layout;
+      } else {
+        // buffers share one global barrier per pass, drivers handle that
+        // better than a list of buffer ranges
+        batch.hasMemory = true;
+        batch.memory.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER_2;
+        batch.memory.srcStageMask |= srcStages;
+        batch.memory.srcAccessMask |= srcAccess;
+        batch.memory.dstStageMask |= next.stages;
+        batch.memory.dstAccessMask |= next.access;
+      }
+    }
+  }
+
+  auto &finalBatch = this->m_barriers.back();
+  for (uint32_t i = 0; i < this->m_resources.size(); i++) {
+    const auto &resource = this->m_resources[i];
+    if (!resource.imported || !resource.hasFinalUsage) {
+      continue;
+    }
+    const auto &state = states[i];
+    const ResourceState finalState = usage_state(resource.finalUsage);
+    if (resource.isImage) {
+      finalBatch.images.push_back(
+          image_barrier(i, state, state.writeStages | state.readStages,
+                        state.writeAccess, finalState));
+    } else if (state.used) {
+      finalBatch.hasMemory = true;
+      finalBatch.memory.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER_2;
+      finalBatch.memory.srcStageMask |= state.writeStages | state.readStages;
+      finalBatch.memory.srcAccessMask |= state.writeAccess;
+      finalBatch.memory.dstStageMask |= finalState.stages;
+      finalBatch.memory.dstAccessMask |= finalState.access;
+    }
+  }
+}
+
+auto RenderGraph::execute(VkCommandBuffer commandBuffer)
+    -> expected<void, string> {
+  if (!this->m_compiled) {
+    return unexpected("render graph must be compiled before it is executed");
+  }
+  for (size_t order = 0; order < this->m_executionOrder.size(); order++) {
+    const auto &batch = this->m_barriers[order];
+    emit_barriers(commandBuffer, batch.images,
+                  batch.hasMemory ? &batch.memory : nullptr);
+    const auto &pass = this->m_passes[this->m_executionOrder[order]];
+    if (pass.execute) {
+      pass.execute(commandBuffer, *this);
+    }
+  }
+  const auto &finalBatch = this->m_barriers.back();
+  emit_barriers(commandBuffer, finalBatch.images,
+                finalBatch.hasMemory ? &finalBatch.memory : nullptr);
+  return {};
+}
+
+auto RenderGraph::get_image(const ResourceHandle resource) const -> VkImage {
+  return this->m_resources[resource.index].vkImage;
+}
+
+auto RenderGraph::get_image_view(const ResourceHandle resource) const
+    -> VkImageView {
+  return this->m_resources[resource.index].vkImageView;
+}
+
+auto RenderGraph::get_buffer(const ResourceHandle resource) const -> VkBuffer {
+  return this->m_resources[resource.index].vkBuffer;
+}
+
+auto RenderGraph::get_image_desc(const ResourceHandle resource) const
+    -> const RenderGraphImageDesc & {
+  return this->m_resources[resource.index].image;
+}
+
+auto RenderGraph::culled_pass_count() const -> size_t {
+  return this->m_passes.size() - this->m_executionOrder.size();
+}
+
+auto RenderGraph::transient_bytes_requested() const -> VkDeviceSize {
+  return this->m_pools.empty()
+             ? 0
+             : this->m_pools[this->m_frameSlot].requested_bytes();
+}
+
+auto RenderGraph::transient_bytes_allocated() const -> VkDeviceSize {
+  return this->m_pools.empty()
+             ? 0
+             : this->m_pools[this->m_frameSlot].allocated_bytes();
+}
+#pragma endregion
+} // namespace SFT::Renderer::VK
@@ -0,0 +1,226 @@
+//
+// Created by sturd on 10/18/2026.
+//
+
+#ifndef RENDERGRAPH_H
+#define RENDERGRAPH_H
+
+#include "TransientResourcePool.h"
+#include "Core/Renderer/VK/VulkanDispatch.h"
+#include <cstdint>
+#include <expected>
+#include <functional>
+#include <string>
+#include <vector>
+
+using std::expected;
+using std::string;
+using std::unexpected;
+using std::vector;
+
+namespace SFT::Renderer::VK {
+/*!
+ * @brief How a pass touches a resource, each usage maps to the stages, access
+ * and image layout synchronization2 needs, so passes never spell those out
+ */
+enum class ResourceUsage : uint8_t {
+  ColorAttachment,
+  DepthStencilAttachment,
+  DepthStencilRead,
+  SampledFragment,
+  SampledCompute,
+  StorageReadCompute,
+  StorageWriteCompute,
+  TransferSource,
+  TransferDestination,
+  VertexBuffer,
+  IndexBuffer,
+  IndirectBuffer,
+  UniformBuffer,
+  Present,
+};
+
+struct ResourceState {
+  VkPipelineStageFlags2 stages = VK_PIPELINE_STAGE_2_NONE;
+  VkAccessFlags2 access = VK_ACCESS_2_NONE;
+  VkImageLayout layout = VK_IMAGE_LAYOUT_UNDEFINED;
+};
+
+/*!
+ * @brief Gets the synchronization state a usage requires
+ * @param usage the usage
+ * @return the stages, access and layout of the usage
+ */
+auto usage_state(ResourceUsage usage) -> ResourceState;
+/*!
+ * @brief Checks whether a usage writes to the resource
+ * @param usage the usage
+ * @return true if the usage writes
+ */
+auto usage_writes(ResourceUsage usage) -> bool;
+
+struct ResourceHandle {
+  uint32_t index = UINT32_MAX;
+
+  [[nodiscard]] auto valid() const -> bool { return index != UINT32_MAX; }
+};
+
+struct PassHandle {
+  uint32_t index = UINT32_MAX;
+};
+
+class RenderGraph;
+using PassExecute = std::function<void(VkCommandBuffer, const RenderGraph &)>;
+
+/*!
+ * @brief A frame graph, passes declare which resources they read and write
+ * and the graph works out the rest: passes nothing depends on are culled,
+ * barriers are derived from the declared usages and batched into one
+ * vkCmdPipelineBarrier2 per pass, and transient resources are created by the
+ * graph and share memory with other transients that are never alive at the
+ * same time. The graph is declared again every frame, the memory of each frame
+ * slot is kept for as long as the declarations don't change
+ */
+class RenderGraph {
+private:
+  struct Resource {
+    string name;
+    bool isImage = true;
+    bool imported = false;
+    RenderGraphImageDesc image{};
+    RenderGraphBufferDesc buffer{};
+    VkImage vkImage = VK_NULL_HANDLE;
+    VkImageView vkImageView = VK_NULL_HANDLE;
+    VkBuffer vkBuffer = VK_NULL_HANDLE;
+    ResourceState initialState{};
+    bool hasFinalUsage = false;
+    ResourceUsage finalUsage = ResourceUsage::Present;
+    uint32_t transientIndex = UINT32_MAX;
+  };
+  struct Access {
+    uint32_t resource;
+    ResourceUsage usage;
+    bool write;
+  };
+  struct Pass {
+    string name;
+    PassExecute execute;
+    vector<Access> accesses;
+    bool sideEffect = false;
+  };
+  struct BarrierBatch {
+    vector<VkImageMemoryBarrier2> images;
+    VkMemoryBarrier2 memory{};
+    bool hasMemory = false;
+  };
+
+  VkDevice m_device = VK_NULL_HANDLE;
+  vector<TransientResourcePool> m_pools;
+  uint32_t m_frameSlot = 0;
+  vector<Resource> m_resources;
+  vector<Pass> m_passes;
+  // passes that survived culling, in declaration order, with the barriers
+  // recorded before each of them, the last batch is the final transitions
+  vector<uint32_t> m_executionOrder;
+  vector<BarrierBatch> m_barriers;
+  bool m_compiled = false;
+
+  auto declare_access(PassHandle pass, ResourceHandle resource,
+                      ResourceUsage usage, bool write)
+      -> expected<void, string>;
+  auto cull() -> vector<bool>;
+  auto build_barriers() -> void;
+
+public:
+  /*!
+   * @brief Creates one transient pool per frame in flight
+   * @param device the logical device transients are created on
+   * @param physicalDevice the device whose memory types transients use
+   * @param framesInFlight how many frames can be recorded before the oldest is
+   * known to be finished on the GPU
+   */
+  auto init(VkDevice device, VkPhysicalDevice physicalDevice,
+            uint32_t framesInFlight) -> void;
+  auto destroy() -> void;
+  /*!
+   * @brief Clears every declaration so the frame can be declared again, the
+   * GPU must be done with the previous frame that used the slot
+   * @param frameSlot the frame in flight being recorded
+   */
+  auto begin_frame(uint32_t frameSlot) -> void;
+  auto create_image(const string &name, const RenderGraphImageDesc &desc)
+      -> ResourceHandle;
+  auto create_buffer(const string &name, const RenderGraphBufferDesc &desc)
+      -> ResourceHandle;
+  /*!
+   * @brief Makes an image the graph doesn't own usable by passes, such as the
+   * swapchain image, passes that write imported resources are never culled
+   * @param name the debug name of the image
+   * @param image the image
+   * @param view the view passes should use
+   * @param desc the format and extent of the image
+   * @param currentState the last use of the image before the graph runs
+   * @return the handle passes refer to the image by
+   */
+  auto import_image(const string &name, VkImage image, VkImageView view,
+                    const RenderGraphImageDesc &desc,
+                    const ResourceState &currentState) -> ResourceHandle;
+  auto import_buffer(const string &name, VkBuffer buffer,
+                     const RenderGraphBufferDesc &desc,
+                     const ResourceState &currentState) -> ResourceHandle;
+  /*!
+   * @brief Transitions an imported resource after the last pass, for example
+   * to ResourceUsage::Present for the swapchain image
+   * @param resource the imported resource
+   * @param usage the usage the resource is left in
+   * @return On success, returns void, on failure, returns unexpected with error
+   * message
+   */
+  auto set_final_usage(ResourceHandle resource, ResourceUsage usage)
+      -> expected<void, string>;
+  auto add_pass(const string &name, PassExecute execute) -> PassHandle;
+  /*!
+   * @brief Declares that a pass reads a resource, a pass may use each resource
+   * once
+   * @param pass the pass reading
+   * @param resource the resource read
+   * @param usage how the resource is read
+   * @return On success, returns void, on failure, returns unexpected with error
+   * message
+   */
+  auto read(PassHandle pass, ResourceHandle resource, ResourceUsage usage)
+      -> expected<void, string>;
+  auto write(PassHandle pass, ResourceHandle resource, ResourceUsage usage)
+      -> expected<void, string>;
+  /*!
+   * @brief Keeps a pass even if nothing reads what it writes, for passes that
+   * work through things the graph doesn't track like readbacks
+   * @param pass the pass to keep
+   */
+  auto set_side_effect(PassHandle pass) -> void;
+  /*!
+   * @brief Culls unused passes, backs the transients and derives every barrier
+   * @return On success, returns void, on failure, returns unexpected with error
+   * message
+   */
+  auto compile() -> expected<void, string>;
+  /*!
+   * @brief Records every pass that survived culling with its barriers
+   * @param commandBuffer the command buffer being recorded
+   * @return On success, returns void, on failure (the graph wasn't compiled),
+   * returns unexpected with error message
+   */
+  auto execute(VkCommandBuffer commandBuffer) -> expected<void, string>;
+  [[nodiscard]] auto get_image(ResourceHandle resource) const -> VkImage;
+  [[nodiscard]] auto get_image_view(ResourceHandle resource) const
+      -> VkImageView;
+  [[nodiscard]] auto get_buffer(ResourceHandle resource) const -> VkBuffer;
+  [[nodiscard]] auto get_image_desc(ResourceHandle resource) const
+      -> const RenderGraphImageDesc &;
+  [[nodiscard]] auto culled_pass_count() const -> size_t;
+  [[nodiscard]] auto transient_bytes_requested() const -> VkDeviceSize;
+  [[nodiscard]] auto transient_bytes_allocated() const -> VkDeviceSize;
+};
+} // namespace SFT::Renderer::VK
+
+#endif // RENDERGRAPH_H
@@ -0,0 +1,315 @@
+//
+// Created by sturd on 10/18/2026.
+//
+
+#include "TransientResourcePool.h"
+
+#include "Core/Renderer/VK/Memory/DeviceMemory.h"
+#include "Core/Utility/Utility.h"
+#include "spdlog/spdlog.h"
+#include <algorithm>
+#include <map>
+#include <utility>
+
+namespace SFT::Renderer::VK {
+#pragma region additional functions
+namespace {
+using Utility::hash_combine;
+
+auto hash_requests(const std::span<const TransientRequest> requests)
+    -> uint64_t {
+  uint64_t seed = requests.size();
+  for (const auto &request : requests) {
+    seed = hash_combine(seed, request.isImage);
+    seed = hash_combine(seed, request.firstPass);
+    seed = hash_combine(seed, request.lastPass);
+    if (request.isImage) {
+      const auto &image = request.image;
+      seed = hash_combine(seed, static_cast<uint64_t>(image.format));
+      seed = hash_combine(seed, image.extent.width);
+      seed = hash_combine(seed, image.extent.height);
+      seed = hash_combine(seed, image.mipLevels);
+      seed = hash_combine(seed, image.arrayLayers);
+      seed = hash_combine(seed, static_cast<uint64_t>(image.samples));
+      seed = hash_combine(seed, image.usage);
+    } else {
+      seed = hash_combine(seed, request.buffer.size);
+      seed = hash_combine(seed, request.buffer.usage);
+    }
+  }
+  return seed;
+}
+
+auto align_up(const VkDeviceSize value, const VkDeviceSize alignment)
+    -> VkDeviceSize {
+  return (value + alignment - 1) / alignment * alignment;
+}
+
+auto lifetimes_overlap(const TransientRequest &a, const TransientRequest &b)
+    -> bool {
+  return a.firstPass <= b.lastPass && b.firstPass <= a.lastPass;
+}
+} // namespace
+#pragma endregion
+
+auto aspect_from_format(const VkFormat format) -> VkImageAspectFlags {
+  switch (format) {
+  case VK_FORMAT_D16_UNORM:
+  case VK_FORMAT_X8_D24_UNORM_PACK32:
+  case VK_FORMAT_D32_SFLOAT:
+    return VK_IMAGE_ASPECT_DEPTH_BIT;
+  case VK_FORMAT_S8_UINT:
+    return VK_IMAGE_ASPECT_STENCIL_BIT;
+  case VK_FORMAT_D16_UNORM_S8_UINT:
+  case VK_FORMAT_D24_UNORM_S8_UINT:
+  case VK_FORMAT_D32_SFLOAT_S8_UINT:
+    return VK_IMAGE_ASPECT_DEPTH_BIT | VK_IMAGE_ASPECT_STENCIL_BIT;
+  default:
+    return VK_IMAGE_ASPECT_COLOR_BIT;
+  }
+}
+
+#pragma region TransientResourcePool Functions
+auto TransientResourcePool::init(VkDevice device,
+                                 VkPhysicalDevice physicalDevice) -> void {
+  this->m_device = device;
+  vkGetPhysicalDeviceMemoryProperties(physicalDevice,
+                                      &this->m_memoryProperties);
+}
+
+auto TransientResourcePool::destroy() -> void {
+  this->release();
+  this->m_layoutHash = 0;
+  this->m_requests.clear();
+}
+
+auto TransientResourcePool::release() -> void {
+  for (const auto &resource : this->m_resources) {
+    if (resource.view != VK_NULL_HANDLE) {
+      vkDestroyImageView(this->m_device, resource.view, nullptr);
+    }
+    if (resource.image != VK_NULL_HANDLE) {
+      vkDestroyImage(this->m_device, resource.image, nullptr);
+    }
+    if (resource.buffer != VK_NULL_HANDLE) {
+      vkDestroyBuffer(this->m_device, resource.buffer, nullptr);
+    }
+  }
+  for (const auto &heap : this->m_heaps) {
+    free_device_memory(this->m_device, heap.memory);
+  }
+  this->m_resources.clear();
+  this->m_heaps.clear();
+  this->m_requestedBytes = 0;
+  this->m_allocatedBytes = 0;
+}
+
+auto TransientResourcePool::find_memory_type(const uint32_t typeBits) const
+    -> expected<uint32_t, string> {
+  for (uint32_t i = 0; i < this->m_memoryProperties.memoryTypeCount; i++) {
+    if ((typeBits & (1u << i)) &&
+        (this->m_memoryProperties.memoryTypes[i].propertyFlags &
+         VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT)) {
+      return i;
+    }
+  }
+  return unexpected("no device local memory type fits a transient resource");
+}
+
+auto TransientResourcePool::realize(
+    const std::span<const TransientRequest> requests)
+    -> expected<void, string> {
+  const uint64_t layoutHash = hash_requests(requests);
+  if (layoutHash == this->m_layoutHash &&
+      std::ranges::equal(requests, this->m_requests)) {
+    return {};
+  }
+  this->release();
+  this->m_layoutHash = 0;
+  this->m_requests.clear();
+  this->m_resources.resize(requests.size());
+
+  // create the resources unbound first, their memory requirements decide
+  // where they can be placed
+  for (size_t i = 0; i < requests.size(); i++) {
+    const auto &request = requests[i];
+    auto &resource = this->m_resources[i];
+    if (request.isImage) {
+      VkImageCreateInfo imageInfo{};
+      imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+      imageInfo.imageType = VK_IMAGE_TYPE_2D;
+      imageInfo.format = request.image.format;
+      imageInfo.extent = {request.image.extent.width,
+                          request.image.extent.height, 1};
+      imageInfo.mipLevels = request.image.mipLevels;
+      imageInfo.arrayLayers = request.image.arrayLayers;
+      imageInfo.samples = request.image.samples;
+      imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+      imageInfo.usage = request.image.usage;
+      imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+      imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+      if (vkCreateImage(this->m_device, &imageInfo, nullptr,
+                        &resource.image) != VK_SUCCESS) {
+        this->release();
+        return unexpected("failed to create transient image");
+      }
+      vkGetImageMemoryRequirements(this->m_device, resource.image,
+                                   &resource.requirements);
+    } else {
+      VkBufferCreateInfo bufferInfo{};
+      bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+      bufferInfo.size = request.buffer.size;
+      bufferInfo.usage = request.buffer.usage;
+      bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+      if (vkCreateBuffer(this->m_device, &bufferInfo, nullptr,
+                         &resource.buffer) != VK_SUCCESS) {
+        this->release();
+        return unexpected("failed to create transient buffer");
+      }
+      vkGetBufferMemoryRequirements(this->m_device, resource.buffer,
+                                    &resource.requirements);
+    }
+    this->m_requestedBytes += resource.requirements.size;
+  }
+
+  // images and buffers get separate heaps so bufferImageGranularity never
+  // matters, within a heap the biggest resources are placed first, each at the
+  // lowest offset that doesn't collide with a resource alive at the same time
+  std::map<std::pair<uint32_t, bool>, vector<uint32_t>> groups;
+  for (uint32_t i = 0; i < requests.size(); i++) {
+    auto memoryType =
+        this->find_memory_type(this->m_resources[i].requirements.memoryTypeBits);
+    if (!memoryType.has_value()) {
+      this->release();
+      return unexpected(memoryType.error());
+    }
+    groups[{memoryType.value(), requests[i].isImage}].push_back(i);
+  }
+  for (auto &[group, members] : groups) {
+    std::ranges::stable_sort(members, [this](const uint32_t a,
+                                             const uint32_t b) {
+      return this->m_resources[a].requirements.size >
+             this->m_resources[b].requirements.size;
+    });
+    const auto heapIndex = static_cast<uint32_t>(this->m_heaps.size());
+    Heap heap{};
+    heap.memoryType = group.first;
+    heap.images = group.second;
+    vector<uint32_t> placed;
+    for (const uint32_t index : members) {
+      auto &resource = this->m_resources[index];
+      const VkDeviceSize size = resource.requirements.size;
+      const VkDeviceSize alignment =
+          std::max<VkDeviceSize>(resource.requirements.alignment, 1);
+      VkDeviceSize offset = 0;
+      bool moved = true;
+      while (moved) {
+        moved = false;
+        for (const uint32_t other : placed) {
+          const auto &otherResource = this->m_resources[other];
+          const VkDeviceSize otherEnd =
+              otherResource.offset + otherResource.requirements.size;
+          if (lifetimes_overlap(requests[index], requests[other]) &&
+              offset < otherEnd && otherResource.offset < offset + size) {
+            offset = align_up(otherEnd, alignment);
+            moved = true;
+          }
+        }
+      }
+      resource.heap = heapIndex;
+      resource.offset = offset;
+      heap.size = std::max(heap.size, offset + size);
+      placed.push_back(index);
+    }
+
+    VkMemoryAllocateInfo allocInfo{};
+    allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+    allocInfo.allocationSize = heap.size;
+    allocInfo.memoryTypeIndex = heap.memoryType;
+    if (allocate_device_memory(this->m_device, allocInfo,
+                               DeviceMemoryCategory::RenderTargets,
+                               &heap.memory) != VK_SUCCESS) {
+      this->release();
+      return unexpected("failed to allocate transient resource memory");
+    }
+    this->m_heaps.push_back(heap);
+    this->m_allocatedBytes += heap.size;
+  }
+
+  for (uint32_t i = 0; i < requests.size(); i++) {
+    auto &resource = this->m_resources[i];
+    const VkDeviceMemory memory = this->m_heaps[resource.heap].memory;
+    if (requests[i].isImage) {
+      if (vkBindImageMemory(this->m_device, resource.image, memory,
+                            resource.offset) != VK_SUCCESS) {
+        this->release();
+        return unexpected("failed to bind transient image memory");
+      }
+      VkImageViewCreateInfo viewInfo{};
+      viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+      viewInfo.image = resource.image;
+      viewInfo.viewType = requests[i].image.arrayLayers > 1
+                              ? VK_IMAGE_VIEW_TYPE_2D_ARRAY
+                              : VK_IMAGE_VIEW_TYPE_2D;
+      viewInfo.format = requests[i].image.format;
+      viewInfo.subresourceRange.aspectMask =
+          aspect_from_format(requests[i].image.format);
+      viewInfo.subresourceRange.levelCount = requests[i].image.mipLevels;
+      viewInfo.subresourceRange.layerCount = requests[i].image.arrayLayers;
+      if (vkCreateImageView(this->m_device, &viewInfo, nullptr,
+                            &resource.view) != VK_SUCCESS) {
+        this->release();
+        return unexpected("failed to create transient image view");
+      }
+    } else if (vkBindBufferMemory(this->m_device, resource.buffer, memory,
+                                  resource.offset) != VK_SUCCESS) {
+      this->release();
+      return unexpected("failed to bind transient buffer memory");
+    }
+    for (uint32_t j = 0; j < requests.size(); j++) {
+      const auto &other = this->m_resources[j];
+      if (other.heap == resource.heap &&
+          requests[j].lastPass < requests[i].firstPass &&
+          resource.offset < other.offset + other.requirements.size &&
+          other.offset < resource.offset + resource.requirements.size) {
+        resource.aliasedBy.push_back(j);
+      }
+    }
+  }
+
+  this->m_layoutHash = layoutHash;
+  this->m_requests.assign(requests.begin(), requests.end());
+  spdlog::debug("render graph transients: {} resources, {} bytes requested, "
+                "{} bytes allocated",
+                requests.size(), this->m_requestedBytes,
+                this->m_allocatedBytes);
+  return {};
+}
+
+auto TransientResourcePool::image(const uint32_t index) const -> VkImage {
+  return this->m_resources[index].image;
+}
+
+auto TransientResourcePool::image_view(const uint32_t index) const
+    -> VkImageView {
+  return this->m_resources[index].view;
+}
+
+auto TransientResourcePool::buffer(const uint32_t index) const -> VkBuffer {
+  return this->m_resources[index].buffer;
+}
+
+auto TransientResourcePool::aliased_by(const uint32_t index) const
+    -> std::span<const uint32_t> {
+  return this->m_resources[index].aliasedBy;
+}
+
+auto TransientResourcePool::requested_bytes() const -> VkDeviceSize {
+  return this->m_requestedBytes;
+}
+
+auto TransientResourcePool::allocated_bytes() const -> VkDeviceSize {
+  return this->m_allocatedBytes;
+}
+#pragma endregion
+} // namespace SFT::Renderer::VK
@@ -0,0 +1,130 @@
+//
+// Created by sturd on 10/18/2026.
+//
+
+#ifndef TRANSIENTRESOURCEPOOL_H
+#define TRANSIENTRESOURCEPOOL_H
+
+#include "Core/Renderer/VK/VulkanDispatch.h"
+#include <cstdint>
+#include <expected>
+#include <span>
+#include <string>
+#include <vector>
+
+using std::expected;
+using std::string;
+using std::unexpected;
+using std::vector;
+
+namespace SFT::Renderer::VK {
+struct RenderGraphImageDesc {
+  VkFormat format = VK_FORMAT_UNDEFINED;
+  VkExtent2D extent{};
+  uint32_t mipLevels = 1;
+  uint32_t arrayLayers = 1;
+  VkSampleCountFlagBits samples = VK_SAMPLE_COUNT_1_BIT;
+  // the graph adds the bits implied by how passes use the image, this is only
+  // needed for uses that happen outside the graph
+  VkImageUsageFlags usage = 0;
+
+  auto operator==(const RenderGraphImageDesc &) const -> bool = default;
+};
+
+struct RenderGraphBufferDesc {
+  VkDeviceSize size = 0;
+  VkBufferUsageFlags usage = 0;
+
+  auto operator==(const RenderGraphBufferDesc &) const -> bool = default;
+};
+
+/*!
+ * @brief A resource the graph wants backed by memory, lifetimes are indices
+ * into the graph's execution order and are inclusive
+ */
+struct TransientRequest {
+  bool isImage = true;
+  RenderGraphImageDesc image{};
+  RenderGraphBufferDesc buffer{};
+  uint32_t firstPass = 0;
+  uint32_t lastPass = 0;
+
+  auto operator==(const TransientRequest &) const -> bool = default;
+};
+
+/*!
+ * @brief Backs the transient resources of one frame's render graph, resources
+ * whose lifetimes don't overlap are placed at overlapping offsets of a shared
+ * allocation, and the whole set is kept alive across frames for as long as
+ * the graph keeps asking for the same thing
+ */
+class TransientResourcePool {
+private:
+  struct Heap {
+    VkDeviceMemory memory = VK_NULL_HANDLE;
+    VkDeviceSize size = 0;
+    uint32_t memoryType = 0;
+    bool images = true;
+  };
+  struct Physical {
+    VkImage image = VK_NULL_HANDLE;
+    VkImageView view = VK_NULL_HANDLE;
+    VkBuffer buffer = VK_NULL_HANDLE;
+    VkMemoryRequirements requirements{};
+    uint32_t heap = 0;
+    VkDeviceSize offset = 0;
+    // resources earlier in the frame that occupied some of the same memory
+    vector<uint32_t> aliasedBy;
+  };
+
+  VkDevice m_device = VK_NULL_HANDLE;
+  VkPhysicalDeviceMemoryProperties m_memoryProperties{};
+  vector<Heap> m_heaps;
+  vector<Physical> m_resources;
+  // the hash is only a quick reject, a matching hash still compares the
+  // requests the resources were built for before reusing them
+  uint64_t m_layoutHash = 0;
+  vector<TransientRequest> m_requests;
+  VkDeviceSize m_requestedBytes = 0;
+  VkDeviceSize m_allocatedBytes = 0;
+
+  auto release() -> void;
+  auto find_memory_type(uint32_t typeBits) const -> expected<uint32_t, string>;
+
+public:
+  auto init(VkDevice device, VkPhysicalDevice physicalDevice) -> void;
+  auto destroy() -> void;
+  /*!
+   * @brief Makes sure every request is backed, when the requests match the
+   * previous call exactly the existing resources are reused, otherwise they are
+   * destroyed and rebuilt, so callers must know the GPU is done with them
+   * @param requests the resources and lifetimes of this frame
+   * @return On success, returns void, on failure, returns unexpected with error
+   * message
+   */
+  auto realize(std::span<const TransientRequest> requests)
+      -> expected<void, string>;
+  [[nodiscard]] auto image(uint32_t index) const -> VkImage;
+  [[nodiscard]] auto image_view(uint32_t index) const -> VkImageView;
+  [[nodiscard]] auto buffer(uint32_t index) const -> VkBuffer;
+  /*!
+   * @brief Gets the resources that used some of a resource's memory earlier in
+   * the frame, its first use has to wait for their last use
+   * @param index the resource to check
+   * @return the indices of the earlier resources
+   */
+  [[nodiscard]] auto aliased_by(uint32_t index) const
+      -> std::span<const uint32_t>;
+  [[nodiscard]] auto requested_bytes() const -> VkDeviceSize;
+  [[nodiscard]] auto allocated_bytes() const -> VkDeviceSize;
+};
+
+/*!
+ * @brief Gets the aspects an image of the format has
+ * @param format the format of the image
+ * @return depth and/or stencil for depth formats, color for everything else
+ */
+auto aspect_from_format(VkFormat format) -> VkImageAspectFlags;
+} // namespace SFT::Renderer::VK
+
+#endif // TRANSIENTRESOURCEPOOL_H
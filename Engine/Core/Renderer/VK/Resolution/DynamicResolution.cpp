@@ -0,0 +1,184 @@
+//
+// Created by sturd on 10/18/2026.
+//
+
+#include "DynamicResolution.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace SFT::Renderer::VK {
+#pragma region additional functions
+namespace {
+// how much of a new measurement goes into the smoothed time, over budget
+// frames are taken in faster than under budget ones so spikes are answered
+// quickly and the scale only creeps back up once the GPU has settled
+constexpr double overBudgetWeight = 0.5;
+constexpr double underBudgetWeight = 0.1;
+
+auto scale_axis(const uint32_t size, const float scale,
+                const uint32_t granularity, const uint32_t limit)
+    -> uint32_t {
+  const auto scaled = static_cast<uint32_t>(
+      std::lround(static_cast<double>(size) * static_cast<double>(scale)));
+  const uint32_t rounded =
+      (scaled + granularity - 1) / granularity * granularity;
+  return std::clamp(rounded, std::min(granularity, limit), limit);
+}
+} // namespace
+#pragma endregion
+
+#pragma region DynamicResolution Functions
+auto DynamicResolution::init(VkDevice device, VkPhysicalDevice physicalDevice,
+                             const uint32_t graphicsFamily,
+                             const uint32_t framesInFlight,
+                             const DynamicResolutionSettings &settings)
+    -> expected<void, string> {
+  this->m_device = device;
+  this->m_settings = settings;
+  // max first, clamping min against a max below 0.1 would be undefined
+  this->m_settings.maxScale = std::clamp(settings.maxScale, 0.1f, 1.0f);
+  this->m_settings.minScale =
+      std::clamp(settings.minScale, 0.1f, this->m_settings.maxScale);
+  this->m_settings.granularity = std::max(settings.granularity, 1u);
+  this->m_scale = this->m_settings.maxScale;
+  this->m_smoothedMs = 0.0;
+  this->m_lastMs = 0.0;
+  this->m_pending.assign(framesInFlight, false);
+
+  VkPhysicalDeviceProperties properties;
+  vkGetPhysicalDeviceProperties(physicalDevice, &properties);
+  uint32_t familyCount = 0;
+  vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &familyCount,
+                                           nullptr);
+  vector<VkQueueFamilyProperties> families(familyCount);
+  vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &familyCount,
+                                           families.data());
+  const uint32_t validBits = graphicsFamily < familyCount
+                                 ? families[graphicsFamily].timestampValidBits
+                                 : 0;
+  if (validBits == 0 || properties.limits.timestampPeriod <= 0.0f) {
+    return unexpected("the graphics queue has no timestamps, dynamic "
+                      "resolution stays at its maximum scale");
+  }
+  this->m_timestampPeriod = properties.limits.timestampPeriod;
+  this->m_timestampMask =
+      validBits >= 64 ? UINT64_MAX : (uint64_t{1} << validBits) - 1;
+
+  VkQueryPoolCreateInfo poolInfo{};
+  poolInfo.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+  poolInfo.queryType = VK_QUERY_TYPE_TIMESTAMP;
+  poolInfo.queryCount = framesInFlight * 2;
+  if (vkCreateQueryPool(device, &poolInfo, nullptr, &this->m_queries) !=
+      VK_SUCCESS) {
+    return unexpected("failed to create the frame timestamp query pool");
+  }
+  return {};
+}
+
+auto DynamicResolution::destroy() -> void {
+  if (this->m_queries != VK_NULL_HANDLE) {
+    vkDestroyQueryPool(this->m_device, this->m_queries, nullptr);
+  }
+  this->m_queries = VK_NULL_HANDLE;
+  this->m_pending.clear();
+}
+
+auto DynamicResolution::set_output_extent(const VkExtent2D extent) -> void {
+  this->m_outputExtent = extent;
+  this->m_maxRenderExtent = {
+      scale_axis(extent.width, this->m_settings.maxScale, 1, UINT32_MAX),
+      scale_axis(extent.height, this->m_settings.maxScale, 1, UINT32_MAX)};
+  this->update_render_extent();
+}
+
+auto DynamicResolution::update_render_extent() -> void {
+  const uint32_t granularity = this->m_settings.granularity;
+  this->m_renderExtent = {
+      scale_axis(this->m_outputExtent.width, this->m_scale, granularity,
+                 this->m_maxRenderExtent.width),
+      scale_axis(this->m_outputExtent.height, this->m_scale, granularity,
+                 this->m_maxRenderExtent.height)};
+}
+
+auto DynamicResolution::begin_frame(const uint32_t frameSlot) -> VkExtent2D {
+  if (this->m_queries == VK_NULL_HANDLE ||
+      frameSlot >= this->m_pending.size() || !this->m_pending[frameSlot]) {
+    return this->m_renderExtent;
+  }
+  uint64_t timestamps[2] = {};
+  const VkResult result = vkGetQueryPoolResults(
+      this->m_device, this->m_queries, frameSlot * 2, 2, sizeof(timestamps),
+      timestamps, sizeof(uint64_t), VK_QUERY_RESULT_64_BIT);
+  this->m_pending[frameSlot] = false;
+  if (result != VK_SUCCESS) {
+    return this->m_renderExtent;
+  }
+  const uint64_t ticks =
+      (timestamps[1] - timestamps[0]) & this->m_timestampMask;
+  const double ms = static_cast<double>(ticks) * this->m_timestampPeriod / 1e6;
+  this->m_lastMs = ms;
+
+  const double target = this->m_settings.targetFrameMs;
+  if (this->m_smoothedMs == 0.0) {
+    this->m_smoothedMs = ms;
+  } else {
+    const double weight = ms > target ? overBudgetWeight : underBudgetWeight;
+    this->m_smoothedMs += (ms - this->m_smoothedMs) * weight;
+  }
+  if (std::abs(this->m_smoothedMs - target) <=
+      target * this->m_settings.deadband) {
+    return this->m_renderExtent;
+  }
+  // GPU time follows the pixel count, which follows the scale squared
+  const auto desired = static_cast<float>(
+      this->m_scale * std::sqrt(target / std::max(this->m_smoothedMs, 0.01)));
+  const float step = std::clamp(desired - this->m_scale,
+                                -this->m_settings.maxStep,
+                                this->m_settings.maxStep);
+  this->m_scale = std::clamp(this->m_scale + step, this->m_settings.minScale,
+                             this->m_settings.maxScale);
+  this->update_render_extent();
+  return this->m_renderExtent;
+}
+
+auto DynamicResolution::record_begin(VkCommandBuffer commandBuffer,
+                                     const uint32_t frameSlot) -> void {
+  if (this->m_queries == VK_NULL_HANDLE ||
+      frameSlot >= this->m_pending.size()) {
+    return;
+  }
+  vkCmdResetQueryPool(commandBuffer, this->m_queries, frameSlot * 2, 2);
+  vkCmdWriteTimestamp2(commandBuffer, VK_PIPELINE_STAGE_2_TOP_OF_PIPE_BIT,
+                       this->m_queries, frameSlot * 2);
+}
+
+auto DynamicResolution::record_end(VkCommandBuffer commandBuffer,
+                                   const uint32_t frameSlot) -> void {
+  if (this->m_queries == VK_NULL_HANDLE ||
+      frameSlot >= this->m_pending.size()) {
+    return;
+  }
+  vkCmdWriteTimestamp2(commandBuffer, VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT,
+                       this->m_queries, frameSlot * 2 + 1);
+  this->m_pending[frameSlot] = true;
+}
+
+auto DynamicResolution::record_upscale(VkCommandBuffer commandBuffer,
+                                       VkImage source,
+                                       VkImage destination) const -> void {
+  VkImageBlit region{};
+  region.srcSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1};
+  region.srcOffsets[1] = {static_cast<int32_t>(this->m_renderExtent.width),
+                          static_cast<int32_t>(this->m_renderExtent.height),
+                          1};
+  region.dstSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1};
+  region.dstOffsets[1] = {static_cast<int32_t>(this->m_outputExtent.width),
+                          static_cast<int32_t>(this->m_outputExtent.height),
+                          1};
+  vkCmdBlitImage(commandBuffer, source, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                 destination, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region,
+                 VK_FILTER_LINEAR);
+}
+#pragma endregion
+} // namespace SFT::Renderer::VK
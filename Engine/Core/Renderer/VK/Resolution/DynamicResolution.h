@@ -0,0 +1,133 @@
+//
+// Created by sturd on 10/18/2026.
+//
+
+#ifndef DYNAMICRESOLUTION_H
+#define DYNAMICRESOLUTION_H
+
+#include "Core/Renderer/VK/VulkanDispatch.h"
+#include <cstdint>
+#include <expected>
+#include <string>
+#include <vector>
+
+using std::expected;
+using std::string;
+using std::unexpected;
+using std::vector;
+
+namespace SFT::Renderer::VK {
+struct DynamicResolutionSettings {
+  // the GPU time per frame the controller aims for, in milliseconds
+  double targetFrameMs = 1000.0 / 60.0;
+  // bounds of the render scale, per axis, relative to the output
+  float minScale = 0.5f;
+  float maxScale = 1.0f;
+  // the most the scale moves in one frame, so a spike doesn't blur the image
+  // for a single frame and snap back on the next
+  float maxStep = 0.1f;
+  // no change while the smoothed time is within this fraction of the target
+  double deadband = 0.05;
+  // render extents are rounded to multiples of this, so the scale doesn't
+  // jitter by a pixel every frame
+  uint32_t granularity = 8;
+};
+
+/*!
+ * @brief Picks the internal render resolution from measured GPU time. A pair
+ * of timestamps brackets each frame's GPU work, once a frame slot comes back
+ * its time is smoothed and the render scale is nudged to hold the target,
+ * pixel cost scales with area so the scale moves by the square root of the
+ * ratio. Render targets are created at max_render_extent() once and each
+ * frame renders into the top left render_extent() of them, so changing the
+ * scale never reallocates anything, record_upscale stretches that region onto
+ * the output at the end of the frame
+ */
+class DynamicResolution {
+private:
+  VkDevice m_device = VK_NULL_HANDLE;
+  VkQueryPool m_queries = VK_NULL_HANDLE;
+  // nanoseconds per timestamp tick, and the bits a timestamp actually has
+  double m_timestampPeriod = 0.0;
+  uint64_t m_timestampMask = 0;
+  // whether the slot's queries were written and not read back yet
+  vector<bool> m_pending;
+  DynamicResolutionSettings m_settings;
+  VkExtent2D m_outputExtent{};
+  VkExtent2D m_maxRenderExtent{};
+  VkExtent2D m_renderExtent{};
+  float m_scale = 1.0f;
+  double m_smoothedMs = 0.0;
+  double m_lastMs = 0.0;
+
+  auto update_render_extent() -> void;
+
+public:
+  /*!
+   * @brief Creates the timestamp queries, without timestamp support on the
+   * graphics queue the scale stays at maxScale
+   * @param device the logical device
+   * @param physicalDevice the device whose timestamp period is used
+   * @param graphicsFamily the queue family frames are recorded for
+   * @param framesInFlight how many frames can be recorded ahead of the GPU
+   * @param settings the target and bounds
+   * @return On success, returns void, on failure, returns unexpected with
+   * error message
+   */
+  auto init(VkDevice device, VkPhysicalDevice physicalDevice,
+            uint32_t graphicsFamily, uint32_t framesInFlight,
+            const DynamicResolutionSettings &settings)
+      -> expected<void, string>;
+  auto destroy() -> void;
+  /*!
+   * @brief Sets the size of the image the frame is upscaled to, call it
+   * whenever the swap chain is recreated, render targets then need to be
+   * recreated at max_render_extent()
+   * @param extent the swap chain extent
+   */
+  auto set_output_extent(VkExtent2D extent) -> void;
+  /*!
+   * @brief Reads back the frame slot's previous timings and updates the
+   * render extent, the GPU must be done with the slot's previous use
+   * @param frameSlot the frame in flight being recorded
+   * @return the extent to render this frame at
+   */
+  auto begin_frame(uint32_t frameSlot) -> VkExtent2D;
+  /*!
+   * @brief Records the timestamp before the frame's GPU work, first in the
+   * command buffer and outside of rendering
+   */
+  auto record_begin(VkCommandBuffer commandBuffer, uint32_t frameSlot) -> void;
+  /*!
+   * @brief Records the timestamp after the frame's GPU work, last in the
+   * command buffer and outside of rendering
+   */
+  auto record_end(VkCommandBuffer commandBuffer, uint32_t frameSlot) -> void;
+  /*!
+   * @brief Stretches the rendered region of an image onto the whole output
+   * with linear filtering
+   * @param commandBuffer the command buffer being recorded, outside of
+   * rendering
+   * @param source a color image at least render_extent() large in
+   * TRANSFER_SRC_OPTIMAL
+   * @param destination an image of the output extent in
+   * TRANSFER_DST_OPTIMAL, such as the swap chain image
+   */
+  auto record_upscale(VkCommandBuffer commandBuffer, VkImage source,
+                      VkImage destination) const -> void;
+  [[nodiscard]] auto render_extent() const -> VkExtent2D {
+    return this->m_renderExtent;
+  }
+  [[nodiscard]] auto max_render_extent() const -> VkExtent2D {
+    return this->m_maxRenderExtent;
+  }
+  [[nodiscard]] auto output_extent() const -> VkExtent2D {
+    return this->m_outputExtent;
+  }
+  [[nodiscard]] auto scale() const -> float { return this->m_scale; }
+  // the last GPU frame time measured, in milliseconds, 0 until one is known
+  [[nodiscard]] auto gpu_frame_ms() const -> double { return this->m_lastMs; }
+};
+} // namespace SFT::Renderer::VK
+
+#endif // DYNAMICRESOLUTION_H
@@ -0,0 +1,240 @@
+//
+// Created by sturd on 10/18/2026.
+//
+
+#include "QueueTimelines.h"
+
+#include "Core/Memory/LinearArena.h"
+#include <memory_resource>
+#include <vector>
+
+namespace SFT::Renderer::VK {
+#pragma region additional functions
+namespace {
+constexpr size_t queueCount = static_cast<size_t>(GpuQueue::Count);
+
+auto queue_name(const GpuQueue queue) -> const char * {
+  switch (queue) {
+  case GpuQueue::Graphics:
+    return "graphics";
+  case GpuQueue::Compute:
+    return "compute";
+  case GpuQueue::Transfer:
+    return "transfer";
+  default:
+    return "unknown";
+  }
+}
+} // namespace
+#pragma endregion
+
+#pragma region QueueTimelines Functions
+auto QueueTimelines::init(VkDevice device, const QueueSelection &selection)
+    -> expected<void, string> {
+  this->m_device = device;
+  for (size_t i = 0; i < queueCount; i++) {
+    VkQueue queue = VK_NULL_HANDLE;
+    vkGetDeviceQueue(device, selection.family[i], selection.index[i], &queue);
+    // queues the device doesn't have separately fall back onto one that
+    // exists, they share its timeline so their submits stay serialized
+    for (size_t j = 0; j < i; j++) {
+      if (this->m_timelines[j]->queue == queue) {
+        this->m_timelines[i] = this->m_timelines[j];
+        break;
+      }
+    }
+    if (this->m_timelines[i] != nullptr) {
+      continue;
+    }
+    auto timeline = std::make_unique<Timeline>();
+    timeline->queue = queue;
+    timeline->family = selection.family[i];
+    VkSemaphoreTypeCreateInfo typeInfo{};
+    typeInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO;
+    typeInfo.semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE;
+    typeInfo.initialValue = 0;
+    VkSemaphoreCreateInfo semaphoreInfo{};
+    semaphoreInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+    semaphoreInfo.pNext = &typeInfo;
+    if (vkCreateSemaphore(device, &semaphoreInfo, nullptr,
+                          &timeline->semaphore) != VK_SUCCESS) {
+      return unexpected(string("failed to create the ") +
+                        queue_name(static_cast<GpuQueue>(i)) +
+                        " timeline semaphore");
+    }
+    this->m_timelines[i] = timeline.get();
+    this->m_owned[i] = std::move(timeline);
+  }
+  return {};
+}
+
+auto QueueTimelines::destroy() -> void {
+  for (auto &timeline : this->m_owned) {
+    if (timeline == nullptr) {
+      continue;
+    }
+    const uint64_t submitted = timeline->submitted.load();
+    VkSemaphoreWaitInfo waitInfo{};
+    waitInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO;
+    waitInfo.semaphoreCount = 1;
+    waitInfo.pSemaphores = &timeline->semaphore;
+    waitInfo.pValues = &submitted;
+    vkWaitSemaphores(this->m_device, &waitInfo, UINT64_MAX);
+    vkDestroySemaphore(this->m_device, timeline->semaphore, nullptr);
+    timeline.reset();
+  }
+  this->m_timelines = {};
+}
+
+auto QueueTimelines::refresh(Timeline &timeline) const -> uint64_t {
+  uint64_t value = 0;
+  vkGetSemaphoreCounterValue(this->m_device, timeline.semaphore, &value);
+  uint64_t seen = timeline.completed.load(std::memory_order_relaxed);
+  while (seen < value && !timeline.completed.compare_exchange_weak(
+                             seen, value, std::memory_order_relaxed)) {
+  }
+  return std::max(seen, value);
+}
+
+auto QueueTimelines::submit(const GpuQueue queue, const QueueSubmit &submit)
+    -> expected<TimelinePoint, string> {
+  auto &target = this->timeline(queue);
+
+  // one wait per semaphore is enough, the highest value covers the rest, and
+  // points already known to be reached are dropped
+  std::array<uint64_t, queueCount> waitValues{};
+  std::array<Timeline *, queueCount> waitTimelines{};
+  size_t waitCount = 0;
+  for (const auto &point : submit.waits) {
+    Timeline *source = &this->timeline(point.queue);
+    if (point.value <= source->completed.load(std::memory_order_relaxed)) {
+      continue;
+    }
+    size_t slot = 0;
+    while (slot < waitCount && waitTimelines[slot] != source) {
+      slot++;
+    }
+    if (slot == waitCount) {
+      waitTimelines[waitCount++] = source;
+    }
+    waitValues[slot] = std::max(waitValues[slot], point.value);
+  }
+
+  auto &scratch = Memory::thread_scratch_arena();
+  Memory::ArenaScope scope(scratch);
+  std::pmr::vector<VkSemaphoreSubmitInfo> waits(submit.binaryWaits.begin(),
+                                                submit.binaryWaits.end(),
+                                                &scratch);
+  for (size_t i = 0; i < waitCount; i++) {
+    VkSemaphoreSubmitInfo wait{};
+    wait.sType = VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO;
+    wait.semaphore = waitTimelines[i]->semaphore;
+    wait.value = waitValues[i];
+    wait.stageMask = submit.waitStages;
+    waits.push_back(wait);
+  }
+  std::pmr::vector<VkCommandBufferSubmitInfo> commandBuffers(&scratch);
+  commandBuffers.reserve(submit.commandBuffers.size());
+  for (VkCommandBuffer commandBuffer : submit.commandBuffers) {
+    VkCommandBufferSubmitInfo info{};
+    info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_SUBMIT_INFO;
+    info.commandBuffer = commandBuffer;
+    commandBuffers.push_back(info);
+  }
+  std::pmr::vector<VkSemaphoreSubmitInfo> signals(submit.binarySignals.begin(),
+                                                  submit.binarySignals.end(),
+                                                  &scratch);
+  signals.emplace_back();
+
+  std::lock_guard lock(target.submitMutex);
+  const uint64_t value = target.submitted.load(std::memory_order_relaxed) + 1;
+  auto &signal = signals.back();
+  signal.sType = VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO;
+  signal.semaphore = target.semaphore;
+  signal.value = value;
+  signal.stageMask = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT;
+
+  VkSubmitInfo2 submitInfo{};
+  submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO_2;
+  submitInfo.waitSemaphoreInfoCount = static_cast<uint32_t>(waits.size());
+  submitInfo.pWaitSemaphoreInfos = waits.data();
+  submitInfo.commandBufferInfoCount =
+      static_cast<uint32_t>(commandBuffers.size());
+  submitInfo.pCommandBufferInfos = commandBuffers.data();
+  submitInfo.signalSemaphoreInfoCount = static_cast<uint32_t>(signals.size());
+  submitInfo.pSignalSemaphoreInfos = signals.data();
+  if (vkQueueSubmit2(target.queue, 1, &submitInfo, VK_NULL_HANDLE) !=
+      VK_SUCCESS) {
+    return unexpected(string("failed to submit to the ") + queue_name(queue) +
+                      " queue");
+  }
+  target.submitted.store(value, std::memory_order_release);
+  return TimelinePoint{queue, value};
+}
+
+auto QueueTimelines::is_complete(const TimelinePoint point) const -> bool {
+  auto &timeline = this->timeline(point.queue);
+  if (point.value <= timeline.completed.load(std::memory_order_relaxed)) {
+    return true;
+  }
+  return point.value <= this->refresh(timeline);
+}
+
+auto QueueTimelines::completed_value(const GpuQueue queue) const -> uint64_t {
+  return this->refresh(this->timeline(queue));
+}
+
+auto QueueTimelines::last_submitted(const GpuQueue queue) const
+    -> TimelinePoint {
+  return TimelinePoint{
+      queue, this->timeline(queue).submitted.load(std::memory_order_acquire)};
+}
+
+auto QueueTimelines::wait(const std::span<const TimelinePoint> points,
+                          const uint64_t timeoutNs) -> expected<void, string> {
+  std::array<VkSemaphore, queueCount> semaphores{};
+  std::array<uint64_t, queueCount> values{};
+  std::array<Timeline *, queueCount> timelines{};
+  uint32_t count = 0;
+  for (const auto &point : points) {
+    Timeline *timeline = &this->timeline(point.queue);
+    if (point.value <= timeline->completed.load(std::memory_order_relaxed)) {
+      continue;
+    }
+    uint32_t slot = 0;
+    while (slot < count && timelines[slot] != timeline) {
+      slot++;
+    }
+    if (slot == count) {
+      timelines[count] = timeline;
+      semaphores[count++] = timeline->semaphore;
+    }
+    values[slot] = std::max(values[slot], point.value);
+  }
+  if (count == 0) {
+    return {};
+  }
+  VkSemaphoreWaitInfo waitInfo{};
+  waitInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO;
+  waitInfo.semaphoreCount = count;
+  waitInfo.pSemaphores = semaphores.data();
+  waitInfo.pValues = values.data();
+  const VkResult result = vkWaitSemaphores(this->m_device, &waitInfo, timeoutNs);
+  if (result == VK_TIMEOUT) {
+    return unexpected("timed out waiting on the GPU");
+  }
+  if (result != VK_SUCCESS) {
+    return unexpected("failed to wait on the GPU");
+  }
+  for (uint32_t i = 0; i < count; i++) {
+    this->refresh(*timelines[i]);
+  }
+  return {};
+}
+
+auto QueueTimelines::wait(const TimelinePoint point, const uint64_t timeoutNs)
+    -> expected<void, string> {
+  return this->wait(std::span(&point, 1), timeoutNs);
+}
+#pragma endregion
+} // namespace SFT::Renderer::VK
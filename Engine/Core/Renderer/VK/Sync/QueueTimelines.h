@@ -0,0 +1,160 @@
+//
+// Created by sturd on 10/18/2026.
+//
+
+#ifndef QUEUETIMELINES_H
+#define QUEUETIMELINES_H
+
+#include "Core/Renderer/VK/VulkanDispatch.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <expected>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string>
+
+using std::expected;
+using std::string;
+using std::unexpected;
+
+namespace SFT::Renderer::VK {
+enum class GpuQueue : uint8_t { Graphics, Compute, Transfer, Count };
+
+/*!
+ * @brief A point on a queue's timeline, reached once every submit up to and
+ * including the one that returned it has finished. Value 0 is always reached,
+ * so a default point never waits
+ */
+struct TimelinePoint {
+  GpuQueue queue = GpuQueue::Graphics;
+  uint64_t value = 0;
+};
+
+/*!
+ * @brief The family and queue index each GpuQueue runs on, queues that end up
+ * on the same VkQueue share one timeline
+ */
+struct QueueSelection {
+  std::array<uint32_t, static_cast<size_t>(GpuQueue::Count)> family{};
+  std::array<uint32_t, static_cast<size_t>(GpuQueue::Count)> index{};
+};
+
+/*!
+ * @brief One submit, the waits are timeline points on any queue, binary
+ * semaphores are only for the swap chain, which can't use timelines
+ */
+struct QueueSubmit {
+  std::span<const VkCommandBuffer> commandBuffers;
+  std::span<const TimelinePoint> waits;
+  // the stages that wait on the timeline points
+  VkPipelineStageFlags2 waitStages = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT;
+  std::span<const VkSemaphoreSubmitInfo> binaryWaits;
+  std::span<const VkSemaphoreSubmitInfo> binarySignals;
+};
+
+/*!
+ * @brief Synchronizes the graphics, compute and transfer queues with one
+ * timeline semaphore per queue. Every submit signals the next value of its
+ * queue's timeline, so CPU waits, cross queue waits and checking whether a
+ * resource is still in use are all comparisons of 64 bit values, no fences
+ * or per frame binary semaphores. Submitting is thread safe, submits to a
+ * queue are serialized since a VkQueue must be externally synchronized
+ */
+class QueueTimelines {
+private:
+  struct Timeline {
+    VkQueue queue = VK_NULL_HANDLE;
+    uint32_t family = 0;
+    VkSemaphore semaphore = VK_NULL_HANDLE;
+    std::mutex submitMutex;
+    // the value the last submit signals, written under submitMutex
+    std::atomic<uint64_t> submitted{0};
+    // the highest value seen reached, saves a driver call on most checks
+    std::atomic<uint64_t> completed{0};
+  };
+
+  VkDevice m_device = VK_NULL_HANDLE;
+  // unique_ptr keeps the mutexes in place, aliased queues point at the same
+  // timeline
+  std::array<std::unique_ptr<Timeline>, static_cast<size_t>(GpuQueue::Count)>
+      m_owned;
+  std::array<Timeline *, static_cast<size_t>(GpuQueue::Count)> m_timelines{};
+
+  [[nodiscard]] auto timeline(GpuQueue queue) const -> Timeline & {
+    return *this->m_timelines[static_cast<size_t>(queue)];
+  }
+  auto refresh(Timeline &timeline) const -> uint64_t;
+
+public:
+  QueueTimelines() = default;
+  QueueTimelines(const QueueTimelines &) = delete;
+  auto operator=(const QueueTimelines &) -> QueueTimelines & = delete;
+
+  /*!
+   * @brief Gets the queues and creates their timelines, the device must have
+   * the timelineSemaphore and synchronization2 features enabled
+   * @param device the logical device
+   * @param selection where each GpuQueue runs
+   * @return On success, returns void, on failure, returns unexpected with
+   * error message
+   */
+  auto init(VkDevice device, const QueueSelection &selection)
+      -> expected<void, string>;
+  /*!
+   * @brief Waits for every submit to finish, then destroys the timelines
+   */
+  auto destroy() -> void;
+  /*!
+   * @brief Submits to a queue, waiting on the given points first
+   * @param queue the queue to submit to
+   * @param submit what to submit and wait on
+   * @return On success, returns the point that's reached once the submit is
+   * done, on failure, returns unexpected with error message
+   */
+  auto submit(GpuQueue queue, const QueueSubmit &submit)
+      -> expected<TimelinePoint, string>;
+  /*!
+   * @brief Whether the GPU has reached a point, never blocks
+   */
+  [[nodiscard]] auto is_complete(TimelinePoint point) const -> bool;
+  /*!
+   * @brief The highest value a queue's timeline has reached
+   */
+  [[nodiscard]] auto completed_value(GpuQueue queue) const -> uint64_t;
+  /*!
+   * @brief The point the last submit to a queue reaches, waiting on it waits
+   * for everything submitted so far
+   */
+  [[nodiscard]] auto last_submitted(GpuQueue queue) const -> TimelinePoint;
+  /*!
+   * @brief Blocks until every point is reached
+   * @param points the points to wait for, on any queues
+   * @param timeoutNs how long to wait at most
+   * @return On success, returns void, on failure (including the timeout),
+   * returns unexpected with error message
+   */
+  auto wait(std::span<const TimelinePoint> points,
+            uint64_t timeoutNs = UINT64_MAX) -> expected<void, string>;
+  auto wait(TimelinePoint point, uint64_t timeoutNs = UINT64_MAX)
+      -> expected<void, string>;
+  [[nodiscard]] auto queue(GpuQueue queue) const -> VkQueue {
+    return this->timeline(queue).queue;
+  }
+  [[nodiscard]] auto family(GpuQueue queue) const -> uint32_t {
+    return this->timeline(queue).family;
+  }
+  /*!
+   * @brief Whether two GpuQueues run on the same VkQueue, pipeline barriers
+   * then order work between them and resources need no ownership transfer
+   */
+  [[nodiscard]] auto same_queue(GpuQueue a, GpuQueue b) const -> bool {
+    return this->m_timelines[static_cast<size_t>(a)] ==
+           this->m_timelines[static_cast<size_t>(b)];
+  }
+};
+} // namespace SFT::Renderer::VK
+
+#endif // QUEUETIMELINES_H
@@ -0,0 +1,128 @@
+//
+// Created by sturd on 10/18/2026.
+//
+
+#include "CookedTextureSource.h"
+
+#include "Core/Utility/Utility.h"
+#include <algorithm>
+#include <bit>
+#include <system_error>
+
+namespace SFT::Renderer::VK {
+#pragma region additional functions
+namespace {
+// the formats the editor's texture cooker writes
+auto is_cooked_format(const VkFormat format) -> bool {
+  switch (format) {
+  case VK_FORMAT_BC1_RGB_UNORM_BLOCK:
+  case VK_FORMAT_BC1_RGB_SRGB_BLOCK:
+  case VK_FORMAT_BC3_UNORM_BLOCK:
+  case VK_FORMAT_BC3_SRGB_BLOCK:
+  case VK_FORMAT_BC5_UNORM_BLOCK:
+  case VK_FORMAT_BC7_UNORM_BLOCK:
+  case VK_FORMAT_BC7_SRGB_BLOCK:
+    return true;
+  default:
+    return false;
+  }
+}
+} // namespace
+#pragma endregion
+
+#pragma region CookedTextureSource Functions
+CookedTextureSource::CookedTextureSource(
+    std::filesystem::path path, const Assets::CookedTextureHeader &header)
+    : m_path(std::move(path)), m_header(header) {}
+
+auto CookedTextureSource::open(const std::filesystem::path &path)
+    -> expected<std::unique_ptr<CookedTextureSource>, string> {
+  std::error_code error;
+  const auto fileSize = std::filesystem::file_size(path, error);
+  if (error) {
+    return unexpected("failed to open " + path.string() + ": " +
+                      error.message());
+  }
+  if (fileSize < sizeof(Assets::CookedTextureHeader)) {
+    return unexpected(path.string() + " is too small to be a cooked texture");
+  }
+  Assets::CookedTextureHeader header{};
+  if (auto result = Utility::read_file_range(
+          path, 0, std::as_writable_bytes(std::span(&header, 1)));
+      !result.has_value()) {
+    return unexpected(result.error());
+  }
+  if (header.magic != Assets::CookedTextureMagic) {
+    return unexpected(path.string() + " is not a cooked texture");
+  }
+  if (header.version != Assets::CookedTextureVersion) {
+    return unexpected(path.string() + " was cooked as version " +
+                      std::to_string(header.version) + ", expected " +
+                      std::to_string(Assets::CookedTextureVersion) +
+                      ", cook it again");
+  }
+  if (header.mipLevels == 0 ||
+      header.mipLevels > Assets::CookedTextureMaxMips) {
+    return unexpected(path.string() + " has an invalid mip count");
+  }
+  // everything below goes straight into image creation and the upload, so
+  // the header has to describe exactly what the cooker would have written
+  const TextureInfo info{
+      .format = static_cast<VkFormat>(header.vkFormat),
+      .width = header.width,
+      .height = header.height,
+      .mipLevels = header.mipLevels,
+  };
+  if (!is_cooked_format(info.format)) {
+    return unexpected(path.string() + " has unsupported format " +
+                      std::to_string(header.vkFormat));
+  }
+  if (header.width == 0 || header.height == 0 ||
+      header.mipLevels > static_cast<uint32_t>(std::bit_width(
+                             std::max(header.width, header.height)))) {
+    return unexpected(path.string() + " has an invalid size");
+  }
+  for (uint32_t level = 0; level < header.mipLevels; level++) {
+    const auto &mip = header.mips[level];
+    // offsets come from the file, so every check is phrased so it can't wrap
+    if (mip.offset % Assets::CookedTextureAlignment != 0 ||
+        mip.offset > fileSize || mip.size > fileSize - mip.offset) {
+      return unexpected(path.string() + " mip " + std::to_string(level) +
+                        " is out of bounds");
+    }
+    if (const VkDeviceSize mipSize = TextureStreamer::mip_bytes(info, level);
+        mip.size != mipSize) {
+      return unexpected(path.string() + " mip " + std::to_string(level) +
+                        " is " + std::to_string(mip.size) +
+                        " bytes, expected " + std::to_string(mipSize));
+    }
+  }
+  return std::unique_ptr<CookedTextureSource>(
+      new CookedTextureSource(path, header));
+}
+
+auto CookedTextureSource::info() const -> TextureInfo {
+  return TextureInfo{
+      .format = static_cast<VkFormat>(this->m_header.vkFormat),
+      .width = this->m_header.width,
+      .height = this->m_header.height,
+      .mipLevels = this->m_header.mipLevels,
+  };
+}
+
+auto CookedTextureSource::read_mip(const uint32_t level)
+    -> expected<vector<std::byte>, string> {
+  if (level >= this->m_header.mipLevels) {
+    return unexpected("mip " + std::to_string(level) + " is out of range for " +
+                      this->m_path.string());
+  }
+  const auto &mip = this->m_header.mips[level];
+  vector<std::byte> data(mip.size);
+  if (auto result = Utility::read_file_range(this->m_path, mip.offset, data);
+      !result.has_value()) {
+    return unexpected(result.error());
+  }
+  return data;
+}
+#pragma endregion
+} // namespace SFT::Renderer::VK
@@ -0,0 +1,41 @@
+//
+// Created by sturd on 10/18/2026.
+//
+
+#ifndef COOKEDTEXTURESOURCE_H
+#define COOKEDTEXTURESOURCE_H
+
+#include "Core/Assets/CookedTexture.h"
+#include "TextureStreamer.h"
+#include <filesystem>
+#include <memory>
+
+namespace SFT::Renderer::VK {
+/*!
+ * @brief Streams a texture cooked by the editor (.sftx), the header is read
+ * once and every mip is read straight from its offset on request
+ */
+class CookedTextureSource final : public TextureSource {
+private:
+  std::filesystem::path m_path;
+  Assets::CookedTextureHeader m_header{};
+
+  CookedTextureSource(std::filesystem::path path,
+                      const Assets::CookedTextureHeader &header);
+
+public:
+  /*!
+   * @brief Opens a cooked texture and validates its header
+   * @param path the .sftx file
+   * @return On success, returns the source, on failure, returns unexpected
+   * with error message
+   */
+  static auto open(const std::filesystem::path &path)
+      -> expected<std::unique_ptr<CookedTextureSource>, string>;
+  [[nodiscard]] auto info() const -> TextureInfo override;
+  auto read_mip(uint32_t level)
+      -> expected<vector<std::byte>, string> override;
+};
+} // namespace SFT::Renderer::VK
+
+#endif // COOKEDTEXTURESOURCE_H
@@ -0,0 +1,690 @@
+//
+// Created by sturd on 10/18/2026.
+//
+
+#include "TextureStreamer.h"
+
+#include "Core/Renderer/VK/Memory/DeviceMemory.h"
+#include "Core/Renderer/VK/Memory/MemoryBudget.h"
+#include "spdlog/spdlog.h"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstring>
+
+namespace SFT::Renderer::VK {
+#pragma region additional functions
+namespace {
+auto mip_extent(const TextureInfo &info, const uint32_t mip) -> VkExtent3D {
+  return {std::max(1u, info.width >> mip), std::max(1u, info.height >> mip), 1};
+}
+
+struct FormatBlock {
+  uint32_t bytes;
+  uint32_t size;
+};
+
+// block compressed formats store 4x4 texels per block, everything else is
+// treated as a 1x1 block
+auto format_block(const VkFormat format) -> FormatBlock {
+  switch (format) {
+  case VK_FORMAT_BC1_RGB_UNORM_BLOCK:
+  case VK_FORMAT_BC1_RGB_SRGB_BLOCK:
+  case VK_FORMAT_BC1_RGBA_UNORM_BLOCK:
+  case VK_FORMAT_BC1_RGBA_SRGB_BLOCK:
+  case VK_FORMAT_BC4_UNORM_BLOCK:
+  case VK_FORMAT_BC4_SNORM_BLOCK:
+    return {8, 4};
+  case VK_FORMAT_BC2_UNORM_BLOCK:
+  case VK_FORMAT_BC2_SRGB_BLOCK:
+  case VK_FORMAT_BC3_UNORM_BLOCK:
+  case VK_FORMAT_BC3_SRGB_BLOCK:
+  case VK_FORMAT_BC5_UNORM_BLOCK:
+  case VK_FORMAT_BC5_SNORM_BLOCK:
+  case VK_FORMAT_BC6H_UFLOAT_BLOCK:
+  case VK_FORMAT_BC6H_SFLOAT_BLOCK:
+  case VK_FORMAT_BC7_UNORM_BLOCK:
+  case VK_FORMAT_BC7_SRGB_BLOCK:
+    return {16, 4};
+  case VK_FORMAT_R8_UNORM:
+  case VK_FORMAT_R8_SRGB:
+    return {1, 1};
+  case VK_FORMAT_R8G8_UNORM:
+  case VK_FORMAT_R16_SFLOAT:
+    return {2, 1};
+  case VK_FORMAT_R8G8B8A8_UNORM:
+  case VK_FORMAT_R8G8B8A8_SRGB:
+  case VK_FORMAT_B8G8R8A8_UNORM:
+  case VK_FORMAT_B8G8R8A8_SRGB:
+  case VK_FORMAT_R16G16_SFLOAT:
+  case VK_FORMAT_R32_SFLOAT:
+    return {4, 1};
+  case VK_FORMAT_R16G16B16A16_SFLOAT:
+    return {8, 1};
+  case VK_FORMAT_R32G32B32A32_SFLOAT:
+    return {16, 1};
+  default:
+    return {0, 1};
+  }
+}
+
+auto color_layers(const uint32_t mip) -> VkImageSubresourceLayers {
+  VkImageSubresourceLayers layers{};
+  layers.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+  layers.mipLevel = mip;
+  layers.layerCount = 1;
+  return layers;
+}
+
+auto layout_barrier(VkImage image, const VkImageLayout oldLayout,
+                    const VkImageLayout newLayout,
+                    const VkPipelineStageFlags2 srcStages,
+                    const VkAccessFlags2 srcAccess,
+                    const VkPipelineStageFlags2 dstStages,
+                    const VkAccessFlags2 dstAccess) -> VkImageMemoryBarrier2 {
+  VkImageMemoryBarrier2 barrier{};
+  barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2;
+  barrier.srcStageMask = srcStages;
+  barrier.srcAccessMask = srcAccess;
+  barrier.dstStageMask = dstStages;
+  barrier.dstAccessMask = dstAccess;
+  barrier.oldLayout = oldLayout;
+  barrier.newLayout = newLayout;
+  barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+  barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+  barrier.image = image;
+  barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+  barrier.subresourceRange.levelCount = VK_REMAINING_MIP_LEVELS;
+  barrier.subresourceRange.layerCount = VK_REMAINING_ARRAY_LAYERS;
+  return barrier;
+}
+
+auto pipeline_barrier(VkCommandBuffer commandBuffer,
+                      const vector<VkImageMemoryBarrier2> &barriers) -> void {
+  VkDependencyInfo dependencyInfo{};
+  dependencyInfo.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO;
+  dependencyInfo.imageMemoryBarrierCount =
+      static_cast<uint32_t>(barriers.size());
+  dependencyInfo.pImageMemoryBarriers = barriers.data();
+  vkCmdPipelineBarrier2(commandBuffer, &dependencyInfo);
+}
+
+constexpr VkPipelineStageFlags2 SamplingStages =
+    VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT |
+    VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT;
+} // namespace
+#pragma endregion
+
+#pragma region TextureStreamer Functions
+auto TextureStreamer::init(VkDevice device, VkPhysicalDevice physicalDevice,
+                           const bool hasMemoryBudget,
+                           const uint32_t framesInFlight,
+                           const uint32_t loaderThreads)
+    -> expected<void, string> {
+  this->m_device = device;
+  this->m_physicalDevice = physicalDevice;
+  this->m_hasMemoryBudget = hasMemoryBudget;
+  this->m_framesInFlight = std::max(1u, framesInFlight);
+  vkGetPhysicalDeviceMemoryProperties(physicalDevice,
+                                      &this->m_memoryProperties);
+
+  this->m_staging.resize(this->m_framesInFlight);
+  for (auto &staging : this->m_staging) {
+    if (auto result = this->create_staging(staging); !result.has_value()) {
+      // tears down the staging buffers made so far, the rest are null
+      this->shutdown();
+      return unexpected(result.error());
+    }
+  }
+  this->m_loaders = std::make_unique<Threading::ThreadPool>(
+      std::max(1u, loaderThreads));
+  return {};
+}
+
+auto TextureStreamer::create_staging(StagingBuffer &staging)
+    -> expected<void, string> {
+  VkBufferCreateInfo bufferInfo{};
+  bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+  bufferInfo.size = StagingSize;
+  bufferInfo.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+  bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+  if (vkCreateBuffer(this->m_device, &bufferInfo, nullptr, &staging.buffer) !=
+      VK_SUCCESS) {
+    return unexpected("failed to create texture staging buffer");
+  }
+  VkMemoryRequirements requirements;
+  vkGetBufferMemoryRequirements(this->m_device, staging.buffer, &requirements);
+  auto memoryType = this->find_memory_type(
+      requirements.memoryTypeBits, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
+                                       VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+  if (!memoryType.has_value()) {
+    return unexpected(memoryType.error());
+  }
+  VkMemoryAllocateInfo allocInfo{};
+  allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+  allocInfo.allocationSize = requirements.size;
+  allocInfo.memoryTypeIndex = memoryType.value();
+  if (allocate_device_memory(this->m_device, allocInfo,
+                             DeviceMemoryCategory::Staging,
+                             &staging.memory) != VK_SUCCESS) {
+    return unexpected("failed to allocate texture staging memory");
+  }
+  if (vkBindBufferMemory(this->m_device, staging.buffer, staging.memory, 0) !=
+      VK_SUCCESS) {
+    return unexpected("failed to bind texture staging memory");
+  }
+  void *mapped = nullptr;
+  if (vkMapMemory(this->m_device, staging.memory, 0, VK_WHOLE_SIZE, 0,
+                  &mapped) != VK_SUCCESS) {
+    return unexpected("failed to map texture staging memory");
+  }
+  staging.mapped = static_cast<std::byte *>(mapped);
+  return {};
+}
+
+auto TextureStreamer::shutdown() -> void {
+  // loaders reference the sources, they have to finish first
+  this->m_loaders.reset();
+  for (const auto &texture : this->m_textures) {
+    this->retire(texture.image, texture.view, texture.memory);
+  }
+  for (const auto &[frame, image, view, memory] : this->m_retired) {
+    vkDestroyImageView(this->m_device, view, nullptr);
+    vkDestroyImage(this->m_device, image, nullptr);
+    free_device_memory(this->m_device, memory);
+  }
+  for (const auto &staging : this->m_staging) {
+    vkDestroyBuffer(this->m_device, staging.buffer, nullptr);
+    free_device_memory(this->m_device, staging.memory);
+  }
+  this->m_retired.clear();
+  this->m_staging.clear();
+  this->m_textures.clear();
+  this->m_pendingUploads.clear();
+  this->m_loaded.clear();
+  this->m_residentBytes = 0;
+}
+
+auto TextureStreamer::set_budget(const float fraction,
+                                 const VkDeviceSize capBytes) -> void {
+  this->m_budgetFraction = std::clamp(fraction, 0.0f, 1.0f);
+  this->m_budgetCap = capBytes;
+}
+
+auto TextureStreamer::find_memory_type(const uint32_t typeBits,
+                                       const VkMemoryPropertyFlags properties)
+    const -> expected<uint32_t, string> {
+  for (uint32_t i = 0; i < this->m_memoryProperties.memoryTypeCount; i++) {
+    if ((typeBits & (1u << i)) &&
+        (this->m_memoryProperties.memoryTypes[i].propertyFlags & properties) ==
+            properties) {
+      return i;
+    }
+  }
+  return unexpected("no memory type fits a streamed texture");
+}
+
+auto TextureStreamer::compute_budget() -> VkDeviceSize {
+  const auto heaps =
+      query_heap_budgets(this->m_physicalDevice, this->m_hasMemoryBudget);
+  const size_t primary = primary_device_local_heap(heaps);
+  VkDeviceSize budget = this->m_budgetCap;
+  if (primary < heaps.size()) {
+    const auto &heap = heaps[primary];
+    // the reported usage includes our own textures, only what everyone else
+    // uses is taken off the top
+    const VkDeviceSize others =
+        heap.usage > this->m_residentBytes ? heap.usage - this->m_residentBytes
+                                           : 0;
+    const auto share = static_cast<VkDeviceSize>(
+        static_cast<double>(heap.budget) * this->m_budgetFraction);
+    const VkDeviceSize available = share > others ? share - others : 0;
+    budget = budget == 0 ? available : std::min(budget, available);
+  }
+  return budget;
+}
+
+auto TextureStreamer::add_texture(std::unique_ptr<TextureSource> source)
+    -> expected<TextureHandle, string> {
+  if (source == nullptr) {
+    return unexpected("texture source is null");
+  }
+  const TextureInfo info = source->info();
+  if (info.width == 0 || info.height == 0 || info.mipLevels == 0 ||
+      info.format == VK_FORMAT_UNDEFINED) {
+    return unexpected("texture source describes an empty texture");
+  }
+  if (info.mipLevels >
+      static_cast<uint32_t>(std::bit_width(std::max(info.width, info.height)))) {
+    return unexpected("texture source has more mips than its size allows");
+  }
+  if (mip_bytes(info, 0) == 0) {
+    return unexpected("texture source has a format the streamer can't upload");
+  }
+  Texture texture;
+  texture.source = std::move(source);
+  texture.info = info;
+  texture.residentMip = info.mipLevels;
+  // the tail is every mip no bigger than MipTailSize, or just the last one
+  // for textures without a full chain
+  texture.tailMip = info.mipLevels - 1;
+  while (texture.tailMip > 0 &&
+         std::max(info.width, info.height) >> (texture.tailMip - 1) <=
+             MipTailSize) {
+    texture.tailMip--;
+  }
+  texture.requestedMip = texture.tailMip;
+  texture.lastUsedFrame = this->m_frame;
+  this->m_textures.push_back(std::move(texture));
+
+  const auto index = static_cast<uint32_t>(this->m_textures.size() - 1);
+  this->queue_load(index, this->m_textures[index].tailMip, info.mipLevels);
+  return TextureHandle{index};
+}
+
+auto TextureStreamer::queue_load(const uint32_t texture,
+                                 const uint32_t firstMip,
+                                 const uint32_t lastMip) -> void {
+  auto &entry = this->m_textures[texture];
+  entry.loading = true;
+  this->m_loadsInFlight++;
+  TextureSource *source = entry.source.get();
+  this->m_loaders->submit([this, source, info = entry.info, texture, firstMip,
+                           lastMip] {
+    LoadedMips loaded;
+    loaded.texture = texture;
+    loaded.firstMip = firstMip;
+    for (uint32_t mip = firstMip; mip < lastMip; mip++) {
+      auto data = source->read_mip(mip);
+      if (!data.has_value()) {
+        loaded.error = data.error();
+        loaded.levels.clear();
+        break;
+      }
+      // the upload copies a whole mip out of staging, a short one would copy
+      // whatever an earlier upload left there
+      if (const VkDeviceSize mipSize = mip_bytes(info, mip);
+          data->size() != mipSize) {
+        loaded.error = "mip " + std::to_string(mip) + " is " +
+                       std::to_string(data->size()) + " bytes, expected " +
+                       std::to_string(mipSize);
+        loaded.levels.clear();
+        break;
+      }
+      loaded.levels.push_back(std::move(data.value()));
+    }
+    std::lock_guard lock(this->m_loadedMutex);
+    this->m_loaded.push_back(std::move(loaded));
+  });
+}
+
+auto TextureStreamer::request_mip(const TextureHandle texture,
+                                  const uint32_t mip) -> void {
+  if (texture.index >= this->m_textures.size()) {
+    return;
+  }
+  auto &entry = this->m_textures[texture.index];
+  entry.requestedMip = std::min(mip, entry.tailMip);
+  entry.lastUsedFrame = this->m_frame;
+}
+
+auto TextureStreamer::mip_for_screen_size(const TextureInfo &info,
+                                          const float screenPixels)
+    -> uint32_t {
+  if (screenPixels <= 0.0f) {
+    return info.mipLevels - 1;
+  }
+  // the larger axis decides, so a long thin texture keeps its detail
+  const float ratio =
+      static_cast<float>(std::max(info.width, info.height)) / screenPixels;
+  const auto mip = static_cast<int32_t>(std::floor(std::log2(ratio)));
+  return static_cast<uint32_t>(
+      std::clamp(mip, 0, static_cast<int32_t>(info.mipLevels) - 1));
+}
+
+auto TextureStreamer::mip_bytes(const TextureInfo &info, const uint32_t mip)
+    -> VkDeviceSize {
+  const VkExtent3D extent = mip_extent(info, mip);
+  const auto [blockBytes, blockSize] = format_block(info.format);
+  const VkDeviceSize columns = (extent.width + blockSize - 1) / blockSize;
+  const VkDeviceSize rows = (extent.height + blockSize - 1) / blockSize;
+  return columns * rows * blockBytes;
+}
+
+auto TextureStreamer::retire(VkImage image, VkImageView view,
+                             VkDeviceMemory memory) -> void {
+  if (image == VK_NULL_HANDLE) {
+    return;
+  }
+  this->m_retired.push_back({this->m_frame, image, view, memory});
+}
+
+auto TextureStreamer::rebuild(VkCommandBuffer commandBuffer,
+                              const uint32_t texture, const uint32_t firstMip,
+                              const LoadedMips *upload,
+                              StagingBuffer &staging)
+    -> expected<void, string> {
+  auto &entry = this->m_textures[texture];
+  const TextureInfo &info = entry.info;
+
+  VkImageCreateInfo imageInfo{};
+  imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+  imageInfo.imageType = VK_IMAGE_TYPE_2D;
+  imageInfo.format = info.format;
+  imageInfo.extent = mip_extent(info, firstMip);
+  imageInfo.mipLevels = info.mipLevels - firstMip;
+  imageInfo.arrayLayers = 1;
+  imageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+  imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+  // transfer source so the next residency change can copy out of it
+  imageInfo.usage = VK_IMAGE_USAGE_SAMPLED_BIT |
+                    VK_IMAGE_USAGE_TRANSFER_DST_BIT |
+                    VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
+  imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+  imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+  VkImage image = VK_NULL_HANDLE;
+  if (vkCreateImage(this->m_device, &imageInfo, nullptr, &image) !=
+      VK_SUCCESS) {
+    return unexpected("failed to create streamed texture image");
+  }
+  VkMemoryRequirements requirements;
+  vkGetImageMemoryRequirements(this->m_device, image, &requirements);
+  auto memoryType = this->find_memory_type(requirements.memoryTypeBits,
+                                           VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+  VkMemoryAllocateInfo allocInfo{};
+  allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+  allocInfo.allocationSize = requirements.size;
+  allocInfo.memoryTypeIndex = memoryType.value_or(0);
+  VkDeviceMemory memory = VK_NULL_HANDLE;
+  if (!memoryType.has_value() ||
+      allocate_device_memory(this->m_device, allocInfo,
+                             DeviceMemoryCategory::Textures,
+                             &memory) != VK_SUCCESS) {
+    vkDestroyImage(this->m_device, image, nullptr);
+    return unexpected("failed to allocate streamed texture memory");
+  }
+  if (vkBindImageMemory(this->m_device, image, memory, 0) != VK_SUCCESS) {
+    vkDestroyImage(this->m_device, image, nullptr);
+    free_device_memory(this->m_device, memory);
+    return unexpected("failed to bind streamed texture memory");
+  }
+  VkImageViewCreateInfo viewInfo{};
+  viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+  viewInfo.image = image;
+  viewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
+  viewInfo.format = info.format;
+  viewInfo.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+  viewInfo.subresourceRange.levelCount = imageInfo.mipLevels;
+  viewInfo.subresourceRange.layerCount = 1;
+  VkImageView view = VK_NULL_HANDLE;
+  if (vkCreateImageView(this->m_device, &viewInfo, nullptr, &view) !=
+      VK_SUCCESS) {
+    vkDestroyImage(this->m_device, image, nullptr);
+    free_device_memory(this->m_device, memory);
+    return unexpected("failed to create streamed texture view");
+  }
+
+  vector<VkImageMemoryBarrier2> barriers;
+  barriers.push_back(layout_barrier(
+      image, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+      VK_PIPELINE_STAGE_2_NONE, VK_ACCESS_2_NONE,
+      VK_PIPELINE_STAGE_2_ALL_TRANSFER_BIT, VK_ACCESS_2_TRANSFER_WRITE_BIT));
+  if (entry.image != VK_NULL_HANDLE) {
+    // earlier frames may still be sampling the old image, the copy waits
+    // for them but nothing has to be made visible since sampling only reads
+    barriers.push_back(layout_barrier(
+        entry.image, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+        VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, SamplingStages, VK_ACCESS_2_NONE,
+        VK_PIPELINE_STAGE_2_ALL_TRANSFER_BIT, VK_ACCESS_2_TRANSFER_READ_BIT));
+  }
+  pipeline_barrier(commandBuffer, barriers);
+
+  if (entry.image != VK_NULL_HANDLE) {
+    vector<VkImageCopy> copies;
+    for (uint32_t mip = std::max(firstMip, entry.residentMip);
+         mip < info.mipLevels; mip++) {
+      VkImageCopy copy{};
+      copy.srcSubresource = color_layers(mip - entry.residentMip);
+      copy.dstSubresource = color_layers(mip - firstMip);
+      copy.extent = mip_extent(info, mip);
+      copies.push_back(copy);
+    }
+    vkCmdCopyImage(commandBuffer, entry.image,
+                   VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, image,
+                   VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                   static_cast<uint32_t>(copies.size()), copies.data());
+  }
+  if (upload != nullptr) {
+    vector<VkBufferImageCopy> copies;
+    for (uint32_t level = 0; level < upload->levels.size(); level++) {
+      const auto &data = upload->levels[level];
+      const uint32_t mip = upload->firstMip + level;
+      staging.used = (staging.used + 15) & ~VkDeviceSize{15};
+      std::memcpy(staging.mapped + staging.used, data.data(), data.size());
+      VkBufferImageCopy copy{};
+      copy.bufferOffset = staging.used;
+      copy.imageSubresource = color_layers(mip - firstMip);
+      copy.imageExtent = mip_extent(info, mip);
+      copies.push_back(copy);
+      staging.used += data.size();
+    }
+    vkCmdCopyBufferToImage(commandBuffer, staging.buffer, image,
+                           VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                           static_cast<uint32_t>(copies.size()),
+                           copies.data());
+  }
+
+  barriers.clear();
+  barriers.push_back(layout_barrier(
+      image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+      VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+      VK_PIPELINE_STAGE_2_ALL_TRANSFER_BIT, VK_ACCESS_2_TRANSFER_WRITE_BIT,
+      SamplingStages, VK_ACCESS_2_SHADER_SAMPLED_READ_BIT));
+  pipeline_barrier(commandBuffer, barriers);
+
+  this->retire(entry.image, entry.view, entry.memory);
+  this->m_residentBytes -= entry.bytes;
+  entry.image = image;
+  entry.view = view;
+  entry.memory = memory;
+  entry.bytes = requirements.size;
+  entry.residentMip = firstMip;
+  this->m_residentBytes += entry.bytes;
+  return {};
+}
+
+auto TextureStreamer::evict_one(VkCommandBuffer commandBuffer,
+                                const uint32_t protectedTexture,
+                                StagingBuffer &staging) -> bool {
+  // mips nobody asks for anymore go first, then the least recently used
+  // texture, the mip tail and textures used this frame are never evicted
+  uint32_t victim = UINT32_MAX;
+  for (uint32_t i = 0; i < this->m_textures.size(); i++) {
+    const auto &candidate = this->m_textures[i];
+    // textures with a load in flight keep their mips, the load is for the
+    // mip right above the resident ones
+    if (i == protectedTexture || candidate.image == VK_NULL_HANDLE ||
+        candidate.loading || candidate.residentMip >= candidate.tailMip ||
+        candidate.lastUsedFrame == this->m_frame) {
+      continue;
+    }
+    if (victim == UINT32_MAX) {
+      victim = i;
+      continue;
+    }
+    const auto &current = this->m_textures[victim];
+    const bool candidateUnwanted =
+        candidate.requestedMip > candidate.residentMip;
+    const bool currentUnwanted = current.requestedMip > current.residentMip;
+    if (candidateUnwanted != currentUnwanted) {
+      if (candidateUnwanted) {
+        victim = i;
+      }
+    } else if (candidate.lastUsedFrame < current.lastUsedFrame) {
+      victim = i;
+    }
+  }
+  if (victim == UINT32_MAX) {
+    return false;
+  }
+  const uint32_t nextMip = this->m_textures[victim].residentMip + 1;
+  if (auto result = this->rebuild(commandBuffer, victim, nextMip, nullptr,
+                                  staging);
+      !result.has_value()) {
+    spdlog::warn("failed to evict a texture mip: {}", result.error());
+    return false;
+  }
+  this->m_evictions++;
+  return true;
+}
+
+auto TextureStreamer::update(VkCommandBuffer commandBuffer,
+                             const uint32_t frameSlot)
+    -> expected<void, string> {
+  if (this->m_staging.empty()) {
+    return unexpected("texture streamer is not initialized");
+  }
+  // everything retired before the oldest frame still in flight is unused
+  std::erase_if(this->m_retired, [this](const Retired &retired) {
+    if (retired.frame + this->m_framesInFlight > this->m_frame) {
+      return false;
+    }
+    vkDestroyImageView(this->m_device, retired.view, nullptr);
+    vkDestroyImage(this->m_device, retired.image, nullptr);
+    free_device_memory(this->m_device, retired.memory);
+    return true;
+  });
+  auto &staging = this->m_staging[frameSlot % this->m_staging.size()];
+  staging.used = 0;
+  {
+    std::lock_guard lock(this->m_loadedMutex);
+    for (auto &loaded : this->m_loaded) {
+      this->m_pendingUploads.push_back(std::move(loaded));
+    }
+    this->m_loadsInFlight -= static_cast<uint32_t>(this->m_loaded.size());
+    this->m_loaded.clear();
+  }
+  this->m_budgetBytes = this->compute_budget();
+  // the budget moves with what other processes use, give mips back when it
+  // shrinks even if nothing is waiting to be uploaded
+  while (this->m_residentBytes > this->m_budgetBytes &&
+         this->evict_one(commandBuffer, UINT32_MAX, staging)) {
+  }
+
+  while (!this->m_pendingUploads.empty()) {
+    const auto &upload = this->m_pendingUploads.front();
+    auto &texture = this->m_textures[upload.texture];
+    if (!upload.error.empty()) {
+      spdlog::error("failed to stream texture mip {}: {}", upload.firstMip,
+                    upload.error);
+      texture.loading = false;
+      texture.failed = true;
+      this->m_pendingUploads.pop_front();
+      continue;
+    }
+    VkDeviceSize uploadBytes = 0;
+    for (const auto &level : upload.levels) {
+      uploadBytes += (level.size() + 15) & ~size_t{15};
+    }
+    if (uploadBytes > StagingSize) {
+      spdlog::error("texture mip {} doesn't fit the staging buffer",
+                    upload.firstMip);
+      texture.loading = false;
+      texture.failed = true;
+      this->m_pendingUploads.pop_front();
+      continue;
+    }
+    if (staging.used + uploadBytes > StagingSize) {
+      // out of staging space for this frame, the rest goes next frame
+      break;
+    }
+    // the finer mip roughly quadruples the image, make room for it first,
+    // tails are always let in since a texture without one can't be drawn
+    const bool isTail = texture.image == VK_NULL_HANDLE;
+    const VkDeviceSize grownBytes =
+        isTail ? uploadBytes : texture.bytes + uploadBytes;
+    while (!isTail &&
+           this->m_residentBytes - texture.bytes + grownBytes >
+               this->m_budgetBytes &&
+           this->evict_one(commandBuffer, upload.texture, staging)) {
+    }
+    if (!isTail && this->m_residentBytes - texture.bytes + grownBytes >
+                       this->m_budgetBytes) {
+      // nothing left to evict, the mip is dropped and asked for again after
+      // a while, when evictions may have made room
+      texture.loading = false;
+      texture.retryFrame = this->m_frame + BudgetRetryFrames;
+      this->m_pendingUploads.pop_front();
+      continue;
+    }
+    if (auto result = this->rebuild(commandBuffer, upload.texture,
+                                    upload.firstMip, &upload, staging);
+        !result.has_value()) {
+      texture.failed = true;
+      spdlog::error("failed to upload streamed texture: {}", result.error());
+    }
+    texture.loading = false;
+    this->m_pendingUploads.pop_front();
+  }
+
+  // queue the next finer mip of the textures that are furthest from what
+  // they were asked for, recently used ones win ties
+  vector<uint32_t> wanted;
+  for (uint32_t i = 0; i < this->m_textures.size(); i++) {
+    const auto &texture = this->m_textures[i];
+    if (!texture.loading && !texture.failed &&
+        texture.retryFrame <= this->m_frame &&
+        texture.image != VK_NULL_HANDLE &&
+        texture.requestedMip < texture.residentMip) {
+      wanted.push_back(i);
+    }
+  }
+  std::ranges::sort(wanted, [this](const uint32_t a, const uint32_t b) {
+    const auto &ta = this->m_textures[a];
+    const auto &tb = this->m_textures[b];
+    const uint32_t gapA = ta.residentMip - ta.requestedMip;
+    const uint32_t gapB = tb.residentMip - tb.requestedMip;
+    if (gapA != gapB) {
+      return gapA > gapB;
+    }
+    return ta.lastUsedFrame > tb.lastUsedFrame;
+  });
+  for (const uint32_t index : wanted) {
+    if (this->m_loadsInFlight >= MaxLoadsInFlight) {
+      break;
+    }
+    const uint32_t mip = this->m_textures[index].residentMip - 1;
+    this->queue_load(index, mip, mip + 1);
+  }
+
+  this->m_frame++;
+  return {};
+}
+
+auto TextureStreamer::get_view(const TextureHandle texture) const
+    -> VkImageView {
+  if (texture.index >= this->m_textures.size()) {
+    return VK_NULL_HANDLE;
+  }
+  return this->m_textures[texture.index].view;
+}
+
+auto TextureStreamer::resident_mip(const TextureHandle texture) const
+    -> uint32_t {
+  if (texture.index >= this->m_textures.size()) {
+    return 0;
+  }
+  return this->m_textures[texture.index].residentMip;
+}
+
+auto TextureStreamer::stats() const -> TextureStreamerStats {
+  TextureStreamerStats stats;
+  stats.residentBytes = this->m_residentBytes;
+  stats.budgetBytes = this->m_budgetBytes;
+  stats.loadsInFlight = this->m_loadsInFlight;
+  stats.pendingUploads = static_cast<uint32_t>(this->m_pendingUploads.size());
+  stats.evictions = this->m_evictions;
+  return stats;
+}
+#pragma endregion
+} // namespace SFT::Renderer::VK
@@ -0,0 +1,247 @@
+//
+// Created by sturd on 10/18/2026.
+//
+
+#ifndef TEXTURESTREAMER_H
+#define TEXTURESTREAMER_H
+
+#include "Core/Threading/ThreadPool.h"
+#include "Core/Renderer/VK/VulkanDispatch.h"
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <expected>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+using std::expected;
+using std::string;
+using std::unexpected;
+using std::vector;
+
+namespace SFT::Renderer::VK {
+struct TextureInfo {
+  VkFormat format = VK_FORMAT_UNDEFINED;
+  uint32_t width = 0;
+  uint32_t height = 0;
+  uint32_t mipLevels = 1;
+};
+
+/*!
+ * @brief Where the streamer reads texture data from, read_mip is called from
+ * loader threads but never concurrently for the same texture
+ */
+class TextureSource {
+public:
+  virtual ~TextureSource() = default;
+  [[nodiscard]] virtual auto info() const -> TextureInfo = 0;
+  /*!
+   * @brief Reads one mip level in the layout vkCmdCopyBufferToImage expects
+   * (tightly packed rows, or blocks for compressed formats)
+   * @param level the mip level, 0 is the finest
+   * @return On success, returns the texel data, on failure, returns
+   * unexpected with error message
+   */
+  virtual auto read_mip(uint32_t level)
+      -> expected<vector<std::byte>, string> = 0;
+};
+
+struct TextureHandle {
+  uint32_t index = UINT32_MAX;
+
+  [[nodiscard]] auto valid() const -> bool { return index != UINT32_MAX; }
+};
+
+struct TextureStreamerStats {
+  VkDeviceSize residentBytes = 0;
+  VkDeviceSize budgetBytes = 0;
+  uint32_t loadsInFlight = 0;
+  uint32_t pendingUploads = 0;
+  uint64_t evictions = 0;
+};
+
+/*!
+ * @brief Streams texture mips in and out of VRAM, a texture becomes usable as
+ * soon as its smallest mips (the tail) are loaded, finer mips are loaded one at
+ * a time as usage feedback asks for them, and when the budget taken from
+ * VK_EXT_memory_budget (or the heap size without it) would be exceeded the
+ * least recently used textures give their finest mips back. Residency changes
+ * rebuild the image with the new mip range and copy the mips it keeps on the
+ * GPU, so no sparse binding support is needed
+ */
+class TextureStreamer {
+private:
+  struct Texture {
+    std::unique_ptr<TextureSource> source;
+    TextureInfo info{};
+    VkImage image = VK_NULL_HANDLE;
+    VkImageView view = VK_NULL_HANDLE;
+    VkDeviceMemory memory = VK_NULL_HANDLE;
+    VkDeviceSize bytes = 0;
+    // finest mip that is resident, mipLevels while nothing is
+    uint32_t residentMip = 0;
+    uint32_t tailMip = 0;
+    uint32_t requestedMip = 0;
+    uint64_t lastUsedFrame = 0;
+    // a mip dropped for lack of budget isn't asked for again before this
+    // frame, so a full budget doesn't read the same mip every frame
+    uint64_t retryFrame = 0;
+    bool loading = false;
+    bool failed = false;
+  };
+  struct LoadedMips {
+    uint32_t texture = 0;
+    uint32_t firstMip = 0;
+    vector<vector<std::byte>> levels;
+    string error;
+  };
+  struct StagingBuffer {
+    VkBuffer buffer = VK_NULL_HANDLE;
+    VkDeviceMemory memory = VK_NULL_HANDLE;
+    std::byte *mapped = nullptr;
+    VkDeviceSize used = 0;
+  };
+  struct Retired {
+    uint64_t frame = 0;
+    VkImage image = VK_NULL_HANDLE;
+    VkImageView view = VK_NULL_HANDLE;
+    VkDeviceMemory memory = VK_NULL_HANDLE;
+  };
+
+  VkDevice m_device = VK_NULL_HANDLE;
+  VkPhysicalDevice m_physicalDevice = VK_NULL_HANDLE;
+  VkPhysicalDeviceMemoryProperties m_memoryProperties{};
+  bool m_hasMemoryBudget = false;
+  float m_budgetFraction = 0.8f;
+  VkDeviceSize m_budgetCap = 0;
+  uint32_t m_framesInFlight = 1;
+  std::unique_ptr<Threading::ThreadPool> m_loaders;
+  uint32_t m_loadsInFlight = 0;
+
+  vector<Texture> m_textures;
+  vector<StagingBuffer> m_staging;
+  std::deque<LoadedMips> m_pendingUploads;
+  vector<Retired> m_retired;
+  uint64_t m_frame = 0;
+  VkDeviceSize m_residentBytes = 0;
+  VkDeviceSize m_budgetBytes = 0;
+  uint64_t m_evictions = 0;
+
+  // filled by loader threads, drained by update
+  std::mutex m_loadedMutex;
+  vector<LoadedMips> m_loaded;
+
+  auto find_memory_type(uint32_t typeBits, VkMemoryPropertyFlags properties)
+      const -> expected<uint32_t, string>;
+  auto create_staging(StagingBuffer &staging) -> expected<void, string>;
+  auto compute_budget() -> VkDeviceSize;
+  auto queue_load(uint32_t texture, uint32_t firstMip, uint32_t lastMip)
+      -> void;
+  auto rebuild(VkCommandBuffer commandBuffer, uint32_t texture,
+               uint32_t firstMip, const LoadedMips *upload,
+               StagingBuffer &staging) -> expected<void, string>;
+  auto evict_one(VkCommandBuffer commandBuffer, uint32_t protectedTexture,
+                 StagingBuffer &staging) -> bool;
+  auto retire(VkImage image, VkImageView view, VkDeviceMemory memory) -> void;
+
+public:
+  static constexpr uint32_t MipTailSize = 64;
+  static constexpr VkDeviceSize StagingSize = 32ull * 1024 * 1024;
+  static constexpr uint32_t MaxLoadsInFlight = 16;
+  static constexpr uint64_t BudgetRetryFrames = 60;
+
+  TextureStreamer() = default;
+  ~TextureStreamer() = default;
+  TextureStreamer(const TextureStreamer &) = delete;
+  auto operator=(const TextureStreamer &) -> TextureStreamer & = delete;
+
+  /*!
+   * @brief Creates the loader threads and one staging buffer per frame in
+   * flight
+   * @param device the logical device textures are created on
+   * @param physicalDevice the device budgets are queried from
+   * @param hasMemoryBudget whether VK_EXT_memory_budget was enabled
+   * @param framesInFlight how many frames the CPU records ahead of the GPU
+   * @param loaderThreads how many threads read texture data
+   * @return On success, returns void, on failure, returns unexpected with error
+   * message
+   */
+  auto init(VkDevice device, VkPhysicalDevice physicalDevice,
+            bool hasMemoryBudget, uint32_t framesInFlight,
+            uint32_t loaderThreads) -> expected<void, string>;
+  /*!
+   * @brief Waits for the loaders and destroys every texture, the GPU must be
+   * idle
+   */
+  auto shutdown() -> void;
+  /*!
+   * @brief Limits streaming to a fraction of the device local budget, and
+   * optionally to a fixed number of bytes on top of that
+   * @param fraction the share of the heap budget textures may use
+   * @param capBytes an absolute limit, 0 for none
+   */
+  auto set_budget(float fraction, VkDeviceSize capBytes) -> void;
+  /*!
+   * @brief Starts streaming a texture, its mip tail is loaded right away
+   * @param source where the texture's mips are read from
+   * @return On success, returns the handle of the texture, on failure,
+   * returns unexpected with error message
+   */
+  auto add_texture(std::unique_ptr<TextureSource> source)
+      -> expected<TextureHandle, string>;
+  /*!
+   * @brief Usage feedback, the finest mip the texture was sampled at this
+   * frame, textures that don't get feedback age towards eviction
+   * @param texture the texture that was used
+   * @param mip the finest mip that would have been sampled
+   */
+  auto request_mip(TextureHandle texture, uint32_t mip) -> void;
+  /*!
+   * @brief Picks the mip that matches how big a texture is on screen
+   * @param info the texture
+   * @param screenPixels how many pixels the texture's larger axis covers on
+   * screen
+   * @return the mip whose larger axis is closest to (not below) the coverage
+   */
+  static auto mip_for_screen_size(const TextureInfo &info, float screenPixels)
+      -> uint32_t;
+  /*!
+   * @brief Gets how many bytes read_mip has to return for a mip, tightly
+   * packed rows, or whole 4x4 blocks for block compressed formats
+   * @param info the texture
+   * @param mip the mip level, 0 is the finest
+   * @return the size of the mip, 0 for formats the streamer doesn't know
+   */
+  static auto mip_bytes(const TextureInfo &info, uint32_t mip) -> VkDeviceSize;
+  /*!
+   * @brief Uploads finished loads, evicts to stay under budget and queues new
+   * loads, the GPU must be done with the previous frame that used the slot
+   * @param commandBuffer the command buffer uploads and copies are recorded to,
+   * it must execute before anything samples the streamed textures
+   * @param frameSlot the frame in flight being recorded
+   * @return On success, returns void, on failure, returns unexpected with
+   * error message
+   */
+  auto update(VkCommandBuffer commandBuffer, uint32_t frameSlot)
+      -> expected<void, string>;
+  /*!
+   * @brief Gets the view to sample a texture through, it changes whenever the
+   * residency does so it must be fetched every frame
+   * @param texture the texture
+   * @return the view, or VK_NULL_HANDLE while the mip tail is still loading
+   */
+  [[nodiscard]] auto get_view(TextureHandle texture) const -> VkImageView;
+  /*!
+   * @brief Gets the finest resident mip, the view's mip 0 is this mip of the
+   * full texture, samplers that clamp LOD need to offset by it
+   * @param texture the texture
+   * @return the finest resident mip
+   */
+  [[nodiscard]] auto resident_mip(TextureHandle texture) const -> uint32_t;
+  [[nodiscard]] auto stats() const -> TextureStreamerStats;
+};
+} // namespace SFT::Renderer::VK
+
+#endif // TEXTURESTREAMER_H
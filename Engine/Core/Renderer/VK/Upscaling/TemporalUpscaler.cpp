@@ -0,0 +1,372 @@
+//
+// Created by sturd on 10/18/2026.
+//
+
+#include "TemporalUpscaler.h"
+
+#include "Core/Renderer/VK/Memory/DeviceMemory.h"
+#include <algorithm>
+#include <cmath>
+
+namespace SFT::Renderer::VK {
+#pragma region additional functions
+namespace {
+constexpr uint32_t groupSize = 8;
+// the shortest jitter sequence, at native resolution
+constexpr uint32_t minJitterPhases = 8;
+constexpr uint32_t maxJitterPhases = 64;
+
+// mirrors the push constant block of temporal_upscale.comp
+struct UpscaleConstants {
+  float renderSize[2];
+  float outputSize[2];
+  float jitter[2];
+  uint32_t resetHistory;
+  uint32_t padding;
+};
+
+auto halton(uint32_t index, const uint32_t base) -> float {
+  float result = 0.0f;
+  float fraction = 1.0f;
+  while (index > 0) {
+    fraction /= static_cast<float>(base);
+    result += fraction * static_cast<float>(index % base);
+    index /= base;
+  }
+  return result;
+}
+} // namespace
+#pragma endregion
+
+#pragma region TemporalUpscaler Functions
+auto apply_jitter(float (&projection)[16], const Jitter jitter,
+                  const VkExtent2D renderExtent) -> void {
+  if (renderExtent.width == 0 || renderExtent.height == 0) {
+    return;
+  }
+  // a clip space translation applied after the projection, so it works for
+  // any projection: every column gets its w row scaled into x and y
+  const float offsetX = 2.0f * jitter.x / static_cast<float>(renderExtent.width);
+  const float offsetY =
+      2.0f * jitter.y / static_cast<float>(renderExtent.height);
+  for (uint32_t column = 0; column < 4; column++) {
+    projection[column * 4 + 0] += offsetX * projection[column * 4 + 3];
+    projection[column * 4 + 1] += offsetY * projection[column * 4 + 3];
+  }
+}
+
+auto TemporalUpscaler::init(VkDevice device, VkPhysicalDevice physicalDevice,
+                            PipelineLayoutCache &layoutCache,
+                            const std::span<const std::byte> upscaleCode,
+                            const uint32_t framesInFlight)
+    -> expected<void, string> {
+  this->m_device = device;
+  vkGetPhysicalDeviceMemoryProperties(physicalDevice,
+                                      &this->m_memoryProperties);
+  auto pipeline = create_compute_pipeline(device, layoutCache, upscaleCode);
+  if (!pipeline.has_value()) {
+    return unexpected("temporal upscale: " + pipeline.error());
+  }
+  this->m_upscale = std::move(pipeline.value());
+  auto setLayout =
+      layoutCache.get_set_layout_for(this->m_upscale.reflection, 0);
+  if (!setLayout.has_value()) {
+    return unexpected(setLayout.error());
+  }
+  this->m_setLayout = setLayout.value();
+
+  // bilinear for the reprojected history, the scene is read with texelFetch
+  VkSamplerCreateInfo samplerInfo{};
+  samplerInfo.sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
+  samplerInfo.magFilter = VK_FILTER_LINEAR;
+  samplerInfo.minFilter = VK_FILTER_LINEAR;
+  samplerInfo.mipmapMode = VK_SAMPLER_MIPMAP_MODE_NEAREST;
+  samplerInfo.addressModeU = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+  samplerInfo.addressModeV = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+  samplerInfo.addressModeW = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+  if (vkCreateSampler(device, &samplerInfo, nullptr, &this->m_sampler) !=
+      VK_SUCCESS) {
+    return unexpected("failed to create the temporal upscale sampler");
+  }
+
+  const uint32_t setCount = std::max(1u, framesInFlight);
+  const VkDescriptorPoolSize poolSizes[] = {
+      {VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, setCount * 4},
+      {VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, setCount},
+  };
+  VkDescriptorPoolCreateInfo poolInfo{};
+  poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+  poolInfo.maxSets = setCount;
+  poolInfo.poolSizeCount = 2;
+  poolInfo.pPoolSizes = poolSizes;
+  if (vkCreateDescriptorPool(device, &poolInfo, nullptr, &this->m_pool) !=
+      VK_SUCCESS) {
+    return unexpected("failed to create the temporal upscale descriptor pool");
+  }
+  vector<VkDescriptorSetLayout> layouts(setCount, this->m_setLayout);
+  this->m_sets.resize(setCount);
+  VkDescriptorSetAllocateInfo setInfo{};
+  setInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+  setInfo.descriptorPool = this->m_pool;
+  setInfo.descriptorSetCount = setCount;
+  setInfo.pSetLayouts = layouts.data();
+  if (vkAllocateDescriptorSets(device, &setInfo, this->m_sets.data()) !=
+      VK_SUCCESS) {
+    return unexpected("failed to allocate the temporal upscale descriptor "
+                      "sets");
+  }
+  return {};
+}
+
+auto TemporalUpscaler::release_history() -> void {
+  for (uint32_t i = 0; i < 2; i++) {
+    if (this->m_historyViews[i] != VK_NULL_HANDLE) {
+      vkDestroyImageView(this->m_device, this->m_historyViews[i], nullptr);
+    }
+    if (this->m_history[i] != VK_NULL_HANDLE) {
+      vkDestroyImage(this->m_device, this->m_history[i], nullptr);
+    }
+    free_device_memory(this->m_device, this->m_historyMemory[i]);
+    this->m_historyViews[i] = VK_NULL_HANDLE;
+    this->m_history[i] = VK_NULL_HANDLE;
+    this->m_historyMemory[i] = VK_NULL_HANDLE;
+  }
+  this->m_outputExtent = {};
+  this->m_historyValid = false;
+  this->m_initialized = false;
+}
+
+auto TemporalUpscaler::destroy() -> void {
+  this->release_history();
+  if (this->m_pool != VK_NULL_HANDLE) {
+    vkDestroyDescriptorPool(this->m_device, this->m_pool, nullptr);
+  }
+  this->m_pool = VK_NULL_HANDLE;
+  this->m_sets.clear();
+  if (this->m_sampler != VK_NULL_HANDLE) {
+    vkDestroySampler(this->m_device, this->m_sampler, nullptr);
+  }
+  this->m_sampler = VK_NULL_HANDLE;
+  destroy_compute_pipeline(this->m_device, this->m_upscale);
+}
+
+auto TemporalUpscaler::resize(const VkExtent2D outputExtent)
+    -> expected<void, string> {
+  if (this->m_history[0] != VK_NULL_HANDLE &&
+      outputExtent.width == this->m_outputExtent.width &&
+      outputExtent.height == this->m_outputExtent.height) {
+    return {};
+  }
+  this->release_history();
+  if (outputExtent.width == 0 || outputExtent.height == 0) {
+    return {};
+  }
+  // a half built history would pass the same size check next time, so any
+  // failure releases all of it
+  if (auto result = this->create_history(outputExtent); !result.has_value()) {
+    this->release_history();
+    return unexpected(result.error());
+  }
+  this->m_outputExtent = outputExtent;
+  return {};
+}
+
+auto TemporalUpscaler::create_history(const VkExtent2D outputExtent)
+    -> expected<void, string> {
+  VkImageCreateInfo imageInfo{};
+  imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+  imageInfo.imageType = VK_IMAGE_TYPE_2D;
+  imageInfo.format = sceneColorFormat;
+  imageInfo.extent = {outputExtent.width, outputExtent.height, 1};
+  imageInfo.mipLevels = 1;
+  imageInfo.arrayLayers = 1;
+  imageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+  imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+  imageInfo.usage = VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_STORAGE_BIT |
+                    VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
+  imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+  imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+  for (uint32_t i = 0; i < 2; i++) {
+    if (vkCreateImage(this->m_device, &imageInfo, nullptr,
+                      &this->m_history[i]) != VK_SUCCESS) {
+      return unexpected("failed to create the temporal upscale history");
+    }
+    VkMemoryRequirements requirements;
+    vkGetImageMemoryRequirements(this->m_device, this->m_history[i],
+                                 &requirements);
+    uint32_t memoryType = UINT32_MAX;
+    for (uint32_t type = 0; type < this->m_memoryProperties.memoryTypeCount;
+         type++) {
+      if ((requirements.memoryTypeBits & (1u << type)) &&
+          (this->m_memoryProperties.memoryTypes[type].propertyFlags &
+           VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT)) {
+        memoryType = type;
+        break;
+      }
+    }
+    if (memoryType == UINT32_MAX) {
+      return unexpected("no device local memory fits the temporal upscale "
+                        "history");
+    }
+    VkMemoryAllocateInfo allocInfo{};
+    allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+    allocInfo.allocationSize = requirements.size;
+    allocInfo.memoryTypeIndex = memoryType;
+    if (allocate_device_memory(this->m_device, allocInfo,
+                               DeviceMemoryCategory::RenderTargets,
+                               &this->m_historyMemory[i]) != VK_SUCCESS) {
+      return unexpected("failed to allocate the temporal upscale history");
+    }
+    if (vkBindImageMemory(this->m_device, this->m_history[i],
+                          this->m_historyMemory[i], 0) != VK_SUCCESS) {
+      return unexpected("failed to bind the temporal upscale history memory");
+    }
+
+    VkImageViewCreateInfo viewInfo{};
+    viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+    viewInfo.image = this->m_history[i];
+    viewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
+    viewInfo.format = sceneColorFormat;
+    viewInfo.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    viewInfo.subresourceRange.levelCount = 1;
+    viewInfo.subresourceRange.layerCount = 1;
+    if (vkCreateImageView(this->m_device, &viewInfo, nullptr,
+                          &this->m_historyViews[i]) != VK_SUCCESS) {
+      return unexpected("failed to create the temporal upscale history view");
+    }
+  }
+  return {};
+}
+
+auto TemporalUpscaler::jitter(const uint64_t frameIndex,
+                              const VkExtent2D renderExtent,
+                              const VkExtent2D outputExtent) -> Jitter {
+  const double renderPixels = static_cast<double>(renderExtent.width) *
+                              static_cast<double>(renderExtent.height);
+  const double outputPixels = static_cast<double>(outputExtent.width) *
+                              static_cast<double>(outputExtent.height);
+  const double ratio = renderPixels > 0.0 ? outputPixels / renderPixels : 1.0;
+  const auto phases = std::clamp(
+      static_cast<uint32_t>(std::ceil(minJitterPhases * ratio)),
+      minJitterPhases, maxJitterPhases);
+  // skips index 0 of the sequence, which is always the texel corner
+  const auto index = static_cast<uint32_t>(frameIndex % phases) + 1;
+  return {halton(index, 2) - 0.5f, halton(index, 3) - 0.5f};
+}
+
+auto TemporalUpscaler::record_upscale(VkCommandBuffer commandBuffer,
+                                      const uint32_t frameSlot,
+                                      const UpscaleInputs &inputs,
+                                      const Jitter jitter)
+    -> expected<void, string> {
+  if (this->m_history[0] == VK_NULL_HANDLE) {
+    return unexpected("temporal upscaler has no history, call resize first");
+  }
+  if (this->m_sets.empty()) {
+    return unexpected("temporal upscaler isn't initialized");
+  }
+  if (inputs.color == VK_NULL_HANDLE || inputs.depth == VK_NULL_HANDLE ||
+      inputs.motion == VK_NULL_HANDLE) {
+    return unexpected("temporal upscaler needs color, depth and motion");
+  }
+  const uint32_t previous = this->m_current;
+  const uint32_t target = this->m_current ^ 1;
+
+  // the slot's previous frame is done, so its set can be rewritten
+  VkDescriptorSet set = this->m_sets[frameSlot % this->m_sets.size()];
+  const VkDescriptorImageInfo images[] = {
+      {this->m_sampler, inputs.color,
+       VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL},
+      {this->m_sampler, inputs.depth,
+       VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL},
+      {this->m_sampler, inputs.motion,
+       VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL},
+      {this->m_sampler, this->m_historyViews[previous],
+       VK_IMAGE_LAYOUT_GENERAL},
+      {VK_NULL_HANDLE, this->m_historyViews[target], VK_IMAGE_LAYOUT_GENERAL},
+  };
+  VkWriteDescriptorSet writes[5]{};
+  for (uint32_t binding = 0; binding < 5; binding++) {
+    writes[binding].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+    writes[binding].dstSet = set;
+    writes[binding].dstBinding = binding;
+    writes[binding].descriptorCount = 1;
+    writes[binding].descriptorType =
+        binding == 4 ? VK_DESCRIPTOR_TYPE_STORAGE_IMAGE
+                     : VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+    writes[binding].pImageInfo = &images[binding];
+  }
+  vkUpdateDescriptorSets(this->m_device, 5, writes, 0, nullptr);
+
+  // the history lives in GENERAL and only leaves UNDEFINED once; the target
+  // was last read as the previous history or the previous output, the
+  // previous history was written by the last upscale
+  VkImageMemoryBarrier2 barriers[2]{};
+  for (uint32_t i = 0; i < 2; i++) {
+    barriers[i].sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2;
+    barriers[i].oldLayout = this->m_initialized ? VK_IMAGE_LAYOUT_GENERAL
+                                                : VK_IMAGE_LAYOUT_UNDEFINED;
+    barriers[i].newLayout = VK_IMAGE_LAYOUT_GENERAL;
+    barriers[i].srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barriers[i].dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barriers[i].subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    barriers[i].subresourceRange.levelCount = 1;
+    barriers[i].subresourceRange.layerCount = 1;
+  }
+  barriers[0].image = this->m_history[target];
+  barriers[0].srcStageMask = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT |
+                             VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT |
+                             VK_PIPELINE_STAGE_2_TRANSFER_BIT;
+  barriers[0].srcAccessMask =
+      VK_ACCESS_2_SHADER_SAMPLED_READ_BIT | VK_ACCESS_2_TRANSFER_READ_BIT;
+  barriers[0].dstStageMask = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT;
+  barriers[0].dstAccessMask = VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT;
+  barriers[1].image = this->m_history[previous];
+  barriers[1].srcStageMask = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT;
+  barriers[1].srcAccessMask = VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT;
+  barriers[1].dstStageMask = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT;
+  barriers[1].dstAccessMask = VK_ACCESS_2_SHADER_SAMPLED_READ_BIT;
+  VkDependencyInfo dependency{};
+  dependency.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO;
+  dependency.imageMemoryBarrierCount = 2;
+  dependency.pImageMemoryBarriers = barriers;
+  vkCmdPipelineBarrier2(commandBuffer, &dependency);
+  this->m_initialized = true;
+
+  UpscaleConstants constants{};
+  constants.renderSize[0] = static_cast<float>(inputs.renderExtent.width);
+  constants.renderSize[1] = static_cast<float>(inputs.renderExtent.height);
+  constants.outputSize[0] = static_cast<float>(this->m_outputExtent.width);
+  constants.outputSize[1] = static_cast<float>(this->m_outputExtent.height);
+  constants.jitter[0] = jitter.x;
+  constants.jitter[1] = jitter.y;
+  constants.resetHistory = this->m_historyValid ? 0 : 1;
+  vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE,
+                    this->m_upscale.pipeline);
+  vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE,
+                          this->m_upscale.layout, 0, 1, &set, 0, nullptr);
+  vkCmdPushConstants(commandBuffer, this->m_upscale.layout,
+                     VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(constants),
+                     &constants);
+  vkCmdDispatch(commandBuffer,
+                (this->m_outputExtent.width + groupSize - 1) / groupSize,
+                (this->m_outputExtent.height + groupSize - 1) / groupSize, 1);
+
+  VkImageMemoryBarrier2 toReaders = barriers[0];
+  toReaders.oldLayout = VK_IMAGE_LAYOUT_GENERAL;
+  toReaders.srcStageMask = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT;
+  toReaders.srcAccessMask = VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT;
+  toReaders.dstStageMask = VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT |
+                           VK_PIPELINE_STAGE_2_TRANSFER_BIT;
+  toReaders.dstAccessMask =
+      VK_ACCESS_2_SHADER_SAMPLED_READ_BIT | VK_ACCESS_2_TRANSFER_READ_BIT;
+  dependency.imageMemoryBarrierCount = 1;
+  dependency.pImageMemoryBarriers = &toReaders;
+  vkCmdPipelineBarrier2(commandBuffer, &dependency);
+
+  this->m_current = target;
+  this->m_historyValid = true;
+  return {};
+}
+#pragma endregion
+} // namespace SFT::Renderer::VK
@@ -0,0 +1,159 @@
+//
+// Created by sturd on 10/18/2026.
+//
+
+#ifndef TEMPORALUPSCALER_H
+#define TEMPORALUPSCALER_H
+
+#include "../Pipeline/ComputePipeline.h"
+#include "../Pipeline/PipelineLayoutCache.h"
+#include "Core/Renderer/VK/VulkanDispatch.h"
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <span>
+#include <string>
+#include <vector>
+
+using std::expected;
+using std::string;
+using std::unexpected;
+using std::vector;
+
+namespace SFT::Renderer::VK {
+// the scene color the upscaler reads and the history it keeps
+constexpr VkFormat sceneColorFormat = VK_FORMAT_R16G16B16A16_SFLOAT;
+// the motion vector attachment the forward pass writes, in UV units
+constexpr VkFormat motionVectorFormat = VK_FORMAT_R16G16_SFLOAT;
+
+/*!
+ * @brief The sub-pixel offset of one frame, in render texels
+ */
+struct Jitter {
+  float x = 0.0f;
+  float y = 0.0f;
+};
+
+/*!
+ * @brief The inputs of one upscale, all readable by compute shaders in
+ * SHADER_READ_ONLY_OPTIMAL with the frame's writes made visible
+ */
+struct UpscaleInputs {
+  VkImageView color = VK_NULL_HANDLE;
+  // a depth aspect view, reversed Z
+  VkImageView depth = VK_NULL_HANDLE;
+  VkImageView motion = VK_NULL_HANDLE;
+  // the top left region of the inputs rendered this frame
+  VkExtent2D renderExtent{};
+};
+
+/*!
+ * @brief Applies a jitter to a perspective projection, the image moves by
+ * the jitter in render texels
+ * @param projection column major projection matrix
+ * @param jitter the offset from TemporalUpscaler::jitter
+ * @param renderExtent the resolution being rendered
+ */
+auto apply_jitter(float (&projection)[16], Jitter jitter,
+                  VkExtent2D renderExtent) -> void;
+
+/*!
+ * @brief Temporal upscaling and anti-aliasing on core compute only, so it
+ * runs on every vendor. Each frame is rendered at a lower resolution with a
+ * sub-pixel jitter from a Halton sequence, and the upscaler accumulates
+ * those samples at the output resolution: the history is reprojected with
+ * the motion vectors of the nearest surface, clipped to the variance of the
+ * new samples around the pixel so disoccluded and changed pixels don't
+ * ghost, and blended with the new samples. The result is the history of the
+ * next frame, the two history images swap every frame
+ */
+class TemporalUpscaler {
+private:
+  VkDevice m_device = VK_NULL_HANDLE;
+  VkPhysicalDeviceMemoryProperties m_memoryProperties{};
+  ComputePipeline m_upscale;
+  VkDescriptorSetLayout m_setLayout = VK_NULL_HANDLE;
+  VkSampler m_sampler = VK_NULL_HANDLE;
+  VkDescriptorPool m_pool = VK_NULL_HANDLE;
+  // the inputs can change every frame, so each frame in flight has a set
+  vector<VkDescriptorSet> m_sets;
+  VkImage m_history[2] = {VK_NULL_HANDLE, VK_NULL_HANDLE};
+  VkDeviceMemory m_historyMemory[2] = {VK_NULL_HANDLE, VK_NULL_HANDLE};
+  VkImageView m_historyViews[2] = {VK_NULL_HANDLE, VK_NULL_HANDLE};
+  VkExtent2D m_outputExtent{};
+  // the history written by the last upscale
+  uint32_t m_current = 0;
+  bool m_historyValid = false;
+  bool m_initialized = false;
+
+  auto create_history(VkExtent2D outputExtent) -> expected<void, string>;
+  auto release_history() -> void;
+
+public:
+  /*!
+   * @brief Creates the upscale pipeline, the sampler and a descriptor set
+   * per frame in flight
+   * @param device the logical device
+   * @param physicalDevice the device the history's memory comes from
+   * @param layoutCache the cache the pipeline layout comes from
+   * @param upscaleCode SPIR-V of temporal_upscale.comp
+   * @param framesInFlight how many frames can be recorded ahead of the GPU
+   * @return On success, returns void, on failure, returns unexpected with
+   * error message
+   */
+  auto init(VkDevice device, VkPhysicalDevice physicalDevice,
+            PipelineLayoutCache &layoutCache,
+            std::span<const std::byte> upscaleCode, uint32_t framesInFlight)
+      -> expected<void, string>;
+  auto destroy() -> void;
+  /*!
+   * @brief Recreates the history for an output size, does nothing if the
+   * size didn't change, otherwise the GPU must be done with the old history
+   * @param outputExtent the resolution to reconstruct
+   * @return On success, returns void, on failure, returns unexpected with
+   * error message
+   */
+  auto resize(VkExtent2D outputExtent) -> expected<void, string>;
+  /*!
+   * @brief Drops the history, for camera cuts, the next upscale only uses
+   * its own samples
+   */
+  auto reset() -> void { this->m_historyValid = false; }
+  /*!
+   * @brief Gets the jitter of a frame, the sequence is longer the more
+   * output pixels each render texel covers so every output pixel still gets
+   * a sample near its center
+   * @param frameIndex a number that goes up by one every frame
+   * @param renderExtent the resolution being rendered
+   * @param outputExtent the resolution being reconstructed
+   * @return the jitter, within half a render texel
+   */
+  [[nodiscard]] static auto jitter(uint64_t frameIndex, VkExtent2D renderExtent,
+                                   VkExtent2D outputExtent) -> Jitter;
+  /*!
+   * @brief Records the upscale, output_image() then holds the frame at the
+   * output resolution in GENERAL, readable by transfers and fragment shaders
+   * @param commandBuffer the command buffer being recorded, outside of
+   * rendering
+   * @param frameSlot the frame in flight being recorded
+   * @param inputs this frame's scene
+   * @param jitter the jitter the scene was rendered with
+   * @return On success, returns void, on failure, returns unexpected with
+   * error message
+   */
+  auto record_upscale(VkCommandBuffer commandBuffer, uint32_t frameSlot,
+                      const UpscaleInputs &inputs, Jitter jitter)
+      -> expected<void, string>;
+  [[nodiscard]] auto output_image() const -> VkImage {
+    return this->m_history[this->m_current];
+  }
+  [[nodiscard]] auto output_view() const -> VkImageView {
+    return this->m_historyViews[this->m_current];
+  }
+  [[nodiscard]] auto output_extent() const -> VkExtent2D {
+    return this->m_outputExtent;
+  }
+};
+} // namespace SFT::Renderer::VK
+
+#endif // TEMPORALUPSCALER_H
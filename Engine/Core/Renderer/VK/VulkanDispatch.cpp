@@ -0,0 +1,50 @@
+//
+// Created by sturd on 10/18/2026.
+//
+
+#include "VulkanDispatch.h"
+
+namespace SFT::Renderer::VK {
+#pragma region VulkanDispatch Functions
+auto load_global_functions() -> expected<void, string> {
+  // the loader's own export, everything else is looked up through it
+#define SFT_VK_LOAD_FUNCTION(name)                                             \
+  name = reinterpret_cast<PFN_##name>(::vkGetInstanceProcAddr(nullptr, #name)); \
+  if (name == nullptr) {                                                       \
+    return unexpected("the Vulkan loader has no " #name);                      \
+  }
+  SFT_VK_GLOBAL_FUNCTIONS(SFT_VK_LOAD_FUNCTION)
+#undef SFT_VK_LOAD_FUNCTION
+  return {};
+}
+
+auto load_instance_functions(VkInstance instance) -> expected<void, string> {
+#define SFT_VK_LOAD_FUNCTION(name)                                             \
+  name =                                                                       \
+      reinterpret_cast<PFN_##name>(::vkGetInstanceProcAddr(instance, #name));  \
+  if (name == nullptr) {                                                       \
+    return unexpected("the instance has no " #name);                           \
+  }
+  SFT_VK_INSTANCE_FUNCTIONS(SFT_VK_LOAD_FUNCTION)
+#undef SFT_VK_LOAD_FUNCTION
+#define SFT_VK_LOAD_FUNCTION(name)                                             \
+  name = reinterpret_cast<PFN_##name>(::vkGetInstanceProcAddr(instance, #name));
+  SFT_VK_OPTIONAL_INSTANCE_FUNCTIONS(SFT_VK_LOAD_FUNCTION)
+#undef SFT_VK_LOAD_FUNCTION
+  return {};
+}
+
+auto load_device_functions(VkDevice device) -> expected<void, string> {
+  // device functions from vkGetDeviceProcAddr point into the driver, the
+  // loader's versions first look up the device's dispatch table on every call
+#define SFT_VK_LOAD_FUNCTION(name)                                             \
+  name = reinterpret_cast<PFN_##name>(vkGetDeviceProcAddr(device, #name));     \
+  if (name == nullptr) {                                                       \
+    return unexpected("the device has no " #name);                             \
+  }
+  SFT_VK_DEVICE_FUNCTIONS(SFT_VK_LOAD_FUNCTION)
+#undef SFT_VK_LOAD_FUNCTION
+  return {};
+}
+#pragma endregion
+} // namespace SFT::Renderer::VK
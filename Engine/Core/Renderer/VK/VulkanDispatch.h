@@ -0,0 +1,179 @@
+//
+// Created by sturd on 10/18/2026.
+//
+
+#ifndef VULKANDISPATCH_H
+#define VULKANDISPATCH_H
+
+#include <vulkan/vulkan.h>
+#include <expected>
+#include <string>
+
+using std::expected;
+using std::string;
+using std::unexpected;
+
+// Every Vulkan function the renderer calls, loaded straight from the driver.
+// Adding a call means adding its name to the matching list, the pointers and
+// the loaders are generated from them
+
+// callable before an instance exists
+#define SFT_VK_GLOBAL_FUNCTIONS(X)                                             \
+  X(vkCreateInstance)                                                          \
+  X(vkEnumerateInstanceExtensionProperties)                                    \
+  X(vkEnumerateInstanceLayerProperties)
+
+#define SFT_VK_INSTANCE_FUNCTIONS(X)                                           \
+  X(vkDestroyInstance)                                                         \
+  X(vkEnumeratePhysicalDevices)                                                \
+  X(vkEnumerateDeviceExtensionProperties)                                      \
+  X(vkGetPhysicalDeviceProperties)                                             \
+  X(vkGetPhysicalDeviceProperties2)                                            \
+  X(vkGetPhysicalDeviceFeatures)                                               \
+  X(vkGetPhysicalDeviceFeatures2)                                              \
+  X(vkGetPhysicalDeviceFormatProperties)                                       \
+  X(vkGetPhysicalDeviceMemoryProperties)                                       \
+  X(vkGetPhysicalDeviceMemoryProperties2)                                      \
+  X(vkGetPhysicalDeviceQueueFamilyProperties)                                  \
+  X(vkGetPhysicalDeviceSurfaceSupportKHR)                                      \
+  X(vkGetPhysicalDeviceSurfaceCapabilitiesKHR)                                 \
+  X(vkGetPhysicalDeviceSurfaceFormatsKHR)                                      \
+  X(vkGetPhysicalDeviceSurfacePresentModesKHR)                                 \
+  X(vkDestroySurfaceKHR)                                                       \
+  X(vkCreateDevice)                                                            \
+  X(vkGetDeviceProcAddr)
+
+// only present when VK_EXT_debug_utils is enabled, left null otherwise
+#define SFT_VK_OPTIONAL_INSTANCE_FUNCTIONS(X)                                  \
+  X(vkCreateDebugUtilsMessengerEXT)                                            \
+  X(vkDestroyDebugUtilsMessengerEXT)
+
+#define SFT_VK_DEVICE_FUNCTIONS(X)                                             \
+  X(vkDestroyDevice)                                                           \
+  X(vkGetDeviceQueue)                                                          \
+  X(vkDeviceWaitIdle)                                                          \
+  X(vkQueueWaitIdle)                                                           \
+  X(vkQueueSubmit2)                                                            \
+  X(vkCreateSemaphore)                                                         \
+  X(vkDestroySemaphore)                                                        \
+  X(vkWaitSemaphores)                                                          \
+  X(vkSignalSemaphore)                                                         \
+  X(vkGetSemaphoreCounterValue)                                                \
+  X(vkAllocateMemory)                                                          \
+  X(vkFreeMemory)                                                              \
+  X(vkMapMemory)                                                               \
+  X(vkUnmapMemory)                                                             \
+  X(vkFlushMappedMemoryRanges)                                                 \
+  X(vkInvalidateMappedMemoryRanges)                                            \
+  X(vkCreateBuffer)                                                            \
+  X(vkDestroyBuffer)                                                           \
+  X(vkGetBufferMemoryRequirements)                                             \
+  X(vkBindBufferMemory)                                                        \
+  X(vkGetBufferDeviceAddress)                                                  \
+  X(vkCreateImage)                                                             \
+  X(vkDestroyImage)                                                            \
+  X(vkGetImageMemoryRequirements)                                              \
+  X(vkBindImageMemory)                                                         \
+  X(vkCreateImageView)                                                         \
+  X(vkDestroyImageView)                                                        \
+  X(vkCreateSampler)                                                           \
+  X(vkDestroySampler)                                                          \
+  X(vkCreateFramebuffer)                                                       \
+  X(vkDestroyFramebuffer)                                                      \
+  X(vkCreateShaderModule)                                                      \
+  X(vkDestroyShaderModule)                                                     \
+  X(vkCreatePipelineCache)                                                     \
+  X(vkDestroyPipelineCache)                                                    \
+  X(vkGetPipelineCacheData)                                                    \
+  X(vkCreatePipelineLayout)                                                    \
+  X(vkDestroyPipelineLayout)                                                   \
+  X(vkCreateGraphicsPipelines)                                                 \
+  X(vkCreateComputePipelines)                                                  \
+  X(vkDestroyPipeline)                                                         \
+  X(vkCreateDescriptorSetLayout)                                               \
+  X(vkDestroyDescriptorSetLayout)                                              \
+  X(vkCreateDescriptorPool)                                                    \
+  X(vkDestroyDescriptorPool)                                                   \
+  X(vkResetDescriptorPool)                                                     \
+  X(vkAllocateDescriptorSets)                                                  \
+  X(vkFreeDescriptorSets)                                                      \
+  X(vkUpdateDescriptorSets)                                                    \
+  X(vkCreateQueryPool)                                                         \
+  X(vkDestroyQueryPool)                                                        \
+  X(vkResetQueryPool)                                                          \
+  X(vkGetQueryPoolResults)                                                     \
+  X(vkCreateCommandPool)                                                       \
+  X(vkDestroyCommandPool)                                                      \
+  X(vkResetCommandPool)                                                        \
+  X(vkAllocateCommandBuffers)                                                  \
+  X(vkFreeCommandBuffers)                                                      \
+  X(vkBeginCommandBuffer)                                                      \
+  X(vkEndCommandBuffer)                                                        \
+  X(vkCmdPipelineBarrier2)                                                     \
+  X(vkCmdBeginRendering)                                                       \
+  X(vkCmdEndRendering)                                                         \
+  X(vkCmdSetViewport)                                                          \
+  X(vkCmdSetScissor)                                                           \
+  X(vkCmdBindPipeline)                                                         \
+  X(vkCmdBindDescriptorSets)                                                   \
+  X(vkCmdPushConstants)                                                        \
+  X(vkCmdBindVertexBuffers)                                                    \
+  X(vkCmdBindIndexBuffer)                                                      \
+  X(vkCmdDraw)                                                                 \
+  X(vkCmdDrawIndexed)                                                          \
+  X(vkCmdDrawIndirect)                                                         \
+  X(vkCmdDrawIndexedIndirect)                                                  \
+  X(vkCmdDispatch)                                                             \
+  X(vkCmdDispatchIndirect)                                                     \
+  X(vkCmdFillBuffer)                                                           \
+  X(vkCmdUpdateBuffer)                                                         \
+  X(vkCmdCopyBuffer)                                                           \
+  X(vkCmdCopyImage)                                                            \
+  X(vkCmdCopyBufferToImage)                                                    \
+  X(vkCmdCopyImageToBuffer)                                                    \
+  X(vkCmdBlitImage)                                                            \
+  X(vkCmdClearColorImage)                                                      \
+  X(vkCmdResetQueryPool)                                                       \
+  X(vkCmdWriteTimestamp2)                                                      \
+  X(vkCreateSwapchainKHR)                                                      \
+  X(vkDestroySwapchainKHR)                                                     \
+  X(vkGetSwapchainImagesKHR)                                                   \
+  X(vkAcquireNextImageKHR)                                                     \
+  X(vkQueuePresentKHR)
+
+namespace SFT::Renderer::VK {
+// The pointers share the names of the loader's exports, code inside this
+// namespace finds them first and calls the driver directly, without the
+// loader's trampoline. Device functions come from vkGetDeviceProcAddr, so
+// there's one table for the one device the renderer creates
+#define SFT_VK_DECLARE_FUNCTION(name) inline PFN_##name name = nullptr;
+SFT_VK_GLOBAL_FUNCTIONS(SFT_VK_DECLARE_FUNCTION)
+SFT_VK_INSTANCE_FUNCTIONS(SFT_VK_DECLARE_FUNCTION)
+SFT_VK_OPTIONAL_INSTANCE_FUNCTIONS(SFT_VK_DECLARE_FUNCTION)
+SFT_VK_DEVICE_FUNCTIONS(SFT_VK_DECLARE_FUNCTION)
+#undef SFT_VK_DECLARE_FUNCTION
+
+/*!
+ * @brief Loads the functions that don't need an instance, call before
+ * anything else
+ * @return On success, returns void, on failure, returns unexpected with the
+ * missing function
+ */
+auto load_global_functions() -> expected<void, string>;
+/*!
+ * @brief Loads the instance functions, call right after vkCreateInstance
+ * @param instance the instance
+ * @return On success, returns void, on failure, returns unexpected with the
+ * missing function
+ */
+auto load_instance_functions(VkInstance instance) -> expected<void, string>;
+/*!
+ * @brief Loads the device functions, call right after vkCreateDevice
+ * @param device the logical device
+ * @return On success, returns void, on failure, returns unexpected with the
+ * missing function
+ */
+auto load_device_functions(VkDevice device) -> expected<void, string>;
+} // namespace SFT::Renderer::VK
+
+#endif // VULKANDISPATCH_H
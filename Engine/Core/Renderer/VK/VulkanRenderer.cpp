@@ -1,5 +1,6 @@
 
 #include "VulkanRenderer.h"
+#include "Core/Assets/CookedMesh.h"
 #include "Core/Window/GLFW/GLFWWindowWrapped.h"
 #include "GLFW/glfw3.h"
 #include "spdlog/spdlog.h"
@@ -8,6 +9,47 @@ const std::vector validationLayers = {"VK_LAYER_KHRONOS_validation"};
 const std::vector<const char*> deviceExtensions = {
     VK_KHR_SWAPCHAIN_EXTENSION_NAME
   };
+// enabled when the device has them, features depending on them fall back
+const std::vector<const char*> optionalDeviceExtensions = {
+    VK_EXT_MEMORY_BUDGET_EXTENSION_NAME
+  };
+const string pipelineCachePath = "pipeline_cache.bin";
+const string pipelineManifestPath = "pipeline_manifest.bin";
+// packed by `Editor pack`, every asset the renderer loads comes out of it
+const string assetArchivePath = "assets.sftpak";
+// frames the CPU may record ahead of the GPU, per-frame resources come in this
+// many copies
+constexpr uint32_t maxFramesInFlight = 2;
+// texture loads mostly wait on the disk, a couple of threads keep it busy
+constexpr uint32_t textureLoaderThreads = 2;
+// per-frame CPU scratch, arenas grow past this and settle on the high water
+constexpr size_t frameArenaBlockSize = 1024 * 1024;
+// per-draw constants of one frame, the ring holds this much per frame in flight
+constexpr VkDeviceSize uniformRingBytesPerFrame = 4 * 1024 * 1024;
+// what the shared geometry buffers start out holding, 32 and 16 MiB, they grow
+// when meshes stop fitting
+constexpr uint32_t geometryPoolVertices = 1024 * 1024;
+constexpr uint32_t geometryPoolIndices = 4 * 1024 * 1024;
+// objects one occlusion cull can take, 4 bytes of visibility and two 20 byte
+// indirect commands each
+constexpr uint32_t maxCulledObjects = 64 * 1024;
+// particles alive at once, 64 bytes of state and 12 bytes of list entries each
+constexpr uint32_t maxParticles = 1024 * 1024;
+// dynamic lights one frame can have, and the average number of lights per
+// cluster the shared light index list is sized for
+constexpr uint32_t maxLights = 4096;
+constexpr uint32_t averageLightsPerCluster = 32;
+// the GPU time dynamic resolution holds, and how far below the swap chain
+// resolution it may render to get there
+constexpr double targetGpuFrameMs = 1000.0 / 60.0;
+constexpr float minRenderScale = 0.5f;
+// memory reports for tools and bug reports, the JSON holds the latest sample,
+// the CSV every sample since startup
+const string memoryTelemetryJsonPath = "memory_telemetry.json";
+const string memoryTelemetryCsvPath = "memory_telemetry.csv";
+// captures in flight at once, one more than the frames in flight so a capture
+// every frame never runs out
+constexpr uint32_t readbackSlots = maxFramesInFlight + 1;
 
 #ifdef NDEBUG
 constexpr bool enableValidationLayers = false;
@@ -21,11 +63,10 @@ namespace SFT::Renderer::VK {
                                      VkDebugUtilsMessengerEXT debugMessenger,
                                      const VkAllocationCallbacks* pAllocator)
     -> void {
-    auto func = reinterpret_cast<PFN_vkDestroyDebugUtilsMessengerEXT>(
-      vkGetInstanceProcAddr(instance, "vkDestroyDebugUtilsMessengerEXT"));
-    if (func != nullptr)
+    // loaded with the instance, null when debug utils isn't enabled
+    if (vkDestroyDebugUtilsMessengerEXT != nullptr)
     {
-      func(instance, debugMessenger, pAllocator);
+      vkDestroyDebugUtilsMessengerEXT(instance, debugMessenger, pAllocator);
     }
   }
 
@@ -33,11 +74,9 @@ namespace SFT::Renderer::VK {
     VkInstance instance, const VkDebugUtilsMessengerCreateInfoEXT* pCreateInfo,
     const VkAllocationCallbacks* pAllocator,
     VkDebugUtilsMessengerEXT* pDebugMessenger) -> VkResult {
-    if (auto func = reinterpret_cast<PFN_vkCreateDebugUtilsMessengerEXT>(
-        vkGetInstanceProcAddr(instance, "vkCreateDebugUtilsMessengerEXT"));
-      func != nullptr)
+    if (vkCreateDebugUtilsMessengerEXT != nullptr)
     {
-      return func(instance, pCreateInfo, pAllocator, pDebugMessenger);
+      return vkCreateDebugUtilsMessengerEXT(instance, pCreateInfo, pAllocator, pDebugMessenger);
     } else
     {
       return VK_ERROR_EXTENSION_NOT_PRESENT;
@@ -97,6 +136,21 @@ namespace SFT::Renderer::VK {
     if (deviceFeatures.wideLines)
       score *= feature_multipliers["wideLines"];
 
+    // more VRAM means more headroom before the driver starts paging, the
+    // largest device local heap counts, with diminishing returns
+    VkPhysicalDeviceMemoryProperties memoryProperties;
+    vkGetPhysicalDeviceMemoryProperties(device, &memoryProperties);
+    VkDeviceSize deviceLocalBytes = 0;
+    for (uint32_t i = 0; i < memoryProperties.memoryHeapCount; i++)
+    {
+      if (memoryProperties.memoryHeaps[i].flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT)
+      {
+        deviceLocalBytes = std::max(deviceLocalBytes, memoryProperties.memoryHeaps[i].size);
+      }
+    }
+    const double deviceLocalGiB = static_cast<double>(deviceLocalBytes) / (1024.0 * 1024.0 * 1024.0);
+    score *= 1.0 + std::log2(1.0 + deviceLocalGiB) * 0.25;
+
     // Apply device type multiplier
     switch (deviceProperties.deviceType)
     {
@@ -122,25 +176,19 @@ namespace SFT::Renderer::VK {
     return score;
   }
 
-  static auto readFile(const string& filename) -> vector<char> {
-    std::ifstream file(filename, std::ios::ate | std::ios::binary);
-
-    if (!file.is_open())
-    {
-      throw std::runtime_error("failed to open file!");
-    }
-    size_t fileSize = (size_t)file.tellg();
-    std::vector<char> buffer(fileSize);
-    file.seekg(0);
-    file.read(buffer.data(), fileSize);
-    file.close();
-
-    return buffer;
+  // SPIR-V is read straight out of the archive mapping, add_stage copies it
+  // into words so nothing has to stay mapped afterwards
+  auto as_chars(const std::span<const std::byte> bytes) -> std::span<const char> {
+    return {reinterpret_cast<const char*>(bytes.data()), bytes.size()};
   }
 #pragma endregion
 
 #pragma region VulkanRenderer Functions
   auto VulkanRenderer::create_instance() -> expected<void, string> {
+    if (auto result = load_global_functions(); !result.has_value())
+    {
+      return unexpected(result.error());
+    }
     if (enableValidationLayers && !checkValidationLayerSupport())
     {
       // ReSharper disable once CppDFAUnreachableCode
@@ -207,6 +255,10 @@ namespace SFT::Renderer::VK {
     {
       return unexpected("We failed to create the Vulkan instance");
     }
+    if (auto result = load_instance_functions(this->m_instance); !result.has_value())
+    {
+      return unexpected(result.error());
+    }
 
     vkEnumerateInstanceExtensionProperties(nullptr, &extensionCount, nullptr);
     vector<VkExtensionProperties> extensionsList(extensionCount);
@@ -277,6 +329,12 @@ namespace SFT::Renderer::VK {
     vkGetPhysicalDeviceProperties(device, &deviceProperties);
     VkPhysicalDeviceFeatures deviceFeatures;
     vkGetPhysicalDeviceFeatures(device, &deviceFeatures);
+    VkPhysicalDeviceVulkan13Features vulkan13Features{};
+    vulkan13Features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_3_FEATURES;
+    VkPhysicalDeviceFeatures2 features2{};
+    features2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+    features2.pNext = &vulkan13Features;
+    vkGetPhysicalDeviceFeatures2(device, &features2);
     QueueFamilyIndices indices = this->findQueueFamilies(device);
     bool extensions_supported = checkDeviceExtensionSupport(device);
     bool swapChainAdequate = false;
@@ -286,8 +344,8 @@ namespace SFT::Renderer::VK {
       swapChainAdequate = not swapChainSupport.formats.empty() and
         not swapChainSupport.presentModes.empty();
     }
-    return deviceFeatures.geometryShader and indices.isComplete() and
-      extensions_supported and swapChainAdequate;
+    return deviceFeatures.geometryShader and vulkan13Features.dynamicRendering and
+      vulkan13Features.synchronization2 and indices.isComplete() and extensions_supported and swapChainAdequate;
   }
 
   // RateDeviceSuitability moved to additional functions
@@ -301,15 +359,19 @@ namespace SFT::Renderer::VK {
       return unexpected("failed to find GPUs with Vulkan support!");
       // we obviously can't draw on a system that doesn't support Vulkan
     }
+    // the queries below only live for this function, so they come out of the
+    // thread's scratch arena rather than the heap
+    auto& scratch = Memory::thread_scratch_arena();
+    Memory::ArenaScope scope(scratch);
     // we can now pre-alloc a vector to store the devices
-    vector<VkPhysicalDevice> devices(deviceCount);
+    std::pmr::vector<VkPhysicalDevice> devices(deviceCount, &scratch);
     vkEnumeratePhysicalDevices(
       this->m_instance, &deviceCount,
       devices.data()
     ); // once more for the data
     // create an ordered map to store the devices and their scores, this also
     // sorts them
-    multimap<double, VkPhysicalDevice> candidates;
+    std::pmr::multimap<double, VkPhysicalDevice> candidates(&scratch);
 
     for (const auto& device : devices)
     {
@@ -352,7 +414,9 @@ namespace SFT::Renderer::VK {
     uint32_t queueFamilyCount = 0;
     vkGetPhysicalDeviceQueueFamilyProperties(device, &queueFamilyCount, nullptr);
 
-    std::vector<VkQueueFamilyProperties> queueFamilies(queueFamilyCount);
+    auto& scratch = Memory::thread_scratch_arena();
+    Memory::ArenaScope scope(scratch);
+    std::pmr::vector<VkQueueFamilyProperties> queueFamilies(queueFamilyCount, &scratch);
     vkGetPhysicalDeviceQueueFamilyProperties(
       device, &queueFamilyCount,
       queueFamilies.data()
@@ -361,13 +425,20 @@ namespace SFT::Renderer::VK {
     int i = 0;
     for (const auto& queueFamily : queueFamilies)
     {
-      if (indices.isComplete())
+      const bool graphics = queueFamily.queueFlags & VK_QUEUE_GRAPHICS_BIT;
+      const bool compute = queueFamily.queueFlags & VK_QUEUE_COMPUTE_BIT;
+      if (graphics && !indices.graphicsFamily.has_value())
       {
-        break;
+        indices.graphicsFamily = i;
       }
-      if (queueFamily.queueFlags & VK_QUEUE_GRAPHICS_BIT)
+      if (compute && !graphics && !indices.computeFamily.has_value())
       {
-        indices.graphicsFamily = i;
+        indices.computeFamily = i;
+      }
+      // a family with transfer alone is usually the copy engine
+      if (!graphics && !compute && (queueFamily.queueFlags & VK_QUEUE_TRANSFER_BIT) && !indices.transferFamily.has_value())
+      {
+        indices.transferFamily = i;
       }
 
       VkBool32 presentSupport = false;
@@ -375,13 +446,21 @@ namespace SFT::Renderer::VK {
         device, i, this->m_surface,
         &presentSupport
       );
-      if (presentSupport)
+      if (presentSupport && !indices.presentFamily.has_value())
       {
         indices.presentFamily = i;
       }
 
       i++;
     }
+    if (!indices.computeFamily.has_value())
+    {
+      indices.computeFamily = indices.graphicsFamily;
+    }
+    if (!indices.transferFamily.has_value())
+    {
+      indices.transferFamily = indices.computeFamily;
+    }
 
     return indices;
   }
@@ -391,11 +470,16 @@ namespace SFT::Renderer::VK {
   auto VulkanRenderer::createLogicalDevice() -> expected<void, string> {
     QueueFamilyIndices indices = findQueueFamilies(this->m_physicalDevice);
 
-    vector<VkDeviceQueueCreateInfo> queueCreateInfos;
-    set<uint32_t> uniqueQueueFamilies = {
-        indices.graphicsFamily.value(),
-        indices.presentFamily.value()
-      };
+    auto& scratch = Memory::thread_scratch_arena();
+    Memory::ArenaScope scope(scratch);
+    std::pmr::vector<VkDeviceQueueCreateInfo> queueCreateInfos(&scratch);
+    std::pmr::set<uint32_t> uniqueQueueFamilies(
+      {
+        indices.graphicsFamily.value(), indices.presentFamily.value(),
+        indices.computeFamily.value(), indices.transferFamily.value()
+      },
+      &scratch
+    );
 
     float queuePriority = 1.0f;
     for (uint32_t queueFamily : uniqueQueueFamilies)
@@ -410,8 +494,24 @@ namespace SFT::Renderer::VK {
 
     VkPhysicalDeviceFeatures deviceFeatures{};
 
+    // pipelines render through dynamic rendering, no render pass objects, and
+    // the render graph records its barriers with synchronization2
+    VkPhysicalDeviceVulkan13Features vulkan13Features{};
+    vulkan13Features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_3_FEATURES;
+    vulkan13Features.dynamicRendering = VK_TRUE;
+    vulkan13Features.synchronization2 = VK_TRUE;
+    // per-draw constants are read through buffer device addresses into the
+    // uniform ring, core and required since Vulkan 1.3
+    VkPhysicalDeviceVulkan12Features vulkan12Features{};
+    vulkan12Features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+    vulkan12Features.bufferDeviceAddress = VK_TRUE;
+    // every queue signals a timeline semaphore per submit, see QueueTimelines
+    vulkan12Features.timelineSemaphore = VK_TRUE;
+    vulkan13Features.pNext = &vulkan12Features;
+
     VkDeviceCreateInfo createInfo{};
     createInfo.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
+    createInfo.pNext = &vulkan13Features;
 
     createInfo.queueCreateInfoCount =
       static_cast<uint32_t>(queueCreateInfos.size());
@@ -419,9 +519,28 @@ namespace SFT::Renderer::VK {
 
     createInfo.pEnabledFeatures = &deviceFeatures;
 
+    std::pmr::vector<const char*> enabledExtensions(deviceExtensions.begin(), deviceExtensions.end(), &scratch);
+    uint32_t extensionCount = 0;
+    vkEnumerateDeviceExtensionProperties(this->m_physicalDevice, nullptr, &extensionCount, nullptr);
+    std::pmr::vector<VkExtensionProperties> availableExtensions(extensionCount, &scratch);
+    vkEnumerateDeviceExtensionProperties(this->m_physicalDevice, nullptr, &extensionCount, availableExtensions.data());
+    for (const char* extension : optionalDeviceExtensions)
+    {
+      const bool available = std::ranges::any_of(availableExtensions, [extension](const VkExtensionProperties& properties) {
+        return std::string_view(properties.extensionName) == extension;
+      });
+      if (available)
+      {
+        enabledExtensions.push_back(extension);
+      }
+    }
+    this->m_hasMemoryBudget = std::ranges::any_of(enabledExtensions, [](const char* extension) {
+      return std::string_view(extension) == VK_EXT_MEMORY_BUDGET_EXTENSION_NAME;
+    });
+
     createInfo.enabledExtensionCount =
-      static_cast<uint32_t>(deviceExtensions.size());
-    createInfo.ppEnabledExtensionNames = deviceExtensions.data();
+      static_cast<uint32_t>(enabledExtensions.size());
+    createInfo.ppEnabledExtensionNames = enabledExtensions.data();
 
     if (enableValidationLayers)
     {
@@ -439,6 +558,10 @@ namespace SFT::Renderer::VK {
     {
       return unexpected("failed to create logical device!");
     }
+    if (auto result = load_device_functions(this->m_logicalDevice); !result.has_value())
+    {
+      return unexpected("failed to load device functions: " + result.error());
+    }
     vkGetDeviceQueue(
       this->m_logicalDevice, indices.graphicsFamily.value(), 0,
       &this->m_graphicsQueue
@@ -447,6 +570,36 @@ namespace SFT::Renderer::VK {
       this->m_logicalDevice, indices.presentFamily.value(), 0,
       &this->m_presentQueue
     );
+    QueueSelection queues;
+    queues.family = {indices.graphicsFamily.value(), indices.computeFamily.value(), indices.transferFamily.value()};
+    if (auto result = this->m_queueTimelines.init(this->m_logicalDevice, queues); !result.has_value())
+    {
+      return unexpected("failed to create queue timelines: " + result.error());
+    }
+    this->m_readback.init(this->m_logicalDevice, this->m_physicalDevice, readbackSlots);
+    this->m_pipelineLayoutCache.init(this->m_logicalDevice);
+    this->m_renderGraph.init(this->m_logicalDevice, this->m_physicalDevice, maxFramesInFlight);
+    this->m_frameArenas.init(maxFramesInFlight, frameArenaBlockSize, Memory::MemoryTag::Renderer);
+    if (auto result = this->m_uniformRing.init(this->m_logicalDevice, this->m_physicalDevice, maxFramesInFlight, uniformRingBytesPerFrame); !result.has_value())
+    {
+      return unexpected("failed to create uniform ring: " + result.error());
+    }
+    if (!this->m_hasMemoryBudget)
+    {
+      spdlog::warn("VK_EXT_memory_budget is unavailable, texture streaming budgets come from heap sizes");
+    }
+    MemoryTelemetrySettings telemetrySettings;
+    telemetrySettings.jsonPath = memoryTelemetryJsonPath;
+    telemetrySettings.csvPath = memoryTelemetryCsvPath;
+    this->m_memoryTelemetry.init(this->m_physicalDevice, this->m_hasMemoryBudget, telemetrySettings);
+    if (auto result = this->m_textureStreamer.init(this->m_logicalDevice, this->m_physicalDevice, this->m_hasMemoryBudget, maxFramesInFlight, textureLoaderThreads); !result.has_value())
+    {
+      return unexpected("failed to create texture streamer: " + result.error());
+    }
+    if (auto result = this->m_geometryPool.init(this->m_logicalDevice, this->m_physicalDevice, sizeof(Assets::CookedMeshVertex), geometryPoolVertices, geometryPoolIndices, maxFramesInFlight); !result.has_value())
+    {
+      return unexpected("failed to create geometry pool: " + result.error());
+    }
     return {};
   }
 
@@ -479,15 +632,21 @@ namespace SFT::Renderer::VK {
       nullptr
     );
 
-    vector<VkExtensionProperties> availableExtensions(extensionCount);
+    auto& scratch = Memory::thread_scratch_arena();
+    Memory::ArenaScope scope(scratch);
+    std::pmr::vector<VkExtensionProperties> availableExtensions(extensionCount, &scratch);
     vkEnumerateDeviceExtensionProperties(
       device, nullptr, &extensionCount,
       availableExtensions.data()
     );
 
-    set<string> requiredExtensions(
+    // views into the static name lists, erasing by a view of each available
+    // name needs no string copies
+    std::pmr::set<std::string_view, std::less<>> requiredExtensions(
       deviceExtensions.begin(),
-      deviceExtensions.end()
+      deviceExtensions.end(),
+      std::less<>(),
+      &scratch
     );
 
     for (const auto& [extensionName, specVersion] : availableExtensions)
@@ -633,6 +792,18 @@ namespace SFT::Renderer::VK {
     createInfo.imageExtent = extent;
     createInfo.imageArrayLayers = 1;
     createInfo.imageUsage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;
+    // screenshots and golden image tests copy straight out of the swap chain
+    this->m_swapChainReadable = swapChainSupport.capabilities.supportedUsageFlags & VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
+    if (this->m_swapChainReadable)
+    {
+      createInfo.imageUsage |= VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
+    }
+    // frames rendered below the swap chain resolution are blitted into it
+    this->m_swapChainBlittable = swapChainSupport.capabilities.supportedUsageFlags & VK_IMAGE_USAGE_TRANSFER_DST_BIT;
+    if (this->m_swapChainBlittable)
+    {
+      createInfo.imageUsage |= VK_IMAGE_USAGE_TRANSFER_DST_BIT;
+    }
 
     QueueFamilyIndices indices = findQueueFamilies(this->m_physicalDevice);
     uint32_t queueFamilyIndices[] = {
@@ -720,48 +891,76 @@ namespace SFT::Renderer::VK {
 
   // Graphics Pipeline lesson
 
-  auto VulkanRenderer::createShaderModule(const std::vector<char>& code) -> expected<VkShaderModule, string> {
-    VkShaderModuleCreateInfo createInfo{};
-    createInfo.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
-    createInfo.codeSize = code.size();
-    createInfo.pCode = reinterpret_cast<const uint32_t*>(code.data());
+  auto VulkanRenderer::createPipelineManager() -> expected<void, string> {
+    // leave headroom for the main and render threads
+    const uint32_t compilerThreads = std::max(1u, std::thread::hardware_concurrency() / 2);
+    if (auto result = this->m_pipelineManager.init(this->m_logicalDevice, &this->m_pipelineLayoutCache, pipelineCachePath, compilerThreads); !result.has_value()) {
+      return unexpected(result.error());
+    }
+    // a broken manifest only costs us the pre-warm, it's not worth failing over
+    if (auto result = this->m_pipelineManager.prewarm_from_manifest(pipelineManifestPath); !result.has_value()) {
+      spdlog::warn("Skipping pipeline pre-warm: {}", result.error());
+    }
+    return {};
+  }
 
-    VkShaderModule shaderModule;
-    if (vkCreateShaderModule(this->m_logicalDevice, &createInfo, nullptr, &shaderModule) != VK_SUCCESS)
-    {
-      return unexpected("failed to create shader module!");
+  auto VulkanRenderer::openAssetArchive() -> expected<void, string> {
+    if (auto result = this->m_assets.open(assetArchivePath); !result.has_value()) {
+      return unexpected(result.error());
     }
-    return shaderModule;
+    spdlog::info("Mapped {} assets from {}", this->m_assets.entry_count(), assetArchivePath);
+    return {};
   }
 
   auto VulkanRenderer::createGraphicsPipeline() -> expected<void, string> {
-    auto vertShaderCode = readFile("D:/Projects/SturdyEngine3/Shaders/vert.spv");
-    auto fragShaderCode = readFile("D:/Projects/SturdyEngine3/Shaders/frag.spv");
-    expected<VkShaderModule, string> result = createShaderModule(vertShaderCode);
-    if (!result.has_value()) {
-      return unexpected("Failed to create vertex shader module: " + result.error());
-    }
-    VkShaderModule vertShaderModule = result.value();
-    if (result = createShaderModule(fragShaderCode); !result.has_value()) {
-      return unexpected("Failed to create fragment shader module: " + result.error());
-    }
-    VkShaderModule fragShaderModule = result.value();
-    VkPipelineShaderStageCreateInfo vertShaderStageInfo{};
-    vertShaderStageInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
-    vertShaderStageInfo.stage = VK_SHADER_STAGE_VERTEX_BIT;
-
-    vertShaderStageInfo.module = vertShaderModule;
-    vertShaderStageInfo.pName = "main";
-
-    VkPipelineShaderStageCreateInfo fragShaderStageInfo{};
-    fragShaderStageInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
-    fragShaderStageInfo.stage = VK_SHADER_STAGE_FRAGMENT_BIT;
-    fragShaderStageInfo.module = fragShaderModule;
-    fragShaderStageInfo.pName = "main";
-
-    VkPipelineShaderStageCreateInfo shaderStages[] = {vertShaderStageInfo, fragShaderStageInfo};
-    vkDestroyShaderModule(this->m_logicalDevice, fragShaderModule, nullptr);
-    vkDestroyShaderModule(this->m_logicalDevice, vertShaderModule, nullptr);
+    using Shaders::Shader::ShaderStage;
+    Shaders::Shader::Shader shader;
+    auto vertCode = this->m_assets.get("shaders/vert.spv");
+    if (!vertCode.has_value()) {
+      return unexpected("Failed to load vertex shader: " + vertCode.error());
+    }
+    if (auto result = shader.add_stage(ShaderStage::Vertex, as_chars(vertCode.value())); !result.has_value()) {
+      return unexpected("Failed to load vertex shader: " + result.error());
+    }
+    auto fragCode = this->m_assets.get("shaders/frag.spv");
+    if (!fragCode.has_value()) {
+      return unexpected("Failed to load fragment shader: " + fragCode.error());
+    }
+    if (auto result = shader.add_stage(ShaderStage::Fragment, as_chars(fragCode.value())); !result.has_value()) {
+      return unexpected("Failed to load fragment shader: " + result.error());
+    }
+    // the manager creates the modules and derives the pipeline layout from the
+    // shaders themselves, identical interfaces share one layout through the cache
+    auto vertShader = this->m_pipelineManager.register_shader(shader, ShaderStage::Vertex);
+    if (!vertShader.has_value()) {
+      return unexpected("Failed to register vertex shader: " + vertShader.error());
+    }
+    auto fragShader = this->m_pipelineManager.register_shader(shader, ShaderStage::Fragment);
+    if (!fragShader.has_value()) {
+      return unexpected("Failed to register fragment shader: " + fragShader.error());
+    }
+
+    this->m_trianglePipelineKey.vertexShader = vertShader.value();
+    this->m_trianglePipelineKey.fragmentShader = fragShader.value();
+    // the forward pass renders the scene and its motion vectors at the render
+    // resolution, the temporal upscaler turns them into the output
+    this->m_trianglePipelineKey.state.colorFormatCount = 2;
+    this->m_trianglePipelineKey.state.colorFormats[0] = sceneColorFormat;
+    this->m_trianglePipelineKey.state.colorFormats[1] = motionVectorFormat;
+
+    // the forward pass's fallback, any material drawn into the scene and
+    // motion vector targets is served this until its own pipeline is ready
+    if (auto result = this->m_pipelineManager.set_fallback(this->m_trianglePipelineKey); !result.has_value()) {
+      return unexpected("Failed to create fallback pipeline: " + result.error());
+    }
+    if (auto pipeline = this->m_pipelineManager.request(this->m_trianglePipelineKey); !pipeline.has_value()) {
+      return unexpected("Failed to queue pipeline: " + pipeline.error());
+    }
+    auto layout = this->m_pipelineManager.layout_for(this->m_trianglePipelineKey);
+    if (!layout.has_value()) {
+      return unexpected("Failed to create pipeline layout: " + layout.error());
+    }
+    this->m_pipelineLayout = layout.value();
     return {};
   }
 
@@ -833,13 +1032,148 @@ namespace SFT::Renderer::VK {
         result.error()
       );
     }
+    if (result = this->openAssetArchive(); !result.has_value())
+    {
+      return unexpected("Failed to open asset archive: " + result.error());
+    }
+    if (result = this->createPipelineManager(); !result.has_value())
+    {
+      return unexpected("Failed to create pipeline manager: " + result.error());
+    }
     if (result = this->createGraphicsPipeline(); !result.has_value())
     {
       return unexpected("Failed to create graphics pipeline: " + result.error());
     }
+    this->createDynamicResolution();
+    // without it frames are upscaled with a plain blit
+    if (result = this->createTemporalUpscaler(); !result.has_value())
+    {
+      spdlog::warn("Temporal upscaling disabled: {}", result.error());
+      this->m_temporalUpscaler.destroy();
+    }
+    // the forward shaders read the light clusters, so this one is required
+    if (result = this->createClusteredLighting(); !result.has_value())
+    {
+      return unexpected("Failed to create clustered lighting: " + result.error());
+    }
+    // culling is an optimization, without it every object is simply drawn
+    if (result = this->createOcclusionCuller(); !result.has_value())
+    {
+      spdlog::warn("Occlusion culling disabled: {}", result.error());
+      this->m_occlusionCuller.destroy();
+    }
+    if (result = this->createParticleSystem(); !result.has_value())
+    {
+      spdlog::warn("GPU particles disabled: {}", result.error());
+      this->m_particles.destroy();
+    }
     return {};
   }
 
+  auto VulkanRenderer::createOcclusionCuller() -> expected<void, string> {
+    auto cullCode = this->m_assets.get("shaders/occlusion_cull.spv");
+    if (!cullCode.has_value()) {
+      return unexpected("Failed to load occlusion cull shader: " + cullCode.error());
+    }
+    auto downsampleCode = this->m_assets.get("shaders/hiz_downsample.spv");
+    if (!downsampleCode.has_value()) {
+      return unexpected("Failed to load Hi-Z downsample shader: " + downsampleCode.error());
+    }
+    if (auto result = this->m_occlusionCuller.init(
+          this->m_logicalDevice, this->m_physicalDevice, this->m_pipelineLayoutCache,
+          cullCode.value(), downsampleCode.value(), maxCulledObjects, maxFramesInFlight
+        ); !result.has_value())
+    {
+      return unexpected(result.error());
+    }
+    // the depth buffer matches the swap chain
+    return this->m_occlusionCuller.resize(this->swapChainExtent);
+  }
+
+  auto VulkanRenderer::createClusteredLighting() -> expected<void, string> {
+    auto binCode = this->m_assets.get("shaders/light_cluster.spv");
+    if (!binCode.has_value()) {
+      return unexpected("Failed to load light binning shader: " + binCode.error());
+    }
+    return this->m_clusteredLighting.init(
+      this->m_logicalDevice, this->m_physicalDevice, this->m_pipelineLayoutCache,
+      binCode.value(), maxLights, averageLightsPerCluster, maxFramesInFlight
+    );
+  }
+
+  auto VulkanRenderer::createDynamicResolution() -> void {
+    DynamicResolutionSettings settings;
+    settings.targetFrameMs = targetGpuFrameMs;
+    settings.minScale = minRenderScale;
+    if (!this->m_swapChainBlittable)
+    {
+      spdlog::warn("Swap chain images can't be blitted to, rendering at full resolution");
+      settings.minScale = settings.maxScale;
+    }
+    QueueFamilyIndices indices = findQueueFamilies(this->m_physicalDevice);
+    if (auto result = this->m_dynamicResolution.init(
+          this->m_logicalDevice, this->m_physicalDevice, indices.graphicsFamily.value(),
+          maxFramesInFlight, settings
+        ); !result.has_value())
+    {
+      spdlog::warn("{}", result.error());
+    }
+    // render targets are sized by max_render_extent, not the swap chain
+    this->m_dynamicResolution.set_output_extent(this->swapChainExtent);
+  }
+
+  auto VulkanRenderer::createTemporalUpscaler() -> expected<void, string> {
+    auto upscaleCode = this->m_assets.get("shaders/temporal_upscale.spv");
+    if (!upscaleCode.has_value()) {
+      return unexpected("Failed to load temporal upscale shader: " + upscaleCode.error());
+    }
+    if (auto result = this->m_temporalUpscaler.init(
+          this->m_logicalDevice, this->m_physicalDevice, this->m_pipelineLayoutCache,
+          upscaleCode.value(), maxFramesInFlight
+        ); !result.has_value())
+    {
+      return unexpected(result.error());
+    }
+    return this->m_temporalUpscaler.resize(this->m_dynamicResolution.output_extent());
+  }
+
+  auto VulkanRenderer::createParticleSystem() -> expected<void, string> {
+    using Shaders::Shader::ShaderStage;
+    auto updateCode = this->m_assets.get("shaders/particle_update.spv");
+    if (!updateCode.has_value()) {
+      return unexpected("Failed to load particle update shader: " + updateCode.error());
+    }
+    Shaders::Shader::Shader shader;
+    auto vertCode = this->m_assets.get("shaders/particle_vert.spv");
+    if (!vertCode.has_value()) {
+      return unexpected("Failed to load particle vertex shader: " + vertCode.error());
+    }
+    if (auto result = shader.add_stage(ShaderStage::Vertex, as_chars(vertCode.value())); !result.has_value()) {
+      return unexpected("Failed to load particle vertex shader: " + result.error());
+    }
+    auto fragCode = this->m_assets.get("shaders/particle_frag.spv");
+    if (!fragCode.has_value()) {
+      return unexpected("Failed to load particle fragment shader: " + fragCode.error());
+    }
+    if (auto result = shader.add_stage(ShaderStage::Fragment, as_chars(fragCode.value())); !result.has_value()) {
+      return unexpected("Failed to load particle fragment shader: " + result.error());
+    }
+    auto vertShader = this->m_pipelineManager.register_shader(shader, ShaderStage::Vertex);
+    if (!vertShader.has_value()) {
+      return unexpected("Failed to register particle vertex shader: " + vertShader.error());
+    }
+    auto fragShader = this->m_pipelineManager.register_shader(shader, ShaderStage::Fragment);
+    if (!fragShader.has_value()) {
+      return unexpected("Failed to register particle fragment shader: " + fragShader.error());
+    }
+    // there is no depth buffer yet, particles draw straight onto the swap chain
+    return this->m_particles.init(
+      this->m_logicalDevice, this->m_physicalDevice, this->m_pipelineLayoutCache,
+      this->m_pipelineManager, updateCode.value(), vertShader.value(), fragShader.value(),
+      swapChainImageFormat, VK_FORMAT_UNDEFINED, maxParticles
+    );
+  }
+
   auto VulkanRenderer::getRequiredExtensions() -> vector<const char*> {
     uint32_t glfwExtensionCount = 0;
     const char** glfwExtensions =
@@ -856,6 +1190,9 @@ namespace SFT::Renderer::VK {
   }
 
   void VulkanRenderer::Shutdown() {
+    // waits for everything submitted, so nothing below is still in use
+    this->m_queueTimelines.destroy();
+    this->m_readback.destroy();
     for (auto framebuffer : this->m_swapChainFramebuffers)
     {
       vkDestroyFramebuffer(this->m_logicalDevice, framebuffer, nullptr);
@@ -865,6 +1202,19 @@ namespace SFT::Renderer::VK {
       vkDestroyImageView(this->m_logicalDevice, imageView, nullptr);
     }
     vkDestroySwapchainKHR(this->m_logicalDevice, this->m_swapChain, nullptr);
+    this->m_occlusionCuller.destroy();
+    this->m_particles.destroy();
+    this->m_clusteredLighting.destroy();
+    this->m_dynamicResolution.destroy();
+    this->m_temporalUpscaler.destroy();
+    this->m_pipelineManager.shutdown(pipelineCachePath, pipelineManifestPath);
+    this->m_pipelineLayoutCache.destroy();
+    this->m_renderGraph.destroy();
+    this->m_frameArenas.destroy();
+    this->m_uniformRing.destroy();
+    this->m_textureStreamer.shutdown();
+    this->m_geometryPool.destroy();
+    this->m_assets.close();
     vkDestroyDevice(this->m_logicalDevice, nullptr);
     if (enableValidationLayers)
     {
@@ -878,6 +1228,10 @@ namespace SFT::Renderer::VK {
   }
 
   auto VulkanRenderer::RenderFrame() -> expected<void, string> {
+    // captures whose copies finished get their callbacks here
+    this->m_readback.deliver(this->m_queueTimelines);
+    this->m_memoryTelemetry.update(this->m_frameNumber);
+    this->m_frameNumber++;
     return {};
   }
 
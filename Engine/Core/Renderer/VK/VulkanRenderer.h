@@ -6,17 +6,38 @@
 #define VULKAN_H
 
 #include "../Renderer.h"
+#include "Core/Assets/AssetArchive.h"
+#include "Capture/ImageReadback.h"
+#include "Core/Memory/FrameArenas.h"
+#include "Culling/OcclusionCuller.h"
+#include "Geometry/GeometryPool.h"
+#include "Lighting/ClusteredLighting.h"
+#include "Particles/ParticleSystem.h"
+#include "Pipeline/PipelineLayoutCache.h"
+#include "Pipeline/PipelineManager.h"
+#include "RenderGraph/RenderGraph.h"
+#include "Resolution/DynamicResolution.h"
+#include "Sync/QueueTimelines.h"
+#include "Textures/TextureStreamer.h"
+#include "Upscaling/TemporalUpscaler.h"
 #include "Core/Window/Window.h"
-#include <vulkan/vulkan.h>
+#include "Memory/MemoryTelemetry.h"
+#include "Memory/UniformRing.h"
+#include "Core/Renderer/VK/VulkanDispatch.h"
 #include <GLFW/glfw3.h>
+#include <algorithm>
+#include <cmath>
 #include <complex>
 #include <expected>
 #include <fstream>
 #include <iostream>
 #include <map>
+#include <memory_resource>
 #include <optional>
 #include <set>
+#include <span>
 #include <string>
+#include <string_view>
 #include <vector>
 
 
@@ -47,12 +68,36 @@ private:
     VkSurfaceKHR m_surface;
     Window::Window *m_window;
     VkQueue m_presentQueue;
+    QueueTimelines m_queueTimelines;
     VkSwapchainKHR m_swapChain;
     vector<VkImage> m_swapChainImages;
     VkFormat swapChainImageFormat;
     VkExtent2D swapChainExtent;
     vector<VkImageView> m_swapChainImageViews;
+    // whether swap chain images can be copied from, for captures
+    bool m_swapChainReadable = false;
+    // whether swap chain images can be blitted to, for upscaling
+    bool m_swapChainBlittable = false;
     vector<VkFramebuffer> m_swapChainFramebuffers;
+    PipelineLayoutCache m_pipelineLayoutCache;
+    VkPipelineLayout m_pipelineLayout = VK_NULL_HANDLE;
+    PipelineManager m_pipelineManager;
+    PipelineKey m_trianglePipelineKey;
+    RenderGraph m_renderGraph;
+    Memory::FrameArenas m_frameArenas;
+    UniformRing m_uniformRing;
+    OcclusionCuller m_occlusionCuller;
+    ParticleSystem m_particles;
+    ClusteredLighting m_clusteredLighting;
+    DynamicResolution m_dynamicResolution;
+    TemporalUpscaler m_temporalUpscaler;
+    bool m_hasMemoryBudget = false;
+    MemoryTelemetry m_memoryTelemetry;
+    ImageReadback m_readback;
+    uint64_t m_frameNumber = 0;
+    TextureStreamer m_textureStreamer;
+    GeometryPool m_geometryPool;
+    Assets::AssetArchive m_assets;
 #pragma endregion
 
 #pragma region Internal Functions
@@ -77,8 +122,14 @@ private:
       -> VkExtent2D;
   auto createSwapChain() -> expected<void, string>;
   auto createSwapChainImageViews() -> expected<void, string>;
-    auto createShaderModule(const std::vector<char>& code) -> expected<VkShaderModule, string>;
-    auto createGraphicsPipeline() -> expected<void, string>;
+  auto openAssetArchive() -> expected<void, string>;
+  auto createPipelineManager() -> expected<void, string>;
+  auto createGraphicsPipeline() -> expected<void, string>;
+  auto createOcclusionCuller() -> expected<void, string>;
+  auto createParticleSystem() -> expected<void, string>;
+  auto createClusteredLighting() -> expected<void, string>;
+  auto createDynamicResolution() -> void;
+  auto createTemporalUpscaler() -> expected<void, string>;
   auto createFramebuffers() -> void;
   auto getRequiredExtensions() -> vector<const char *>;
 #pragma endregion
@@ -92,6 +143,22 @@ public:
   auto Resize(int width, int height) -> expected<void, string> override;
   auto SetWindow(Window::Window *window) -> void override;
   auto getAPIName() -> string override;
+  /*!
+   * @brief The memory report RenderFrame sampled last, per heap budgets,
+   * device memory per category and the CPU allocator tags, returned by value
+   * so it can be read from any thread
+   */
+  [[nodiscard]] auto memory_report() const -> MemoryReport {
+    return this->m_memoryTelemetry.latest();
+  }
+  /*!
+   * @brief Copies rendered or offscreen images back to the CPU without
+   * stalling, see ImageReadback
+   */
+  [[nodiscard]] auto readback() -> ImageReadback & { return this->m_readback; }
+  [[nodiscard]] auto swap_chain_readable() const -> bool {
+    return this->m_swapChainReadable;
+  }
   static auto
   debugCallback(VkDebugUtilsMessageSeverityFlagBitsEXT messageSeverity,
                 VkDebugUtilsMessageTypeFlagsEXT messageType,
@@ -101,6 +168,10 @@ public:
 struct QueueFamilyIndices {
   optional<uint32_t> graphicsFamily;
   optional<uint32_t> presentFamily;
+  // families without graphics are preferred so async work overlaps, both
+  // fall back to the graphics family when the device has none
+  optional<uint32_t> computeFamily;
+  optional<uint32_t> transferFamily;
 
   auto isComplete() -> bool;
 };
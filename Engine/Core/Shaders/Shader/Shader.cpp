@@ -4,18 +4,149 @@
 
 #include "Shader.h"
 
+#include "Core/Utility/Utility.h"
+#include <algorithm>
+#include <bit>
+#include <cstring>
+
 namespace SFT::Shaders::Shader {
+namespace {
+constexpr uint32_t SpvMagicNumber = 0x07230203;
+constexpr uint32_t SpvHeaderWords = 5;
+constexpr uint32_t SpvOpDecorate = 71;
+constexpr uint32_t SpvDecorationSpecId = 1;
+
+using Utility::fnv1a;
+
+auto scan_specialization_ids(const std::span<const uint32_t> code)
+    -> vector<uint32_t> {
+  vector<uint32_t> ids;
+  for (size_t word = SpvHeaderWords; word < code.size();) {
+    const uint32_t wordCount = code[word] >> 16;
+    const uint32_t opcode = code[word] & 0xFFFF;
+    if (wordCount == 0 || word + wordCount > code.size()) {
+      break;
+    }
+    if (opcode == SpvOpDecorate && wordCount >= 4 &&
+        code[word + 2] == SpvDecorationSpecId) {
+      ids.push_back(code[word + 3]);
+    }
+    word += wordCount;
+  }
+  std::ranges::sort(ids);
+  return ids;
+}
+} // namespace
+
+auto hash_spirv(const std::span<const uint32_t> code) -> uint64_t {
+  return fnv1a(code.data(), code.size_bytes());
+}
+
+#pragma region ShaderPermutation Functions
+auto ShaderPermutation::set(const uint32_t id, const uint32_t value)
+    -> expected<void, string> {
+  const auto begin = this->m_constants.begin();
+  const auto end = begin + this->m_count;
+  auto it = std::lower_bound(begin, end, id,
+                             [](const SpecializationConstant &constant,
+                                const uint32_t key) { return constant.id < key; });
+  if (it != end && it->id == id) {
+    it->value = value;
+    return {};
+  }
+  if (this->m_count == MaxSpecializationConstants) {
+    return unexpected("too many specialization constants in one permutation");
+  }
+  std::move_backward(it, end, end + 1);
+  *it = {id, value};
+  this->m_count++;
+  return {};
+}
+
+auto ShaderPermutation::set_bool(const uint32_t id, const bool value)
+    -> expected<void, string> {
+  return this->set(id, value ? 1u : 0u);
+}
+
+auto ShaderPermutation::set_float(const uint32_t id, const float value)
+    -> expected<void, string> {
+  return this->set(id, std::bit_cast<uint32_t>(value));
+}
+
+auto ShaderPermutation::constants() const
+    -> std::span<const SpecializationConstant> {
+  return {this->m_constants.data(), this->m_count};
+}
 
+auto ShaderPermutation::empty() const -> bool { return this->m_count == 0; }
+
+auto ShaderPermutation::hash() const -> uint64_t {
+  return fnv1a(this->m_constants.data(),
+               this->m_count * sizeof(SpecializationConstant));
+}
+
+auto ShaderPermutation::operator==(const ShaderPermutation &other) const
+    -> bool {
+  return std::ranges::equal(this->constants(), other.constants());
+}
+#pragma endregion
+
+#pragma region Shader Functions
 Shader::Shader() {}
 
 Shader::~Shader() {}
 
-auto Shader::add_stage(const string &stage_name, const char *stage_code)
-    -> void {
-  this->shader_stages[stage_name] = stage_code;
+auto Shader::add_stage(const ShaderStage stage, vector<uint32_t> code)
+    -> expected<void, string> {
+  if (stage == ShaderStage::Count) {
+    return unexpected("invalid shader stage");
+  }
+  if (code.size() < SpvHeaderWords || code[0] != SpvMagicNumber) {
+    return unexpected("stage code is not a SPIR-V module");
+  }
+  const auto index = static_cast<size_t>(stage);
+  this->m_stageHashes[index] = hash_spirv(code);
+  this->m_specializationIds[index] = scan_specialization_ids(code);
+  this->m_stages[index] = std::move(code);
+  return {};
+}
+
+auto Shader::add_stage(const ShaderStage stage,
+                       const std::span<const char> bytes)
+    -> expected<void, string> {
+  if (bytes.size() % sizeof(uint32_t) != 0) {
+    return unexpected("SPIR-V size is not a multiple of 4 bytes");
+  }
+  vector<uint32_t> code(bytes.size() / sizeof(uint32_t));
+  std::memcpy(code.data(), bytes.data(), bytes.size());
+  return this->add_stage(stage, std::move(code));
+}
+
+auto Shader::get_stage(const ShaderStage stage) const
+    -> std::span<const uint32_t> {
+  if (stage == ShaderStage::Count) {
+    return {};
+  }
+  return this->m_stages[static_cast<size_t>(stage)];
+}
+
+auto Shader::has_stage(const ShaderStage stage) const -> bool {
+  return !this->get_stage(stage).empty();
+}
+
+auto Shader::stage_hash(const ShaderStage stage) const -> uint64_t {
+  if (stage == ShaderStage::Count) {
+    return 0;
+  }
+  return this->m_stageHashes[static_cast<size_t>(stage)];
 }
 
-auto Shader::get_stage(const string &stage_name) -> const char * {
-  return this->shader_stages[stage_name];
+auto Shader::specialization_ids(const ShaderStage stage) const
+    -> std::span<const uint32_t> {
+  if (stage == ShaderStage::Count) {
+    return {};
+  }
+  return this->m_specializationIds[static_cast<size_t>(stage)];
 }
-} // namespace SFT::Shaders::Shader
\ No newline at end of file
+#pragma endregion
+} // namespace SFT::Shaders::Shader
@@ -4,23 +4,139 @@
 
 #ifndef SHADER_H
 #define SHADER_H
-#include <map>
+#include <array>
+#include <cstdint>
+#include <expected>
+#include <span>
 #include <string>
+#include <vector>
 
-using std::map;
+using std::expected;
 using std::string;
+using std::unexpected;
+using std::vector;
 
 namespace SFT::Shaders::Shader {
 
+/*!
+ * @brief The pipeline stages a shader can provide code for, this is an index
+ * into a fixed array rather than a map key so lookups are free
+ */
+enum class ShaderStage : uint8_t {
+  Vertex,
+  TessellationControl,
+  TessellationEvaluation,
+  Geometry,
+  Fragment,
+  Compute,
+  Count,
+};
+constexpr size_t ShaderStageCount = static_cast<size_t>(ShaderStage::Count);
+constexpr uint32_t MaxSpecializationConstants = 16;
+
+/*!
+ * @brief Hashes SPIR-V words, used as the identity of a shader stage
+ * @param code the SPIR-V words
+ * @return the 64 bit FNV-1a hash of the code
+ */
+auto hash_spirv(std::span<const uint32_t> code) -> uint64_t;
+
+/*!
+ * @brief A specialization constant override, every value is 32 bits wide,
+ * bools are 0 or 1 and floats are stored by their bit pattern
+ */
+struct SpecializationConstant {
+  uint32_t id = 0;
+  uint32_t value = 0;
+
+  auto operator==(const SpecializationConstant &) const -> bool = default;
+};
+
+/*!
+ * @brief A feature variant of a shader expressed as specialization constant
+ * overrides, the variant is generated by the driver when the pipeline is
+ * created so we ship one binary instead of one per combination of features,
+ * it is fixed size and trivially copyable so it can live inside pipeline keys
+ */
+class ShaderPermutation {
+private:
+  std::array<SpecializationConstant, MaxSpecializationConstants> m_constants{};
+  uint32_t m_count = 0;
+
+public:
+  /*!
+   * @brief Overrides a specialization constant, constants stay sorted by id
+   * so equal permutations compare and hash equal regardless of set order
+   * @param id the constant_id declared in the shader
+   * @param value the raw 32 bit value
+   * @return On success, returns void, on failure (more than
+   * MaxSpecializationConstants constants), returns unexpected with error message
+   */
+  auto set(uint32_t id, uint32_t value) -> expected<void, string>;
+  auto set_bool(uint32_t id, bool value) -> expected<void, string>;
+  auto set_float(uint32_t id, float value) -> expected<void, string>;
+  [[nodiscard]] auto constants() const
+      -> std::span<const SpecializationConstant>;
+  [[nodiscard]] auto empty() const -> bool;
+  [[nodiscard]] auto hash() const -> uint64_t;
+
+  auto operator==(const ShaderPermutation &other) const -> bool;
+};
+
+/*!
+ * @brief Owns the SPIR-V of every stage of a shader, along with a content hash
+ * per stage computed once when a stage is added
+ */
 class Shader {
 private:
-  map<string, const char *> shader_stages;
+  std::array<vector<uint32_t>, ShaderStageCount> m_stages;
+  std::array<uint64_t, ShaderStageCount> m_stageHashes{};
+  std::array<vector<uint32_t>, ShaderStageCount> m_specializationIds;
 
 public:
   Shader();
   ~Shader();
-  auto add_stage(const string &stage_name, const char *stage_code) -> void;
-  auto get_stage(const string &stage_name) -> const char *;
+  /*!
+   * @brief Takes ownership of the SPIR-V of a stage, replacing any code the
+   * stage had before
+   * @param stage the stage the code is for
+   * @param code the SPIR-V words
+   * @return On success, returns void, on failure (the code isn't SPIR-V),
+   * returns unexpected with error message
+   */
+  auto add_stage(ShaderStage stage, vector<uint32_t> code)
+      -> expected<void, string>;
+  /*!
+   * @brief Copies the SPIR-V of a stage out of a byte buffer, such as a file
+   * that was read from disk
+   * @param stage the stage the code is for
+   * @param bytes the SPIR-V module, its size must be a multiple of 4
+   * @return On success, returns void, on failure, returns unexpected with
+   * error message
+   */
+  auto add_stage(ShaderStage stage, std::span<const char> bytes)
+      -> expected<void, string>;
+  /*!
+   * @brief Gets the SPIR-V of a stage
+   * @param stage the stage to get
+   * @return the SPIR-V words, empty if the shader has no such stage
+   */
+  [[nodiscard]] auto get_stage(ShaderStage stage) const
+      -> std::span<const uint32_t>;
+  [[nodiscard]] auto has_stage(ShaderStage stage) const -> bool;
+  /*!
+   * @brief Gets the content hash of a stage
+   * @param stage the stage to get the hash of
+   * @return the hash, 0 if the shader has no such stage
+   */
+  [[nodiscard]] auto stage_hash(ShaderStage stage) const -> uint64_t;
+  /*!
+   * @brief Gets the specialization constant ids a stage declares
+   * @param stage the stage to inspect
+   * @return the SpecId decorations of the stage, sorted
+   */
+  [[nodiscard]] auto specialization_ids(ShaderStage stage) const
+      -> std::span<const uint32_t>;
 };
 
 } // namespace SFT::Shaders::Shader
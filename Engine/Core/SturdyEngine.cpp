@@ -1,26 +1,83 @@
 
 #include "SturdyEngine.h"
+#include "Memory/MemoryStats.h"
 #include "Renderer/VK/VulkanRenderer.h"
 #include "Window/GLFW/GLFWWindowWrapped.h"
 #include "spdlog/spdlog.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
 
 namespace SFT {
+namespace {
+constexpr uint32_t audioSampleRate = 48000;
+constexpr uint32_t maxAudioVoices = 256;
+// 4 blocks of 1024 frames is about 85ms of queued audio
+constexpr uint32_t audioBlockFrames = 1024;
+constexpr uint32_t audioBufferCount = 4;
+// the main thread pumps window events this often, independent of rendering
+constexpr std::chrono::microseconds inputPollInterval{1000};
+// fixed simulation rate, each step drains the input ring
+constexpr std::chrono::nanoseconds updateInterval{1'000'000'000 / 120};
+} // namespace
+
 SturdyEngine::SturdyEngine() {}
 
 void SturdyEngine::main_loop() {
-  while (!this->window->should_close()) {
+  // GLFW only pumps events on the main thread, so rendering gets a thread of
+  // its own and a slow frame no longer delays input or the simulation
+  std::atomic<bool> renderFailed = false;
+  std::jthread renderThread(
+      [this, &renderFailed](const std::stop_token &stop) {
+        while (!stop.stop_requested()) {
+          if (auto result = this->renderer->RenderFrame();
+              !result.has_value()) {
+            spdlog::error("Failed to render frame: {}", result.error());
+            renderFailed.store(true, std::memory_order_release);
+            return;
+          }
+        }
+      });
+  auto nextUpdate = std::chrono::steady_clock::now();
+  while (!this->window->should_close() &&
+         !renderFailed.load(std::memory_order_acquire)) {
     this->window->ProcessEvents();
-    if (std::expected<void, std::string> result = this->renderer->RenderFrame();
-        (!result.has_value()))
-      break;
+    const auto now = std::chrono::steady_clock::now();
+    if (now >= nextUpdate) {
+      this->update();
+      // steps missed while the thread was held up are skipped, not replayed
+      nextUpdate = std::max(nextUpdate + updateInterval, now);
+    }
+    std::this_thread::sleep_until(
+        std::min(nextUpdate, now + inputPollInterval));
+  }
+  // joins before the renderer is shut down
+  renderThread.request_stop();
+}
+
+void SturdyEngine::update() {
+  // drained every step, so the ring only has to hold one step's events
+  this->inputEvents.resize(Window::Window::InputQueueSize);
+  this->inputEvents.resize(this->window->drain_input(this->inputEvents));
+  if (!this->inputEvents.empty()) {
+    this->inputLatencyNs =
+        Window::input_clock_ns() - this->inputEvents.front().timestampNs;
   }
 }
 
 SturdyEngine::~SturdyEngine() {
-  this->renderer->Shutdown();
-  delete this->renderer;
-  this->window->Destroy();
-  delete this->window;
+  this->audioOutput.shutdown();
+  this->audioMixer.shutdown();
+  if (this->renderer) {
+    this->renderer->Shutdown();
+    this->renderer.reset();
+  }
+  if (this->window) {
+    this->window->Destroy();
+    this->window.reset();
+  }
+  Memory::log_memory_stats();
 }
 
 void SturdyEngine::run() {
@@ -31,7 +88,7 @@ void SturdyEngine::run() {
   spdlog::set_level(spdlog::level::debug);
 #endif
   spdlog::set_pattern("%^[%l]%$: %v");
-  this->window = new Window::GLFW::GLFWWindowWrapped();
+  this->window = std::make_unique<Window::GLFW::GLFWWindowWrapped>();
   auto result = this->window->Create(800, 600, "deez nuts");
   if (!result.has_value()) {
     throw std::runtime_error("Failed to initialize window: " + result.error());
@@ -41,12 +98,22 @@ void SturdyEngine::run() {
       throw std::runtime_error("Failed to set background blur: " +
   result.error());
   }*/
-  this->renderer = new Renderer::VK::VulkanRenderer();
-  this->renderer->SetWindow(this->window);
+  this->renderer = std::make_unique<Renderer::VK::VulkanRenderer>();
+  this->renderer->SetWindow(this->window.get());
   if (result = this->renderer->Initialize(); !result.has_value()) {
     throw std::runtime_error("Failed to initialize renderer: " +
                              result.error());
   }
+  // the game runs fine without sound, so audio failing is only worth a warning
+  if (result = this->audioMixer.init(audioSampleRate, maxAudioVoices);
+      !result.has_value()) {
+    spdlog::warn("Failed to initialize audio mixer: {}", result.error());
+  } else if (result = this->audioOutput.init(this->audioMixer, nullptr,
+                                             audioBlockFrames,
+                                             audioBufferCount);
+             !result.has_value()) {
+    spdlog::warn("Failed to open audio output: {}", result.error());
+  }
   this->main_loop();
 }
 } // namespace SFT
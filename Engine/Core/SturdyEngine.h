@@ -6,8 +6,13 @@
 #define Ok(value) std::expected::expected(value);
 #define Err(value) std::unexpected(value);
 
+#include "Audio/AudioMixer.h"
+#include "Audio/OpenALOutput.h"
 #include "Renderer/Renderer.h"
 #include "Window/Window.h"
+#include <cstdint>
+#include <memory>
+#include <vector>
 
 namespace SFT {
 class SturdyEngine {
@@ -16,9 +21,21 @@ private:
   // base class, this also means we cannot default since the default is just a
   // spec of a general renderer and won't work
   //  ReSharper disable once CppUninitializedNonStaticDataMember
-  Window::Window *window;
-  Renderer::Renderer *renderer;
+  std::unique_ptr<Window::Window> window;
+  std::unique_ptr<Renderer::Renderer> renderer;
+  // the output pulls from the mixer, so it's declared after it and goes first
+  Audio::AudioMixer audioMixer;
+  Audio::OpenALOutput audioOutput;
+  // the input drained by the latest update, what simulation code reads
+  std::vector<Window::InputEvent> inputEvents;
+  // how long the oldest event of the latest update waited in the ring
+  uint64_t inputLatencyNs = 0;
   void main_loop();
+  /*!
+   * @brief One simulation step, runs at a fixed rate on the main thread
+   * whatever the render rate is, and drains the window's input ring
+   */
+  void update();
 
 public:
   SturdyEngine();
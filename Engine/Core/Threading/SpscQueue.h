@@ -0,0 +1,131 @@
+//
+// Created by sturd on 10/18/2026.
+//
+
+#ifndef SPSCQUEUE_H
+#define SPSCQUEUE_H
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+namespace SFT::Threading {
+// fixed rather than std::hardware_destructive_interference_size, which can
+// differ between translation units built with different flags
+constexpr size_t CacheLineSize = 64;
+
+/*!
+ * @brief A bounded lock free queue for exactly one producer thread and one
+ * consumer thread, neither side ever blocks or allocates after construction,
+ * which makes it safe to use from audio and input threads
+ */
+template <typename T> class SpscQueue {
+  static_assert(std::is_nothrow_move_assignable_v<T>);
+
+private:
+  std::vector<T> m_items;
+  size_t m_mask = 0;
+  // each index is only written by one side, kept on separate cache lines so
+  // the two threads don't fight over them
+  alignas(CacheLineSize) std::atomic<size_t> m_head = 0;
+  alignas(CacheLineSize) size_t m_cachedTail = 0;
+  alignas(CacheLineSize) std::atomic<size_t> m_tail = 0;
+  alignas(CacheLineSize) size_t m_cachedHead = 0;
+
+public:
+  /*!
+   * @brief Allocates the queue
+   * @param capacity how many items fit, rounded up to a power of two
+   */
+  explicit SpscQueue(const size_t capacity)
+      : m_items(std::bit_ceil(std::max<size_t>(capacity, 2))),
+        m_mask(m_items.size() - 1) {}
+  SpscQueue(const SpscQueue &) = delete;
+  auto operator=(const SpscQueue &) -> SpscQueue & = delete;
+
+  /*!
+   * @brief Producer side, adds an item
+   * @param item the item
+   * @return false if the queue is full, the item is left untouched then
+   */
+  auto try_push(T &&item) -> bool {
+    const size_t tail = this->m_tail.load(std::memory_order_relaxed);
+    if (tail - this->m_cachedHead > this->m_mask) {
+      this->m_cachedHead = this->m_head.load(std::memory_order_acquire);
+      if (tail - this->m_cachedHead > this->m_mask) {
+        return false;
+      }
+    }
+    this->m_items[tail & this->m_mask] = std::move(item);
+    this->m_tail.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+  auto try_push(const T &item) -> bool { return this->try_push(T(item)); }
+  /*!
+   * @brief Producer side, adds as many items as fit
+   * @param items the items to copy in
+   * @return how many were added
+   */
+  auto push(std::span<const T> items) -> size_t {
+    const size_t tail = this->m_tail.load(std::memory_order_relaxed);
+    this->m_cachedHead = this->m_head.load(std::memory_order_acquire);
+    const size_t count = std::min(
+        items.size(), this->m_items.size() - (tail - this->m_cachedHead));
+    for (size_t i = 0; i < count; i++) {
+      this->m_items[(tail + i) & this->m_mask] = items[i];
+    }
+    this->m_tail.store(tail + count, std::memory_order_release);
+    return count;
+  }
+  /*!
+   * @brief Consumer side, takes the oldest item
+   * @param item receives the item
+   * @return false if the queue is empty
+   */
+  auto try_pop(T &item) -> bool {
+    const size_t head = this->m_head.load(std::memory_order_relaxed);
+    if (head == this->m_cachedTail) {
+      this->m_cachedTail = this->m_tail.load(std::memory_order_acquire);
+      if (head == this->m_cachedTail) {
+        return false;
+      }
+    }
+    item = std::move(this->m_items[head & this->m_mask]);
+    this->m_head.store(head + 1, std::memory_order_release);
+    return true;
+  }
+  /*!
+   * @brief Consumer side, takes as many items as are queued and fit
+   * @param items receives the items, oldest first
+   * @return how many were taken
+   */
+  auto pop(std::span<T> items) -> size_t {
+    const size_t head = this->m_head.load(std::memory_order_relaxed);
+    this->m_cachedTail = this->m_tail.load(std::memory_order_acquire);
+    const size_t count = std::min(items.size(), this->m_cachedTail - head);
+    for (size_t i = 0; i < count; i++) {
+      items[i] = std::move(this->m_items[(head + i) & this->m_mask]);
+    }
+    this->m_head.store(head + count, std::memory_order_release);
+    return count;
+  }
+  /*!
+   * @brief How many items are queued, a lower bound on the consumer side
+   * since the producer may add more, an upper bound on the producer side
+   * since the consumer may take some, only an estimate anywhere else
+   */
+  [[nodiscard]] auto size() const -> size_t {
+    // head first, the tail can only have moved further by the time it's read
+    const size_t head = this->m_head.load(std::memory_order_acquire);
+    return this->m_tail.load(std::memory_order_acquire) - head;
+  }
+  [[nodiscard]] auto capacity() const -> size_t { return this->m_items.size(); }
+};
+} // namespace SFT::Threading
+
+#endif // SPSCQUEUE_H
@@ -0,0 +1,101 @@
+//
+// Created by sturd on 10/18/2026.
+//
+
+#include "ThreadPool.h"
+
+#include <algorithm>
+#include <latch>
+
+namespace SFT::Threading {
+ThreadPool::ThreadPool(uint32_t threadCount) {
+  if (threadCount == 0) {
+    threadCount = std::max(1u, std::thread::hardware_concurrency());
+  }
+  this->m_workers.reserve(threadCount);
+  for (uint32_t i = 0; i < threadCount; i++) {
+    this->m_workers.emplace_back([this] { this->worker_loop(); });
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard lock(this->m_mutex);
+    this->m_stopping = true;
+  }
+  this->m_jobAvailable.notify_all();
+  // jthread joins on destruction
+  this->m_workers.clear();
+}
+
+auto ThreadPool::worker_loop() -> void {
+  while (true) {
+    std::function<void()> job;
+    {
+      std::unique_lock lock(this->m_mutex);
+      this->m_jobAvailable.wait(lock, [this] {
+        return this->m_stopping || !this->m_jobs.empty();
+      });
+      if (this->m_jobs.empty()) {
+        // only reachable when stopping, the queue is drained first
+        return;
+      }
+      job = std::move(this->m_jobs.front());
+      this->m_jobs.pop_front();
+      this->m_activeJobs++;
+    }
+    job();
+    {
+      std::lock_guard lock(this->m_mutex);
+      this->m_activeJobs--;
+      if (this->m_activeJobs == 0 && this->m_jobs.empty()) {
+        this->m_idle.notify_all();
+      }
+    }
+  }
+}
+
+auto ThreadPool::submit(std::function<void()> job) -> void {
+  {
+    std::lock_guard lock(this->m_mutex);
+    this->m_jobs.push_back(std::move(job));
+  }
+  this->m_jobAvailable.notify_one();
+}
+
+auto ThreadPool::wait_idle() -> void {
+  std::unique_lock lock(this->m_mutex);
+  this->m_idle.wait(lock, [this] {
+    return this->m_activeJobs == 0 && this->m_jobs.empty();
+  });
+}
+
+auto ThreadPool::parallel_for(const size_t count,
+                              const std::function<void(size_t, size_t)> &job)
+    -> void {
+  if (count == 0) {
+    return;
+  }
+  // the calling thread takes a chunk too instead of sitting idle
+  const size_t chunks =
+      std::min(count, static_cast<size_t>(this->thread_count()) + 1);
+  const size_t chunkSize = (count + chunks - 1) / chunks;
+  const size_t jobCount = (count + chunkSize - 1) / chunkSize;
+  std::latch done(static_cast<std::ptrdiff_t>(jobCount));
+  for (size_t chunk = 1; chunk < jobCount; chunk++) {
+    const size_t begin = chunk * chunkSize;
+    const size_t end = std::min(count, begin + chunkSize);
+    this->submit([&job, &done, begin, end] {
+      job(begin, end);
+      done.count_down();
+    });
+  }
+  job(0, std::min(count, chunkSize));
+  done.count_down();
+  done.wait();
+}
+
+auto ThreadPool::thread_count() const -> uint32_t {
+  return static_cast<uint32_t>(this->m_workers.size());
+}
+} // namespace SFT::Threading
@@ -0,0 +1,69 @@
+//
+// Created by sturd on 10/18/2026.
+//
+
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using std::vector;
+
+namespace SFT::Threading {
+/*!
+ * @brief A plain FIFO pool of worker threads, jobs are type erased callables
+ * that run to completion on whichever worker picks them up first
+ */
+class ThreadPool {
+private:
+  vector<std::jthread> m_workers;
+  std::deque<std::function<void()>> m_jobs;
+  std::mutex m_mutex;
+  std::condition_variable m_jobAvailable;
+  std::condition_variable m_idle;
+  uint32_t m_activeJobs = 0;
+  bool m_stopping = false;
+
+  auto worker_loop() -> void;
+
+public:
+  /*!
+   * @brief Spawns the workers
+   * @param threadCount the number of workers, 0 means one per hardware thread
+   */
+  explicit ThreadPool(uint32_t threadCount = 0);
+  /*!
+   * @brief Finishes every queued job, then joins the workers
+   */
+  ~ThreadPool();
+  ThreadPool(const ThreadPool &) = delete;
+  auto operator=(const ThreadPool &) -> ThreadPool & = delete;
+
+  /*!
+   * @brief Queues a job to run on a worker thread
+   * @param job the job to run
+   */
+  auto submit(std::function<void()> job) -> void;
+  /*!
+   * @brief Blocks until the queue is empty and no job is running
+   */
+  auto wait_idle() -> void;
+  /*!
+   * @brief Splits [0, count) into roughly equal chunks, runs them on the pool
+   * (and the calling thread) and returns once all of them are done
+   * @param count the number of items
+   * @param job called once per chunk with the chunk's [begin, end) range
+   */
+  auto parallel_for(size_t count,
+                    const std::function<void(size_t, size_t)> &job) -> void;
+  [[nodiscard]] auto thread_count() const -> uint32_t;
+};
+} // namespace SFT::Threading
+
+#endif // THREADPOOL_H
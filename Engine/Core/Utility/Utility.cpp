@@ -0,0 +1,44 @@
+//
+// Created by sturd on 10/18/2026.
+//
+
+#include "Utility.h"
+
+#include <fstream>
+
+namespace SFT::Utility {
+#pragma region Utility Functions
+auto read_file(const std::filesystem::path &path)
+    -> expected<vector<uint8_t>, string> {
+  std::ifstream file(path, std::ios::binary | std::ios::ate);
+  if (!file.is_open()) {
+    return unexpected("failed to open " + path.string());
+  }
+  const auto size = static_cast<size_t>(file.tellg());
+  vector<uint8_t> bytes(size);
+  file.seekg(0);
+  if (!file.read(reinterpret_cast<char *>(bytes.data()),
+                 static_cast<std::streamsize>(size))) {
+    return unexpected("failed to read " + path.string());
+  }
+  return bytes;
+}
+
+auto read_file_range(const std::filesystem::path &path, const uint64_t offset,
+                     const std::span<std::byte> out)
+    -> expected<void, string> {
+  std::ifstream file(path, std::ios::binary);
+  if (!file.is_open()) {
+    return unexpected("failed to open " + path.string());
+  }
+  file.seekg(static_cast<std::streamoff>(offset));
+  if (!file.read(reinterpret_cast<char *>(out.data()),
+                 static_cast<std::streamsize>(out.size()))) {
+    return unexpected("failed to read " + std::to_string(out.size()) +
+                      " bytes at " + std::to_string(offset) + " of " +
+                      path.string());
+  }
+  return {};
+}
+#pragma endregion
+} // namespace SFT::Utility
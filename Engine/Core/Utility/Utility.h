@@ -0,0 +1,74 @@
+//
+// Created by sturd on 10/18/2026.
+//
+
+#ifndef UTILITY_H
+#define UTILITY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <filesystem>
+#include <span>
+#include <string>
+#include <vector>
+
+using std::expected;
+using std::string;
+using std::unexpected;
+using std::vector;
+
+namespace SFT::Utility {
+/*!
+ * @brief Hashes bytes with 64 bit FNV-1a, cheap and stable across platforms
+ * and runs, so hashes can be written to disk and compared on the next launch
+ * @param data the bytes to hash
+ * @param size how many bytes to hash
+ * @param hash the hash to continue from, chains several buffers into one hash
+ * @return the hash of the bytes
+ */
+inline auto fnv1a(const void *data, const size_t size,
+                  uint64_t hash = 0xcbf29ce484222325ULL) -> uint64_t {
+  const auto *bytes = static_cast<const uint8_t *>(data);
+  for (size_t i = 0; i < size; i++) {
+    hash ^= bytes[i];
+    hash *= 0x100000001b3ULL;
+  }
+  return hash;
+}
+
+/*!
+ * @brief Mixes a value into a running hash, boost's hash_combine, cheap and
+ * good enough for small in-memory keys but not stable enough to write to disk
+ * @param seed the hash so far
+ * @param value the value to mix in
+ * @return the combined hash
+ */
+inline auto hash_combine(uint64_t seed, const uint64_t value) -> uint64_t {
+  seed ^= value + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2);
+  return seed;
+}
+
+/*!
+ * @brief Reads a whole file into memory
+ * @param path the file to read
+ * @return On success, returns the contents of the file, on failure, returns
+ * unexpected with error message
+ */
+auto read_file(const std::filesystem::path &path)
+    -> expected<vector<uint8_t>, string>;
+
+/*!
+ * @brief Reads part of a file straight into memory the caller owns, for
+ * formats that keep their payloads at known offsets
+ * @param path the file to read
+ * @param offset where in the file the bytes start
+ * @param out where the bytes go, the whole span is filled
+ * @return On success, returns void, on failure (including a file too short to
+ * fill out), returns unexpected with error message
+ */
+auto read_file_range(const std::filesystem::path &path, uint64_t offset,
+                     std::span<std::byte> out) -> expected<void, string>;
+} // namespace SFT::Utility
+
+#endif // UTILITY_H
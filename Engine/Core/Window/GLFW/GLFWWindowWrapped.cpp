@@ -41,6 +41,16 @@ auto GLFWWindowWrapped::Create(const int width, const int height,
   if (!this->m_window) {
     return std::unexpected("Failed to create window");
   }
+  // the callbacks run inside glfwPollEvents and only stamp and queue events,
+  // so ProcessEvents stays cheap enough to call more often than once a frame
+  glfwSetWindowUserPointer(this->m_window, this);
+  glfwSetKeyCallback(this->m_window, on_key);
+  glfwSetCharCallback(this->m_window, on_char);
+  glfwSetMouseButtonCallback(this->m_window, on_mouse_button);
+  glfwSetCursorPosCallback(this->m_window, on_cursor_pos);
+  glfwSetScrollCallback(this->m_window, on_scroll);
+  glfwSetWindowFocusCallback(this->m_window, on_focus);
+  glfwSetFramebufferSizeCallback(this->m_window, on_framebuffer_size);
   return {};
 }
 /*!
@@ -92,9 +102,79 @@ auto GLFWWindowWrapped::GetNativeWindowHandle()
 #endif
 }
 /*!
- * @brief Processes events for the window
+ * @brief Processes events for the window, input is queued for drain_input
  */
 auto GLFWWindowWrapped::ProcessEvents() -> void { glfwPollEvents(); }
+auto GLFWWindowWrapped::from(GLFWwindow *window) -> GLFWWindowWrapped * {
+  return static_cast<GLFWWindowWrapped *>(glfwGetWindowUserPointer(window));
+}
+auto GLFWWindowWrapped::on_key(GLFWwindow *window, const int key,
+                               const int scancode, const int action,
+                               const int mods) -> void {
+  InputEvent event;
+  event.type = InputEventType::Key;
+  event.action = static_cast<InputAction>(action);
+  event.mods = static_cast<uint16_t>(mods);
+  event.code = key;
+  event.scancode = scancode;
+  event.timestampNs = input_clock_ns();
+  from(window)->push_input(event);
+}
+auto GLFWWindowWrapped::on_char(GLFWwindow *window,
+                                const unsigned int codepoint) -> void {
+  InputEvent event;
+  event.type = InputEventType::Char;
+  event.code = static_cast<int32_t>(codepoint);
+  event.timestampNs = input_clock_ns();
+  from(window)->push_input(event);
+}
+auto GLFWWindowWrapped::on_mouse_button(GLFWwindow *window, const int button,
+                                        const int action, const int mods)
+    -> void {
+  InputEvent event;
+  event.type = InputEventType::MouseButton;
+  event.action = static_cast<InputAction>(action);
+  event.mods = static_cast<uint16_t>(mods);
+  event.code = button;
+  event.timestampNs = input_clock_ns();
+  from(window)->push_input(event);
+}
+auto GLFWWindowWrapped::on_cursor_pos(GLFWwindow *window, const double x,
+                                      const double y) -> void {
+  InputEvent event;
+  event.type = InputEventType::MouseMove;
+  event.x = x;
+  event.y = y;
+  event.timestampNs = input_clock_ns();
+  from(window)->push_input(event);
+}
+auto GLFWWindowWrapped::on_scroll(GLFWwindow *window, const double x,
+                                  const double y) -> void {
+  InputEvent event;
+  event.type = InputEventType::Scroll;
+  event.x = x;
+  event.y = y;
+  event.timestampNs = input_clock_ns();
+  from(window)->push_input(event);
+}
+auto GLFWWindowWrapped::on_focus(GLFWwindow *window, const int focused)
+    -> void {
+  InputEvent event;
+  event.type = InputEventType::Focus;
+  event.x = focused == GLFW_TRUE ? 1.0 : 0.0;
+  event.timestampNs = input_clock_ns();
+  from(window)->push_input(event);
+}
+auto GLFWWindowWrapped::on_framebuffer_size(GLFWwindow *window,
+                                            const int width, const int height)
+    -> void {
+  InputEvent event;
+  event.type = InputEventType::Resize;
+  event.x = width;
+  event.y = height;
+  event.timestampNs = input_clock_ns();
+  from(window)->push_input(event);
+}
 /*!
  * @brief Checks if the window should close
  * @return true if the window should close, false otherwise
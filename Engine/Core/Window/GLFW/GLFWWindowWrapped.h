@@ -65,6 +65,18 @@ class GLFWWindowWrapped : public Window {
 private:
   GLFWwindow *m_window;
 
+  static auto from(GLFWwindow *window) -> GLFWWindowWrapped *;
+  static auto on_key(GLFWwindow *window, int key, int scancode, int action,
+                     int mods) -> void;
+  static auto on_char(GLFWwindow *window, unsigned int codepoint) -> void;
+  static auto on_mouse_button(GLFWwindow *window, int button, int action,
+                              int mods) -> void;
+  static auto on_cursor_pos(GLFWwindow *window, double x, double y) -> void;
+  static auto on_scroll(GLFWwindow *window, double x, double y) -> void;
+  static auto on_focus(GLFWwindow *window, int focused) -> void;
+  static auto on_framebuffer_size(GLFWwindow *window, int width, int height)
+      -> void;
+
 public:
   ~GLFWWindowWrapped() override { assert(glfwInit() == GLFW_TRUE); };
   auto Create(int width, int height, const string &title, bool use_transparency)
@@ -0,0 +1,62 @@
+//
+// Created by sturd on 10/18/2026.
+//
+
+#ifndef INPUTEVENT_H
+#define INPUTEVENT_H
+
+#include <chrono>
+#include <cstdint>
+
+namespace SFT::Window {
+enum class InputEventType : uint8_t {
+  Key,
+  Char,
+  MouseButton,
+  MouseMove,
+  Scroll,
+  Focus,
+  Resize,
+};
+
+enum class InputAction : uint8_t {
+  Release,
+  Press,
+  Repeat,
+};
+
+/*!
+ * @brief One input event, key and button codes and modifier bits use GLFW's
+ * values (GLFW_KEY_*, GLFW_MOUSE_BUTTON_*, GLFW_MOD_*), other window backends
+ * translate to them
+ */
+struct InputEvent {
+  InputEventType type = InputEventType::Key;
+  InputAction action = InputAction::Press;
+  // GLFW_MOD_* bits held when the event happened
+  uint16_t mods = 0;
+  // key or mouse button code, or the codepoint of a Char event
+  int32_t code = 0;
+  int32_t scancode = 0;
+  // cursor position, scroll offset or new framebuffer size, focus events
+  // have x = 1 when focus was gained
+  double x = 0.0;
+  double y = 0.0;
+  // input_clock_ns when the window received the event
+  uint64_t timestampNs = 0;
+};
+
+/*!
+ * @brief The clock input events are stamped with, compare against it to
+ * measure how long an event took to be handled
+ * @return nanoseconds on the steady clock
+ */
+inline auto input_clock_ns() -> uint64_t {
+  return static_cast<uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::steady_clock::now().time_since_epoch())
+          .count());
+}
+} // namespace SFT::Window
+
+#endif // INPUTEVENT_H
@@ -4,7 +4,11 @@
 
 #ifndef WINDOW_H
 #define WINDOW_H
+#include "Core/Threading/SpscQueue.h"
+#include "InputEvent.h"
+#include <atomic>
 #include <expected>
+#include <span>
 #include <string>
 
 using std::expected;
@@ -36,7 +40,29 @@ namespace SFT::Window {
  * ways to figure out which subclass is used, see the getAPIName function
  */
 class Window {
+private:
+  // filled by ProcessEvents, drained by whichever single thread consumes
+  // input (SturdyEngine::update), so input is handled at the simulation's rate
+  // rather than once per rendered frame, events pushed while it is full are
+  // counted and dropped
+  Threading::SpscQueue<InputEvent> m_inputEvents{InputQueueSize};
+  std::atomic<uint64_t> m_droppedInputEvents = 0;
+
+protected:
+  /*!
+   * @brief Queues an event for the input consumer, for backends to call from
+   * the thread that runs ProcessEvents
+   * @param event the event, stamped with input_clock_ns when it was received
+   */
+  auto push_input(const InputEvent &event) -> void {
+    if (!this->m_inputEvents.try_push(event)) {
+      this->m_droppedInputEvents.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+
 public:
+  static constexpr size_t InputQueueSize = 1024;
+
   virtual ~Window() {};
   /*!
    *
@@ -80,6 +106,21 @@ public:
    * @return the name of the API used to create the window
    */
   virtual auto getAPIName() -> string = 0;
+  /*!
+   * @brief Takes the oldest queued input events, only one thread may drain
+   * @param events receives the events, oldest first
+   * @return how many events were taken
+   */
+  auto drain_input(std::span<InputEvent> events) -> size_t {
+    return this->m_inputEvents.pop(events);
+  }
+  /*!
+   * @brief Gets how many events were lost because nobody drained the queue in
+   * time
+   */
+  [[nodiscard]] auto dropped_input_events() const -> uint64_t {
+    return this->m_droppedInputEvents.load(std::memory_order_relaxed);
+  }
 };
 } // namespace SFT::Window
 
@@ -1,9 +1,110 @@
-#version 450
+#version 460
+#extension GL_EXT_buffer_reference : require
 
-layout(location = 0) in vec3 fragColor;
+layout (location = 0) in vec3 fragColor;
+layout (location = 1) in vec3 fragViewPosition;
+layout (location = 2) in vec3 fragViewNormal;
+layout (location = 3) in vec4 fragClipPosition;
+layout (location = 4) in vec4 fragPreviousClipPosition;
 
-layout(location = 0) out vec4 outColor;
+layout (location = 0) out vec4 outColor;
+// UV offset to where this surface was last frame, for temporal upscaling
+layout (location = 1) out vec2 outMotion;
+
+struct PointLight {
+    vec3 position;
+    float radius;
+    vec3 color;
+    float intensity;
+};
+
+layout (buffer_reference, std430, buffer_reference_align = 16) readonly buffer Lights {
+    PointLight lights[];
+};
+layout (buffer_reference, std430, buffer_reference_align = 16) readonly buffer ClusterGrid {
+    uint indexCount;
+    uint padding0;
+    uint padding1;
+    uint padding2;
+    uvec2 clusters[];
+};
+layout (buffer_reference, std430, buffer_reference_align = 4) readonly buffer LightIndices {
+    uint indices[];
+};
+// mirrors ClusterFrame in light_cluster.comp
+layout (buffer_reference, std430, buffer_reference_align = 16) readonly buffer ClusterFrame {
+    mat4 view;
+    vec4 projection;
+    uvec4 grid;
+    vec4 screen;
+    Lights lights;
+    Lights viewLights;
+    ClusterGrid clusterGrid;
+    LightIndices lightIndices;
+    uint indexCapacity;
+};
+
+layout (buffer_reference, std430, buffer_reference_align = 16) readonly buffer DrawConstants {
+    mat4 transform;
+    mat4 modelView;
+    mat4 unjitteredTransform;
+    mat4 previousTransform;
+    vec4 tint;
+    // positive while an LOD fades in, negative while it fades out, the two
+    // draws of a transition pass opposite signs of the same value so every
+    // pixel is covered by exactly one of them
+    float lodFade;
+};
+
+layout (push_constant) uniform PushConstants {
+    DrawConstants draw;
+    ClusterFrame lighting;
+} push;
+
+const vec3 ambient = vec3(0.03);
+
+// 4x4 ordered dither thresholds in [0, 1)
+float bayer(uvec2 pixel) {
+    const uint matrix[16] = uint[16](0, 8, 2, 10, 12, 4, 14, 6, 3, 11, 1, 9, 15, 7, 13, 5);
+    return (float(matrix[(pixel.x & 3u) + (pixel.y & 3u) * 4u]) + 0.5) / 16.0;
+}
+
+// inverse square falloff windowed to reach zero at the radius
+float attenuation(float distanceSquared, float radius) {
+    float ratio = distanceSquared / (radius * radius);
+    float window = clamp(1.0 - ratio * ratio, 0.0, 1.0);
+    return window * window / max(distanceSquared, 0.0001);
+}
 
 void main() {
-    outColor = vec4(fragColor, 1.0);
-}
\ No newline at end of file
+    float fade = push.draw.lodFade;
+    if (fade != 0.0) {
+        float threshold = bayer(uvec2(gl_FragCoord.xy));
+        if (fade > 0.0 ? threshold >= fade : threshold < -fade) {
+            discard;
+        }
+    }
+
+    ClusterFrame frame = push.lighting;
+    vec3 normal = normalize(gl_FrontFacing ? fragViewNormal : -fragViewNormal);
+
+    // only the lights binned into this pixel's cluster are visited
+    uvec3 grid = frame.grid.xyz;
+    uvec2 tile = min(uvec2(gl_FragCoord.xy / frame.screen.xy * vec2(grid.xy)), grid.xy - 1);
+    float depth = max(-fragViewPosition.z, frame.projection.z);
+    uint slice = min(uint(max(log(depth) * frame.screen.z + frame.screen.w, 0.0)), grid.z - 1);
+    uvec2 cluster = frame.clusterGrid.clusters[tile.x + grid.x * (tile.y + grid.y * slice)];
+
+    vec3 light = ambient;
+    for (uint i = 0; i < cluster.y; i++) {
+        PointLight point = frame.viewLights.lights[frame.lightIndices.indices[cluster.x + i]];
+        vec3 toLight = point.position - fragViewPosition;
+        float distanceSquared = dot(toLight, toLight);
+        float lambert = max(dot(normal, toLight * inversesqrt(max(distanceSquared, 0.0001))), 0.0);
+        light += point.color * point.intensity * lambert * attenuation(distanceSquared, point.radius);
+    }
+    outColor = vec4(fragColor * light, 1.0);
+    vec2 current = fragClipPosition.xy / fragClipPosition.w;
+    vec2 previous = fragPreviousClipPosition.xy / fragPreviousClipPosition.w;
+    outMotion = (previous - current) * 0.5;
+}
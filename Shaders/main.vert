@@ -1,6 +1,37 @@
-#version 450
+#version 460
+#extension GL_EXT_buffer_reference : require
 
 layout (location = 0) out vec3 fragColor;
+layout (location = 1) out vec3 fragViewPosition;
+layout (location = 2) out vec3 fragViewNormal;
+layout (location = 3) out vec4 fragClipPosition;
+layout (location = 4) out vec4 fragPreviousClipPosition;
+
+// written into the renderer's uniform ring each frame, the push constant only
+// carries its address
+layout (buffer_reference, std430, buffer_reference_align = 16) readonly buffer DrawConstants {
+    // object to clip space, jittered when temporal upscaling is on
+    mat4 transform;
+    // object to view space, lighting is done in view space
+    mat4 modelView;
+    // object to clip space without the jitter, this frame and the last, for
+    // motion vectors
+    mat4 unjitteredTransform;
+    mat4 previousTransform;
+    vec4 tint;
+    // dithered cross-fade between LODs, see main.frag
+    float lodFade;
+};
+
+// the clustered lighting of the frame, see main.frag
+layout (buffer_reference, std430, buffer_reference_align = 16) readonly buffer ClusterFrame {
+    mat4 view;
+};
+
+layout (push_constant) uniform PushConstants {
+    DrawConstants draw;
+    ClusterFrame lighting;
+} push;
 
 vec2 positions[3] = vec2[](
     vec2(0.0, -0.5),
@@ -15,6 +46,11 @@ vec3 colors[3] = vec3[](
 );
 
 void main() {
-    gl_Position = vec4(positions[gl_VertexIndex], 0.0, 1.0);
-    fragColor = colors[gl_VertexIndex];
-}
\ No newline at end of file
+    vec4 position = vec4(positions[gl_VertexIndex], 0.0, 1.0);
+    gl_Position = push.draw.transform * position;
+    fragColor = colors[gl_VertexIndex] * push.draw.tint.rgb;
+    fragViewPosition = (push.draw.modelView * position).xyz;
+    fragViewNormal = mat3(push.draw.modelView) * vec3(0.0, 0.0, 1.0);
+    fragClipPosition = push.draw.unjitteredTransform * position;
+    fragPreviousClipPosition = push.draw.previousTransform * position;
+}
@@ -0,0 +1,15 @@
+#version 460
+
+layout (location = 0) in vec4 fragColor;
+layout (location = 1) in vec2 fragUv;
+
+layout (location = 0) out vec4 outColor;
+
+void main() {
+    // a soft round sprite
+    float falloff = 1.0 - smoothstep(0.5, 1.0, length(fragUv));
+    if (falloff <= 0.0) {
+        discard;
+    }
+    outColor = vec4(fragColor.rgb, fragColor.a * falloff);
+}
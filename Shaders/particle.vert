@@ -0,0 +1,54 @@
+#version 460
+#extension GL_EXT_buffer_reference : require
+
+// camera facing quads, one instance per alive particle, the instance count
+// comes from the simulation
+struct Particle {
+    vec3 position;
+    float age;
+    vec3 velocity;
+    float lifetime;
+    vec4 color;
+    float size;
+    float sizeEnd;
+    float padding0;
+    float padding1;
+};
+
+layout (buffer_reference, std430, buffer_reference_align = 16) readonly buffer Particles {
+    Particle particles[];
+};
+layout (buffer_reference, std430, buffer_reference_align = 4) readonly buffer IndexList {
+    uint indices[];
+};
+
+layout (push_constant) uniform Draw {
+    mat4 viewProjection;
+    // xyz camera right, w unused
+    vec4 right;
+    // xyz camera up, w unused
+    vec4 up;
+    Particles particles;
+    // the alive list the last simulation filled
+    IndexList alive;
+} draw;
+
+layout (location = 0) out vec4 fragColor;
+layout (location = 1) out vec2 fragUv;
+
+const vec2 corners[6] = vec2[](
+    vec2(-1.0, -1.0), vec2(1.0, -1.0), vec2(1.0, 1.0),
+    vec2(-1.0, -1.0), vec2(1.0, 1.0), vec2(-1.0, 1.0)
+);
+
+void main() {
+    Particle particle = draw.particles.particles[draw.alive.indices[gl_InstanceIndex]];
+    float t = clamp(particle.age / particle.lifetime, 0.0, 1.0);
+    vec2 corner = corners[gl_VertexIndex];
+    float size = mix(particle.size, particle.sizeEnd, t);
+    vec3 world = particle.position + (corner.x * draw.right.xyz + corner.y * draw.up.xyz) * size;
+    gl_Position = draw.viewProjection * vec4(world, 1.0);
+    // fades out over its life
+    fragColor = vec4(particle.color.rgb, particle.color.a * (1.0 - t));
+    fragUv = corner;
+}
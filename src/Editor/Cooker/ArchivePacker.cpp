@@ -0,0 +1,158 @@
+//
+// Created by sturd on 10/18/2026.
+//
+
+#include "ArchivePacker.h"
+
+#include "Core/Assets/AssetArchive.h"
+#include <algorithm>
+#include <bit>
+#include <fstream>
+#include <vector>
+
+using std::vector;
+
+namespace SFT::Editor::Cooker {
+#pragma region additional functions
+namespace {
+struct PackedFile {
+  std::filesystem::path source;
+  string name;
+  uint64_t size = 0;
+};
+
+auto align_up(const uint64_t value, const uint64_t alignment) -> uint64_t {
+  return (value + alignment - 1) / alignment * alignment;
+}
+
+auto write_padding(std::ofstream &file, const uint64_t from, const uint64_t to)
+    -> void {
+  static constexpr char zeros[Assets::AssetArchivePayloadAlignment] = {};
+  for (uint64_t position = from; position < to;) {
+    const uint64_t chunk = std::min<uint64_t>(to - position, sizeof(zeros));
+    file.write(zeros, static_cast<std::streamsize>(chunk));
+    position += chunk;
+  }
+}
+} // namespace
+#pragma endregion
+
+auto pack_directory(const std::filesystem::path &input,
+                    const std::filesystem::path &output)
+    -> expected<PackSummary, string> {
+  if (!std::filesystem::is_directory(input)) {
+    return unexpected(input.string() + " is not a directory");
+  }
+  // an archive written into the directory it packs must not pack itself
+  const auto archivePath = std::filesystem::weakly_canonical(output);
+  vector<PackedFile> files;
+  for (const auto &entry :
+       std::filesystem::recursive_directory_iterator(input)) {
+    if (!entry.is_regular_file() || entry.path().extension() == ".tmp" ||
+        std::filesystem::weakly_canonical(entry.path()) == archivePath) {
+      continue;
+    }
+    string name =
+        std::filesystem::relative(entry.path(), input).generic_string();
+    files.push_back({entry.path(), std::move(name), entry.file_size()});
+  }
+  std::ranges::sort(files, {}, &PackedFile::name);
+
+  // at most half full, so probe chains stay short and there's always an empty
+  // slot to end a lookup on
+  const uint32_t tableSlots = std::bit_ceil(
+      std::max<uint32_t>(static_cast<uint32_t>(files.size()) * 2, 16));
+  vector<Assets::AssetArchiveEntry> table(tableSlots);
+  string names;
+  const uint64_t namesOffset =
+      sizeof(Assets::AssetArchiveHeader) +
+      uint64_t{tableSlots} * sizeof(Assets::AssetArchiveEntry);
+  for (const auto &file : files) {
+    names += file.name;
+  }
+  uint64_t offset = align_up(namesOffset + names.size(),
+                             Assets::AssetArchivePayloadAlignment);
+
+  uint32_t nameOffset = 0;
+  for (const auto &file : files) {
+    const uint64_t hash = Assets::hash_asset_path(file.name);
+    uint32_t slot = static_cast<uint32_t>(hash) & (tableSlots - 1);
+    while (table[slot].nameLength != 0) {
+      if (table[slot].hash == hash) {
+        return unexpected(file.name + " collides with another asset's hash, "
+                                      "rename one of them");
+      }
+      slot = (slot + 1) & (tableSlots - 1);
+    }
+    table[slot] = {
+        .hash = hash,
+        .offset = offset,
+        .size = file.size,
+        .nameOffset = nameOffset,
+        .nameLength = static_cast<uint32_t>(file.name.size()),
+    };
+    nameOffset += static_cast<uint32_t>(file.name.size());
+    offset = align_up(offset + file.size, Assets::AssetArchivePayloadAlignment);
+  }
+
+  const Assets::AssetArchiveHeader header{
+      .magic = Assets::AssetArchiveMagic,
+      .version = Assets::AssetArchiveVersion,
+      .entryCount = static_cast<uint32_t>(files.size()),
+      .tableSlots = tableSlots,
+      .namesOffset = namesOffset,
+      .namesSize = names.size(),
+  };
+  if (output.has_parent_path()) {
+    std::error_code error;
+    std::filesystem::create_directories(output.parent_path(), error);
+    if (error) {
+      return unexpected("failed to create " + output.parent_path().string() +
+                        ": " + error.message());
+    }
+  }
+  std::filesystem::path temporary = output;
+  temporary += ".tmp";
+  PackSummary summary;
+  {
+    std::ofstream archive(temporary, std::ios::binary | std::ios::trunc);
+    if (!archive.is_open()) {
+      return unexpected("failed to open " + temporary.string());
+    }
+    archive.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    archive.write(reinterpret_cast<const char *>(table.data()),
+                  static_cast<std::streamsize>(table.size() *
+                                               sizeof(table.front())));
+    archive.write(names.data(), static_cast<std::streamsize>(names.size()));
+    uint64_t position = namesOffset + names.size();
+
+    // payloads go in name order, which is also the order they were placed in
+    vector<char> buffer;
+    for (const auto &file : files) {
+      const uint64_t start =
+          align_up(position, Assets::AssetArchivePayloadAlignment);
+      write_padding(archive, position, start);
+      std::ifstream source(file.source, std::ios::binary);
+      buffer.resize(file.size);
+      if (!source.read(buffer.data(), static_cast<std::streamsize>(file.size))) {
+        return unexpected("failed to read " + file.source.string());
+      }
+      archive.write(buffer.data(), static_cast<std::streamsize>(file.size));
+      position = start + file.size;
+      summary.payloadBytes += file.size;
+    }
+    if (!archive) {
+      return unexpected("failed to write " + temporary.string());
+    }
+    summary.archiveBytes = position;
+  }
+  std::error_code error;
+  std::filesystem::rename(temporary, output, error);
+  if (error) {
+    return unexpected("failed to move " + temporary.string() + " to " +
+                      output.string() + ": " + error.message());
+  }
+  summary.entries = static_cast<uint32_t>(files.size());
+  return summary;
+}
+} // namespace SFT::Editor::Cooker
@@ -0,0 +1,39 @@
+//
+// Created by sturd on 10/18/2026.
+//
+
+#ifndef ARCHIVEPACKER_H
+#define ARCHIVEPACKER_H
+
+#include <cstdint>
+#include <expected>
+#include <filesystem>
+#include <string>
+
+using std::expected;
+using std::string;
+using std::unexpected;
+
+namespace SFT::Editor::Cooker {
+struct PackSummary {
+  uint32_t entries = 0;
+  uint64_t payloadBytes = 0;
+  uint64_t archiveBytes = 0;
+};
+
+/*!
+ * @brief Packs every file under a directory into an asset archive (see
+ * Assets::AssetArchive), entries are named by their path relative to the
+ * directory with forward slashes, and are written sorted by name so the same
+ * input always packs to the same bytes
+ * @param input the directory to pack, usually the cooker's output
+ * @param output the archive to write, replaced once packing succeeded
+ * @return On success, returns what was packed, on failure, returns unexpected
+ * with error message
+ */
+auto pack_directory(const std::filesystem::path &input,
+                    const std::filesystem::path &output)
+    -> expected<PackSummary, string>;
+} // namespace SFT::Editor::Cooker
+
+#endif // ARCHIVEPACKER_H
@@ -0,0 +1,443 @@
+//
+// Created by sturd on 10/18/2026.
+//
+
+#include "BlockCompression.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace SFT::Editor::Cooker {
+#pragma region additional functions
+namespace {
+template <size_t N> using Vec = std::array<float, N>;
+template <size_t N> using Block = std::array<Vec<N>, 16>;
+
+/*!
+ * @brief Finds the direction the texels of a block spread along the most, the
+ * endpoints of every BC format sit on a line so this is where they go
+ */
+template <size_t N>
+auto principal_axis(const Block<N> &points, Vec<N> &mean) -> Vec<N> {
+  mean = {};
+  for (const auto &point : points) {
+    for (size_t c = 0; c < N; c++) {
+      mean[c] += point[c] / 16.0f;
+    }
+  }
+  std::array<Vec<N>, N> covariance{};
+  for (const auto &point : points) {
+    for (size_t i = 0; i < N; i++) {
+      for (size_t j = 0; j < N; j++) {
+        covariance[i][j] += (point[i] - mean[i]) * (point[j] - mean[j]);
+      }
+    }
+  }
+  // power iteration, seeded with the channel that varies the most
+  size_t widest = 0;
+  for (size_t c = 1; c < N; c++) {
+    if (covariance[c][c] > covariance[widest][widest]) {
+      widest = c;
+    }
+  }
+  Vec<N> axis = covariance[widest];
+  for (int iteration = 0; iteration < 8; iteration++) {
+    Vec<N> next{};
+    for (size_t i = 0; i < N; i++) {
+      for (size_t j = 0; j < N; j++) {
+        next[i] += covariance[i][j] * axis[j];
+      }
+    }
+    float largest = 0.0f;
+    for (const float value : next) {
+      largest = std::max(largest, std::abs(value));
+    }
+    if (largest < 1e-6f) {
+      return Vec<N>{};
+    }
+    for (size_t i = 0; i < N; i++) {
+      axis[i] = next[i] / largest;
+    }
+  }
+  float length = 0.0f;
+  for (const float value : axis) {
+    length += value * value;
+  }
+  length = std::sqrt(length);
+  for (auto &value : axis) {
+    value /= length;
+  }
+  return axis;
+}
+
+/*!
+ * @brief Projects the block onto its principal axis and returns the two
+ * extreme points, the first one is furthest along the axis
+ */
+template <size_t N>
+auto axis_endpoints(const Block<N> &points) -> std::pair<Vec<N>, Vec<N>> {
+  Vec<N> mean;
+  const Vec<N> axis = principal_axis(points, mean);
+  float low = 0.0f;
+  float high = 0.0f;
+  for (const auto &point : points) {
+    float projection = 0.0f;
+    for (size_t c = 0; c < N; c++) {
+      projection += (point[c] - mean[c]) * axis[c];
+    }
+    low = std::min(low, projection);
+    high = std::max(high, projection);
+  }
+  Vec<N> first;
+  Vec<N> second;
+  for (size_t c = 0; c < N; c++) {
+    first[c] = std::clamp(mean[c] + axis[c] * high, 0.0f, 255.0f);
+    second[c] = std::clamp(mean[c] + axis[c] * low, 0.0f, 255.0f);
+  }
+  return {first, second};
+}
+
+template <size_t N>
+auto distance(const Vec<N> &a, const Vec<N> &b) -> float {
+  float sum = 0.0f;
+  for (size_t c = 0; c < N; c++) {
+    sum += (a[c] - b[c]) * (a[c] - b[c]);
+  }
+  return sum;
+}
+
+#pragma region BC1
+auto pack565(const Vec<3> &color) -> uint16_t {
+  const auto r = static_cast<uint16_t>(std::lround(color[0] * 31.0f / 255.0f));
+  const auto g = static_cast<uint16_t>(std::lround(color[1] * 63.0f / 255.0f));
+  const auto b = static_cast<uint16_t>(std::lround(color[2] * 31.0f / 255.0f));
+  return static_cast<uint16_t>(r << 11 | g << 5 | b);
+}
+
+auto unpack565(const uint16_t packed) -> Vec<3> {
+  const uint32_t r = packed >> 11 & 31;
+  const uint32_t g = packed >> 5 & 63;
+  const uint32_t b = packed & 31;
+  return {static_cast<float>(r << 3 | r >> 2), static_cast<float>(g << 2 | g >> 4),
+          static_cast<float>(b << 3 | b >> 2)};
+}
+
+struct ColorFit {
+  uint16_t color0 = 0;
+  uint16_t color1 = 0;
+  std::array<uint8_t, 16> indices{};
+  float error = std::numeric_limits<float>::max();
+};
+
+// weight of color0 for each index in four color mode
+constexpr std::array<float, 4> ColorWeights = {1.0f, 0.0f, 2.0f / 3.0f,
+                                               1.0f / 3.0f};
+
+auto fit_colors(const Block<3> &points, uint16_t color0, uint16_t color1)
+    -> ColorFit {
+  // four color mode needs color0 > color1, equal endpoints only need index 0
+  if (color0 < color1) {
+    std::swap(color0, color1);
+  }
+  ColorFit fit;
+  fit.color0 = color0;
+  fit.color1 = color1;
+  fit.error = 0.0f;
+  const Vec<3> c0 = unpack565(color0);
+  const Vec<3> c1 = unpack565(color1);
+  std::array<Vec<3>, 4> palette;
+  for (size_t i = 0; i < 4; i++) {
+    for (size_t c = 0; c < 3; c++) {
+      palette[i][c] = c0[c] * ColorWeights[i] + c1[c] * (1.0f - ColorWeights[i]);
+    }
+  }
+  const size_t choices = color0 == color1 ? 1 : 4;
+  for (size_t t = 0; t < 16; t++) {
+    float best = std::numeric_limits<float>::max();
+    for (size_t i = 0; i < choices; i++) {
+      if (const float error = distance(points[t], palette[i]); error < best) {
+        best = error;
+        fit.indices[t] = static_cast<uint8_t>(i);
+      }
+    }
+    fit.error += best;
+  }
+  return fit;
+}
+
+/*!
+ * @brief Solves for the endpoints that best reproduce the block with the
+ * indices of a previous fit, a least squares step on top of the axis guess
+ */
+auto refine_colors(const Block<3> &points, const ColorFit &fit)
+    -> std::pair<Vec<3>, Vec<3>> {
+  float aa = 0.0f, ab = 0.0f, bb = 0.0f;
+  Vec<3> ax{}, bx{};
+  for (size_t t = 0; t < 16; t++) {
+    const float a = ColorWeights[fit.indices[t]];
+    const float b = 1.0f - a;
+    aa += a * a;
+    ab += a * b;
+    bb += b * b;
+    for (size_t c = 0; c < 3; c++) {
+      ax[c] += a * points[t][c];
+      bx[c] += b * points[t][c];
+    }
+  }
+  const float determinant = aa * bb - ab * ab;
+  if (std::abs(determinant) < 1e-6f) {
+    return {unpack565(fit.color0), unpack565(fit.color1)};
+  }
+  Vec<3> first, second;
+  for (size_t c = 0; c < 3; c++) {
+    first[c] = std::clamp((ax[c] * bb - bx[c] * ab) / determinant, 0.0f, 255.0f);
+    second[c] = std::clamp((bx[c] * aa - ax[c] * ab) / determinant, 0.0f, 255.0f);
+  }
+  return {first, second};
+}
+
+auto encode_color(const uint8_t *rgba, uint8_t *out) -> void {
+  Block<3> points;
+  for (size_t t = 0; t < 16; t++) {
+    for (size_t c = 0; c < 3; c++) {
+      points[t][c] = rgba[t * 4 + c];
+    }
+  }
+  const auto [first, second] = axis_endpoints(points);
+  ColorFit fit = fit_colors(points, pack565(first), pack565(second));
+  if (fit.color0 != fit.color1) {
+    const auto [refinedFirst, refinedSecond] = refine_colors(points, fit);
+    if (ColorFit refined = fit_colors(points, pack565(refinedFirst),
+                                      pack565(refinedSecond));
+        refined.error < fit.error) {
+      fit = refined;
+    }
+  }
+  uint32_t indices = 0;
+  for (size_t t = 0; t < 16; t++) {
+    indices |= static_cast<uint32_t>(fit.indices[t]) << (t * 2);
+  }
+  out[0] = fit.color0 & 0xFF;
+  out[1] = fit.color0 >> 8;
+  out[2] = fit.color1 & 0xFF;
+  out[3] = fit.color1 >> 8;
+  for (size_t i = 0; i < 4; i++) {
+    out[4 + i] = indices >> (i * 8) & 0xFF;
+  }
+}
+#pragma endregion
+
+#pragma region BC4
+/*!
+ * @brief Encodes one channel of a block, the endpoints are the extremes so the
+ * eight value mode is always used
+ * @param rgba the block
+ * @param channel which of the four channels to encode
+ * @param out 8 bytes of output
+ */
+auto encode_channel(const uint8_t *rgba, const size_t channel, uint8_t *out)
+    -> void {
+  uint8_t low = 255;
+  uint8_t high = 0;
+  for (size_t t = 0; t < 16; t++) {
+    low = std::min(low, rgba[t * 4 + channel]);
+    high = std::max(high, rgba[t * 4 + channel]);
+  }
+  std::array<float, 8> palette{};
+  palette[0] = high;
+  palette[1] = low;
+  for (size_t i = 1; i < 7; i++) {
+    palette[i + 1] = (static_cast<float>(7 - i) * high +
+                      static_cast<float>(i) * low) / 7.0f;
+  }
+  uint64_t indices = 0;
+  if (high != low) {
+    for (size_t t = 0; t < 16; t++) {
+      const float value = rgba[t * 4 + channel];
+      uint64_t best = 0;
+      for (size_t i = 1; i < 8; i++) {
+        if (std::abs(palette[i] - value) < std::abs(palette[best] - value)) {
+          best = i;
+        }
+      }
+      indices |= best << (t * 3);
+    }
+  }
+  out[0] = high;
+  out[1] = low;
+  for (size_t i = 0; i < 6; i++) {
+    out[2 + i] = indices >> (i * 8) & 0xFF;
+  }
+}
+#pragma endregion
+
+#pragma region BC7
+/*!
+ * @brief Writes BC7's little endian bit stream, fields are packed from the
+ * least significant bit of byte 0
+ */
+class BitWriter {
+private:
+  uint8_t *m_out;
+  size_t m_bit = 0;
+
+public:
+  explicit BitWriter(uint8_t *out) : m_out(out) { std::memset(out, 0, 16); }
+
+  auto write(const uint32_t value, const size_t bits) -> void {
+    for (size_t i = 0; i < bits; i++) {
+      if (value >> i & 1) {
+        this->m_out[this->m_bit / 8] |= 1 << (this->m_bit % 8);
+      }
+      this->m_bit++;
+    }
+  }
+};
+
+constexpr std::array<uint32_t, 16> Bc7Weights = {
+    0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64};
+
+struct Bc7Fit {
+  std::array<std::array<uint32_t, 4>, 2> endpoints{};
+  std::array<uint32_t, 2> pBits{};
+  std::array<uint8_t, 16> indices{};
+  float error = std::numeric_limits<float>::max();
+};
+
+/*!
+ * @brief Encodes a block with mode 6, one subset with 7 bit RGBA endpoints
+ * plus a shared low bit each and 4 bit indices. Single subset blocks are what
+ * most fast encoders settle on, partitioned modes only pay off for blocks with
+ * two or three distinct colors
+ */
+auto encode_bc7(const uint8_t *rgba, uint8_t *out) -> void {
+  Block<4> points;
+  for (size_t t = 0; t < 16; t++) {
+    for (size_t c = 0; c < 4; c++) {
+      points[t][c] = rgba[t * 4 + c];
+    }
+  }
+  const auto [first, second] = axis_endpoints(points);
+
+  Bc7Fit best;
+  // the low bit is shared by all channels of an endpoint, try every pairing
+  for (uint32_t p0 = 0; p0 < 2; p0++) {
+    for (uint32_t p1 = 0; p1 < 2; p1++) {
+      Bc7Fit fit;
+      fit.pBits = {p0, p1};
+      fit.error = 0.0f;
+      std::array<Vec<4>, 2> decoded{};
+      for (size_t c = 0; c < 4; c++) {
+        const std::array<float, 2> targets = {first[c], second[c]};
+        for (size_t e = 0; e < 2; e++) {
+          const long quantized =
+              std::lround((targets[e] - static_cast<float>(fit.pBits[e])) / 2.0f);
+          fit.endpoints[e][c] = static_cast<uint32_t>(std::clamp(quantized, 0l, 127l));
+          decoded[e][c] =
+              static_cast<float>(fit.endpoints[e][c] << 1 | fit.pBits[e]);
+        }
+      }
+      std::array<Vec<4>, 16> palette;
+      for (size_t i = 0; i < 16; i++) {
+        for (size_t c = 0; c < 4; c++) {
+          const auto e0 = static_cast<uint32_t>(decoded[0][c]);
+          const auto e1 = static_cast<uint32_t>(decoded[1][c]);
+          palette[i][c] = static_cast<float>(
+              ((64 - Bc7Weights[i]) * e0 + Bc7Weights[i] * e1 + 32) >> 6);
+        }
+      }
+      for (size_t t = 0; t < 16; t++) {
+        float texelBest = std::numeric_limits<float>::max();
+        for (size_t i = 0; i < 16; i++) {
+          if (const float error = distance(points[t], palette[i]);
+              error < texelBest) {
+            texelBest = error;
+            fit.indices[t] = static_cast<uint8_t>(i);
+          }
+        }
+        fit.error += texelBest;
+      }
+      if (fit.error < best.error) {
+        best = fit;
+      }
+    }
+  }
+
+  // the first texel's index is stored without its top bit, so it has to be
+  // in the lower half of the palette, flipping the endpoints gets it there
+  if (best.indices[0] >= 8) {
+    std::swap(best.endpoints[0], best.endpoints[1]);
+    std::swap(best.pBits[0], best.pBits[1]);
+    for (auto &index : best.indices) {
+      index = static_cast<uint8_t>(15 - index);
+    }
+  }
+
+  BitWriter writer(out);
+  writer.write(1u << 6, 7);
+  for (size_t c = 0; c < 4; c++) {
+    writer.write(best.endpoints[0][c], 7);
+    writer.write(best.endpoints[1][c], 7);
+  }
+  writer.write(best.pBits[0], 1);
+  writer.write(best.pBits[1], 1);
+  writer.write(best.indices[0], 3);
+  for (size_t t = 1; t < 16; t++) {
+    writer.write(best.indices[t], 4);
+  }
+}
+#pragma endregion
+} // namespace
+#pragma endregion
+
+auto block_bytes(const BlockFormat format) -> size_t {
+  return format == BlockFormat::BC1 ? 8 : 16;
+}
+
+auto compress_block(const BlockFormat format, const uint8_t *rgba,
+                    uint8_t *out) -> void {
+  switch (format) {
+  case BlockFormat::BC1:
+    encode_color(rgba, out);
+    break;
+  case BlockFormat::BC3:
+    encode_channel(rgba, 3, out);
+    encode_color(rgba, out + 8);
+    break;
+  case BlockFormat::BC5:
+    encode_channel(rgba, 0, out);
+    encode_channel(rgba, 1, out + 8);
+    break;
+  case BlockFormat::BC7:
+    encode_bc7(rgba, out);
+    break;
+  }
+}
+
+auto compress_image(const Image &image, const BlockFormat format,
+                    Threading::ThreadPool &pool) -> vector<uint8_t> {
+  const uint32_t blocksWide = (image.width + 3) / 4;
+  const uint32_t blocksHigh = (image.height + 3) / 4;
+  const size_t bytesPerBlock = block_bytes(format);
+  vector<uint8_t> output(static_cast<size_t>(blocksWide) * blocksHigh *
+                         bytesPerBlock);
+  pool.parallel_for(blocksHigh, [&](const size_t begin, const size_t end) {
+    std::array<uint8_t, 64> block{};
+    for (size_t by = begin; by < end; by++) {
+      for (size_t bx = 0; bx < blocksWide; bx++) {
+        for (size_t t = 0; t < 16; t++) {
+          const size_t x = std::min<size_t>(bx * 4 + t % 4, image.width - 1);
+          const size_t y = std::min<size_t>(by * 4 + t / 4, image.height - 1);
+          std::memcpy(&block[t * 4], &image.rgba[(y * image.width + x) * 4], 4);
+        }
+        compress_block(format, block.data(),
+                       &output[(by * blocksWide + bx) * bytesPerBlock]);
+      }
+    }
+  });
+  return output;
+}
+} // namespace SFT::Editor::Cooker
@@ -0,0 +1,55 @@
+//
+// Created by sturd on 10/18/2026.
+//
+
+#ifndef BLOCKCOMPRESSION_H
+#define BLOCKCOMPRESSION_H
+
+#include "Core/Threading/ThreadPool.h"
+#include "ImageLoader.h"
+#include <cstdint>
+#include <vector>
+
+using std::vector;
+
+namespace SFT::Editor::Cooker {
+enum class BlockFormat : uint8_t {
+  // opaque color, 4 bits per texel
+  BC1,
+  // color with smooth alpha, BC1 color plus a BC4 alpha block
+  BC3,
+  // two independent channels, red and green, meant for tangent space normals
+  BC5,
+  // color with alpha at BC3's size and much better quality
+  BC7,
+};
+
+/*!
+ * @brief Gets how many bytes one 4x4 block of a format takes
+ * @param format the format
+ * @return 8 for BC1, 16 for the rest
+ */
+auto block_bytes(BlockFormat format) -> size_t;
+
+/*!
+ * @brief Compresses one 4x4 block
+ * @param format the format to encode to
+ * @param rgba the 16 texels of the block in row order, 4 bytes each
+ * @param out block_bytes(format) bytes of output
+ */
+auto compress_block(BlockFormat format, const uint8_t *rgba, uint8_t *out)
+    -> void;
+
+/*!
+ * @brief Compresses a whole image, rows of blocks are spread over the pool,
+ * images that aren't a multiple of 4 repeat their last row/column
+ * @param image the image to compress
+ * @param format the format to encode to
+ * @param pool the threads blocks are compressed on
+ * @return the blocks in row order, ready for vkCmdCopyBufferToImage
+ */
+auto compress_image(const Image &image, BlockFormat format,
+                    Threading::ThreadPool &pool) -> vector<uint8_t>;
+} // namespace SFT::Editor::Cooker
+
+#endif // BLOCKCOMPRESSION_H
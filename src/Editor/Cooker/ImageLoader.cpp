@@ -0,0 +1,245 @@
+//
+// Created by sturd on 10/18/2026.
+//
+
+#include "ImageLoader.h"
+
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+
+namespace SFT::Editor::Cooker {
+#pragma region additional functions
+namespace {
+auto read_u16(const std::span<const uint8_t> bytes, const size_t offset)
+    -> uint32_t {
+  return bytes[offset] | bytes[offset + 1] << 8;
+}
+
+auto load_tga(const std::span<const uint8_t> bytes) -> expected<Image, string> {
+  constexpr size_t HeaderSize = 18;
+  if (bytes.size() < HeaderSize) {
+    return unexpected("TGA file is truncated");
+  }
+  const uint8_t idLength = bytes[0];
+  const uint8_t colorMapType = bytes[1];
+  const uint8_t imageType = bytes[2];
+  const uint32_t width = read_u16(bytes, 12);
+  const uint32_t height = read_u16(bytes, 14);
+  const uint8_t depth = bytes[16];
+  const uint8_t descriptor = bytes[17];
+  if (colorMapType != 0) {
+    return unexpected("color mapped TGA files are not supported");
+  }
+  const bool rle = imageType == 10 || imageType == 11;
+  const bool gray = imageType == 3 || imageType == 11;
+  if (imageType != 2 && imageType != 3 && !rle) {
+    return unexpected("unsupported TGA image type " + std::to_string(imageType));
+  }
+  if ((gray && depth != 8) || (!gray && depth != 24 && depth != 32)) {
+    return unexpected("unsupported TGA pixel depth " + std::to_string(depth));
+  }
+  if (width == 0 || height == 0) {
+    return unexpected("TGA image is empty");
+  }
+
+  const uint32_t pixelSize = depth / 8;
+  const size_t pixelCount = static_cast<size_t>(width) * height;
+  vector<uint8_t> pixels(pixelCount * pixelSize);
+  size_t cursor = HeaderSize + idLength;
+  if (!rle) {
+    if (bytes.size() < cursor + pixels.size()) {
+      return unexpected("TGA file is truncated");
+    }
+    std::copy_n(bytes.begin() + cursor, pixels.size(), pixels.begin());
+  } else {
+    size_t written = 0;
+    while (written < pixelCount) {
+      if (cursor >= bytes.size()) {
+        return unexpected("TGA file is truncated");
+      }
+      const uint8_t packet = bytes[cursor++];
+      const size_t count =
+          std::min<size_t>((packet & 0x7F) + 1, pixelCount - written);
+      const bool repeat = packet & 0x80;
+      const size_t needed = repeat ? pixelSize : count * pixelSize;
+      if (cursor + needed > bytes.size()) {
+        return unexpected("TGA file is truncated");
+      }
+      for (size_t i = 0; i < count; i++) {
+        const size_t source = cursor + (repeat ? 0 : i * pixelSize);
+        std::copy_n(bytes.begin() + source, pixelSize,
+                    pixels.begin() + (written + i) * pixelSize);
+      }
+      cursor += needed;
+      written += count;
+    }
+  }
+
+  Image image;
+  image.width = width;
+  image.height = height;
+  image.rgba.resize(pixelCount * 4);
+  // rows are stored bottom up unless the descriptor says otherwise
+  const bool topDown = descriptor & 0x20;
+  for (uint32_t y = 0; y < height; y++) {
+    const uint32_t sourceRow = topDown ? y : height - 1 - y;
+    for (uint32_t x = 0; x < width; x++) {
+      const uint8_t *source =
+          &pixels[(static_cast<size_t>(sourceRow) * width + x) * pixelSize];
+      uint8_t *target = &image.rgba[(static_cast<size_t>(y) * width + x) * 4];
+      if (gray) {
+        target[0] = target[1] = target[2] = source[0];
+        target[3] = 255;
+      } else {
+        target[0] = source[2];
+        target[1] = source[1];
+        target[2] = source[0];
+        target[3] = pixelSize == 4 ? source[3] : 255;
+      }
+    }
+  }
+  return image;
+}
+
+/*!
+ * @brief Reads the next whitespace separated token of a Netpbm header,
+ * skipping comments
+ */
+auto next_token(const std::span<const uint8_t> bytes, size_t &cursor)
+    -> string {
+  while (cursor < bytes.size()) {
+    if (bytes[cursor] == '#') {
+      while (cursor < bytes.size() && bytes[cursor] != '\n') {
+        cursor++;
+      }
+    } else if (std::isspace(bytes[cursor])) {
+      cursor++;
+    } else {
+      break;
+    }
+  }
+  string token;
+  while (cursor < bytes.size() && !std::isspace(bytes[cursor])) {
+    token.push_back(static_cast<char>(bytes[cursor++]));
+  }
+  return token;
+}
+
+auto parse_uint(const string &token) -> expected<uint32_t, string> {
+  uint32_t value = 0;
+  const auto [end, error] =
+      std::from_chars(token.data(), token.data() + token.size(), value);
+  if (error != std::errc{} || end != token.data() + token.size()) {
+    return unexpected("malformed number '" + token + "' in Netpbm header");
+  }
+  return value;
+}
+
+auto load_netpbm(const std::span<const uint8_t> bytes)
+    -> expected<Image, string> {
+  size_t cursor = 0;
+  const string magic = next_token(bytes, cursor);
+  uint32_t width = 0;
+  uint32_t height = 0;
+  uint32_t channels = 0;
+  uint32_t maxValue = 0;
+  if (magic == "P5" || magic == "P6") {
+    channels = magic == "P5" ? 1 : 3;
+    for (uint32_t *value : {&width, &height, &maxValue}) {
+      auto parsed = parse_uint(next_token(bytes, cursor));
+      if (!parsed.has_value()) {
+        return unexpected(parsed.error());
+      }
+      *value = parsed.value();
+    }
+    // exactly one whitespace byte separates the header from the data
+    cursor++;
+  } else if (magic == "P7") {
+    while (true) {
+      const string key = next_token(bytes, cursor);
+      if (key.empty()) {
+        return unexpected("PAM header is truncated");
+      }
+      if (key == "ENDHDR") {
+        cursor++;
+        break;
+      }
+      const string value = next_token(bytes, cursor);
+      if (key == "TUPLTYPE") {
+        continue;
+      }
+      auto parsed = parse_uint(value);
+      if (!parsed.has_value()) {
+        return unexpected(parsed.error());
+      }
+      if (key == "WIDTH") {
+        width = parsed.value();
+      } else if (key == "HEIGHT") {
+        height = parsed.value();
+      } else if (key == "DEPTH") {
+        channels = parsed.value();
+      } else if (key == "MAXVAL") {
+        maxValue = parsed.value();
+      }
+    }
+  } else {
+    return unexpected("unsupported Netpbm type '" + magic + "'");
+  }
+  if (width == 0 || height == 0 || channels == 0 || channels > 4) {
+    return unexpected("Netpbm image has an unsupported shape");
+  }
+  if (maxValue != 255) {
+    return unexpected("only 8 bit Netpbm images are supported");
+  }
+  const size_t pixelCount = static_cast<size_t>(width) * height;
+  if (bytes.size() < cursor + pixelCount * channels) {
+    return unexpected("Netpbm file is truncated");
+  }
+
+  Image image;
+  image.width = width;
+  image.height = height;
+  image.rgba.resize(pixelCount * 4);
+  for (size_t i = 0; i < pixelCount; i++) {
+    const uint8_t *source = &bytes[cursor + i * channels];
+    uint8_t *target = &image.rgba[i * 4];
+    switch (channels) {
+    case 1:
+      target[0] = target[1] = target[2] = source[0];
+      target[3] = 255;
+      break;
+    case 2:
+      target[0] = target[1] = target[2] = source[0];
+      target[3] = source[1];
+      break;
+    case 3:
+      std::copy_n(source, 3, target);
+      target[3] = 255;
+      break;
+    default:
+      std::copy_n(source, 4, target);
+      break;
+    }
+  }
+  return image;
+}
+} // namespace
+#pragma endregion
+
+auto load_image(const std::span<const uint8_t> bytes, const string &extension)
+    -> expected<Image, string> {
+  if (extension == ".tga") {
+    return load_tga(bytes);
+  }
+  if (extension == ".pgm" || extension == ".ppm" || extension == ".pam") {
+    return load_netpbm(bytes);
+  }
+  return unexpected("unsupported image extension '" + extension + "'");
+}
+
+auto is_supported_image(const string &extension) -> bool {
+  return extension == ".tga" || extension == ".pgm" || extension == ".ppm" ||
+         extension == ".pam";
+}
+} // namespace SFT::Editor::Cooker
@@ -0,0 +1,49 @@
+//
+// Created by sturd on 10/18/2026.
+//
+
+#ifndef IMAGELOADER_H
+#define IMAGELOADER_H
+
+#include <cstdint>
+#include <expected>
+#include <span>
+#include <string>
+#include <vector>
+
+using std::expected;
+using std::string;
+using std::unexpected;
+using std::vector;
+
+namespace SFT::Editor::Cooker {
+/*!
+ * @brief An 8 bit RGBA image, rows are tightly packed from the top
+ */
+struct Image {
+  uint32_t width = 0;
+  uint32_t height = 0;
+  vector<uint8_t> rgba;
+};
+
+/*!
+ * @brief Decodes a source image, TGA (uncompressed or RLE, 8/24/32 bit) and
+ * Netpbm (PGM, PPM, PAM) are supported, missing channels are filled with
+ * opaque white
+ * @param bytes the contents of the file
+ * @param extension the file extension, lower case with the dot
+ * @return On success, returns the image, on failure, returns unexpected with
+ * error message
+ */
+auto load_image(std::span<const uint8_t> bytes, const string &extension)
+    -> expected<Image, string>;
+
+/*!
+ * @brief Checks whether load_image understands a file extension
+ * @param extension the file extension, lower case with the dot
+ * @return true if the extension is supported
+ */
+auto is_supported_image(const string &extension) -> bool;
+} // namespace SFT::Editor::Cooker
+
+#endif // IMAGELOADER_H
@@ -0,0 +1,219 @@
+//
+// Created by sturd on 10/18/2026.
+//
+
+#include "MeshCooker.h"
+
+#include "Core/Assets/CookedMesh.h"
+#include "MeshLoader.h"
+#include "Core/Utility/Utility.h"
+#include "spdlog/spdlog.h"
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+
+namespace SFT::Editor::Cooker {
+#pragma region additional functions
+namespace {
+// bump whenever the simplifier changes output, so everything is cooked again
+constexpr uint32_t CookerRevision = 1;
+
+using Utility::fnv1a;
+using Utility::read_file;
+
+auto content_hash(const vector<uint8_t> &source, const LodSettings &settings)
+    -> uint64_t {
+  uint64_t hash = fnv1a(source.data(), source.size());
+  const uint32_t key[] = {Assets::CookedMeshVersion, CookerRevision,
+                          settings.maxLods,
+                          static_cast<uint32_t>(settings.minTriangles)};
+  hash = fnv1a(key, sizeof(key), hash);
+  const float factors[] = {settings.reduction, settings.maxRelativeError};
+  return fnv1a(factors, sizeof(factors), hash);
+}
+
+auto is_up_to_date(const std::filesystem::path &output, const uint64_t hash)
+    -> bool {
+  std::ifstream file(output, std::ios::binary);
+  Assets::CookedMeshHeader header{};
+  if (!file.read(reinterpret_cast<char *>(&header), sizeof(header))) {
+    return false;
+  }
+  return header.magic == Assets::CookedMeshMagic &&
+         header.version == Assets::CookedMeshVersion &&
+         header.sourceHash == hash;
+}
+
+auto lower_extension(const std::filesystem::path &path) -> string {
+  string extension = path.extension().string();
+  std::ranges::transform(extension, extension.begin(), [](const char c) {
+    return static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+  });
+  return extension;
+}
+
+auto align(const uint64_t value) -> uint64_t {
+  return (value + Assets::CookedMeshAlignment - 1) /
+         Assets::CookedMeshAlignment * Assets::CookedMeshAlignment;
+}
+
+/*!
+ * @brief Bounding sphere around the box of the vertices, not the tightest but
+ * it always contains every vertex
+ */
+auto bounding_sphere(const Mesh &mesh, float (&center)[3], float &radius)
+    -> void {
+  float low[3] = {INFINITY, INFINITY, INFINITY};
+  float high[3] = {-INFINITY, -INFINITY, -INFINITY};
+  for (const auto &vertex : mesh.vertices) {
+    for (size_t axis = 0; axis < 3; axis++) {
+      low[axis] = std::min(low[axis], vertex.position[axis]);
+      high[axis] = std::max(high[axis], vertex.position[axis]);
+    }
+  }
+  for (size_t axis = 0; axis < 3; axis++) {
+    center[axis] = (low[axis] + high[axis]) * 0.5f;
+  }
+  float radiusSquared = 0.0f;
+  for (const auto &vertex : mesh.vertices) {
+    float distanceSquared = 0.0f;
+    for (size_t axis = 0; axis < 3; axis++) {
+      const float delta = vertex.position[axis] - center[axis];
+      distanceSquared += delta * delta;
+    }
+    radiusSquared = std::max(radiusSquared, distanceSquared);
+  }
+  radius = std::sqrt(radiusSquared);
+}
+} // namespace
+#pragma endregion
+
+#pragma region MeshCooker Functions
+MeshCooker::MeshCooker(const LodSettings settings) : m_settings(settings) {
+  this->m_settings.maxLods =
+      std::clamp(this->m_settings.maxLods, 1u, Assets::CookedMeshMaxLods);
+}
+
+auto MeshCooker::cook(const std::filesystem::path &source,
+                      const std::filesystem::path &output, const bool force)
+    -> expected<CookOutcome, string> {
+  auto bytes = read_file(source);
+  if (!bytes.has_value()) {
+    return unexpected(bytes.error());
+  }
+  const uint64_t hash = content_hash(bytes.value(), this->m_settings);
+  if (!force && is_up_to_date(output, hash)) {
+    return CookOutcome::UpToDate;
+  }
+
+  auto mesh = load_obj(bytes.value());
+  if (!mesh.has_value()) {
+    return unexpected(source.string() + ": " + mesh.error());
+  }
+  if (mesh->indices.empty()) {
+    return unexpected(source.string() + " has no triangles");
+  }
+
+  Assets::CookedMeshHeader header{};
+  header.magic = Assets::CookedMeshMagic;
+  header.version = Assets::CookedMeshVersion;
+  header.sourceHash = hash;
+  header.vertexCount = static_cast<uint32_t>(mesh->vertices.size());
+  bounding_sphere(mesh.value(), header.boundsCenter, header.boundsRadius);
+
+  const vector<SimplifiedMesh> lods =
+      generate_lods(mesh.value(), this->m_settings, header.boundsRadius);
+  header.lodCount = static_cast<uint32_t>(lods.size());
+  uint32_t firstIndex = 0;
+  for (size_t level = 0; level < lods.size(); level++) {
+    header.lods[level].firstIndex = firstIndex;
+    header.lods[level].indexCount =
+        static_cast<uint32_t>(lods[level].indices.size());
+    header.lods[level].error = lods[level].error;
+    firstIndex += header.lods[level].indexCount;
+  }
+  header.indexCount = firstIndex;
+  header.vertexOffset = sizeof(header);
+  header.indexOffset =
+      align(header.vertexOffset +
+            mesh->vertices.size() * sizeof(Assets::CookedMeshVertex));
+
+  // written next to the output and renamed over it, so an interrupted cook
+  // never leaves a truncated file that looks up to date
+  if (output.has_parent_path()) {
+    std::error_code error;
+    std::filesystem::create_directories(output.parent_path(), error);
+    if (error) {
+      return unexpected("failed to create " + output.parent_path().string() +
+                        ": " + error.message());
+    }
+  }
+  std::filesystem::path temporary = output;
+  temporary += ".tmp";
+  {
+    std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+      return unexpected("failed to open " + temporary.string());
+    }
+    file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    const size_t vertexBytes =
+        mesh->vertices.size() * sizeof(Assets::CookedMeshVertex);
+    file.write(reinterpret_cast<const char *>(mesh->vertices.data()),
+               static_cast<std::streamsize>(vertexBytes));
+    constexpr char padding[Assets::CookedMeshAlignment] = {};
+    file.write(padding, static_cast<std::streamsize>(
+                            header.indexOffset - header.vertexOffset -
+                            vertexBytes));
+    for (const auto &lod : lods) {
+      file.write(reinterpret_cast<const char *>(lod.indices.data()),
+                 static_cast<std::streamsize>(lod.indices.size() *
+                                              sizeof(uint32_t)));
+    }
+    if (!file) {
+      return unexpected("failed to write " + temporary.string());
+    }
+  }
+  std::error_code error;
+  std::filesystem::rename(temporary, output, error);
+  if (error) {
+    return unexpected("failed to move " + temporary.string() + " to " +
+                      output.string() + ": " + error.message());
+  }
+  return CookOutcome::Cooked;
+}
+
+auto MeshCooker::cook_directory(const std::filesystem::path &input,
+                                const std::filesystem::path &output,
+                                const bool force)
+    -> expected<CookSummary, string> {
+  if (!std::filesystem::is_directory(input)) {
+    return unexpected(input.string() + " is not a directory");
+  }
+  CookSummary summary;
+  for (const auto &entry :
+       std::filesystem::recursive_directory_iterator(input)) {
+    if (!entry.is_regular_file() ||
+        !is_supported_mesh(lower_extension(entry.path()))) {
+      continue;
+    }
+    std::filesystem::path target =
+        output / std::filesystem::relative(entry.path(), input);
+    target.replace_extension(".sftm");
+    auto result = this->cook(entry.path(), target, force);
+    if (!result.has_value()) {
+      spdlog::error("{}", result.error());
+      summary.failed++;
+    } else if (result.value() == CookOutcome::UpToDate) {
+      spdlog::debug("{} is up to date", entry.path().string());
+      summary.upToDate++;
+    } else {
+      spdlog::info("cooked {}", target.string());
+      summary.cooked++;
+    }
+  }
+  return summary;
+}
+#pragma endregion
+} // namespace SFT::Editor::Cooker
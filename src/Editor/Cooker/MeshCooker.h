@@ -0,0 +1,59 @@
+//
+// Created by sturd on 10/18/2026.
+//
+
+#ifndef MESHCOOKER_H
+#define MESHCOOKER_H
+
+#include "MeshSimplifier.h"
+#include "TextureCooker.h"
+#include <cstdint>
+#include <expected>
+#include <filesystem>
+#include <string>
+
+using std::expected;
+using std::string;
+using std::unexpected;
+
+namespace SFT::Editor::Cooker {
+/*!
+ * @brief Turns source meshes into cooked meshes (see Core/Assets/CookedMesh.h)
+ * with their LOD chain and the error bound of every level, a mesh is only
+ * cooked again when its source or the LOD settings change
+ */
+class MeshCooker {
+private:
+  LodSettings m_settings;
+
+public:
+  explicit MeshCooker(LodSettings settings = {});
+  /*!
+   * @brief Cooks one mesh, unless the output was cooked from the same source
+   * with the same settings already
+   * @param source the source mesh
+   * @param output where the cooked mesh is written
+   * @param force cook even if the output is up to date
+   * @return On success, returns whether the mesh was cooked or skipped, on
+   * failure, returns unexpected with error message
+   */
+  auto cook(const std::filesystem::path &source,
+            const std::filesystem::path &output, bool force)
+      -> expected<CookOutcome, string>;
+  /*!
+   * @brief Cooks every supported mesh below a directory, mirroring the
+   * directory structure with .sftm files
+   * @param input the directory of source meshes
+   * @param output the directory cooked meshes are written to
+   * @param force cook even if outputs are up to date
+   * @return On success, returns how many meshes were cooked, skipped and
+   * failed, on failure (the input isn't a directory), returns unexpected with
+   * error message
+   */
+  auto cook_directory(const std::filesystem::path &input,
+                      const std::filesystem::path &output, bool force)
+      -> expected<CookSummary, string>;
+};
+} // namespace SFT::Editor::Cooker
+
+#endif // MESHCOOKER_H
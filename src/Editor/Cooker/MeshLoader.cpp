@@ -0,0 +1,230 @@
+//
+// Created by sturd on 10/18/2026.
+//
+
+#include "MeshLoader.h"
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cmath>
+#include <string_view>
+#include <unordered_map>
+
+namespace SFT::Editor::Cooker {
+#pragma region additional functions
+namespace {
+struct Corner {
+  int32_t position;
+  int32_t uv;
+  int32_t normal;
+
+  auto operator==(const Corner &) const -> bool = default;
+};
+
+struct CornerHash {
+  auto operator()(const Corner &corner) const -> size_t {
+    uint64_t hash = static_cast<uint32_t>(corner.position);
+    hash = hash * 0x9e3779b97f4a7c15ULL ^ static_cast<uint32_t>(corner.uv);
+    hash = hash * 0x9e3779b97f4a7c15ULL ^ static_cast<uint32_t>(corner.normal);
+    return static_cast<size_t>(hash ^ (hash >> 29));
+  }
+};
+
+auto skip_spaces(std::string_view &text) -> void {
+  while (!text.empty() && (text.front() == ' ' || text.front() == '\t')) {
+    text.remove_prefix(1);
+  }
+}
+
+auto next_token(std::string_view &text) -> std::string_view {
+  skip_spaces(text);
+  size_t end = 0;
+  while (end < text.size() && text[end] != ' ' && text[end] != '\t') {
+    end++;
+  }
+  const std::string_view token = text.substr(0, end);
+  text.remove_prefix(end);
+  return token;
+}
+
+auto parse_floats(std::string_view text, float *values, const size_t count)
+    -> bool {
+  for (size_t i = 0; i < count; i++) {
+    const std::string_view token = next_token(text);
+    if (std::from_chars(token.data(), token.data() + token.size(), values[i])
+            .ec != std::errc{}) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// OBJ indices start at 1 and negative ones count back from the end, the
+// result is 0 based or -1 when the index is absent
+auto resolve_index(const std::string_view token, const size_t count,
+                   int32_t &index) -> bool {
+  if (token.empty()) {
+    index = -1;
+    return true;
+  }
+  int64_t value = 0;
+  if (std::from_chars(token.data(), token.data() + token.size(), value).ec !=
+      std::errc{}) {
+    return false;
+  }
+  value = value < 0 ? static_cast<int64_t>(count) + value : value - 1;
+  if (value < 0 || value >= static_cast<int64_t>(count)) {
+    return false;
+  }
+  index = static_cast<int32_t>(value);
+  return true;
+}
+} // namespace
+#pragma endregion
+
+#pragma region MeshLoader Functions
+auto load_obj(const std::span<const uint8_t> bytes) -> expected<Mesh, string> {
+  vector<std::array<float, 3>> positions;
+  vector<std::array<float, 2>> uvs;
+  vector<std::array<float, 3>> normals;
+  Mesh mesh;
+  std::unordered_map<Corner, uint32_t, CornerHash> corners;
+  vector<Corner> face;
+
+  std::string_view text(reinterpret_cast<const char *>(bytes.data()),
+                        bytes.size());
+  size_t lineNumber = 0;
+  while (!text.empty()) {
+    lineNumber++;
+    const size_t end = text.find('\n');
+    std::string_view line = text.substr(0, end);
+    text.remove_prefix(end == std::string_view::npos ? text.size() : end + 1);
+    if (!line.empty() && line.back() == '\r') {
+      line.remove_suffix(1);
+    }
+    const std::string_view keyword = next_token(line);
+    const string where = "line " + std::to_string(lineNumber);
+    if (keyword == "v") {
+      std::array<float, 3> position{};
+      if (!parse_floats(line, position.data(), 3)) {
+        return unexpected(where + ": bad vertex position");
+      }
+      positions.push_back(position);
+    } else if (keyword == "vt") {
+      std::array<float, 2> uv{};
+      if (!parse_floats(line, uv.data(), 2)) {
+        return unexpected(where + ": bad texture coordinate");
+      }
+      // OBJ puts v = 0 at the bottom, Vulkan samples from the top
+      uv[1] = 1.0f - uv[1];
+      uvs.push_back(uv);
+    } else if (keyword == "vn") {
+      std::array<float, 3> normal{};
+      if (!parse_floats(line, normal.data(), 3)) {
+        return unexpected(where + ": bad normal");
+      }
+      normals.push_back(normal);
+    } else if (keyword == "f") {
+      face.clear();
+      for (std::string_view token = next_token(line); !token.empty();
+           token = next_token(line)) {
+        // v, v/vt, v//vn or v/vt/vn
+        const size_t first = token.find('/');
+        const size_t second = first == std::string_view::npos
+                                  ? std::string_view::npos
+                                  : token.find('/', first + 1);
+        Corner corner{};
+        const bool valid =
+            resolve_index(token.substr(0, first), positions.size(),
+                          corner.position) &&
+            corner.position >= 0 &&
+            (first == std::string_view::npos ||
+             resolve_index(token.substr(first + 1, second - first - 1),
+                           uvs.size(), corner.uv)) &&
+            (second == std::string_view::npos ||
+             resolve_index(token.substr(second + 1), normals.size(),
+                           corner.normal));
+        if (!valid) {
+          return unexpected(where + ": bad face index '" + string(token) +
+                            "'");
+        }
+        if (first == std::string_view::npos) {
+          corner.uv = -1;
+        }
+        if (second == std::string_view::npos) {
+          corner.normal = -1;
+        }
+        face.push_back(corner);
+      }
+      if (face.size() < 3) {
+        return unexpected(where + ": a face needs at least three corners");
+      }
+      // a face without normals gets its own, from the first three corners
+      std::array<float, 3> faceNormal{0.0f, 0.0f, 1.0f};
+      {
+        const auto &a = positions[face[0].position];
+        const auto &b = positions[face[1].position];
+        const auto &c = positions[face[2].position];
+        const float e0[3] = {b[0] - a[0], b[1] - a[1], b[2] - a[2]};
+        const float e1[3] = {c[0] - a[0], c[1] - a[1], c[2] - a[2]};
+        const float n[3] = {e0[1] * e1[2] - e0[2] * e1[1],
+                            e0[2] * e1[0] - e0[0] * e1[2],
+                            e0[0] * e1[1] - e0[1] * e1[0]};
+        const float length = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+        if (length > 0.0f) {
+          faceNormal = {n[0] / length, n[1] / length, n[2] / length};
+        }
+      }
+      vector<uint32_t> faceVertices;
+      faceVertices.reserve(face.size());
+      for (const Corner &corner : face) {
+        // corners without a normal can't be shared between faces, they take
+        // the normal of the face they're in
+        if (corner.normal < 0) {
+          Assets::CookedMeshVertex vertex{};
+          const auto &position = positions[corner.position];
+          std::copy(position.begin(), position.end(), vertex.position);
+          std::copy(faceNormal.begin(), faceNormal.end(), vertex.normal);
+          if (corner.uv >= 0) {
+            vertex.uv[0] = uvs[corner.uv][0];
+            vertex.uv[1] = uvs[corner.uv][1];
+          }
+          faceVertices.push_back(static_cast<uint32_t>(mesh.vertices.size()));
+          mesh.vertices.push_back(vertex);
+          continue;
+        }
+        auto [found, inserted] = corners.try_emplace(
+            corner, static_cast<uint32_t>(mesh.vertices.size()));
+        if (inserted) {
+          Assets::CookedMeshVertex vertex{};
+          const auto &position = positions[corner.position];
+          const auto &normal = normals[corner.normal];
+          std::copy(position.begin(), position.end(), vertex.position);
+          std::copy(normal.begin(), normal.end(), vertex.normal);
+          if (corner.uv >= 0) {
+            vertex.uv[0] = uvs[corner.uv][0];
+            vertex.uv[1] = uvs[corner.uv][1];
+          }
+          mesh.vertices.push_back(vertex);
+        }
+        faceVertices.push_back(found->second);
+      }
+      for (size_t i = 1; i + 1 < faceVertices.size(); i++) {
+        mesh.indices.push_back(faceVertices[0]);
+        mesh.indices.push_back(faceVertices[i]);
+        mesh.indices.push_back(faceVertices[i + 1]);
+      }
+    }
+  }
+  if (mesh.indices.empty()) {
+    return unexpected("the file has no faces");
+  }
+  return mesh;
+}
+
+auto is_supported_mesh(const string &extension) -> bool {
+  return extension == ".obj";
+}
+#pragma endregion
+} // namespace SFT::Editor::Cooker
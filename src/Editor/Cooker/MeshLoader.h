@@ -0,0 +1,48 @@
+//
+// Created by sturd on 10/18/2026.
+//
+
+#ifndef MESHLOADER_H
+#define MESHLOADER_H
+
+#include "Core/Assets/CookedMesh.h"
+#include <cstdint>
+#include <expected>
+#include <span>
+#include <string>
+#include <vector>
+
+using std::expected;
+using std::string;
+using std::unexpected;
+using std::vector;
+
+namespace SFT::Editor::Cooker {
+/*!
+ * @brief An indexed triangle list, vertices are unique so vertices that share
+ * a position but differ in normal or uv are seams
+ */
+struct Mesh {
+  vector<Assets::CookedMeshVertex> vertices;
+  vector<uint32_t> indices;
+};
+
+/*!
+ * @brief Decodes a Wavefront OBJ, polygons are fanned into triangles, groups
+ * and materials are ignored and everything ends up in one mesh, faces without
+ * normals get their face normal
+ * @param bytes the contents of the file
+ * @return On success, returns the mesh, on failure, returns unexpected with
+ * error message
+ */
+auto load_obj(std::span<const uint8_t> bytes) -> expected<Mesh, string>;
+
+/*!
+ * @brief Checks whether the mesh cooker understands a file extension
+ * @param extension the file extension, lower case with the dot
+ * @return true if the extension is supported
+ */
+auto is_supported_mesh(const string &extension) -> bool;
+} // namespace SFT::Editor::Cooker
+
+#endif // MESHLOADER_H
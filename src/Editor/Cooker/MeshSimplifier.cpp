@@ -0,0 +1,348 @@
+//
+// Created by sturd on 10/18/2026.
+//
+
+#include "MeshSimplifier.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <queue>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace SFT::Editor::Cooker {
+#pragma region additional functions
+namespace {
+// a level has to drop at least this fraction of the previous level's
+// triangles, otherwise the mesh is as simple as it gets
+constexpr float minLodReduction = 0.1f;
+// a collapse may not turn a triangle further than this, as a cosine
+constexpr double minNormalCosine = 0.2;
+
+using Vec3 = std::array<double, 3>;
+
+auto subtract(const Vec3 &a, const Vec3 &b) -> Vec3 {
+  return {a[0] - b[0], a[1] - b[1], a[2] - b[2]};
+}
+
+auto cross(const Vec3 &a, const Vec3 &b) -> Vec3 {
+  return {a[1] * b[2] - a[2] * b[1], a[2] * b[0] - a[0] * b[2],
+          a[0] * b[1] - a[1] * b[0]};
+}
+
+auto dot(const Vec3 &a, const Vec3 &b) -> double {
+  return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+}
+
+auto normalize(const Vec3 &v) -> Vec3 {
+  const double length = std::sqrt(dot(v, v));
+  return length > 0.0 ? Vec3{v[0] / length, v[1] / length, v[2] / length}
+                      : Vec3{0.0, 0.0, 0.0};
+}
+
+/*!
+ * the symmetric 4x4 matrix of a sum of squared plane distances, evaluating it
+ * at a point gives the sum of the squared distances to every plane in it
+ */
+struct Quadric {
+  // xx xy xz xw yy yz yw zz zw ww
+  std::array<double, 10> m{};
+
+  auto add_plane(const Vec3 &normal, const double distance) -> void {
+    const double a = normal[0];
+    const double b = normal[1];
+    const double c = normal[2];
+    const double d = distance;
+    const double terms[10] = {a * a, a * b, a * c, a * d, b * b,
+                              b * c, b * d, c * c, c * d, d * d};
+    for (size_t i = 0; i < 10; i++) {
+      this->m[i] += terms[i];
+    }
+  }
+
+  auto operator+=(const Quadric &other) -> Quadric & {
+    for (size_t i = 0; i < 10; i++) {
+      this->m[i] += other.m[i];
+    }
+    return *this;
+  }
+
+  [[nodiscard]] auto evaluate(const Vec3 &p) const -> double {
+    const double x = p[0];
+    const double y = p[1];
+    const double z = p[2];
+    const double value = m[0] * x * x + 2.0 * m[1] * x * y +
+                         2.0 * m[2] * x * z + 2.0 * m[3] * x + m[4] * y * y +
+                         2.0 * m[5] * y * z + 2.0 * m[6] * y + m[7] * z * z +
+                         2.0 * m[8] * z + m[9];
+    return std::max(value, 0.0);
+  }
+};
+
+struct Collapse {
+  double cost;
+  uint32_t from;
+  uint32_t to;
+  uint32_t fromVersion;
+  uint32_t toVersion;
+
+  auto operator>(const Collapse &other) const -> bool {
+    return this->cost > other.cost;
+  }
+};
+
+auto edge_key(const uint32_t a, const uint32_t b) -> uint64_t {
+  return (static_cast<uint64_t>(std::min(a, b)) << 32) | std::max(a, b);
+}
+
+struct PositionHash {
+  auto operator()(const std::array<float, 3> &p) const -> size_t {
+    uint32_t bits[3];
+    std::memcpy(bits, p.data(), sizeof(bits));
+    uint64_t hash = bits[0];
+    hash = hash * 0x9e3779b97f4a7c15ULL ^ bits[1];
+    hash = hash * 0x9e3779b97f4a7c15ULL ^ bits[2];
+    return static_cast<size_t>(hash ^ (hash >> 29));
+  }
+};
+} // namespace
+#pragma endregion
+
+#pragma region MeshSimplifier Functions
+auto simplify_mesh(const Mesh &mesh, const size_t targetIndexCount,
+                   const float maxError) -> SimplifiedMesh {
+  const auto vertexCount = static_cast<uint32_t>(mesh.vertices.size());
+  const size_t triangleCount = mesh.indices.size() / 3;
+  SimplifiedMesh result;
+  if (mesh.indices.size() <= targetIndexCount || triangleCount == 0) {
+    result.indices = mesh.indices;
+    return result;
+  }
+
+  // vertices that only differ in normal or uv share a position, the
+  // quadrics and borders are about positions
+  vector<uint32_t> positionOf(vertexCount);
+  vector<Vec3> positions;
+  vector<uint32_t> verticesAtPosition;
+  {
+    std::unordered_map<std::array<float, 3>, uint32_t, PositionHash> unique;
+    for (uint32_t v = 0; v < vertexCount; v++) {
+      const auto &p = mesh.vertices[v].position;
+      auto [found, inserted] = unique.try_emplace(
+          std::array<float, 3>{p[0], p[1], p[2]},
+          static_cast<uint32_t>(positions.size()));
+      if (inserted) {
+        positions.push_back({p[0], p[1], p[2]});
+        verticesAtPosition.push_back(0);
+      }
+      positionOf[v] = found->second;
+      verticesAtPosition[found->second]++;
+    }
+  }
+  const auto position = [&](const uint32_t vertex) -> const Vec3 & {
+    return positions[positionOf[vertex]];
+  };
+
+  vector<std::array<uint32_t, 3>> triangles(triangleCount);
+  vector<bool> triangleAlive(triangleCount, true);
+  size_t aliveTriangles = triangleCount;
+  vector<vector<uint32_t>> adjacency(vertexCount);
+  vector<Quadric> quadrics(positions.size());
+  std::unordered_map<uint64_t, uint32_t> edgeUses;
+  for (size_t t = 0; t < triangleCount; t++) {
+    auto &triangle = triangles[t];
+    triangle = {mesh.indices[t * 3], mesh.indices[t * 3 + 1],
+                mesh.indices[t * 3 + 2]};
+    const Vec3 normal =
+        normalize(cross(subtract(position(triangle[1]), position(triangle[0])),
+                        subtract(position(triangle[2]), position(triangle[0]))));
+    const double distance = -dot(normal, position(triangle[0]));
+    for (uint32_t corner = 0; corner < 3; corner++) {
+      adjacency[triangle[corner]].push_back(static_cast<uint32_t>(t));
+      quadrics[positionOf[triangle[corner]]].add_plane(normal, distance);
+      edgeUses[edge_key(positionOf[triangle[corner]],
+                        positionOf[triangle[(corner + 1) % 3]])]++;
+    }
+  }
+
+  // border edges get a plane through them, perpendicular to their triangle,
+  // so moving a border vertex off the border costs as much as moving it off
+  // the surface
+  vector<bool> onBorder(positions.size(), false);
+  std::unordered_set<uint64_t> borderEdges;
+  for (size_t t = 0; t < triangleCount; t++) {
+    const auto &triangle = triangles[t];
+    const Vec3 normal =
+        normalize(cross(subtract(position(triangle[1]), position(triangle[0])),
+                        subtract(position(triangle[2]), position(triangle[0]))));
+    for (uint32_t corner = 0; corner < 3; corner++) {
+      const uint32_t a = positionOf[triangle[corner]];
+      const uint32_t b = positionOf[triangle[(corner + 1) % 3]];
+      if (edgeUses[edge_key(a, b)] != 1) {
+        continue;
+      }
+      borderEdges.insert(edge_key(a, b));
+      onBorder[a] = true;
+      onBorder[b] = true;
+      const Vec3 side = normalize(cross(subtract(positions[b], positions[a]),
+                                        normal));
+      const double distance = -dot(side, positions[a]);
+      quadrics[a].add_plane(side, distance);
+      quadrics[b].add_plane(side, distance);
+    }
+  }
+
+  // seams would tear if one side moved without the other
+  const auto locked = [&](const uint32_t vertex) {
+    return verticesAtPosition[positionOf[vertex]] > 1;
+  };
+  vector<uint32_t> versions(vertexCount, 0);
+  vector<bool> vertexAlive(vertexCount, true);
+  std::priority_queue<Collapse, vector<Collapse>, std::greater<>> queue;
+  const auto push = [&](const uint32_t from, const uint32_t to) {
+    if (from == to || locked(from) ||
+        positionOf[from] == positionOf[to]) {
+      return;
+    }
+    Quadric combined = quadrics[positionOf[from]];
+    combined += quadrics[positionOf[to]];
+    queue.push({combined.evaluate(position(to)), from, to, versions[from],
+                versions[to]});
+  };
+  for (const auto &triangle : triangles) {
+    for (uint32_t corner = 0; corner < 3; corner++) {
+      push(triangle[corner], triangle[(corner + 1) % 3]);
+      push(triangle[(corner + 1) % 3], triangle[corner]);
+    }
+  }
+
+  const double maxCost = static_cast<double>(maxError) * maxError;
+  double worstCost = 0.0;
+  while (!queue.empty() && aliveTriangles * 3 > targetIndexCount) {
+    const Collapse collapse = queue.top();
+    queue.pop();
+    const uint32_t from = collapse.from;
+    const uint32_t to = collapse.to;
+    if (!vertexAlive[from] || !vertexAlive[to] ||
+        versions[from] != collapse.fromVersion ||
+        versions[to] != collapse.toVersion) {
+      continue;
+    }
+    if (collapse.cost > maxCost) {
+      break;
+    }
+    const uint32_t fromPosition = positionOf[from];
+    const uint32_t toPosition = positionOf[to];
+    // a border vertex may only slide along its border
+    if (onBorder[fromPosition] &&
+        !borderEdges.contains(edge_key(fromPosition, toPosition))) {
+      continue;
+    }
+    bool valid = false;
+    bool flips = false;
+    for (const uint32_t t : adjacency[from]) {
+      if (!triangleAlive[t]) {
+        continue;
+      }
+      const auto &triangle = triangles[t];
+      if (triangle[0] == to || triangle[1] == to || triangle[2] == to) {
+        // the edge exists, the collapse removes this triangle
+        valid = true;
+        continue;
+      }
+      std::array<Vec3, 3> before;
+      std::array<Vec3, 3> after;
+      for (uint32_t corner = 0; corner < 3; corner++) {
+        before[corner] = position(triangle[corner]);
+        after[corner] =
+            triangle[corner] == from ? position(to) : before[corner];
+      }
+      const Vec3 normalBefore = normalize(cross(
+          subtract(before[1], before[0]), subtract(before[2], before[0])));
+      const Vec3 normalAfter = normalize(
+          cross(subtract(after[1], after[0]), subtract(after[2], after[0])));
+      if (dot(normalBefore, normalAfter) < minNormalCosine) {
+        flips = true;
+        break;
+      }
+    }
+    if (!valid || flips) {
+      continue;
+    }
+
+    for (const uint32_t t : adjacency[from]) {
+      if (!triangleAlive[t]) {
+        continue;
+      }
+      auto &triangle = triangles[t];
+      if (triangle[0] == to || triangle[1] == to || triangle[2] == to) {
+        triangleAlive[t] = false;
+        aliveTriangles--;
+        continue;
+      }
+      for (auto &corner : triangle) {
+        if (corner == from) {
+          corner = to;
+        }
+      }
+      adjacency[to].push_back(t);
+    }
+    adjacency[from].clear();
+    vertexAlive[from] = false;
+    quadrics[toPosition] += quadrics[fromPosition];
+    if (onBorder[fromPosition]) {
+      borderEdges.erase(edge_key(fromPosition, toPosition));
+    }
+    worstCost = std::max(worstCost, collapse.cost);
+
+    // every edge around the kept vertex has a new cost
+    versions[to]++;
+    std::erase_if(adjacency[to],
+                  [&](const uint32_t t) { return !triangleAlive[t]; });
+    for (const uint32_t t : adjacency[to]) {
+      for (const uint32_t corner : triangles[t]) {
+        if (corner != to) {
+          push(corner, to);
+          push(to, corner);
+        }
+      }
+    }
+  }
+
+  result.indices.reserve(aliveTriangles * 3);
+  for (size_t t = 0; t < triangleCount; t++) {
+    if (triangleAlive[t]) {
+      result.indices.insert(result.indices.end(), triangles[t].begin(),
+                            triangles[t].end());
+    }
+  }
+  result.error = static_cast<float>(std::sqrt(worstCost));
+  return result;
+}
+
+auto generate_lods(const Mesh &mesh, const LodSettings &settings,
+                   const float radius) -> vector<SimplifiedMesh> {
+  vector<SimplifiedMesh> lods;
+  lods.push_back({mesh.indices, 0.0f});
+  const float maxError = radius * settings.maxRelativeError;
+  while (lods.size() < settings.maxLods) {
+    const size_t previous = lods.back().indices.size();
+    const auto target = static_cast<size_t>(
+        static_cast<float>(previous / 3) * settings.reduction) * 3;
+    if (target / 3 < settings.minTriangles) {
+      break;
+    }
+    SimplifiedMesh lod = simplify_mesh(mesh, target, maxError);
+    if (static_cast<float>(lod.indices.size()) >
+        static_cast<float>(previous) * (1.0f - minLodReduction)) {
+      break;
+    }
+    lod.error = std::max(lod.error, lods.back().error);
+    lods.push_back(std::move(lod));
+  }
+  return lods;
+}
+#pragma endregion
+} // namespace SFT::Editor::Cooker
@@ -0,0 +1,60 @@
+//
+// Created by sturd on 10/18/2026.
+//
+
+#ifndef MESHSIMPLIFIER_H
+#define MESHSIMPLIFIER_H
+
+#include "MeshLoader.h"
+#include <cstdint>
+#include <span>
+#include <vector>
+
+using std::vector;
+
+namespace SFT::Editor::Cooker {
+struct SimplifiedMesh {
+  vector<uint32_t> indices;
+  // the largest distance, in mesh units, the collapses moved the surface by
+  float error = 0.0f;
+};
+
+/*!
+ * @brief Simplifies a mesh with quadric error metrics, edges are collapsed
+ * onto one of their own vertices, cheapest first, so the result indexes the
+ * original vertices and needs no new ones. Mesh borders are weighted to stay
+ * in place, vertices on attribute seams are never moved, and collapses that
+ * would flip a triangle are skipped
+ * @param mesh the mesh to simplify
+ * @param targetIndexCount stop once the mesh has this few indices
+ * @param maxError stop before a collapse would move the surface further than
+ * this, in mesh units
+ * @return the simplified indices and the error they have
+ */
+auto simplify_mesh(const Mesh &mesh, size_t targetIndexCount, float maxError)
+    -> SimplifiedMesh;
+
+struct LodSettings {
+  // each LOD aims for this fraction of the previous one's triangles
+  float reduction = 0.5f;
+  // LODs stop here, or when a level couldn't reduce the mesh much
+  uint32_t maxLods = 8;
+  size_t minTriangles = 32;
+  // as a fraction of the mesh's bounding radius
+  float maxRelativeError = 0.1f;
+};
+
+/*!
+ * @brief Builds an LOD chain, LOD 0 is the mesh itself and every further
+ * level is simplified from the full mesh so its error is measured against
+ * the real surface, errors never decrease along the chain
+ * @param mesh the full detail mesh
+ * @param settings how far to go
+ * @param radius the bounding radius of the mesh
+ * @return the levels from the finest to the coarsest
+ */
+auto generate_lods(const Mesh &mesh, const LodSettings &settings, float radius)
+    -> vector<SimplifiedMesh>;
+} // namespace SFT::Editor::Cooker
+
+#endif // MESHSIMPLIFIER_H
@@ -0,0 +1,160 @@
+//
+// Created by sturd on 10/18/2026.
+//
+
+#include "MipGenerator.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+#include <emmintrin.h>
+#define SFT_COOKER_SSE2 1
+#endif
+
+namespace SFT::Editor::Cooker {
+#pragma region additional functions
+namespace {
+/*!
+ * @brief A level being filtered, four floats per texel so a texel is exactly
+ * one SSE register
+ */
+struct LinearImage {
+  uint32_t width = 0;
+  uint32_t height = 0;
+  vector<float> texels;
+};
+
+constexpr size_t EncodeTableSize = 4096;
+
+auto srgb_to_linear(const float value) -> float {
+  return value <= 0.04045f ? value / 12.92f
+                           : std::pow((value + 0.055f) / 1.055f, 2.4f);
+}
+
+auto linear_to_srgb(const float value) -> float {
+  return value <= 0.0031308f ? value * 12.92f
+                             : 1.055f * std::pow(value, 1.0f / 2.4f) - 0.055f;
+}
+
+/*!
+ * @brief Lookup tables for the sRGB transfer function, decoding has only 256
+ * inputs, encoding is sampled on a grid over the square root of the linear
+ * value which spends most entries on the dark end where sRGB steps are small
+ */
+struct TransferTables {
+  std::array<float, 256> decode{};
+  std::array<float, EncodeTableSize + 1> encode{};
+
+  TransferTables() {
+    for (uint32_t i = 0; i < 256; i++) {
+      this->decode[i] = srgb_to_linear(static_cast<float>(i) / 255.0f);
+    }
+    for (size_t i = 0; i <= EncodeTableSize; i++) {
+      const float root = static_cast<float>(i) / EncodeTableSize;
+      this->encode[i] = linear_to_srgb(root * root) * 255.0f;
+    }
+  }
+
+  [[nodiscard]] auto to_srgb8(const float linear) const -> uint8_t {
+    const float root = std::sqrt(std::clamp(linear, 0.0f, 1.0f));
+    const float position = root * EncodeTableSize;
+    const auto index = std::min(static_cast<size_t>(position), EncodeTableSize - 1);
+    const float fraction = position - static_cast<float>(index);
+    const float value = this->encode[index] +
+                        (this->encode[index + 1] - this->encode[index]) * fraction;
+    return static_cast<uint8_t>(std::clamp(value + 0.5f, 0.0f, 255.0f));
+  }
+};
+
+auto tables() -> const TransferTables & {
+  static const TransferTables instance;
+  return instance;
+}
+
+auto to_linear(const Image &image, const bool srgb,
+               Threading::ThreadPool &pool) -> LinearImage {
+  LinearImage linear;
+  linear.width = image.width;
+  linear.height = image.height;
+  linear.texels.resize(static_cast<size_t>(image.width) * image.height * 4);
+  const auto &transfer = tables();
+  pool.parallel_for(image.height, [&](const size_t begin, const size_t end) {
+    for (size_t i = begin * image.width * 4; i < end * image.width * 4; i++) {
+      const uint8_t value = image.rgba[i];
+      linear.texels[i] = srgb && i % 4 != 3 ? transfer.decode[value]
+                                            : static_cast<float>(value) / 255.0f;
+    }
+  });
+  return linear;
+}
+
+auto to_image(const LinearImage &linear, const bool srgb,
+              Threading::ThreadPool &pool) -> Image {
+  Image image;
+  image.width = linear.width;
+  image.height = linear.height;
+  image.rgba.resize(linear.texels.size());
+  const auto &transfer = tables();
+  pool.parallel_for(linear.height, [&](const size_t begin, const size_t end) {
+    for (size_t i = begin * linear.width * 4; i < end * linear.width * 4; i++) {
+      const float value = linear.texels[i];
+      image.rgba[i] = srgb && i % 4 != 3
+                          ? transfer.to_srgb8(value)
+                          : static_cast<uint8_t>(
+                                std::clamp(value * 255.0f + 0.5f, 0.0f, 255.0f));
+    }
+  });
+  return image;
+}
+
+auto downsample(const LinearImage &source, Threading::ThreadPool &pool)
+    -> LinearImage {
+  LinearImage target;
+  target.width = std::max(1u, source.width / 2);
+  target.height = std::max(1u, source.height / 2);
+  target.texels.resize(static_cast<size_t>(target.width) * target.height * 4);
+  pool.parallel_for(target.height, [&](const size_t begin, const size_t end) {
+    for (size_t y = begin; y < end; y++) {
+      // odd sizes and 1 texel wide levels clamp to the last row/column
+      const size_t y0 = std::min<size_t>(y * 2, source.height - 1);
+      const size_t y1 = std::min<size_t>(y * 2 + 1, source.height - 1);
+      const float *row0 = &source.texels[y0 * source.width * 4];
+      const float *row1 = &source.texels[y1 * source.width * 4];
+      float *out = &target.texels[y * target.width * 4];
+      for (size_t x = 0; x < target.width; x++) {
+        const size_t x0 = std::min<size_t>(x * 2, source.width - 1) * 4;
+        const size_t x1 = std::min<size_t>(x * 2 + 1, source.width - 1) * 4;
+#ifdef SFT_COOKER_SSE2
+        const __m128 sum = _mm_add_ps(
+            _mm_add_ps(_mm_loadu_ps(row0 + x0), _mm_loadu_ps(row0 + x1)),
+            _mm_add_ps(_mm_loadu_ps(row1 + x0), _mm_loadu_ps(row1 + x1)));
+        _mm_storeu_ps(out + x * 4, _mm_mul_ps(sum, _mm_set1_ps(0.25f)));
+#else
+        for (size_t c = 0; c < 4; c++) {
+          out[x * 4 + c] =
+              (row0[x0 + c] + row0[x1 + c] + row1[x0 + c] + row1[x1 + c]) *
+              0.25f;
+        }
+#endif
+      }
+    }
+  });
+  return target;
+}
+} // namespace
+#pragma endregion
+
+auto generate_mips(const Image &image, const bool srgb,
+                   Threading::ThreadPool &pool) -> vector<Image> {
+  vector<Image> levels;
+  levels.push_back(image);
+  LinearImage current = to_linear(image, srgb, pool);
+  while (current.width > 1 || current.height > 1) {
+    current = downsample(current, pool);
+    levels.push_back(to_image(current, srgb, pool));
+  }
+  return levels;
+}
+} // namespace SFT::Editor::Cooker
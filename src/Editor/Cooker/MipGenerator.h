@@ -0,0 +1,29 @@
+//
+// Created by sturd on 10/18/2026.
+//
+
+#ifndef MIPGENERATOR_H
+#define MIPGENERATOR_H
+
+#include "Core/Threading/ThreadPool.h"
+#include "ImageLoader.h"
+#include <vector>
+
+using std::vector;
+
+namespace SFT::Editor::Cooker {
+/*!
+ * @brief Builds the full mip chain of an image, every level is filtered from
+ * the one above it with a 2x2 box filter in linear space, so sRGB colors are
+ * decoded before they are averaged and encoded again afterwards, otherwise
+ * every level would come out darker than the last
+ * @param image the base level
+ * @param srgb whether the color channels are sRGB encoded, alpha never is
+ * @param pool the threads rows are filtered on
+ * @return every level, the base level first, down to 1x1
+ */
+auto generate_mips(const Image &image, bool srgb, Threading::ThreadPool &pool)
+    -> vector<Image>;
+} // namespace SFT::Editor::Cooker
+
+#endif // MIPGENERATOR_H
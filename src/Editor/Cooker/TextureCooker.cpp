@@ -0,0 +1,222 @@
+//
+// Created by sturd on 10/18/2026.
+//
+
+#include "TextureCooker.h"
+
+#include "Core/Assets/CookedTexture.h"
+#include "ImageLoader.h"
+#include "MipGenerator.h"
+#include "Core/Utility/Utility.h"
+#include "spdlog/spdlog.h"
+#include <vulkan/vulkan.h>
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <fstream>
+
+namespace SFT::Editor::Cooker {
+#pragma region additional functions
+namespace {
+// bump whenever the encoders change output, so everything is cooked again
+constexpr uint32_t CookerRevision = 1;
+
+using Utility::fnv1a;
+using Utility::read_file;
+
+auto vk_format(const CookSettings &settings) -> VkFormat {
+  switch (settings.format) {
+  case BlockFormat::BC1:
+    return settings.srgb ? VK_FORMAT_BC1_RGB_SRGB_BLOCK
+                         : VK_FORMAT_BC1_RGB_UNORM_BLOCK;
+  case BlockFormat::BC3:
+    return settings.srgb ? VK_FORMAT_BC3_SRGB_BLOCK : VK_FORMAT_BC3_UNORM_BLOCK;
+  case BlockFormat::BC5:
+    return VK_FORMAT_BC5_UNORM_BLOCK;
+  case BlockFormat::BC7:
+  default:
+    return settings.srgb ? VK_FORMAT_BC7_SRGB_BLOCK : VK_FORMAT_BC7_UNORM_BLOCK;
+  }
+}
+
+auto content_hash(const vector<uint8_t> &source, const CookSettings &settings)
+    -> uint64_t {
+  uint64_t hash = fnv1a(source.data(), source.size());
+  const uint32_t key[] = {Assets::CookedTextureVersion, CookerRevision,
+                          static_cast<uint32_t>(settings.format),
+                          settings.srgb ? 1u : 0u,
+                          settings.generateMips ? 1u : 0u};
+  return fnv1a(key, sizeof(key), hash);
+}
+
+auto is_up_to_date(const std::filesystem::path &output, const uint64_t hash)
+    -> bool {
+  std::ifstream file(output, std::ios::binary);
+  Assets::CookedTextureHeader header{};
+  if (!file.read(reinterpret_cast<char *>(&header), sizeof(header))) {
+    return false;
+  }
+  return header.magic == Assets::CookedTextureMagic &&
+         header.version == Assets::CookedTextureVersion &&
+         header.sourceHash == hash;
+}
+
+auto ends_with(const string &value, const string &suffix) -> bool {
+  return value.size() >= suffix.size() &&
+         value.compare(value.size() - suffix.size(), suffix.size(), suffix) ==
+             0;
+}
+
+auto lower_extension(const std::filesystem::path &path) -> string {
+  string extension = path.extension().string();
+  std::ranges::transform(extension, extension.begin(), [](const char c) {
+    return static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+  });
+  return extension;
+}
+} // namespace
+#pragma endregion
+
+#pragma region TextureCooker Functions
+TextureCooker::TextureCooker(const uint32_t threadCount)
+    : m_pool(std::make_unique<Threading::ThreadPool>(threadCount)) {}
+
+auto TextureCooker::settings_for(const std::filesystem::path &source)
+    -> CookSettings {
+  string stem = source.stem().string();
+  std::ranges::transform(stem, stem.begin(), [](const char c) {
+    return static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+  });
+  CookSettings settings;
+  if (ends_with(stem, "_n") || ends_with(stem, "_normal")) {
+    settings.format = BlockFormat::BC5;
+    settings.srgb = false;
+  } else if (ends_with(stem, "_l") || ends_with(stem, "_linear")) {
+    settings.srgb = false;
+  }
+  return settings;
+}
+
+auto TextureCooker::cook(const std::filesystem::path &source,
+                         const std::filesystem::path &output,
+                         const CookSettings &settings, const bool force)
+    -> expected<CookOutcome, string> {
+  auto bytes = read_file(source);
+  if (!bytes.has_value()) {
+    return unexpected(bytes.error());
+  }
+  const uint64_t hash = content_hash(bytes.value(), settings);
+  if (!force && is_up_to_date(output, hash)) {
+    return CookOutcome::UpToDate;
+  }
+
+  auto image = load_image(bytes.value(), lower_extension(source));
+  if (!image.has_value()) {
+    return unexpected(source.string() + ": " + image.error());
+  }
+  vector<Image> levels =
+      settings.generateMips
+          ? generate_mips(image.value(), settings.srgb, *this->m_pool)
+          : vector<Image>{std::move(image.value())};
+  if (levels.size() > Assets::CookedTextureMaxMips) {
+    return unexpected(source.string() + " is too large, cooked textures hold "
+                                        "at most " +
+                      std::to_string(Assets::CookedTextureMaxMips) + " mips");
+  }
+
+  Assets::CookedTextureHeader header{};
+  header.magic = Assets::CookedTextureMagic;
+  header.version = Assets::CookedTextureVersion;
+  header.vkFormat = static_cast<uint32_t>(vk_format(settings));
+  header.width = levels.front().width;
+  header.height = levels.front().height;
+  header.mipLevels = static_cast<uint32_t>(levels.size());
+  header.sourceHash = hash;
+  vector<vector<uint8_t>> payloads;
+  uint64_t offset = sizeof(header);
+  for (size_t level = 0; level < levels.size(); level++) {
+    payloads.push_back(
+        compress_image(levels[level], settings.format, *this->m_pool));
+    header.mips[level].offset = offset;
+    header.mips[level].size = payloads.back().size();
+    offset += (payloads.back().size() + Assets::CookedTextureAlignment - 1) /
+              Assets::CookedTextureAlignment * Assets::CookedTextureAlignment;
+  }
+
+  // written next to the output and renamed over it, so an interrupted cook
+  // never leaves a truncated file that looks up to date
+  if (output.has_parent_path()) {
+    std::error_code error;
+    std::filesystem::create_directories(output.parent_path(), error);
+    if (error) {
+      return unexpected("failed to create " + output.parent_path().string() +
+                        ": " + error.message());
+    }
+  }
+  std::filesystem::path temporary = output;
+  temporary += ".tmp";
+  {
+    std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+      return unexpected("failed to open " + temporary.string());
+    }
+    file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    constexpr char padding[Assets::CookedTextureAlignment] = {};
+    for (const auto &payload : payloads) {
+      file.write(reinterpret_cast<const char *>(payload.data()),
+                 static_cast<std::streamsize>(payload.size()));
+      const size_t remainder = payload.size() % Assets::CookedTextureAlignment;
+      if (remainder != 0) {
+        file.write(padding, static_cast<std::streamsize>(
+                                Assets::CookedTextureAlignment - remainder));
+      }
+    }
+    if (!file) {
+      return unexpected("failed to write " + temporary.string());
+    }
+  }
+  std::error_code error;
+  std::filesystem::rename(temporary, output, error);
+  if (error) {
+    return unexpected("failed to move " + temporary.string() + " to " +
+                      output.string() + ": " + error.message());
+  }
+  return CookOutcome::Cooked;
+}
+
+auto TextureCooker::cook_directory(const std::filesystem::path &input,
+                                   const std::filesystem::path &output,
+                                   const std::optional<CookSettings> &overrides,
+                                   const bool force)
+    -> expected<CookSummary, string> {
+  if (!std::filesystem::is_directory(input)) {
+    return unexpected(input.string() + " is not a directory");
+  }
+  CookSummary summary;
+  for (const auto &entry :
+       std::filesystem::recursive_directory_iterator(input)) {
+    if (!entry.is_regular_file() ||
+        !is_supported_image(lower_extension(entry.path()))) {
+      continue;
+    }
+    std::filesystem::path target =
+        output / std::filesystem::relative(entry.path(), input);
+    target.replace_extension(".sftx");
+    const CookSettings settings =
+        overrides.value_or(settings_for(entry.path()));
+    auto result = this->cook(entry.path(), target, settings, force);
+    if (!result.has_value()) {
+      spdlog::error("{}", result.error());
+      summary.failed++;
+    } else if (result.value() == CookOutcome::UpToDate) {
+      spdlog::debug("{} is up to date", entry.path().string());
+      summary.upToDate++;
+    } else {
+      spdlog::info("cooked {}", target.string());
+      summary.cooked++;
+    }
+  }
+  return summary;
+}
+#pragma endregion
+} // namespace SFT::Editor::Cooker
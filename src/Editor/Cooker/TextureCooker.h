@@ -0,0 +1,95 @@
+//
+// Created by sturd on 10/18/2026.
+//
+
+#ifndef TEXTURECOOKER_H
+#define TEXTURECOOKER_H
+
+#include "BlockCompression.h"
+#include "Core/Threading/ThreadPool.h"
+#include <cstdint>
+#include <expected>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <string>
+
+using std::expected;
+using std::string;
+using std::unexpected;
+
+namespace SFT::Editor::Cooker {
+struct CookSettings {
+  BlockFormat format = BlockFormat::BC7;
+  bool srgb = true;
+  bool generateMips = true;
+};
+
+enum class CookOutcome : uint8_t {
+  Cooked,
+  UpToDate,
+};
+
+struct CookSummary {
+  uint32_t cooked = 0;
+  uint32_t upToDate = 0;
+  uint32_t failed = 0;
+};
+
+/*!
+ * @brief Turns source images into cooked textures (see
+ * Core/Assets/CookedTexture.h), block compressed with their full mip chain so
+ * the runtime uploads them as they are, a texture is only cooked again when
+ * its source or its settings change
+ */
+class TextureCooker {
+private:
+  std::unique_ptr<Threading::ThreadPool> m_pool;
+
+public:
+  /*!
+   * @brief Creates the threads mips and blocks are spread over
+   * @param threadCount how many threads to use, 0 for one per core
+   */
+  explicit TextureCooker(uint32_t threadCount);
+  /*!
+   * @brief Picks settings from the file name, names ending in _n or _normal are
+   * normal maps (BC5, linear), names ending in _l or _linear hold data (BC7,
+   * linear), everything else is color (BC7, sRGB)
+   * @param source the source image
+   * @return the settings for the image
+   */
+  static auto settings_for(const std::filesystem::path &source) -> CookSettings;
+  /*!
+   * @brief Cooks one texture, unless the output was cooked from the same
+   * source with the same settings already
+   * @param source the source image
+   * @param output where the cooked texture is written
+   * @param settings how to cook it
+   * @param force cook even if the output is up to date
+   * @return On success, returns whether the texture was cooked or skipped, on
+   * failure, returns unexpected with error message
+   */
+  auto cook(const std::filesystem::path &source,
+            const std::filesystem::path &output, const CookSettings &settings,
+            bool force) -> expected<CookOutcome, string>;
+  /*!
+   * @brief Cooks every supported image below a directory, mirroring the
+   * directory structure with .sftx files, files are cooked one after another
+   * with each file using every thread
+   * @param input the directory of source images
+   * @param output the directory cooked textures are written to
+   * @param overrides settings to use instead of the ones picked by name
+   * @param force cook even if outputs are up to date
+   * @return On success, returns how many textures were cooked, skipped and
+   * failed, on failure (the input isn't a directory), returns unexpected with
+   * error message
+   */
+  auto cook_directory(const std::filesystem::path &input,
+                      const std::filesystem::path &output,
+                      const std::optional<CookSettings> &overrides, bool force)
+      -> expected<CookSummary, string>;
+};
+} // namespace SFT::Editor::Cooker
+
+#endif // TEXTURECOOKER_H
@@ -0,0 +1,248 @@
+//
+// Created by sturd on 10/18/2026.
+//
+
+#include "SceneBaker.h"
+
+#include "Core/Assets/SceneFormat.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <fstream>
+
+namespace SFT::Editor::Scene {
+#pragma region additional functions
+namespace {
+/*!
+ * @brief Lays a baked file out in one growing buffer, everything is addressed
+ * by offset while building since growing moves the buffer, relative arrays
+ * are filled in by link once both ends are placed
+ */
+class BakeWriter {
+private:
+  vector<std::byte> m_bytes;
+
+public:
+  template <typename T> auto allocate(const size_t count) -> size_t {
+    const size_t offset =
+        (this->m_bytes.size() + alignof(T) - 1) / alignof(T) * alignof(T);
+    this->m_bytes.resize(offset + count * sizeof(T));
+    return offset;
+  }
+
+  template <typename T> auto store(const size_t offset, const T &value) -> void {
+    std::memcpy(this->m_bytes.data() + offset, &value, sizeof(T));
+  }
+
+  auto link(const size_t field, const size_t target, const size_t count)
+      -> void {
+    const Assets::RelativeArray<std::byte> array{
+        .offset = count == 0 ? 0
+                             : static_cast<int64_t>(target) -
+                                   static_cast<int64_t>(field),
+        .count = count,
+    };
+    this->store(field, array);
+  }
+
+  auto link_string(const size_t field, const string &value) -> void {
+    const size_t offset = this->allocate<char>(value.size());
+    std::memcpy(this->m_bytes.data() + offset, value.data(), value.size());
+    this->link(field, offset, value.size());
+  }
+
+  auto take() -> vector<std::byte> {
+    // the size is padded so anything placed after this file in an archive or
+    // in memory stays aligned
+    this->m_bytes.resize((this->m_bytes.size() + 7) / 8 * 8);
+    return std::move(this->m_bytes);
+  }
+};
+
+auto to_index(const int32_t index) -> uint32_t {
+  return index < 0 ? Assets::SceneNone : static_cast<uint32_t>(index);
+}
+
+auto light_type(const string &type) -> expected<Assets::SceneLightType, string> {
+  if (type == "directional") {
+    return Assets::SceneLightType::Directional;
+  }
+  if (type == "point") {
+    return Assets::SceneLightType::Point;
+  }
+  if (type == "spot") {
+    return Assets::SceneLightType::Spot;
+  }
+  return unexpected("unknown light type '" + type + "'");
+}
+
+// where a field of the index'th element of an array placed at arrayOffset is
+template <typename T>
+auto field_offset(const size_t arrayOffset, const size_t index,
+                  const size_t fieldOffset) -> size_t {
+  return arrayOffset + index * sizeof(T) + fieldOffset;
+}
+} // namespace
+#pragma endregion
+
+auto bake_scene(const SceneDescription &scene)
+    -> expected<vector<std::byte>, string> {
+  for (size_t i = 0; i < scene.nodes.size(); i++) {
+    const auto &node = scene.nodes[i];
+    if (node.parent >= static_cast<int32_t>(i)) {
+      return unexpected("node '" + node.name +
+                        "' comes before its parent, parents must be listed "
+                        "first");
+    }
+    if (node.mesh >= static_cast<int32_t>(scene.meshes.size()) ||
+        node.material >= static_cast<int32_t>(scene.materials.size()) ||
+        node.light >= static_cast<int32_t>(scene.lights.size())) {
+      return unexpected("node '" + node.name + "' refers to a missing mesh, "
+                                               "material or light");
+    }
+  }
+
+  BakeWriter writer;
+  const size_t header = writer.allocate<Assets::SceneHeader>(1);
+  const size_t nodes = writer.allocate<Assets::SceneNode>(scene.nodes.size());
+  const size_t meshes = writer.allocate<Assets::SceneMesh>(scene.meshes.size());
+  const size_t materials =
+      writer.allocate<Assets::SceneMaterial>(scene.materials.size());
+  const size_t lights =
+      writer.allocate<Assets::SceneLight>(scene.lights.size());
+
+  for (size_t i = 0; i < scene.nodes.size(); i++) {
+    const auto &source = scene.nodes[i];
+    Assets::SceneNode node{};
+    std::ranges::copy(source.translation, node.local.translation);
+    std::ranges::copy(source.rotation, node.local.rotation);
+    std::ranges::copy(source.scale, node.local.scale);
+    node.parent = to_index(source.parent);
+    node.mesh = to_index(source.mesh);
+    node.material = to_index(source.material);
+    node.light = to_index(source.light);
+    writer.store(nodes + i * sizeof(node), node);
+  }
+  for (size_t i = 0; i < scene.meshes.size(); i++) {
+    Assets::SceneMesh mesh{};
+    std::ranges::copy(scene.meshes[i].boundsMin, mesh.boundsMin);
+    std::ranges::copy(scene.meshes[i].boundsMax, mesh.boundsMax);
+    writer.store(meshes + i * sizeof(mesh), mesh);
+  }
+  for (size_t i = 0; i < scene.materials.size(); i++) {
+    const auto &source = scene.materials[i];
+    Assets::SceneMaterial material{};
+    std::ranges::copy(source.baseColor, material.baseColor);
+    material.roughness = source.roughness;
+    material.metallic = source.metallic;
+    writer.store(materials + i * sizeof(material), material);
+  }
+  for (size_t i = 0; i < scene.lights.size(); i++) {
+    const auto &source = scene.lights[i];
+    auto type = light_type(source.type);
+    if (!type.has_value()) {
+      return unexpected(type.error());
+    }
+    Assets::SceneLight light{};
+    light.type = type.value();
+    std::ranges::copy(source.color, light.color);
+    light.intensity = source.intensity;
+    light.range = source.range;
+    light.innerConeAngle = source.innerConeAngle;
+    light.outerConeAngle = source.outerConeAngle;
+    writer.store(lights + i * sizeof(light), light);
+  }
+
+  // strings go after every array, so the arrays stay together in memory
+  using Assets::SceneHeader;
+  using Assets::SceneMaterial;
+  using Assets::SceneMesh;
+  using Assets::SceneNode;
+  writer.link_string(header + offsetof(SceneHeader, name), scene.name);
+  for (size_t i = 0; i < scene.nodes.size(); i++) {
+    writer.link_string(
+        field_offset<SceneNode>(nodes, i, offsetof(SceneNode, name)),
+        scene.nodes[i].name);
+  }
+  for (size_t i = 0; i < scene.meshes.size(); i++) {
+    writer.link_string(
+        field_offset<SceneMesh>(meshes, i, offsetof(SceneMesh, asset)),
+        scene.meshes[i].asset);
+  }
+  for (size_t i = 0; i < scene.materials.size(); i++) {
+    writer.link_string(field_offset<SceneMaterial>(
+                           materials, i, offsetof(SceneMaterial, albedoTexture)),
+                       scene.materials[i].albedoTexture);
+    writer.link_string(field_offset<SceneMaterial>(
+                           materials, i, offsetof(SceneMaterial, normalTexture)),
+                       scene.materials[i].normalTexture);
+  }
+  writer.link(header + offsetof(SceneHeader, nodes), nodes, scene.nodes.size());
+  writer.link(header + offsetof(SceneHeader, meshes), meshes,
+              scene.meshes.size());
+  writer.link(header + offsetof(SceneHeader, materials), materials,
+              scene.materials.size());
+  writer.link(header + offsetof(SceneHeader, lights), lights,
+              scene.lights.size());
+  vector<std::byte> bytes = writer.take();
+
+  // the fixed fields last, the arrays and strings were linked in place above
+  Assets::SceneHeader fixed{};
+  std::memcpy(&fixed, bytes.data() + header, sizeof(fixed));
+  fixed.magic = Assets::SceneMagic;
+  fixed.versionMajor = Assets::SceneVersionMajor;
+  fixed.versionMinor = Assets::SceneVersionMinor;
+  fixed.headerSize = sizeof(Assets::SceneHeader);
+  fixed.fileSize = bytes.size();
+  std::memcpy(bytes.data() + header, &fixed, sizeof(fixed));
+
+  // the same checks the runtime makes, a scene that bakes always loads
+  if (auto view = Assets::view_scene(bytes); !view.has_value()) {
+    return unexpected("baked scene failed validation: " + view.error());
+  }
+  return bytes;
+}
+
+auto bake_scene_file(const std::filesystem::path &input,
+                     const std::filesystem::path &output)
+    -> expected<void, string> {
+  auto scene = load_scene_description(input);
+  if (!scene.has_value()) {
+    return unexpected(scene.error());
+  }
+  auto bytes = bake_scene(scene.value());
+  if (!bytes.has_value()) {
+    return unexpected(input.string() + ": " + bytes.error());
+  }
+  // written next to the output and renamed over it, so an interrupted bake
+  // never leaves a truncated scene behind
+  if (output.has_parent_path()) {
+    std::error_code error;
+    std::filesystem::create_directories(output.parent_path(), error);
+    if (error) {
+      return unexpected("failed to create " + output.parent_path().string() +
+                        ": " + error.message());
+    }
+  }
+  std::filesystem::path temporary = output;
+  temporary += ".tmp";
+  {
+    std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+      return unexpected("failed to open " + temporary.string());
+    }
+    file.write(reinterpret_cast<const char *>(bytes->data()),
+               static_cast<std::streamsize>(bytes->size()));
+    if (!file) {
+      return unexpected("failed to write " + temporary.string());
+    }
+  }
+  std::error_code error;
+  std::filesystem::rename(temporary, output, error);
+  if (error) {
+    return unexpected("failed to move " + temporary.string() + " to " +
+                      output.string() + ": " + error.message());
+  }
+  return {};
+}
+} // namespace SFT::Editor::Scene
@@ -0,0 +1,33 @@
+//
+// Created by sturd on 10/18/2026.
+//
+
+#ifndef SCENEBAKER_H
+#define SCENEBAKER_H
+
+#include "SceneDescription.h"
+#include <cstddef>
+
+namespace SFT::Editor::Scene {
+/*!
+ * @brief Flattens a scene into the baked format the runtime maps in place
+ * (see Assets::SceneHeader), arrays first, then every string
+ * @param scene the scene, its nodes must come after their parents
+ * @return On success, returns the file's bytes, on failure, returns unexpected
+ * with error message
+ */
+auto bake_scene(const SceneDescription &scene)
+    -> expected<vector<std::byte>, string>;
+/*!
+ * @brief Bakes a JSON scene into a file
+ * @param input the .json scene
+ * @param output the baked scene to write
+ * @return On success, returns void, on failure, returns unexpected with error
+ * message
+ */
+auto bake_scene_file(const std::filesystem::path &input,
+                     const std::filesystem::path &output)
+    -> expected<void, string>;
+} // namespace SFT::Editor::Scene
+
+#endif // SCENEBAKER_H
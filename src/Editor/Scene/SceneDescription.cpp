@@ -0,0 +1,45 @@
+//
+// Created by sturd on 10/18/2026.
+//
+
+#include "SceneDescription.h"
+
+#include <cereal/archives/json.hpp>
+#include <fstream>
+
+namespace SFT::Editor::Scene {
+auto load_scene_description(const std::filesystem::path &path)
+    -> expected<SceneDescription, string> {
+  std::ifstream file(path);
+  if (!file.is_open()) {
+    return unexpected("failed to open " + path.string());
+  }
+  SceneDescription scene;
+  // cereal reports malformed input by throwing
+  try {
+    cereal::JSONInputArchive archive(file);
+    archive(cereal::make_nvp("scene", scene));
+  } catch (const cereal::Exception &exception) {
+    return unexpected(path.string() + ": " + exception.what());
+  }
+  return scene;
+}
+
+auto save_scene_description(const SceneDescription &scene,
+                            const std::filesystem::path &path)
+    -> expected<void, string> {
+  std::ofstream file(path, std::ios::trunc);
+  if (!file.is_open()) {
+    return unexpected("failed to open " + path.string());
+  }
+  {
+    // the archive finishes the JSON document when it goes out of scope
+    cereal::JSONOutputArchive archive(file);
+    archive(cereal::make_nvp("scene", scene));
+  }
+  if (!file) {
+    return unexpected("failed to write " + path.string());
+  }
+  return {};
+}
+} // namespace SFT::Editor::Scene
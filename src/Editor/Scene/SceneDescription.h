@@ -0,0 +1,118 @@
+//
+// Created by sturd on 10/18/2026.
+//
+
+#ifndef SCENEDESCRIPTION_H
+#define SCENEDESCRIPTION_H
+
+#include <cereal/cereal.hpp>
+#include <cereal/types/array.hpp>
+#include <cereal/types/string.hpp>
+#include <cereal/types/vector.hpp>
+#include <array>
+#include <cstdint>
+#include <expected>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+using std::expected;
+using std::string;
+using std::unexpected;
+using std::vector;
+
+// the editable form of a scene, read and written as JSON through cereal so it
+// diffs and merges well, the runtime only ever sees the baked form (see
+// Assets::SceneHeader)
+namespace SFT::Editor::Scene {
+struct NodeDescription {
+  string name;
+  // indices into the scene's arrays, -1 for none
+  int32_t parent = -1;
+  int32_t mesh = -1;
+  int32_t material = -1;
+  int32_t light = -1;
+  std::array<float, 3> translation{0.0f, 0.0f, 0.0f};
+  std::array<float, 4> rotation{0.0f, 0.0f, 0.0f, 1.0f};
+  std::array<float, 3> scale{1.0f, 1.0f, 1.0f};
+
+  template <class Archive> auto serialize(Archive &archive) -> void {
+    archive(CEREAL_NVP(name), CEREAL_NVP(parent), CEREAL_NVP(mesh),
+            CEREAL_NVP(material), CEREAL_NVP(light), CEREAL_NVP(translation),
+            CEREAL_NVP(rotation), CEREAL_NVP(scale));
+  }
+};
+
+struct MeshDescription {
+  string asset;
+  std::array<float, 3> boundsMin{0.0f, 0.0f, 0.0f};
+  std::array<float, 3> boundsMax{0.0f, 0.0f, 0.0f};
+
+  template <class Archive> auto serialize(Archive &archive) -> void {
+    archive(CEREAL_NVP(asset), CEREAL_NVP(boundsMin), CEREAL_NVP(boundsMax));
+  }
+};
+
+struct MaterialDescription {
+  string albedoTexture;
+  string normalTexture;
+  std::array<float, 4> baseColor{1.0f, 1.0f, 1.0f, 1.0f};
+  float roughness = 1.0f;
+  float metallic = 0.0f;
+
+  template <class Archive> auto serialize(Archive &archive) -> void {
+    archive(CEREAL_NVP(albedoTexture), CEREAL_NVP(normalTexture),
+            CEREAL_NVP(baseColor), CEREAL_NVP(roughness), CEREAL_NVP(metallic));
+  }
+};
+
+struct LightDescription {
+  // "directional", "point" or "spot"
+  string type = "point";
+  std::array<float, 3> color{1.0f, 1.0f, 1.0f};
+  float intensity = 1.0f;
+  float range = 10.0f;
+  float innerConeAngle = 0.0f;
+  float outerConeAngle = 0.785398f;
+
+  template <class Archive> auto serialize(Archive &archive) -> void {
+    archive(CEREAL_NVP(type), CEREAL_NVP(color), CEREAL_NVP(intensity),
+            CEREAL_NVP(range), CEREAL_NVP(innerConeAngle),
+            CEREAL_NVP(outerConeAngle));
+  }
+};
+
+struct SceneDescription {
+  string name;
+  vector<NodeDescription> nodes;
+  vector<MeshDescription> meshes;
+  vector<MaterialDescription> materials;
+  vector<LightDescription> lights;
+
+  template <class Archive> auto serialize(Archive &archive) -> void {
+    archive(CEREAL_NVP(name), CEREAL_NVP(nodes), CEREAL_NVP(meshes),
+            CEREAL_NVP(materials), CEREAL_NVP(lights));
+  }
+};
+
+/*!
+ * @brief Reads a scene from its JSON interchange form
+ * @param path the .json file
+ * @return On success, returns the scene, on failure, returns unexpected with
+ * error message
+ */
+auto load_scene_description(const std::filesystem::path &path)
+    -> expected<SceneDescription, string>;
+/*!
+ * @brief Writes a scene in its JSON interchange form
+ * @param scene the scene
+ * @param path the .json file
+ * @return On success, returns void, on failure, returns unexpected with error
+ * message
+ */
+auto save_scene_description(const SceneDescription &scene,
+                            const std::filesystem::path &path)
+    -> expected<void, string>;
+} // namespace SFT::Editor::Scene
+
+#endif // SCENEDESCRIPTION_H
@@ -1,9 +1,186 @@
+#include <charconv>
+#include <cstdint>
 #include <iostream>
+#include <optional>
+#include <string>
+#include <vector>
 
+#include "Cooker/ArchivePacker.h"
+#include "Cooker/MeshCooker.h"
+#include "Cooker/TextureCooker.h"
+#include "Scene/SceneBaker.h"
+#include "spdlog/spdlog.h"
 
 using std::cout;
+using std::string;
+using std::vector;
 
-int main()
+namespace {
+auto print_usage() -> void {
+    cout << "usage: Editor cook <input dir> <output dir> [options]\n"
+            "  --force            cook even if outputs are up to date\n"
+            "  --threads <n>      worker threads, defaults to one per core\n"
+            "  --format <f>       bc1, bc3, bc5 or bc7 for every texture instead\n"
+            "                     of picking by file name\n"
+            "  --linear           with --format, the data isn't sRGB\n"
+            "  --lods <n>         most LODs generated per mesh, defaults to 8\n"
+            "       Editor pack <input dir> <archive>\n"
+            "       Editor bake <scene.json> <baked scene>\n";
+}
+
+auto parse_format(const string& name) -> std::optional<SFT::Editor::Cooker::BlockFormat> {
+    using SFT::Editor::Cooker::BlockFormat;
+    if (name == "bc1") return BlockFormat::BC1;
+    if (name == "bc3") return BlockFormat::BC3;
+    if (name == "bc5") return BlockFormat::BC5;
+    if (name == "bc7") return BlockFormat::BC7;
+    return std::nullopt;
+}
+
+// the whole argument must be a number that fits, std::stoul would throw on
+// garbage and accept trailing junk and negative values
+auto parse_count(const string& text) -> std::optional<uint32_t> {
+    uint32_t value = 0;
+    const char* end = text.data() + text.size();
+    const auto [last, error] = std::from_chars(text.data(), end, value);
+    if (error != std::errc() || last != end)
+    {
+        return std::nullopt;
+    }
+    return value;
+}
+
+auto run_cook(const vector<string>& args) -> int {
+    bool force = false;
+    bool linear = false;
+    uint32_t threads = 0;
+    SFT::Editor::Cooker::LodSettings lodSettings;
+    std::optional<SFT::Editor::Cooker::CookSettings> overrides;
+    for (size_t i = 3; i < args.size(); i++)
+    {
+        if (args[i] == "--force")
+        {
+            force = true;
+        } else if (args[i] == "--linear")
+        {
+            linear = true;
+        } else if (args[i] == "--threads" && i + 1 < args.size())
+        {
+            const auto count = parse_count(args[++i]);
+            if (!count.has_value())
+            {
+                spdlog::error("invalid thread count '{}'", args[i]);
+                print_usage();
+                return 1;
+            }
+            threads = count.value();
+        } else if (args[i] == "--lods" && i + 1 < args.size())
+        {
+            const auto count = parse_count(args[++i]);
+            if (!count.has_value())
+            {
+                spdlog::error("invalid LOD count '{}'", args[i]);
+                print_usage();
+                return 1;
+            }
+            lodSettings.maxLods = count.value();
+        } else if (args[i] == "--format" && i + 1 < args.size())
+        {
+            const auto format = parse_format(args[++i]);
+            if (!format.has_value())
+            {
+                spdlog::error("unknown format '{}'", args[i]);
+                return 1;
+            }
+            overrides = SFT::Editor::Cooker::CookSettings{};
+            overrides->format = format.value();
+        } else
+        {
+            print_usage();
+            return 1;
+        }
+    }
+    if (overrides.has_value())
+    {
+        overrides->srgb = !linear && overrides->format != SFT::Editor::Cooker::BlockFormat::BC5;
+    }
+
+    SFT::Editor::Cooker::TextureCooker cooker(threads);
+    auto summary = cooker.cook_directory(args[1], args[2], overrides, force);
+    if (!summary.has_value())
+    {
+        spdlog::error("{}", summary.error());
+        return 1;
+    }
+    // meshes live next to the textures, the same directories are cooked for
+    // both
+    SFT::Editor::Cooker::MeshCooker meshCooker(lodSettings);
+    auto meshSummary = meshCooker.cook_directory(args[1], args[2], force);
+    if (!meshSummary.has_value())
+    {
+        spdlog::error("{}", meshSummary.error());
+        return 1;
+    }
+    summary->cooked += meshSummary->cooked;
+    summary->upToDate += meshSummary->upToDate;
+    summary->failed += meshSummary->failed;
+    spdlog::info(
+        "{} cooked, {} up to date, {} failed",
+        summary->cooked, summary->upToDate, summary->failed
+    );
+    return summary->failed == 0 ? 0 : 1;
+}
+
+auto run_pack(const vector<string>& args) -> int {
+    if (args.size() != 3)
+    {
+        print_usage();
+        return 1;
+    }
+    auto summary = SFT::Editor::Cooker::pack_directory(args[1], args[2]);
+    if (!summary.has_value())
+    {
+        spdlog::error("{}", summary.error());
+        return 1;
+    }
+    spdlog::info(
+        "packed {} assets, {} bytes of payload into {} bytes",
+        summary->entries, summary->payloadBytes, summary->archiveBytes
+    );
+    return 0;
+}
+
+auto run_bake(const vector<string>& args) -> int {
+    if (args.size() != 3)
+    {
+        print_usage();
+        return 1;
+    }
+    if (auto result = SFT::Editor::Scene::bake_scene_file(args[1], args[2]); !result.has_value())
+    {
+        spdlog::error("{}", result.error());
+        return 1;
+    }
+    spdlog::info("baked {}", args[2]);
+    return 0;
+}
+}
+
+int main(int argc, char** argv)
 {
-    cout << "Hello, World!\n";
-}
\ No newline at end of file
+    const vector<string> args(argv + 1, argv + argc);
+    if (args.size() >= 3 && args[0] == "cook")
+    {
+        return run_cook(args);
+    }
+    if (args.size() >= 3 && args[0] == "pack")
+    {
+        return run_pack(args);
+    }
+    if (args.size() >= 3 && args[0] == "bake")
+    {
+        return run_bake(args);
+    }
+    print_usage();
+    return args.empty() ? 0 : 1;
+}